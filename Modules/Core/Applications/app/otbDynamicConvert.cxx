@@ -26,12 +26,15 @@
 #include "otbStreamingShrinkImageFilter.h"
 #include "itkListSample.h"
 #include "otbListSampleToHistogramListGenerator.h"
+#include "otbStreamingStatisticsVectorImageFilter.h"
 #include "itkImageRegionConstIterator.h"
 
 #include "otbImageListToVectorImageFilter.h"
 #include "otbMultiToMonoChannelExtractROI.h"
 #include "otbImageList.h"
 
+#include <cmath>
+#include <limits>
 #include <numeric>
 
 namespace otb
@@ -63,6 +66,8 @@ public:
 
   typedef StreamingShrinkImageFilter<UInt8ImageType, UInt8ImageType> UInt8ShrinkFilterType;
 
+  typedef StreamingStatisticsVectorImageFilter<FloatVectorImageType> StatisticsFilterType;
+
 private:
   void DoInit() override
   {
@@ -76,6 +81,8 @@ private:
         "that corresponds to the given extension).\n"
         "The conversion can include a rescale of the data range, by default it's set between the 2nd to "
         "the 98th percentile. The rescale can be linear or log2. \n"
+        "The percentiles are estimated either on the histogram of a quicklook of the image, or on all the "
+        "pixels of the image with quantile sketches (see the quantile.method parameter).\n"
         "The choice of the output channels can be done with the extended filename, but "
         "less easy to handle. To do this, a 'channels' parameter allows you to "
         "select the desired bands at the output. There are 3 modes, the "
@@ -137,6 +144,29 @@ private:
     SetDefaultParameterFloat("quantile.low", 2.0);
     DisableParameter("quantile.low");
 
+    AddParameter(ParameterType_Choice, "quantile.method", "Quantile estimation method");
+    SetParameterDescription("quantile.method", "Method used to estimate the quantiles of each band");
+
+    AddChoice("quantile.method.histogram", "Histogram of a quicklook");
+    SetParameterDescription("quantile.method.histogram",
+                            "The quantiles are read from a 255 bins histogram of a quicklook of the image, "
+                            "at most 1000 pixels wide and high.");
+
+    AddChoice("quantile.method.sketch", "Quantile sketch of the whole image");
+    SetParameterDescription("quantile.method.sketch",
+                            "The quantiles are estimated on all the pixels of the image, in a single streaming pass, "
+                            "with a mergeable quantile sketch per band. With the default sketch size, the rank of "
+                            "the estimated quantiles is within about 2% of the requested one.");
+
+    AddParameter(ParameterType_Int, "quantile.method.sketch.size", "Sketch size");
+    SetParameterDescription("quantile.method.sketch.size",
+                            "Size of the quantile sketches. The rank error decreases as the inverse of the size, "
+                            "and each sketch keeps up to about 3 times this number of values.");
+    SetDefaultParameterInt("quantile.method.sketch.size", 200);
+    SetMinimumParameterIntValue("quantile.method.sketch.size", 8);
+
+    SetParameterString("quantile.method", "histogram");
+
     AddParameter(ParameterType_Choice, "channels", "Channels selection");
     SetParameterDescription("channels",
                             "It's possible to select the channels "
@@ -225,19 +255,7 @@ private:
 
     const unsigned int nbComp(tempImage->GetNumberOfComponentsPerPixel());
 
-    // We need to subsample the input image in order to estimate its histogram
-    // Shrink factor is computed so as to load a quicklook of 1000
-    // pixels square at most
-    auto         imageSize    = tempImage->GetLargestPossibleRegion().GetSize();
-    unsigned int shrinkFactor = std::max({int(imageSize[0]) / 1000, int(imageSize[1]) / 1000, 1});
-    otbAppLogDEBUG(<< "Shrink factor used to compute Min/Max: " << shrinkFactor);
-
-    otbAppLogDEBUG(<< "Shrink starts...");
-    typename ShrinkFilterType::Pointer shrinkFilter = ShrinkFilterType::New();
-    shrinkFilter->SetShrinkFactor(shrinkFactor);
-    shrinkFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
-    AddProcess(shrinkFilter->GetStreamer(), "Computing shrink Image for min/max estimation...");
-
+    FloatVectorImageType::Pointer image = tempImage;
     if (rescaleType == "log2")
     {
       // define lambda function that applies a log to all bands of the input pixel
@@ -259,22 +277,82 @@ private:
       transferLogFilter->SetInputs(tempImage);
       transferLogFilter->UpdateOutputInformation();
 
-      shrinkFilter->SetInput(transferLogFilter->GetOutput());
-      rescaler->SetInput(transferLogFilter->GetOutput());
-      shrinkFilter->Update();
+      image = transferLogFilter->GetOutput();
+    }
+    rescaler->SetInput(image);
+
+    // Extract the lower and upper quantile
+    typename FloatVectorImageType::PixelType inputMin(nbComp), inputMax(nbComp);
+    if (GetParameterString("quantile.method") == "sketch")
+    {
+      ComputeQuantilesWithSketches(image, inputMin, inputMax);
     }
     else
     {
-      shrinkFilter->SetInput(tempImage);
-      rescaler->SetInput(tempImage);
-      shrinkFilter->Update();
+      ComputeQuantilesWithHistograms(image, inputMin, inputMax);
+    }
+
+    otbAppLogDEBUG(<< std::setprecision(5) << "Min/Max computation done : min=" << inputMin << " max=" << inputMax);
+
+    rescaler->AutomaticInputMinMaxComputationOff();
+    rescaler->SetInputMinimum(inputMin);
+    rescaler->SetInputMaximum(inputMax);
+
+    if (rescaleType == "linear")
+    {
+      rescaler->SetGamma(GetParameterFloat("type.linear.gamma"));
     }
 
+    typename TImageType::PixelType minimum(nbComp);
+    typename TImageType::PixelType maximum(nbComp);
+
+    /*
+    float outminvalue = std::numeric_limits<typename TImageType::InternalPixelType>::min();
+    float outmaxvalue = std::numeric_limits<typename TImageType::InternalPixelType>::max();
+    // TODO test outmin/outmax values
+    if (outminvalue > GetParameterFloat("outmin"))
+      itkExceptionMacro("The outmin value at " << GetParameterFloat("outmin") <<
+                        " is too low, select a value in "<< outminvalue <<" min.");
+    if ( outmaxvalue < GetParameterFloat("outmax") )
+      itkExceptionMacro("The outmax value at " << GetParameterFloat("outmax") <<
+                        " is too high, select a value in "<< outmaxvalue <<" max.");
+    */
+
+    maximum.Fill(GetParameterFloat("outmax"));
+    minimum.Fill(GetParameterFloat("outmin"));
+
+    rescaler->SetOutputMinimum(minimum);
+    rescaler->SetOutputMaximum(maximum);
+
+    m_Filters.push_back(rescaler.GetPointer());
+    SetParameterOutputImage<TImageType>("out", rescaler->GetOutput());
+  }
+
+  // Estimate the quantiles on the histograms of a quicklook of the image
+  void ComputeQuantilesWithHistograms(FloatVectorImageType* image, FloatVectorImageType::PixelType& inputMin, FloatVectorImageType::PixelType& inputMax)
+  {
+    const unsigned int nbComp(image->GetNumberOfComponentsPerPixel());
+
+    // We need to subsample the input image in order to estimate its histogram
+    // Shrink factor is computed so as to load a quicklook of 1000
+    // pixels square at most
+    auto         imageSize    = image->GetLargestPossibleRegion().GetSize();
+    unsigned int shrinkFactor = std::max({int(imageSize[0]) / 1000, int(imageSize[1]) / 1000, 1});
+    otbAppLogDEBUG(<< "Shrink factor used to compute Min/Max: " << shrinkFactor);
+
+    otbAppLogDEBUG(<< "Shrink starts...");
+    ShrinkFilterType::Pointer shrinkFilter = ShrinkFilterType::New();
+    shrinkFilter->SetShrinkFactor(shrinkFactor);
+    shrinkFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+    AddProcess(shrinkFilter->GetStreamer(), "Computing shrink Image for min/max estimation...");
+    shrinkFilter->SetInput(image);
+    shrinkFilter->Update();
+
     otbAppLogDEBUG(<< "Evaluating input Min/Max...");
     itk::ImageRegionConstIterator<FloatVectorImageType> it(shrinkFilter->GetOutput(), shrinkFilter->GetOutput()->GetLargestPossibleRegion());
 
-    typename ListSampleType::Pointer listSample = ListSampleType::New();
-    listSample->SetMeasurementVectorSize(tempImage->GetNumberOfComponentsPerPixel());
+    ListSampleType::Pointer listSample = ListSampleType::New();
+    listSample->SetMeasurementVectorSize(nbComp);
 
     // Now we generate the list of samples
     if (IsParameterEnabled("mask"))
@@ -317,7 +395,7 @@ private:
     }
 
     // And then the histogram
-    typename HistogramsGeneratorType::Pointer histogramsGenerator = HistogramsGeneratorType::New();
+    HistogramsGeneratorType::Pointer histogramsGenerator = HistogramsGeneratorType::New();
     histogramsGenerator->SetListSample(listSample);
     histogramsGenerator->SetNumberOfBins(255);
     // Samples with nodata values are ignored
@@ -327,7 +405,6 @@ private:
     assert(histOutput);
 
     // And extract the lower and upper quantile
-    typename FloatVectorImageType::PixelType inputMin(nbComp), inputMax(nbComp);
     for (unsigned int i = 0; i < nbComp; ++i)
     {
       auto&& elm = histOutput->GetNthElement(i);
@@ -335,41 +412,94 @@ private:
       inputMin[i] = elm->Quantile(0, 0.01 * GetParameterFloat("quantile.low"));
       inputMax[i] = elm->Quantile(0, 1.0 - 0.01 * GetParameterFloat("quantile.high"));
     }
+  }
 
-    otbAppLogDEBUG(<< std::setprecision(5) << "Min/Max computation done : min=" << inputMin << " max=" << inputMax);
+  // Estimate the quantiles on all the pixels of the image, in a single
+  // streaming pass with a quantile sketch per band
+  void ComputeQuantilesWithSketches(FloatVectorImageType* image, FloatVectorImageType::PixelType& inputMin, FloatVectorImageType::PixelType& inputMax)
+  {
+    const unsigned int nbComp(image->GetNumberOfComponentsPerPixel());
+    const float        noData = std::numeric_limits<float>::quiet_NaN();
 
-    rescaler->AutomaticInputMinMaxComputationOff();
-    rescaler->SetInputMinimum(inputMin);
-    rescaler->SetInputMaximum(inputMax);
+    // Null values are ignored, as the nodata of the histograms, and so are
+    // masked pixels: the sketches leave non finite values out
+    auto nullToNaN = [noData](FloatVectorImageType::PixelType& vectorOut, const FloatVectorImageType::PixelType& vectorIn) {
+      for (unsigned int i = 0; i < vectorIn.Size(); i++)
+      {
+        vectorOut[i] = vectorIn[i] != 0 ? vectorIn[i] : noData;
+      }
+    };
+    auto maskedToNaN = [noData](FloatVectorImageType::PixelType& vectorOut, const FloatVectorImageType::PixelType& vectorIn, UInt8ImageType::PixelType mask) {
+      for (unsigned int i = 0; i < vectorIn.Size(); i++)
+      {
+        vectorOut[i] = mask != 0 && vectorIn[i] != 0 ? vectorIn[i] : noData;
+      }
+    };
 
-    if (rescaleType == "linear")
+    bool useMask = IsParameterEnabled("mask");
+    while (true)
     {
-      rescaler->SetGamma(GetParameterFloat("type.linear.gamma"));
-    }
+      StatisticsFilterType::Pointer statisticsFilter = StatisticsFilterType::New();
+      statisticsFilter->SetEnableMinMax(false);
+      statisticsFilter->SetEnableFirstOrderStats(false);
+      statisticsFilter->SetEnableSecondOrderStats(false);
+      statisticsFilter->SetEnableQuantiles(true);
+      statisticsFilter->SetQuantileSketchSize(GetParameterInt("quantile.method.sketch.size"));
+      statisticsFilter->SetIgnoreInfiniteValues(false);
+      statisticsFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+
+      // Keeps the filter of the valid pixels alive during the pass
+      itk::LightObject::Pointer validFilter;
+      if (useMask)
+      {
+        auto filter = NewFunctorFilter(maskedToNaN, nbComp, {{0, 0}});
+        filter->SetInputs(image, GetParameterUInt8Image("mask"));
+        statisticsFilter->SetInput(filter->GetOutput());
+        validFilter = filter.GetPointer();
+      }
+      else
+      {
+        auto filter = NewFunctorFilter(nullToNaN, nbComp, {{0, 0}});
+        filter->SetInputs(image);
+        statisticsFilter->SetInput(filter->GetOutput());
+        validFilter = filter.GetPointer();
+      }
 
-    typename TImageType::PixelType minimum(nbComp);
-    typename TImageType::PixelType maximum(nbComp);
+      AddProcess(statisticsFilter->GetStreamer(), "Estimating quantiles...");
+      statisticsFilter->Update();
 
-    /*
-    float outminvalue = std::numeric_limits<typename TImageType::InternalPixelType>::min();
-    float outmaxvalue = std::numeric_limits<typename TImageType::InternalPixelType>::max();
-    // TODO test outmin/outmax values
-    if (outminvalue > GetParameterFloat("outmin"))
-      itkExceptionMacro("The outmin value at " << GetParameterFloat("outmin") <<
-                        " is too low, select a value in "<< outminvalue <<" min.");
-    if ( outmaxvalue < GetParameterFloat("outmax") )
-      itkExceptionMacro("The outmax value at " << GetParameterFloat("outmax") <<
-                        " is too high, select a value in "<< outmaxvalue <<" max.");
-    */
-
-    maximum.Fill(GetParameterFloat("outmax"));
-    minimum.Fill(GetParameterFloat("outmin"));
+      inputMin = statisticsFilter->ComputeQuantiles(0.01 * GetParameterFloat("quantile.low"));
+      inputMax = statisticsFilter->ComputeQuantiles(1.0 - 0.01 * GetParameterFloat("quantile.high"));
 
-    rescaler->SetOutputMinimum(minimum);
-    rescaler->SetOutputMaximum(maximum);
+      bool empty = false;
+      for (unsigned int i = 0; i < nbComp; ++i)
+      {
+        empty = empty || std::isnan(inputMin[i]);
+      }
 
-    m_Filters.push_back(rescaler.GetPointer());
-    SetParameterOutputImage<TImageType>("out", rescaler->GetOutput());
+      if (empty && useMask)
+      {
+        otbAppLogINFO(<< "All pixels were masked, the application assume "
+                         "a wrong mask and include all the image");
+        useMask = false;
+      }
+      else
+      {
+        if (empty)
+        {
+          otbAppLogWARNING(<< "Some bands have no valid pixel, their input range is set to 0");
+        }
+        for (unsigned int i = 0; i < nbComp; ++i)
+        {
+          if (std::isnan(inputMin[i]))
+          {
+            inputMin[i] = 0;
+            inputMax[i] = 0;
+          }
+        }
+        return;
+      }
+    }
   }
 
   // Get the bands order
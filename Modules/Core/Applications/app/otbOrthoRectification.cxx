@@ -280,9 +280,13 @@ private:
         genericRSEstimator->EstimateIsotropicSpacingOff();
       }
 
+      // Preload the heights of the image footprint, as the DEM handler
+      // has just been reset
+      genericRSEstimator->PreloadDEMOn();
       genericRSEstimator->SetInput(inImage);
       genericRSEstimator->SetOutputProjectionRef(m_OutputProjectionRef);
       genericRSEstimator->Compute();
+      genericRSEstimator->PreloadDEMOff();
 
       SetDefaultParameterInt("outputs.sizex", genericRSEstimator->GetOutputSize()[0]);
       SetDefaultParameterInt("outputs.sizey", genericRSEstimator->GetOutputSize()[1]);
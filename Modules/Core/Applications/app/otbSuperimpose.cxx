@@ -21,8 +21,10 @@
 #include "otbWrapperApplicationFactory.h"
 
 #include "otbGenericRSResampleImageFilter.h"
+#include "otbImageToGenericRSOutputParameters.h"
 #include "otbGridResampleImageFilter.h"
 #include "otbImportGeoInformationImageFilter.h"
+#include "otbSpatialReference.h"
 
 #include "otbBCOInterpolateImageFunction.h"
 #include "itkNearestNeighborInterpolateImageFunction.h"
@@ -251,6 +253,18 @@ private:
       }
       m_Resampler->SetDisplacementFieldSpacing(defSpacing);
 
+      // Preload the heights of the output footprint, which is the one of the
+      // reference image
+      if (!refImage->GetProjectionRef().empty() || refImage->GetImageMetadata().HasSensorGeometry())
+      {
+        typedef otb::ImageToGenericRSOutputParameters<FloatVectorImageType> OutputParametersEstimatorType;
+        OutputParametersEstimatorType::Pointer                              footprintEstimator = OutputParametersEstimatorType::New();
+        footprintEstimator->PreloadDEMOn();
+        footprintEstimator->SetInput(refImage);
+        footprintEstimator->SetOutputProjectionRef(otb::SpatialReference::FromWGS84().ToWkt());
+        footprintEstimator->Compute();
+      }
+
       // Setup transform through projRef and ImageMetadata
       m_Resampler->SetInputImageMetadata(&(movingImage->GetImageMetadata()));
       m_Resampler->SetInputProjectionRef(movingImage->GetProjectionRef());
@@ -84,6 +84,19 @@ public:
    */
   static RAMValueType GetMaxRAMHint();
 
+  /**
+   * GDALBlockCacheSize is the maximum memory used by the cache of
+   * decoded blocks shared by all the GDAL image readers of the
+   * process, expressed in MegaBytes.
+   *
+   * If environment variable OTB_GDAL_BLOCK_CACHE_SIZE is defined and
+   * could be converted to int, return its content as a 64 bits
+   * unsigned int.
+   * Else, returns default value, which is 0 (cache disabled)
+   *
+   */
+  static RAMValueType GetGDALBlockCacheSize();
+
   /**
    * Logger level controls the level of logging that OTB will output.
    *
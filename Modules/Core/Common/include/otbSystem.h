@@ -63,6 +63,20 @@ public:
 
   /** Returns true if the file descriptor fd is interactive (i.e. like isatty on unix) */
   static bool IsInteractive(int fd);
+
+  /** Returns the resident memory of the current process in bytes, or 0 if
+   * it cannot be measured on this platform */
+  static unsigned long long GetResidentMemoryInBytes();
+
+  /** Returns the peak resident memory of the current process in bytes since
+   * the process start or the last successful ResetPeakResidentMemory(), or 0
+   * if it cannot be measured on this platform */
+  static unsigned long long GetPeakResidentMemoryInBytes();
+
+  /** Reset the peak resident memory to the current resident memory. Returns
+   * false if this is not supported (the peak then covers the whole process
+   * lifetime) */
+  static bool ResetPeakResidentMemory();
 };
 
 } // namespace otb
@@ -65,6 +65,20 @@ ConfigurationManager::RAMValueType ConfigurationManager::GetMaxRAMHint()
   }
 }
 
+ConfigurationManager::RAMValueType ConfigurationManager::GetGDALBlockCacheSize()
+{
+  std::string cache_size;
+  if (itksys::SystemTools::GetEnv("OTB_GDAL_BLOCK_CACHE_SIZE", cache_size))
+  {
+    return std::stoul(cache_size);
+  }
+  else
+  {
+    // Default value: the cache is disabled
+    return 0;
+  }
+}
+
 itk::LoggerBase::PriorityLevelType ConfigurationManager::GetLoggerLevel()
 {
   std::string svalue;
@@ -29,6 +29,7 @@
                    WIN32 / MSVC++ implementation
  *====================================================================*/
 #include <Windows.h>
+#include <psapi.h>
 #include <tchar.h>
 #include <stdio.h>
 #ifndef WIN32CE
@@ -42,7 +43,9 @@
  *====================================================================*/
 #include <unistd.h>
 #include <sys/types.h>
+#include <sys/resource.h>
 #include <dirent.h>
+#include <fstream>
 #endif
 
 namespace otb
@@ -241,4 +244,75 @@ bool System::IsInteractive(int fd)
   return isatty(fd);
 #endif
 }
+
+#if defined(__linux__)
+namespace
+{
+/** Read a "<key>: <value> kB" entry of /proc/self/status, in bytes */
+unsigned long long ReadProcStatusInBytes(const std::string& key)
+{
+  std::ifstream status("/proc/self/status");
+  std::string   line;
+  while (std::getline(status, line))
+  {
+    if (line.compare(0, key.size(), key) == 0 && line.size() > key.size() && line[key.size()] == ':')
+    {
+      return std::strtoull(line.c_str() + key.size() + 1, nullptr, 10) * 1024ULL;
+    }
+  }
+  return 0;
+}
+}
+#endif
+
+unsigned long long System::GetResidentMemoryInBytes()
+{
+#if (defined(WIN32) || defined(WIN32CE)) && !defined(__CYGWIN__) && !defined(__MINGW32__)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return counters.WorkingSetSize;
+  return 0;
+#elif defined(__linux__)
+  return ReadProcStatusInBytes("VmRSS");
+#else
+  return 0;
+#endif
+}
+
+unsigned long long System::GetPeakResidentMemoryInBytes()
+{
+#if (defined(WIN32) || defined(WIN32CE)) && !defined(__CYGWIN__) && !defined(__MINGW32__)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return counters.PeakWorkingSetSize;
+  return 0;
+#elif defined(__linux__)
+  return ReadProcStatusInBytes("VmHWM");
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(__APPLE__)
+  // ru_maxrss is in bytes on macOS, in kilobytes elsewhere
+  return static_cast<unsigned long long>(usage.ru_maxrss);
+#else
+  return static_cast<unsigned long long>(usage.ru_maxrss) * 1024ULL;
+#endif
+#endif
+}
+
+bool System::ResetPeakResidentMemory()
+{
+#if defined(__linux__)
+  // Writing 5 to clear_refs resets VmHWM to VmRSS (Linux >= 4.0)
+  std::ofstream clearRefs("/proc/self/clear_refs");
+  if (!clearRefs)
+    return false;
+  clearRefs << "5";
+  clearRefs.close();
+  return !clearRefs.fail();
+#else
+  return false;
+#endif
+}
 }
@@ -25,6 +25,8 @@
 #include "otbMacro.h"
 #include "itkProgressReporter.h"
 
+#include <vector>
+
 namespace otb
 {
 
@@ -93,68 +95,67 @@ void DEMToImageGenerator<TDEMImage>::ThreadedGenerateData(const OutputImageRegio
 {
   DEMImagePointerType DEMImage = this->GetOutput();
 
-  // Create an iterator that will walk the output region
-  ImageIteratorType outIt = ImageIteratorType(DEMImage, outputRegionForThread);
-
   // support progress methods/callbacks
   itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
-  // Walk the output image, evaluating the height at each pixel
+  const IndexType startIndex = outputRegionForThread.GetIndex();
+  const SizeType  size       = outputRegionForThread.GetSize();
+
+  // Walk the output image line by line: the heights of a line are
+  // evaluated by a single DEM query
+  std::vector<double> lon(size[0]);
+  std::vector<double> lat(size[0]);
+  std::vector<double> height(size[0]);
+
   IndexType currentindex;
   PointType phyPoint;
-  double    height;
   PointType geoPoint;
 
-  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+  for (unsigned int line = 0; line < size[1]; ++line)
   {
-    currentindex = outIt.GetIndex();
-    DEMImage->TransformIndexToPhysicalPoint(currentindex, phyPoint);
-
-
-    if (m_Transform.IsNotNull())
+    currentindex[1] = startIndex[1] + line;
+    for (unsigned int column = 0; column < size[0]; ++column)
     {
-      geoPoint = m_Transform->TransformPoint(phyPoint);
-      if (m_AboveEllipsoid)
+      currentindex[0] = startIndex[0] + column;
+      DEMImage->TransformIndexToPhysicalPoint(currentindex, phyPoint);
+      if (m_Transform.IsNotNull())
       {
-        height = DEMHandler::GetInstance().GetHeightAboveEllipsoid(geoPoint); // Altitude
-                                                                  // calculation
+        geoPoint = m_Transform->TransformPoint(phyPoint);
       }
       else
       {
-        height = DEMHandler::GetInstance().GetHeightAboveMSL(geoPoint); // Altitude
-                                                            // calculation
+        geoPoint = phyPoint;
       }
+      lon[column] = geoPoint[0];
+      lat[column] = geoPoint[1];
+    }
+
+    // Altitude calculation
+    if (m_AboveEllipsoid)
+    {
+      DEMHandler::GetInstance().GetHeightAboveEllipsoid(size[0], lon.data(), lat.data(), height.data());
     }
     else
     {
-      if (m_AboveEllipsoid)
+      DEMHandler::GetInstance().GetHeightAboveMSL(size[0], lon.data(), lat.data(), height.data());
+    }
+
+    for (unsigned int column = 0; column < size[0]; ++column)
+    {
+      currentindex[0] = startIndex[0] + column;
+      // DEM sets a default value (-32768) at point where it doesn't have altitude information.
+      if (!vnl_math_isnan(height[column]))
       {
-        height = DEMHandler::GetInstance().GetHeightAboveEllipsoid(phyPoint); // Altitude
-                                                                  // calculation
+        // Fill the image
+        DEMImage->SetPixel(currentindex, static_cast<PixelType>(height[column]));
       }
       else
       {
-        height = DEMHandler::GetInstance().GetHeightAboveMSL(phyPoint); // Altitude
-                                                            // calculation
+        // Back to the MNT default value
+        DEMImage->SetPixel(currentindex, m_DefaultUnknownValue);
       }
+      progress.CompletedPixel();
     }
-    /*    otbMsgDevMacro(<< "Index : (" << currentindex[0]<< "," << currentindex[1] << ") -> PhyPoint : ("
-                       << phyPoint[0] << "," << phyPoint[1] << ") -> GeoPoint: ("
-                       << geoPoint[0] << "," << geoPoint[1] << ") -> height" << height);
-    */
-    //       otbMsgDevMacro(<< "height" << height);
-    // DEM sets a default value (-32768) at point where it doesn't have altitude information.
-    if (!vnl_math_isnan(height))
-    {
-      // Fill the image
-      DEMImage->SetPixel(currentindex, static_cast<PixelType>(height));
-    }
-    else
-    {
-      // Back to the MNT default value
-      DEMImage->SetPixel(currentindex, m_DefaultUnknownValue);
-    }
-    progress.CompletedPixel();
   }
 }
 
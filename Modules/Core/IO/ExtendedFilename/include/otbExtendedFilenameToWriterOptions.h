@@ -36,6 +36,7 @@ namespace otb
  * - &writegeom=ON : to activate the creation of an external geom file
  * - &gdal:co:<KEY>=<VALUE> : the gdal creation option <KEY>
  * - streaming modes
+ * - &streaming:buffers=<N> : number of stream buffers for asynchronous writing
  * - box
  * - &bands=<BANDS_LIST> : to select a subset of bands from the output image
  * - &nodata=<VALUE>/<VALUE:VALUE...> : to set specific nodata values
@@ -75,11 +76,13 @@ public:
     std::pair<bool, std::string> simpleFileName;
     std::pair<bool, bool>        writeGEOMFile;
     std::pair<bool, bool>        writeRPCTags;
+    std::pair<bool, bool>        cloudOptimizedGeoTIFF;
     std::pair<bool, bool>        multiWrite;
     std::pair<bool, GDALCOType>  gdalCreationOptions;
     std::pair<bool, std::string> streamingType;
     std::pair<bool, std::string> streamingSizeMode;
     std::pair<bool, double>      streamingSizeValue;
+    std::pair<bool, unsigned int> streamingBuffers;
     std::pair<bool, std::string> box;
     std::pair<bool, std::string> bandRange;
     std::pair<bool, unsigned int> srsValue;
@@ -101,6 +104,7 @@ public:
   bool           NoDataValueIsSet() const;
   bool           WriteGEOMFileIsSet() const;
   bool           WriteRPCTagsIsSet() const;
+  bool           CloudOptimizedGeoTIFFIsSet() const;
   bool           GetMultiWrite() const;
   NoDataListType GetNoDataList() const
   {
@@ -109,6 +113,7 @@ public:
 
   bool        GetWriteGEOMFile() const;
   bool        GetWriteRPCTags() const;
+  bool        GetCloudOptimizedGeoTIFF() const;
   bool        gdalCreationOptionsIsSet() const;
   GDALCOType  GetgdalCreationOptions() const;
   bool        StreamingTypeIsSet() const;
@@ -117,6 +122,8 @@ public:
   std::string GetStreamingSizeMode() const;
   bool        StreamingSizeValueIsSet() const;
   double      GetStreamingSizeValue() const;
+  bool         StreamingBuffersIsSet() const;
+  unsigned int GetStreamingBuffers() const;
   std::string GetBandRange() const;
   bool        SrsValueIsSet() const;
   unsigned int GetSrsValue() const;
@@ -42,20 +42,25 @@ ExtendedFilenameToWriterOptions::ExtendedFilenameToWriterOptions() : ExtendedFil
   m_Options.writeRPCTags.first  = false;
   m_Options.writeRPCTags.second = false;
 
+  m_Options.cloudOptimizedGeoTIFF.first  = false;
+  m_Options.cloudOptimizedGeoTIFF.second = false;
+
   has_noDataValue = false;
 
   m_Options.gdalCreationOptions.first = false;
   m_Options.streamingType.first       = false;
   m_Options.streamingSizeMode.first   = false;
   m_Options.streamingSizeValue.first  = false;
+  m_Options.streamingBuffers.first    = false;
+  m_Options.streamingBuffers.second   = 1;
 
   m_Options.bandRange.first  = false;
   m_Options.bandRange.second = "";
 
   m_Options.srsValue.first = false;
 
-  m_Options.optionList = {"writegeom", "writerpctags", "multiwrite", "streaming:type",
-    "streaming:sizemode", "streaming:sizevalue", "nodata", "box", "bands", "epsg"};
+  m_Options.optionList = {"writegeom", "writerpctags", "cog", "multiwrite", "streaming:type",
+    "streaming:sizemode", "streaming:sizevalue", "streaming:buffers", "nodata", "box", "bands", "epsg"};
 }
 
 void ExtendedFilenameToWriterOptions::SetExtendedFileName(const char* extFname)
@@ -140,6 +145,16 @@ void ExtendedFilenameToWriterOptions::SetExtendedFileName(const std::string& ext
     }
   }
 
+  if (!map["cog"].empty())
+  {
+    m_Options.cloudOptimizedGeoTIFF.first = true;
+    if (map["cog"] == "On" || map["cog"] == "on" || map["cog"] == "ON" ||
+        map["cog"] == "true" || map["cog"] == "True" || map["cog"] == "1")
+    {
+      m_Options.cloudOptimizedGeoTIFF.second = true;
+    }
+  }
+
   if (!map["multiwrite"].empty())
   {
     m_Options.multiWrite.first = true;
@@ -153,14 +168,15 @@ void ExtendedFilenameToWriterOptions::SetExtendedFileName(const std::string& ext
   if (!map["streaming:type"].empty())
   {
     if (map["streaming:type"] == "auto" || map["streaming:type"] == "tiled" ||
-        map["streaming:type"] == "stripped" || map["streaming:type"] == "none")
+        map["streaming:type"] == "stripped" || map["streaming:type"] == "measured" ||
+        map["streaming:type"] == "blockaligned" || map["streaming:type"] == "none")
     {
       m_Options.streamingType.first  = true;
       m_Options.streamingType.second = map["streaming:type"];
     }
     else
     {
-      itkWarningMacro("Unknown value " << map["streaming:type"] << " for streaming:type option. Available values are auto,tiled,stripped.");
+      itkWarningMacro("Unknown value " << map["streaming:type"] << " for streaming:type option. Available values are auto,tiled,stripped,measured,blockaligned,none.");
     }
   }
 
@@ -183,6 +199,20 @@ void ExtendedFilenameToWriterOptions::SetExtendedFileName(const std::string& ext
     m_Options.streamingSizeValue.second = atof(map["streaming:sizevalue"].c_str());
   }
 
+  if (!map["streaming:buffers"].empty())
+  {
+    int buffers = Utils::LexicalCast<int>(map["streaming:buffers"], "streaming:buffers");
+    if (buffers > 0)
+    {
+      m_Options.streamingBuffers.first  = true;
+      m_Options.streamingBuffers.second = static_cast<unsigned int>(buffers);
+    }
+    else
+    {
+      itkWarningMacro("Invalid value " << map["streaming:buffers"] << " for streaming:buffers option. Must be a strictly positive integer.");
+    }
+  }
+
   // Manage region size to write in output image
   if (!map["box"].empty())
   {
@@ -292,6 +322,11 @@ bool ExtendedFilenameToWriterOptions::WriteRPCTagsIsSet() const
   return m_Options.writeRPCTags.first;
 }
 
+bool ExtendedFilenameToWriterOptions::CloudOptimizedGeoTIFFIsSet() const
+{
+  return m_Options.cloudOptimizedGeoTIFF.first;
+}
+
 bool ExtendedFilenameToWriterOptions::GetWriteGEOMFile() const
 {
   return m_Options.writeGEOMFile.second;
@@ -307,6 +342,11 @@ bool ExtendedFilenameToWriterOptions::GetWriteRPCTags() const
   return m_Options.writeRPCTags.second;
 }
 
+bool ExtendedFilenameToWriterOptions::GetCloudOptimizedGeoTIFF() const
+{
+  return m_Options.cloudOptimizedGeoTIFF.second;
+}
+
 bool ExtendedFilenameToWriterOptions::gdalCreationOptionsIsSet() const
 {
   return m_Options.gdalCreationOptions.first;
@@ -346,6 +386,16 @@ double ExtendedFilenameToWriterOptions::GetStreamingSizeValue() const
   return m_Options.streamingSizeValue.second;
 }
 
+bool ExtendedFilenameToWriterOptions::StreamingBuffersIsSet() const
+{
+  return m_Options.streamingBuffers.first;
+}
+
+unsigned int ExtendedFilenameToWriterOptions::GetStreamingBuffers() const
+{
+  return m_Options.streamingBuffers.second;
+}
+
 bool ExtendedFilenameToWriterOptions::BoxIsSet() const
 {
   return m_Options.box.first;
@@ -68,6 +68,7 @@ protected:
 // Forward declaration of the class at this point. No need to expose the
 // full class definition.
 class DEMHandlerTLS;
+class DEMPreloadedArea;
 
 /** \class DEMHandler
  *
@@ -108,6 +109,11 @@ class DEMHandlerTLS;
  * - SRTM available, but no geoid: srtm_value
  * - No SRTM and no geoid available: 0
  *
+ * An area can be preloaded with `PreloadArea()`: the heights above
+ * ellipsoid of the area are then resampled once in a grid shared by all
+ * threads, from which `GetHeightAboveEllipsoid()` interpolates the points
+ * of the area.
+ *
  * \ingroup OTBIOGDAL
  */
 class DEMHandler : public DEMSubjectInterface
@@ -172,6 +178,49 @@ public:
   double GetGeoidHeight(double lon, double lat) const;
   double GetGeoidHeight(const PointType& geoPoint) const;
 
+  /**\name Batch queries
+   * Return the heights of `count` points, following the same rules as
+   * the single point functions.
+   *
+   * The points are grouped by DEM block, and interpolated from blocks of
+   * samples kept in memory by the current thread, which avoids a GDAL
+   * read per point.
+   * \param[in] count number of points
+   * \param[in] lon input longitudes, `count` values
+   * \param[in] lat input latitudes, `count` values
+   * \param[out] height output heights, `count` values
+   */
+  /// @{
+  void GetHeightAboveEllipsoid(std::size_t count, double const* lon, double const* lat, double* height) const;
+  void GetHeightAboveMSL(std::size_t count, double const* lon, double const* lat, double* height) const;
+  void GetGeoidHeight(std::size_t count, double const* lon, double const* lat, double* height) const;
+  /// @}
+
+  /** Resample the heights above ellipsoid over a geographic area.
+   *
+   * The DEM and geoid heights (or the default height) are sampled at
+   * the DEM resolution over the area, into a single grid kept in memory
+   * and shared read-only by all threads. Until the configuration of the
+   * handler changes, `GetHeightAboveEllipsoid()` bilinearly interpolates
+   * the points of the area from this grid, without accessing the DEM
+   * files. The other points are handled as usual.
+   *
+   * \param[in] lonMin, latMin, lonMax, latMax area envelope, in WGS84
+   * \return false if the grid would not fit in the RAM hint (see
+   * `ConfigurationManager::GetMaxRAMHint()`); no area is preloaded then.
+   *
+   * \warning Should only be called from the main thread, as the other
+   * configuration functions.
+   */
+  bool PreloadArea(double lonMin, double latMin, double lonMax, double latMax);
+
+  /** Release the preloaded area, if any. */
+  void ClearPreloadedArea();
+
+  /** Tells whether an area has been preloaded. */
+  bool HasPreloadedArea() const noexcept
+  { return bool(m_PreloadedArea); }
+
   /** Return the number of DEM opened */
   std::size_t GetDEMCount() const noexcept;
 
@@ -286,6 +335,9 @@ private:
 
   /** Pool of actual thread local DEM handlers. */
   mutable std::vector<std::shared_ptr<DEMHandlerTLS>> m_tlses;
+
+  /** Heights above ellipsoid of the preloaded area, shared by all `DEMHandlerTLS`. */
+  std::shared_ptr<DEMPreloadedArea const> m_PreloadedArea;
 };
 
 
@@ -308,6 +360,9 @@ double GetGeoidHeight         (DEMHandlerTLS const&, double lon, double lat);
 double GetHeightAboveEllipsoid(DEMHandlerTLS const&, itk::Point<double, 2> geoPoint);
 double GetHeightAboveMSL      (DEMHandlerTLS const&, itk::Point<double, 2> geoPoint);
 double GetGeoidHeight         (DEMHandlerTLS const&, itk::Point<double, 2> geoPoint);
+void   GetHeightAboveEllipsoid(DEMHandlerTLS const&, std::size_t count, double const* lon, double const* lat, double* height);
+void   GetHeightAboveMSL      (DEMHandlerTLS const&, std::size_t count, double const* lon, double const* lat, double* height);
+void   GetGeoidHeight         (DEMHandlerTLS const&, std::size_t count, double const* lon, double const* lat, double* height);
 /// @}
 
 }
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbGDALBlockCache_h
+#define otbGDALBlockCache_h
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gdal.h"
+#include "OTBIOGDALExport.h"
+
+namespace otb
+{
+
+/** \class GDALBlockCache
+ *
+ * \brief Process-wide cache of decoded image blocks
+ *
+ * Each GDALImageIO opens its own GDALDataset, so that the internal
+ * GDAL block cache is not shared between readers of the same file.
+ * This cache stores the blocks decoded by GDALImageIO::Read(), so
+ * that readers opening the same file (for instance several readers on
+ * different bands of the same JPEG2000 product) decode each block only
+ * once.
+ *
+ * Blocks are identified by their file, subdataset, overview, band and
+ * block index, as well as the modification time of the file and the
+ * pixel type they are converted to. The least recently used blocks are
+ * evicted when the size of the cache exceeds its maximum size. The
+ * cache is disabled when the maximum size is 0, which is the default
+ * value from ConfigurationManager::GetGDALBlockCacheSize().
+ *
+ * This class is thread safe.
+ *
+ * \ingroup OTBIOGDAL
+ */
+class OTBIOGDAL_EXPORT GDALBlockCache
+{
+public:
+  /** Identifier of a block */
+  struct KeyType
+  {
+    std::string  FileName;
+    long long    ModificationTime;
+    unsigned int SubDataset;
+    unsigned int Overview;
+    int          Band;
+    int          BlockX;
+    int          BlockY;
+    GDALDataType PixelType;
+
+    bool operator<(const KeyType& other) const;
+  };
+
+  /** Decoded block, the pixels of the band are stored line by line */
+  typedef std::vector<unsigned char>      BlockType;
+  typedef std::shared_ptr<const BlockType> BlockPointerType;
+
+  // GetInstance returns a reference to the unique GDALBlockCache
+  static GDALBlockCache& GetInstance()
+  {
+    static GDALBlockCache theUniqueInstance;
+    return theUniqueInstance;
+  }
+
+  /** Set the maximum size of the cache in bytes. 0 disables the cache. */
+  void SetMaximumSize(unsigned long long maximumSize);
+
+  /** Get the maximum size of the cache in bytes */
+  unsigned long long GetMaximumSize() const;
+
+  /** Get the size of the cached blocks in bytes */
+  unsigned long long GetSize() const;
+
+  /** True if the maximum size is not 0 */
+  bool IsEnabled() const;
+
+  /** Get a block, or a null pointer if it is not cached. Updates the
+   *  hit and miss counters. */
+  BlockPointerType Get(const KeyType& key);
+
+  /** Insert a block, evicting the least recently used blocks if needed */
+  void Insert(const KeyType& key, BlockPointerType block);
+
+  /** Remove all the blocks of a file (for instance when it is written) */
+  void Invalidate(const std::string& fileName);
+
+  /** Remove all the blocks */
+  void Clear();
+
+  /** Get the number of Get() calls that found the block */
+  unsigned long long GetNumberOfHits() const;
+
+  /** Get the number of Get() calls that did not find the block */
+  unsigned long long GetNumberOfMisses() const;
+
+  /** Reset the hit and miss counters */
+  void ResetStatistics();
+
+private:
+  GDALBlockCache();
+  ~GDALBlockCache() = default;
+
+  GDALBlockCache(const GDALBlockCache&) = delete;
+  void operator=(const GDALBlockCache&) = delete;
+
+  /** Evict the least recently used blocks until the size fits. The
+   *  mutex must be locked. */
+  void Shrink();
+
+  typedef std::list<KeyType> RecencyListType;
+
+  struct EntryType
+  {
+    BlockPointerType          Block;
+    RecencyListType::iterator Recency;
+  };
+
+  mutable std::mutex           m_Mutex;
+  std::map<KeyType, EntryType> m_Blocks;
+  /** Keys from the most to the least recently used */
+  RecencyListType    m_Recency;
+  unsigned long long m_MaximumSize;
+  unsigned long long m_Size;
+  unsigned long long m_NumberOfHits;
+  unsigned long long m_NumberOfMisses;
+};
+
+} // end namespace otb
+
+#endif
@@ -25,6 +25,7 @@
 
 /* C++ Libraries */
 #include <string>
+#include <typeinfo>
 
 /* ITK Libraries */
 #include "otbImageIOBase.h"
@@ -114,6 +115,13 @@ public:
   itkSetMacro(WriteRPCTags, bool);
   itkGetMacro(WriteRPCTags, bool);
 
+  /** Set/Get whether a GeoTIFF output is written as a Cloud Optimized GeoTIFF.
+   *  The regions are streamed into a tiled intermediate GeoTIFF whose blocks
+   *  match the COG BLOCKSIZE, overviews are updated from each written region,
+   *  and the COG driver produces the final file with multi-threaded tile
+   *  compression. Requires GDAL >= 3.1. */
+  itkSetMacro(WriteCloudOptimizedGeoTIFF, bool);
+  itkGetMacro(WriteCloudOptimizedGeoTIFF, bool);
 
   /** Set/Get the options */
   void SetOptions(const GDALCreationOptionsType& opts)
@@ -158,6 +166,19 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   void Read(void* buffer) override;
 
+  /** Reads the IORegion with a single RasterIO directly into a buffer of
+   *  pixels made of nbComponents components of type componentType, GDAL
+   *  converting the pixel type on the fly.
+   *  \param bandList 0-based indices of the bands to read, all the bands
+   *  if empty.
+   *  When the file is complex and componentType is not, each band fills
+   *  two consecutive components (real and imaginary parts).
+   *  Only conversions keeping every value exactly are done by GDAL, which
+   *  rounds and clamps where the reader truncates.
+   *  Returns false, without reading anything, if this layout can not be
+   *  read directly: the caller then reads with Read() and converts. */
+  bool ReadWithLayout(void* buffer, const std::type_info& componentType, unsigned int nbComponents, const std::vector<unsigned int>& bandList);
+
   /** Reads 3D data from multiple files assuming one slice per file. */
   virtual void ReadVolume(void* buffer);
 
@@ -197,6 +218,14 @@ public:
    *  count based on size division by 2*/
   unsigned int GetOverviewsCount() override;
 
+  /** Get the number of overviews stored in the file, without the full
+   *  resolution. Unlike GetOverviewsCount(), no overview is computed from
+   *  the file dimensions. Only valid after ReadImageInformation(). */
+  unsigned int GetStoredOverviewsCount() const
+  {
+    return m_NumberOfOverviews;
+  }
+
   /** Get description about overviews available into the file specified */
   std::vector<std::string> GetOverviewsInfo() override;
 
@@ -259,6 +288,8 @@ protected:
   void InternalReadImageInformation();
   /** Write all information on the image*/
   void InternalWriteImageInformation(const void* buffer);
+  /** Get the GDAL dataset opened by CanReadFile(), nullptr if none */
+  GDALDataset* GetGDALDataset() const;
   /** Number of bands of the image*/
   int m_NbBands;
   /** Buffer*/
@@ -290,6 +321,29 @@ private:
    */
   bool CreationOptionContains(std::string partialOption) const;
 
+  /** Get the value of a creation option, or defaultValue if it is not set
+   *  \param key The creation option key (for example "BLOCKSIZE")
+   */
+  std::string GetCreationOptionValue(const std::string& key, const std::string& defaultValue) const;
+
+  /** Name of the tiled GeoTIFF the regions are streamed into when writing a COG */
+  std::string GetCloudOptimizedIntermediateFileName() const;
+
+  /** Create the empty overview levels of the intermediate COG dataset */
+  void CreateCloudOptimizedOverviews();
+
+  /** Propagate the rows completed by the last written region to the overviews */
+  void UpdateCloudOptimizedOverviews(int firstLine, unsigned int nbLines, int firstColumn, unsigned int nbColumns);
+
+  /** Copy the intermediate dataset to the final COG and remove it */
+  void FinalizeCloudOptimizedGeoTIFF();
+
+  /** Read a region, expressed at the current resolution, through the
+   *  process-wide cache of decoded blocks (see GDALBlockCache).
+   *  Returns false if the cache can not be used for this region. */
+  bool ReadThroughBlockCache(unsigned char* buffer, int firstColumn, int firstLine, int nbColumns, int nbLines, int pixelOffset, int lineOffset,
+                             int bandOffset);
+
   /** Dump the ImageMetadata content into GDAL metadata */
   void ExportMetadata();
 
@@ -344,6 +398,18 @@ private:
    */
   bool m_WriteRPCTags;
 
+  /**
+   * True if GeoTIFF outputs should be written as Cloud Optimized GeoTIFF
+   */
+  bool m_WriteCloudOptimizedGeoTIFF;
+
+  /** True while a COG is being streamed into its intermediate dataset */
+  bool m_CloudOptimizedWrite;
+
+  /** Number of completed lines in the full resolution and in each overview
+   *  level of the intermediate COG dataset */
+  std::vector<unsigned int> m_CloudOptimizedCompletedLines;
+
 
   NoDataListType m_NoDataList;
 };
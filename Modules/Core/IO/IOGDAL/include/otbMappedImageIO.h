@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMappedImageIO_h
+#define otbMappedImageIO_h
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "otbGDALImageIO.h"
+
+namespace otb
+{
+class MappedFile;
+
+/** \class MappedImageIO
+ *
+ * \brief ImageIO object reading uncompressed raster files through a
+ * memory mapping of the file
+ *
+ * This ImageIO maps the files whose pixels are stored uncompressed,
+ * in the native byte order, at a fixed stride from each other:
+ * - ENVI files (any interleave),
+ * - ESRI .hdr labelled raw files (EHdr, BIL, BIP or BSQ layout),
+ * - untiled uncompressed GeoTIFF whose strips are contiguous.
+ *
+ * Image information and metadata are read by GDALImageIO. The pixels are
+ * then copied straight from a read-only mapping of the file, without going
+ * through the GDAL block decoding. When the IORegion is laid out in the file
+ * exactly as in an image buffer (pixel interleaved bands, whole lines),
+ * GetIORegionPointer() maps it on its own so that the image can reference
+ * the mapped pages instead of copying them (see MappedImportImageContainer).
+ *
+ * Each region is mapped privately: writing into its pages, e.g. from an
+ * in place filter, modifies neither the file nor the pixels of any other
+ * read.
+ *
+ * The other TIFF and labelled raw files, files with overviews read at a
+ * reduced resolution, subdatasets, indexed images and complex outputs
+ * built from pairs of real bands are read by GDALImageIO, through the
+ * dataset opened by CanReadFile().
+ *
+ * \ingroup IOFilters
+ *
+ * \ingroup OTBIOGDAL
+ */
+class OTBIOGDAL_EXPORT MappedImageIO : public GDALImageIO
+{
+public:
+  /** Standard class typedefs. */
+  typedef MappedImageIO           Self;
+  typedef GDALImageIO             Superclass;
+  typedef itk::SmartPointer<Self> Pointer;
+
+  /** Shared handle on the mapping, which keeps the pages mapped */
+  typedef std::shared_ptr<MappedFile> MappedFilePointerType;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MappedImageIO, GDALImageIO);
+
+  /** Returns true if the file can be read by GDAL and is a raw labelled
+   *  file or a TIFF. The GDAL dataset is opened once: if the pixels can not
+   *  be addressed in a memory mapping of the file, they are read by
+   *  GDALImageIO. */
+  bool CanReadFile(const char*) override;
+
+  /** Writing is left to GDALImageIO */
+  bool CanWriteFile(const char*) override
+  {
+    return false;
+  }
+
+  /** Set the spacing and dimension information for the set filename. */
+  void ReadImageInformation() override;
+
+  /** Copies the IORegion from the mapped file into the buffer */
+  void Read(void* buffer) override;
+
+  /** Maps the IORegion privately and returns its address, if the file
+   *  stores it exactly as Read() would fill a buffer, nullptr otherwise.
+   *  The address stays valid as long as regionMapping is referenced. */
+  void* GetIORegionPointer(MappedFilePointerType& regionMapping);
+
+protected:
+  MappedImageIO();
+  ~MappedImageIO() override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  MappedImageIO(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Position of the pixels in the file */
+  struct Layout
+  {
+    /** File holding the pixels */
+    std::string FileName;
+    /** Offset of the first pixel of each band, in bytes */
+    std::vector<unsigned long long> BandOffsets;
+    /** Distance between two pixels of a line, in bytes */
+    unsigned long long PixelStride = 0;
+    /** Distance between two lines, in bytes */
+    unsigned long long LineStride = 0;
+    /** Size of a band sample, in bytes */
+    unsigned int SampleSize = 0;
+  };
+
+  /** Find the position of the pixels from the GDAL dataset and the
+   *  headers of the file. Returns false if they are not addressable. */
+  bool ComputeLayout(Layout& layout) const;
+
+  bool ComputeENVILayout(const std::string& header, Layout& layout) const;
+  bool ComputeEHdrLayout(const std::string& header, Layout& layout) const;
+  bool ComputeGTiffLayout(Layout& layout) const;
+
+  /** Map the data file read-only if not done yet. Returns false if it failed. */
+  bool MapFile();
+
+  /** True if the IORegion can be read from the mapping */
+  bool CanReadFromMapping();
+
+  Layout                m_Layout;
+  bool                  m_Mappable;
+  MappedFilePointerType m_MappedFile;
+};
+
+} // end namespace otb
+
+#endif // otbMappedImageIO_h
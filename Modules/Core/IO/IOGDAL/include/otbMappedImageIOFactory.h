@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbMappedImageIOFactory_h
+#define otbMappedImageIOFactory_h
+
+#include "itkObjectFactoryBase.h"
+
+#include "OTBIOGDALExport.h"
+
+namespace otb
+{
+/** \class MappedImageIOFactory
+ * \brief Create an instance of MappedImageIO through the object factory.
+ *
+ * \ingroup OTBIOGDAL
+ */
+class OTBIOGDAL_EXPORT MappedImageIOFactory : public itk::ObjectFactoryBase
+{
+public:
+  /** Standard class typedefs. */
+  typedef MappedImageIOFactory          Self;
+  typedef itk::ObjectFactoryBase        Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Class methods used to interface with the registered factories. */
+  const char* GetITKSourceVersion(void) const override;
+  const char* GetDescription(void) const override;
+
+  /** Method for class instantiation. */
+  itkFactorylessNewMacro(Self);
+  static MappedImageIOFactory* FactoryNew()
+  {
+    return new MappedImageIOFactory;
+  }
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MappedImageIOFactory, itk::ObjectFactoryBase);
+
+  /** Register one factory of this type  */
+  static void RegisterOneFactory(void)
+  {
+    MappedImageIOFactory::Pointer MappedFactory = MappedImageIOFactory::New();
+    itk::ObjectFactoryBase::RegisterFactory(MappedFactory);
+  }
+
+protected:
+  MappedImageIOFactory();
+  ~MappedImageIOFactory() override;
+
+private:
+  MappedImageIOFactory(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMappedImportImageContainer_h
+#define otbMappedImportImageContainer_h
+
+#include "itkImportImageContainer.h"
+#include "otbMappedImageIO.h"
+
+namespace otb
+{
+
+/** \class MappedImportImageContainer
+ *
+ * \brief Pixel container referencing the pages of a file mapped by
+ * MappedImageIO
+ *
+ * The container does not manage the memory of its pixels, but keeps the
+ * mapping alive as long as the image uses it, even if the ImageIO which
+ * mapped the file is destroyed.
+ *
+ * \ingroup OTBIOGDAL
+ */
+template <typename TElementIdentifier, typename TElement>
+class ITK_TEMPLATE_EXPORT MappedImportImageContainer : public itk::ImportImageContainer<TElementIdentifier, TElement>
+{
+public:
+  /** Standard class typedefs. */
+  typedef MappedImportImageContainer                              Self;
+  typedef itk::ImportImageContainer<TElementIdentifier, TElement> Superclass;
+  typedef itk::SmartPointer<Self>                                 Pointer;
+  typedef itk::SmartPointer<const Self>                           ConstPointer;
+
+  typedef MappedImageIO::MappedFilePointerType MappedFilePointerType;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MappedImportImageContainer, itk::ImportImageContainer);
+
+  /** Reference size elements at address pointer, in the mapping mappedFile */
+  void SetMappedPointer(TElement* pointer, TElementIdentifier size, const MappedFilePointerType& mappedFile)
+  {
+    this->SetImportPointer(pointer, size, false);
+    m_MappedFile = mappedFile;
+  }
+
+  MappedFilePointerType GetMappedFile() const
+  {
+    return m_MappedFile;
+  }
+
+protected:
+  MappedImportImageContainer() = default;
+  ~MappedImportImageContainer() override = default;
+
+private:
+  MappedImportImageContainer(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  MappedFilePointerType m_MappedFile;
+};
+
+} // end namespace otb
+
+#endif
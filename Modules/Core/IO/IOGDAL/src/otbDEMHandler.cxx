@@ -20,6 +20,7 @@
 
 #include "otbDEMHandler.h"
 #include "otbGDALDriverManagerWrapper.h"
+#include "otbConfigurationManager.h"
 #include <boost/filesystem.hpp>
 #include <boost/range/iterator_range.hpp>
 #include "gdal_utils.h"
@@ -33,10 +34,15 @@
 //TODO C++ 17 : use std::optional instead
 #include <boost/optional.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <list>
 #include <mutex>
 #include <thread>
 #include <memory>
 #include <sstream>
+#include <utility>
 
 namespace
 { // Anonymous namespace
@@ -87,6 +93,101 @@ std::vector<std::string> GetFilesInDirectory(const std::string & directoryPath)
   return fileList;
 }
 
+/**
+ * Block of DEM samples kept in memory, converted to float.
+ *
+ * Blocks overlap their right and bottom neighbours by one pixel, so that
+ * the 2x2 neighbourhood of any pixel lies in a single block.
+ * \internal
+ */
+struct DEMTile
+{
+  int                x0     = 0;
+  int                y0     = 0;
+  int                width  = 0;
+  int                height = 0;
+  std::vector<float> values;
+};
+
+/**
+ * Per thread LRU cache of `DEMTile`s read from a dataset.
+ * \internal
+ */
+class DEMTileCache
+{
+public:
+  /// Number of pixels of a block, along each axis, without the overlap.
+  static constexpr int TileSize = 256;
+  /// Number of blocks kept in memory (about 4MB).
+  static constexpr std::size_t MaximumNumberOfTiles = 16;
+
+  using TilePointer = std::shared_ptr<DEMTile const>;
+
+  /** Return block {tx, ty}, read from the first band of `ds` if not in
+   * the cache.
+   * \return nullptr if the block cannot be read
+   */
+  TilePointer get(GDALDataset & ds, int tx, int ty)
+  {
+    auto const key = std::make_pair(tx, ty);
+    auto const it  = std::find_if(m_Tiles.begin(), m_Tiles.end(), [&](auto const& entry) { return entry.first == key; });
+    if (it != m_Tiles.end())
+    {
+      // Most recently used first
+      m_Tiles.splice(m_Tiles.begin(), m_Tiles, it);
+      return it->second;
+    }
+
+    auto tile    = std::make_shared<DEMTile>();
+    tile->x0     = tx * TileSize;
+    tile->y0     = ty * TileSize;
+    tile->width  = std::min(TileSize + 1, ds.GetRasterXSize() - tile->x0);
+    tile->height = std::min(TileSize + 1, ds.GetRasterYSize() - tile->y0);
+    if (tile->width <= 0 || tile->height <= 0)
+    {
+      return nullptr;
+    }
+    tile->values.resize(static_cast<std::size_t>(tile->width) * tile->height);
+    auto const err = ds.GetRasterBand(1)->RasterIO(GF_Read, tile->x0, tile->y0, tile->width, tile->height,
+        tile->values.data(), tile->width, tile->height, GDT_Float32, 0, 0, nullptr);
+    if (err)
+    {
+      return nullptr;
+    }
+
+    m_Tiles.emplace_front(key, std::move(tile));
+    if (m_Tiles.size() > MaximumNumberOfTiles)
+    {
+      m_Tiles.pop_back();
+    }
+    return m_Tiles.front().second;
+  }
+
+  void clear() { m_Tiles.clear(); }
+
+private:
+  std::list<std::pair<std::pair<int, int>, TilePointer>> m_Tiles;
+};
+
+/**
+ * Tells whether the samples of a DEM band are exactly represented as
+ * floats, and can thus be cached in `DEMTile`s.
+ * \internal
+ */
+bool HasFloatSamples(GDALDataset & ds)
+{
+  switch (ds.GetRasterBand(1)->GetRasterDataType())
+  {
+  case GDT_Byte:
+  case GDT_UInt16:
+  case GDT_Int16:
+  case GDT_Float32:
+    return true;
+  default:
+    return false;
+  }
+}
+
 /**
  * Internal RAII wrapper for providing access to `GDALDataset` and
  * caching related information (projection for WGS84 case and geo
@@ -133,6 +234,8 @@ struct DatasetCache
     m_Dataset.release();
     m_poCT.release();
     m_isWGS84 = false;
+    m_Tiles.clear();
+    m_hasTiles = false;
   }
 
   /** Takes over a `GDALDataset` ownership.
@@ -142,6 +245,8 @@ struct DatasetCache
   void reset(GDALDataset* ds)
   {
     m_Dataset.reset(ds);
+    m_Tiles.clear();
+    m_hasTiles = false;
     if (m_Dataset)
     {
 #if GDAL_VERSION_NUM >= 3000000
@@ -173,6 +278,8 @@ struct DatasetCache
       m_Dataset->GetGeoTransform(m_geoTransform);
 
       m_NoDataValue = m_Dataset->GetRasterBand(1)->GetNoDataValue();
+
+      m_hasTiles = HasFloatSamples(*m_Dataset);
     }
     else
     {
@@ -212,6 +319,16 @@ struct DatasetCache
   /// Accessor to No Data value
   double GetNoDataValue() const noexcept { return m_NoDataValue;}
 
+  /// Tells whether the samples can be read by blocks with `getTile()`.
+  bool hasTiles() const noexcept { return m_hasTiles; }
+
+  /// Block {tx, ty} of `DEMTileCache::TileSize` pixels, cached by this instance.
+  DEMTileCache::TilePointer getTile(int tx, int ty) const
+  {
+    assert(m_Dataset && m_hasTiles);
+    return m_Tiles.get(*m_Dataset, tx, ty);
+  }
+
 
   DatasetCache & operator=(DatasetCache const&) = delete;
   DatasetCache & operator=(DatasetCache &&    ) = default;
@@ -224,6 +341,10 @@ private:
   bool        m_isWGS84 = false;
   double      m_geoTransform[6] = {};
   double      m_NoDataValue     = {};
+  bool        m_hasTiles        = false;
+
+  /// Blocks of samples read by the batch queries (per thread, as the dataset).
+  mutable DEMTileCache m_Tiles;
 };
 
 /**
@@ -301,6 +422,113 @@ boost::optional<double> GetDEMValue(double lon, double lat, DatasetCache const&
   return yBil;
 }
 
+/**
+ * Obtain DEM values from dataset at `count` positions.
+ *
+ * Same result as `GetDEMValue()` for each point, but the points are
+ * grouped by block of samples, each block being read once from the
+ * dataset and interpolated from memory.
+ *
+ * \param[out] values elevations, 0 where there is no value
+ * \param[out] valid  whether each elevation has been found
+ * \internal
+ */
+void GetDEMValues(std::size_t count, double const* lon, double const* lat, DatasetCache const& dsc, double* values, char* valid)
+{
+  std::fill(values, values + count, 0.);
+  std::fill(valid, valid + count, 0);
+
+  if (!dsc.hasTiles())
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      auto const value = GetDEMValue(lon[i], lat[i], dsc);
+      if (value)
+      {
+        values[i] = *value;
+        valid[i]  = 1;
+      }
+    }
+    return;
+  }
+
+  // Pixel coordinates, and points sorted by block
+  std::vector<double> xs(count), ys(count);
+  std::vector<std::pair<std::uint64_t, std::size_t>> order;
+  order.reserve(count);
+
+  int const sizeX = dsc->GetRasterXSize();
+  int const sizeY = dsc->GetRasterYSize();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    double lo = lon[i];
+    double la = lat[i];
+    if (!dsc.convert_lon_lat(lo, la))
+    {
+      continue;
+    }
+    auto const xy = dsc.transform(lo, la);
+    if (xy.first < 0 || xy.second < 0 || 1 + xy.first > sizeX || 1 + xy.second > sizeY)
+    {
+      continue;
+    }
+    xs[i] = xy.first;
+    ys[i] = xy.second;
+
+    auto const tx = static_cast<std::uint64_t>(static_cast<int>(xs[i]) / DEMTileCache::TileSize);
+    auto const ty = static_cast<std::uint64_t>(static_cast<int>(ys[i]) / DEMTileCache::TileSize);
+    order.emplace_back((ty << 32) | tx, i);
+  }
+  std::sort(order.begin(), order.end());
+
+  auto const no_data = dsc.GetNoDataValue();
+  for (auto group = order.begin(); group != order.end();)
+  {
+    auto const key = group->first;
+    auto const groupEnd = std::find_if(group, order.end(), [key](auto const& p) { return p.first != key; });
+
+    // The block stays pinned until the whole group is interpolated
+    auto const tile = dsc.getTile(static_cast<int>(key & 0xFFFFFFFF), static_cast<int>(key >> 32));
+    if (tile)
+    {
+      int const    width = tile->width;
+      float const* data  = tile->values.data();
+      for (; group != groupEnd; ++group)
+      {
+        std::size_t const i     = group->second;
+        auto const        x_int = static_cast<int>(xs[i]);
+        auto const        y_int = static_cast<int>(ys[i]);
+        int const         lx    = x_int - tile->x0;
+        int const         ly    = y_int - tile->y0;
+
+        // Last column or line of the raster: no 2x2 neighbourhood
+        if (lx + 1 >= width || ly + 1 >= tile->height)
+        {
+          continue;
+        }
+
+        float const* p = data + static_cast<std::size_t>(ly) * width + lx;
+        double const e0 = p[0];
+        double const e1 = p[1];
+        double const e2 = p[width];
+        double const e3 = p[width + 1];
+        if (e0 == no_data || e1 == no_data || e2 == no_data || e3 == no_data)
+        {
+          continue;
+        }
+
+        auto const deltaX = xs[i] - x_int;
+        auto const deltaY = ys[i] - y_int;
+        auto const xBil1  = e0 * (1.0 - deltaX) + e1 * deltaX;
+        auto const xBil2  = e2 * (1.0 - deltaX) + e3 * deltaX;
+        values[i]         = xBil1 * (1.0 - deltaY) + xBil2 * deltaY;
+        valid[i]          = 1;
+      }
+    }
+    group = groupEnd;
+  }
+}
+
 /**
  * Tells whether the dataset has a Geo Transformation.
  * \internal
@@ -313,6 +541,64 @@ bool HasGeoTransform(GDALDataset & gdalds)
 
 }  // namespace DEMDetails
 
+/** Heights above ellipsoid of a geographic area, sampled on a regular
+ * grid by `DEMHandler::PreloadArea()`.
+ * \ingroup OTBIOGDAL
+ *
+ * \internal Instances are immutable once filled, and shared by all
+ * `DEMHandlerTLS`.
+ */
+class DEMPreloadedArea
+{
+public:
+  DEMPreloadedArea(double originLon, double originLat, double spacingLon, double spacingLat, int sizeX, int sizeY)
+    : m_OriginLon(originLon), m_OriginLat(originLat), m_SpacingLon(spacingLon), m_SpacingLat(spacingLat),
+      m_SizeX(sizeX), m_SizeY(sizeY), m_Heights(static_cast<std::size_t>(sizeX) * sizeY)
+  {}
+
+  /** Bilinear interpolation of the grid.
+   * \return false if {lon, lat} is outside the grid
+   */
+  bool Interpolate(double lon, double lat, double & height) const
+  {
+    double const x = (lon - m_OriginLon) / m_SpacingLon;
+    double const y = (lat - m_OriginLat) / m_SpacingLat;
+    // Also rejects NaN coordinates
+    if (!(x >= 0 && y >= 0 && x < m_SizeX - 1 && y < m_SizeY - 1))
+    {
+      return false;
+    }
+
+    auto const x_int  = static_cast<int>(x);
+    auto const y_int  = static_cast<int>(y);
+    auto const deltaX = x - x_int;
+    auto const deltaY = y - y_int;
+
+    float const* p = m_Heights.data() + static_cast<std::size_t>(y_int) * m_SizeX + x_int;
+    auto const xBil1 = p[0] * (1.0 - deltaX) + p[1] * deltaX;
+    auto const xBil2 = p[m_SizeX] * (1.0 - deltaX) + p[m_SizeX + 1] * deltaX;
+    height = xBil1 * (1.0 - deltaY) + xBil2 * deltaY;
+    return true;
+  }
+
+  double GetLon(int x) const noexcept { return m_OriginLon + x * m_SpacingLon; }
+  double GetLat(int y) const noexcept { return m_OriginLat + y * m_SpacingLat; }
+  int    GetSizeX()    const noexcept { return m_SizeX; }
+  int    GetSizeY()    const noexcept { return m_SizeY; }
+
+  /// Heights of line `y`, to fill the grid.
+  float* GetLine(int y) { return m_Heights.data() + static_cast<std::size_t>(y) * m_SizeX; }
+
+private:
+  double             m_OriginLon;
+  double             m_OriginLat;
+  double             m_SpacingLon;
+  double             m_SpacingLat;
+  int                m_SizeX;
+  int                m_SizeY;
+  std::vector<float> m_Heights;
+};
+
 
 /** Internal actual instance of DEM handling wrapper for current thread.
  * \ingroup OTBIOGDAL
@@ -338,6 +624,20 @@ public:
   boost::optional<double> GetHeightAboveMSL(double lon, double lat) const;
   boost::optional<double> GetGeoidHeight(double lon, double lat) const;
 
+  void GetHeightAboveEllipsoid(std::size_t count, double const* lon, double const* lat, double* height, double defaultHeight) const;
+  void GetHeightAboveMSL(std::size_t count, double const* lon, double const* lat, double* height) const;
+  void GetGeoidHeight(std::size_t count, double const* lon, double const* lat, double* height) const;
+
+  /** Get the geo transformation of the DEM, or else of the geoid, if it
+   * is expressed in WGS84 coordinates.
+   * \return false if there is no such dataset
+   */
+  bool GetGeographicGeoTransform(double * geoTransform) const;
+
+  /** Set the grid used by `GetHeightAboveEllipsoid()` in its area. */
+  void SetPreloadedArea(std::shared_ptr<DEMPreloadedArea const> area)
+  { m_PreloadedArea = std::move(area); }
+
   DEMHandlerTLS() {
     otbMsgDevMacro(<<std::this_thread::get_id() << " § DEMHandlerTLS::DEMHandlerTLS() --> " << this);
   }
@@ -363,6 +663,9 @@ private:
   DEMHandlerTLS(DEMHandlerTLS const&) = delete;
   void operator=(DEMHandlerTLS const&) = delete;
 
+  /** Batch height above ellipsoid, from the DEM and geoid datasets. */
+  void ComputeHeightAboveEllipsoid(std::size_t count, double const* lon, double const* lat, double* height, double defaultHeight) const;
+
   using DatasetUPtr = std::unique_ptr<GDALDataset, void(*)(GDALDataset*)>;
 
   /** Pointer to the DEM dataset */
@@ -370,6 +673,9 @@ private:
 
   /** Pointer to the geoid dataset */
   DEMDetails::DatasetCache m_GeoidDS;
+
+  /** Preloaded heights above ellipsoid, shared by all threads */
+  std::shared_ptr<DEMPreloadedArea const> m_PreloadedArea;
 };
 
 DEMHandlerTLS const& DEMHandler::GetHandlerForCurrentThread() const
@@ -432,6 +738,7 @@ void DEMHandler::RegisterConfigurationInHandler(DEMHandlerTLS & tls) const
   if (!m_GeoidFilename.empty()) {
     tls.OpenGeoidFile(m_GeoidFilename);
   }
+  tls.SetPreloadedArea(m_PreloadedArea);
   otbMsgDevMacro(<<std::this_thread::get_id() << " § DEMHandler::RegisterConfigurationInHandler(" << &tls <<") END");
 }
 
@@ -492,6 +799,7 @@ bool DEMHandlerTLS::OpenDEMVRTFile()
 void DEMHandler::OpenDEMFile(std::string path)
 {
   otbMsgDevMacro(<<std::this_thread::get_id() << " § DEMHandler::OpenDEMFile("<<path<<")");
+  ClearPreloadedArea();
 
   std::unique_lock<std::mutex> lock(demMutex); // protecting m_tlses
   m_DatasetList.push_back(otb::GDALDriverManagerWrapper::GetInstance().Open(path));
@@ -532,6 +840,8 @@ void DEMHandler::OpenDEMDirectory(std::string DEMDirectory)
     return;
   }
 
+  ClearPreloadedArea();
+
   auto demFiles = DEMDetails::GetFilesInDirectory(DEMDirectory);
   std::size_t nb_new_DEM_opened = 0;
   // Check and open every dem files found in DEMDirectory
@@ -678,6 +988,7 @@ bool DEMHandlerTLS::OpenGeoidFile(const std::string& geoidFile)
 bool DEMHandler::OpenGeoidFile(std::string geoidFile)
 {
   otbMsgDevMacro(<<std::this_thread::get_id() << " § DEMHandler::OpenGeoidFile("<<geoidFile<<")");
+  ClearPreloadedArea();
 
   // In case the geoid is not valid, we still try to open it for real,
   // even if the DEMHandlerTLS will not serve to anything...
@@ -812,6 +1123,12 @@ boost::optional<double> DEMHandlerTLS::GetGeoidHeight(double lon, double lat) co
 
 double DEMHandlerTLS::GetHeightAboveEllipsoid(double lon, double lat, double defaultHeight) const
 {
+  double preloadedHeight;
+  if (m_PreloadedArea && m_PreloadedArea->Interpolate(lon, lat, preloadedHeight))
+  {
+    return preloadedHeight;
+  }
+
   boost::optional<double> DEMresult   = GetHeightAboveMSL(lon, lat);
   boost::optional<double> geoidResult = GetGeoidHeight(lon, lat);
 
@@ -833,6 +1150,112 @@ double DEMHandlerTLS::GetHeightAboveEllipsoid(double lon, double lat, double def
     return defaultHeight;
 }
 
+void DEMHandlerTLS::GetHeightAboveMSL(std::size_t count, double const* lon, double const* lat, double* height) const
+{
+  if (m_DEMDS)
+  {
+    std::vector<char> valid(count);
+    DEMDetails::GetDEMValues(count, lon, lat, m_DEMDS, height, valid.data());
+  }
+  else
+  {
+    std::fill(height, height + count, 0.);
+  }
+}
+
+void DEMHandlerTLS::GetGeoidHeight(std::size_t count, double const* lon, double const* lat, double* height) const
+{
+  if (m_GeoidDS)
+  {
+    std::vector<char> valid(count);
+    DEMDetails::GetDEMValues(count, lon, lat, m_GeoidDS, height, valid.data());
+  }
+  else
+  {
+    std::fill(height, height + count, 0.);
+  }
+}
+
+void DEMHandlerTLS::GetHeightAboveEllipsoid(std::size_t count, double const* lon, double const* lat, double* height, double defaultHeight) const
+{
+  if (!m_PreloadedArea)
+  {
+    ComputeHeightAboveEllipsoid(count, lon, lat, height, defaultHeight);
+    return;
+  }
+
+  // Points outside the preloaded area are computed from the datasets
+  std::vector<std::size_t> misses;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (!m_PreloadedArea->Interpolate(lon[i], lat[i], height[i]))
+    {
+      misses.push_back(i);
+    }
+  }
+  if (misses.empty())
+  {
+    return;
+  }
+
+  std::vector<double> missLon(misses.size()), missLat(misses.size()), missHeight(misses.size());
+  for (std::size_t i = 0; i < misses.size(); ++i)
+  {
+    missLon[i] = lon[misses[i]];
+    missLat[i] = lat[misses[i]];
+  }
+  ComputeHeightAboveEllipsoid(misses.size(), missLon.data(), missLat.data(), missHeight.data(), defaultHeight);
+  for (std::size_t i = 0; i < misses.size(); ++i)
+  {
+    height[misses[i]] = missHeight[i];
+  }
+}
+
+bool DEMHandlerTLS::GetGeographicGeoTransform(double * geoTransform) const
+{
+  for (auto const* dsc : {&m_DEMDS, &m_GeoidDS})
+  {
+    // isWGS84() actually tells that lon/lat need to be converted
+    double const* gt = dsc->getGeoTransform();
+    if (*dsc && !dsc->isWGS84() && gt[1] != 0 && gt[5] != 0 && gt[2] == 0 && gt[4] == 0)
+    {
+      std::copy(gt, gt + 6, geoTransform);
+      return true;
+    }
+  }
+  return false;
+}
+
+void DEMHandlerTLS::ComputeHeightAboveEllipsoid(std::size_t count, double const* lon, double const* lat, double* height, double defaultHeight) const
+{
+  std::vector<char> demValid(count, 0);
+  std::vector<char> geoidValid(count, 0);
+  std::fill(height, height + count, 0.);
+
+  if (m_DEMDS)
+  {
+    DEMDetails::GetDEMValues(count, lon, lat, m_DEMDS, height, demValid.data());
+  }
+  if (m_GeoidDS)
+  {
+    std::vector<double> geoid(count);
+    DEMDetails::GetDEMValues(count, lon, lat, m_GeoidDS, geoid.data(), geoidValid.data());
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      height[i] += geoid[i];
+    }
+  }
+
+  // Missing values are 0 in both arrays
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (!demValid[i] && !geoidValid[i])
+    {
+      height[i] = defaultHeight;
+    }
+  }
+}
+
 double DEMHandler::GetHeightAboveEllipsoid(double lon, double lat) const
 {
   auto & tls = GetHandlerForCurrentThread();
@@ -863,6 +1286,104 @@ double DEMHandler::GetHeightAboveMSL(const PointType& geoPoint) const
   return GetHeightAboveMSL(geoPoint[0], geoPoint[1]);
 }
 
+void DEMHandler::GetHeightAboveEllipsoid(std::size_t count, double const* lon, double const* lat, double* height) const
+{
+  auto & tls = GetHandlerForCurrentThread();
+  tls.GetHeightAboveEllipsoid(count, lon, lat, height, m_DefaultHeightAboveEllipsoid);
+}
+
+void DEMHandler::GetHeightAboveMSL(std::size_t count, double const* lon, double const* lat, double* height) const
+{
+  auto & tls = GetHandlerForCurrentThread();
+  tls.GetHeightAboveMSL(count, lon, lat, height);
+}
+
+void DEMHandler::GetGeoidHeight(std::size_t count, double const* lon, double const* lat, double* height) const
+{
+  auto & tls = GetHandlerForCurrentThread();
+  tls.GetGeoidHeight(count, lon, lat, height);
+}
+
+bool DEMHandler::PreloadArea(double lonMin, double latMin, double lonMax, double latMax)
+{
+  otbMsgDevMacro(<<std::this_thread::get_id() << " § DEMHandler::PreloadArea("<<lonMin<<", "<<latMin<<", "<<lonMax<<", "<<latMax<<")");
+  ClearPreloadedArea();
+
+  if (!(lonMin <= lonMax && latMin <= latMax))
+  {
+    otbLogMacro(Warning, << "Invalid area to preload: [" << lonMin << ", " << lonMax << "] x [" << latMin << ", " << latMax << "]");
+    return false;
+  }
+
+  auto & tls = GetHandlerForCurrentThread();
+
+  // Nodes on the pixel centers of the DEM (or of the geoid) when it is in
+  // WGS84, every 3 arc seconds otherwise
+  double gt[6] = {lonMin, 1. / 1200, 0., latMax, -1. / 1200, 0.};
+  tls.GetGeographicGeoTransform(gt);
+
+  // First pixel center before the area, with one node of margin, from
+  // the side of the area the spacing starts from
+  auto const firstNode = [](double start, double origin, double spacing)
+  {
+    return origin + (std::floor((start - origin) / spacing - 0.5) - 0.5) * spacing;
+  };
+  double const startLon = gt[1] > 0 ? lonMin : lonMax;
+  double const endLon   = gt[1] > 0 ? lonMax : lonMin;
+  double const startLat = gt[5] > 0 ? latMin : latMax;
+  double const endLat   = gt[5] > 0 ? latMax : latMin;
+  double const originLon = firstNode(startLon, gt[0], gt[1]);
+  double const originLat = firstNode(startLat, gt[3], gt[5]);
+  double const sizeX = std::ceil((endLon - originLon) / gt[1]) + 2;
+  double const sizeY = std::ceil((endLat - originLat) / gt[5]) + 2;
+
+  double const sizeInMB = sizeX * sizeY * sizeof(float) / (1024. * 1024.);
+  if (sizeInMB > ConfigurationManager::GetMaxRAMHint())
+  {
+    otbLogMacro(Warning, << "DEM area of " << sizeX << "x" << sizeY << " samples (" << sizeInMB << " MB) exceeds the RAM hint: it will not be preloaded");
+    return false;
+  }
+
+  auto area = std::make_shared<DEMPreloadedArea>(originLon, originLat, gt[1], gt[5], static_cast<int>(sizeX), static_cast<int>(sizeY));
+  std::vector<double> lons(area->GetSizeX()), lats(area->GetSizeX()), heights(area->GetSizeX());
+  for (int x = 0; x < area->GetSizeX(); ++x)
+  {
+    lons[x] = area->GetLon(x);
+  }
+  for (int y = 0; y < area->GetSizeY(); ++y)
+  {
+    std::fill(lats.begin(), lats.end(), area->GetLat(y));
+    tls.GetHeightAboveEllipsoid(lons.size(), lons.data(), lats.data(), heights.data(), m_DefaultHeightAboveEllipsoid);
+    std::copy(heights.begin(), heights.end(), area->GetLine(y));
+  }
+
+  m_PreloadedArea = std::move(area);
+  {
+    const std::lock_guard<std::mutex> lock(demMutex);
+    for (auto tls : m_tlses) {
+      tls->SetPreloadedArea(m_PreloadedArea);
+    }
+  }
+
+  otbLogMacro(Info, << "DEM preloaded over [" << lonMin << ", " << lonMax << "] x [" << latMin << ", " << latMax << "]: " << sizeX << "x" << sizeY
+                    << " samples (" << sizeInMB << " MB)");
+  return true;
+}
+
+void DEMHandler::ClearPreloadedArea()
+{
+  if (!m_PreloadedArea)
+  {
+    return;
+  }
+  m_PreloadedArea.reset();
+
+  const std::lock_guard<std::mutex> lock(demMutex);
+  for (auto tls : m_tlses) {
+    tls->SetPreloadedArea(nullptr);
+  }
+}
+
 std::size_t DEMHandler::GetDEMCount() const noexcept
 {
   return m_DatasetList.size();
@@ -911,6 +1432,7 @@ void DEMHandlerTLS::ClearElevationParameters()
 
 void DEMHandler::ClearElevationParameters()
 {
+  ClearPreloadedArea();
   m_DefaultHeightAboveEllipsoid = 0.;
   m_GeoidFilename.clear();
 
@@ -931,6 +1453,7 @@ void DEMHandler::ClearElevationParameters()
 
 void DEMHandler::SetDefaultHeightAboveEllipsoid(double height)
 {
+  ClearPreloadedArea();
   m_DefaultHeightAboveEllipsoid = height;
   Notify();
 }
@@ -967,4 +1490,13 @@ double GetHeightAboveMSL      (DEMHandlerTLS const& tls, itk::Point<double, 2> g
 double GetGeoidHeight         (DEMHandlerTLS const& tls, itk::Point<double, 2> geoPoint)
 { return GetGeoidHeight(tls, geoPoint[0], geoPoint[1]); }
 
+void GetHeightAboveEllipsoid(DEMHandlerTLS const& tls, std::size_t count, double const* lon, double const* lat, double* height)
+{ tls.GetHeightAboveEllipsoid(count, lon, lat, height, DEMHandler::GetInstance().GetDefaultHeightAboveEllipsoid()); }
+
+void GetHeightAboveMSL      (DEMHandlerTLS const& tls, std::size_t count, double const* lon, double const* lat, double* height)
+{ tls.GetHeightAboveMSL(count, lon, lat, height); }
+
+void GetGeoidHeight         (DEMHandlerTLS const& tls, std::size_t count, double const* lon, double const* lat, double* height)
+{ tls.GetGeoidHeight(count, lon, lat, height); }
+
 } // namespace otb
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbGDALBlockCache.h"
+#include "otbConfigurationManager.h"
+
+#include <tuple>
+
+namespace otb
+{
+
+bool GDALBlockCache::KeyType::operator<(const KeyType& other) const
+{
+  return std::tie(FileName, ModificationTime, SubDataset, Overview, Band, BlockX, BlockY, PixelType) <
+         std::tie(other.FileName, other.ModificationTime, other.SubDataset, other.Overview, other.Band, other.BlockX, other.BlockY, other.PixelType);
+}
+
+GDALBlockCache::GDALBlockCache()
+  : m_MaximumSize(ConfigurationManager::GetGDALBlockCacheSize() * 1024 * 1024), m_Size(0), m_NumberOfHits(0), m_NumberOfMisses(0)
+{
+}
+
+void GDALBlockCache::SetMaximumSize(unsigned long long maximumSize)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_MaximumSize = maximumSize;
+  this->Shrink();
+}
+
+unsigned long long GDALBlockCache::GetMaximumSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumSize;
+}
+
+unsigned long long GDALBlockCache::GetSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Size;
+}
+
+bool GDALBlockCache::IsEnabled() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumSize > 0;
+}
+
+GDALBlockCache::BlockPointerType GDALBlockCache::Get(const KeyType& key)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto                        it = m_Blocks.find(key);
+  if (it == m_Blocks.end())
+  {
+    ++m_NumberOfMisses;
+    return BlockPointerType();
+  }
+  ++m_NumberOfHits;
+  // Move the block to the front of the recency list
+  m_Recency.splice(m_Recency.begin(), m_Recency, it->second.Recency);
+  return it->second.Block;
+}
+
+void GDALBlockCache::Insert(const KeyType& key, BlockPointerType block)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (!block || block->size() > m_MaximumSize)
+  {
+    return;
+  }
+
+  auto it = m_Blocks.find(key);
+  if (it != m_Blocks.end())
+  {
+    // Another reader decoded the same block in the meantime
+    m_Size -= it->second.Block->size();
+    m_Recency.erase(it->second.Recency);
+    m_Blocks.erase(it);
+  }
+
+  m_Recency.push_front(key);
+  m_Blocks[key] = EntryType{block, m_Recency.begin()};
+  m_Size += block->size();
+  this->Shrink();
+}
+
+void GDALBlockCache::Invalidate(const std::string& fileName)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  for (auto it = m_Blocks.begin(); it != m_Blocks.end();)
+  {
+    if (it->first.FileName == fileName)
+    {
+      m_Size -= it->second.Block->size();
+      m_Recency.erase(it->second.Recency);
+      it = m_Blocks.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void GDALBlockCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Blocks.clear();
+  m_Recency.clear();
+  m_Size = 0;
+}
+
+unsigned long long GDALBlockCache::GetNumberOfHits() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfHits;
+}
+
+unsigned long long GDALBlockCache::GetNumberOfMisses() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfMisses;
+}
+
+void GDALBlockCache::ResetStatistics()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_NumberOfHits   = 0;
+  m_NumberOfMisses = 0;
+}
+
+void GDALBlockCache::Shrink()
+{
+  while (m_Size > m_MaximumSize && !m_Recency.empty())
+  {
+    auto it = m_Blocks.find(m_Recency.back());
+    m_Size -= it->second.Block->size();
+    m_Blocks.erase(it);
+    m_Recency.pop_back();
+  }
+}
+
+} // end namespace otb
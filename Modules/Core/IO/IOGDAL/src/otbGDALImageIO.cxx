@@ -22,6 +22,9 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <algorithm>
+#include <cstring>
+#include <memory>
 
 #include "otbGDALImageIO.h"
 #include "otbMacro.h"
@@ -44,6 +47,7 @@
 #include "itksys/RegularExpression.hxx"
 
 #include "otbGDALDriverManagerWrapper.h"
+#include "otbGDALBlockCache.h"
 
 #include "otb_boost_string_header.h"
 
@@ -53,6 +57,87 @@
 
 #include "stdint.h" //needed for uintptr_t
 
+/** Can every value of the type from be converted exactly to the type to ?
+ *  GDAL rounds and clamps the values it converts, while the pixel
+ *  conversion of ImageFileReader truncates, so they only agree on exact
+ *  conversions. */
+inline bool IsExactConversion(GDALDataType from, GDALDataType to)
+{
+  if (from == to)
+  {
+    return true;
+  }
+  if (GDALDataTypeIsComplex(from) != GDALDataTypeIsComplex(to))
+  {
+    return false;
+  }
+
+  // Precision in bits (mantissa for floating types) and signedness of the
+  // components
+  auto describe = [](GDALDataType type, int& bits, bool& isSigned, bool& isFloating) {
+    isFloating = false;
+    switch (type)
+    {
+    case GDT_Byte:
+      bits     = 8;
+      isSigned = false;
+      return true;
+    case GDT_UInt16:
+      bits     = 16;
+      isSigned = false;
+      return true;
+    case GDT_Int16:
+    case GDT_CInt16:
+      bits     = 16;
+      isSigned = true;
+      return true;
+    case GDT_UInt32:
+      bits     = 32;
+      isSigned = false;
+      return true;
+    case GDT_Int32:
+    case GDT_CInt32:
+      bits     = 32;
+      isSigned = true;
+      return true;
+    case GDT_Float32:
+    case GDT_CFloat32:
+      bits       = 24;
+      isSigned   = true;
+      isFloating = true;
+      return true;
+    case GDT_Float64:
+    case GDT_CFloat64:
+      bits       = 53;
+      isSigned   = true;
+      isFloating = true;
+      return true;
+    default:
+      return false;
+    }
+  };
+
+  int  fromBits = 0, toBits = 0;
+  bool fromSigned = false, toSigned = false, fromFloating = false, toFloating = false;
+  if (!describe(from, fromBits, fromSigned, fromFloating) || !describe(to, toBits, toSigned, toFloating))
+  {
+    return false;
+  }
+  if (fromFloating)
+  {
+    return toFloating && toBits >= fromBits;
+  }
+  if (toFloating)
+  {
+    return toBits >= fromBits;
+  }
+  if (fromSigned && !toSigned)
+  {
+    return false;
+  }
+  return toBits > fromBits || (toBits == fromBits && fromSigned == toSigned);
+}
+
 inline unsigned int uint_ceildivpow2(unsigned int a, unsigned int b)
 {
   return (a + (1 << b) - 1) >> b;
@@ -125,6 +210,9 @@ GDALImageIO::GDALImageIO()
   m_BytePerPixel      = 0;
   m_WriteRPCTags      = false;
 
+  m_WriteCloudOptimizedGeoTIFF = false;
+  m_CloudOptimizedWrite        = false;
+
   m_epsgCode          = 0;
 }
 
@@ -152,6 +240,7 @@ void GDALImageIO::PrintSelf(std::ostream& os, itk::Indent indent) const
   os << indent << "Compression Level : " << m_CompressionLevel << "\n";
   os << indent << "IsComplex (otb side) : " << m_IsComplex << "\n";
   os << indent << "Byte per pixel : " << m_BytePerPixel << "\n";
+  os << indent << "Write Cloud Optimized GeoTIFF : " << m_WriteCloudOptimizedGeoTIFF << "\n";
 }
 
 // Read a 3D image (or event more bands)... not implemented yet
@@ -258,21 +347,268 @@ void GDALImageIO::Read(void* buffer)
                        << lFirstLineRegion + lNbLinesRegion - 1 << "] x " << nbBands << " bands of type " << GDALGetDataTypeName(m_PxType->pixType)
                        << " from file " << m_FileName);
 
-    otb::Stopwatch chrono  = otb::Stopwatch::StartNew();
-    CPLErr         lCrGdal = m_Dataset->GetDataSet()->RasterIO(GF_Read, lFirstColumn, lFirstLine, lNbColumns, lNbLines, p, lNbColumnsRegion, lNbLinesRegion,
-                                                       m_PxType->pixType, nbBands,
-                                                       // We want to read all bands
-                                                       nullptr, pixelOffset, lineOffset, bandOffset);
+    otb::Stopwatch chrono = otb::Stopwatch::StartNew();
+    if (!GDALBlockCache::GetInstance().IsEnabled() ||
+        !this->ReadThroughBlockCache(p, lFirstColumnRegion, lFirstLineRegion, lNbColumnsRegion, lNbLinesRegion, pixelOffset, lineOffset, bandOffset))
+    {
+      CPLErr lCrGdal = m_Dataset->GetDataSet()->RasterIO(GF_Read, lFirstColumn, lFirstLine, lNbColumns, lNbLines, p, lNbColumnsRegion, lNbLinesRegion,
+                                                         m_PxType->pixType, nbBands,
+                                                         // We want to read all bands
+                                                         nullptr, pixelOffset, lineOffset, bandOffset);
+      // Check if gdal call succeed
+      if (lCrGdal == CE_Failure)
+      {
+        itkExceptionMacro(<< "Error while reading image (GDAL format) '" << m_FileName << "' : " << CPLGetLastErrorMsg());
+        return;
+      }
+    }
     chrono.Stop();
-    // Check if gdal call succeed
-    if (lCrGdal == CE_Failure)
+
+    otbLogMacro(Debug, << "GDAL read took " << chrono.GetElapsedMilliseconds() << " ms")
+  }
+}
+
+bool GDALImageIO::ReadWithLayout(void* buffer, const std::type_info& componentType, unsigned int nbComponents, const std::vector<unsigned int>& bandList)
+{
+  // Indexed images are expanded to colors, and cached reads go through
+  // the block cache
+  if (buffer == nullptr || m_IsIndexed || GDALBlockCache::GetInstance().IsEnabled())
+  {
+    return false;
+  }
+
+  GDALDataType bufferType = GDT_Unknown;
+  if (componentType == typeid(unsigned char))
+    bufferType = GDT_Byte;
+  else if (componentType == typeid(unsigned short))
+    bufferType = GDT_UInt16;
+  else if (componentType == typeid(short))
+    bufferType = GDT_Int16;
+  else if (componentType == typeid(unsigned int))
+    bufferType = GDT_UInt32;
+  else if (componentType == typeid(int))
+    bufferType = GDT_Int32;
+  else if (componentType == typeid(float))
+    bufferType = GDT_Float32;
+  else if (componentType == typeid(double))
+    bufferType = GDT_Float64;
+  else if (componentType == typeid(std::complex<short>))
+    bufferType = GDT_CInt16;
+  else if (componentType == typeid(std::complex<int>))
+    bufferType = GDT_CInt32;
+  else if (componentType == typeid(std::complex<float>))
+    bufferType = GDT_CFloat32;
+  else if (componentType == typeid(std::complex<double>))
+    bufferType = GDT_CFloat64;
+  else
+    return false;
+
+  const int componentSize = GDALGetDataTypeSize(bufferType) / 8;
+
+  // Each complex band of the file fills two real components
+  int bandComponents = 1;
+  if (GDALDataTypeIsComplex(m_PxType->pixType) && !GDALDataTypeIsComplex(bufferType))
+  {
+    if (!bandList.empty())
     {
-      itkExceptionMacro(<< "Error while reading image (GDAL format) '" << m_FileName << "' : " << CPLGetLastErrorMsg());
-      return;
+      // The band list indexes the real and imaginary parts
+      return false;
+    }
+    switch (bufferType)
+    {
+    case GDT_Int16:
+      bufferType = GDT_CInt16;
+      break;
+    case GDT_Int32:
+      bufferType = GDT_CInt32;
+      break;
+    case GDT_Float32:
+      bufferType = GDT_CFloat32;
+      break;
+    case GDT_Float64:
+      bufferType = GDT_CFloat64;
+      break;
+    default:
+      return false;
     }
+    bandComponents = 2;
+  }
+  else if (!GDALDataTypeIsComplex(m_PxType->pixType) && GDALDataTypeIsComplex(bufferType))
+  {
+    // Pairs of real bands may be read as complex components, let Read() handle it
+    return false;
+  }
 
-    otbLogMacro(Debug, << "GDAL read took " << chrono.GetElapsedMilliseconds() << " ms")
+  // Other conversions are left to the pixel conversion of the reader, which
+  // truncates the values
+  if (!IsExactConversion(m_PxType->pixType, bufferType))
+  {
+    return false;
+  }
+
+  std::vector<int> bandMap;
+  if (bandList.empty())
+  {
+    for (int band = 1; band <= m_NbBands; ++band)
+    {
+      bandMap.push_back(band);
+    }
+  }
+  else
+  {
+    for (auto band : bandList)
+    {
+      if (static_cast<int>(band) >= m_NbBands)
+      {
+        return false;
+      }
+      bandMap.push_back(band + 1);
+    }
+  }
+  if (nbComponents != bandMap.size() * bandComponents)
+  {
+    return false;
+  }
+
+  // Region to read, at the initial resolution
+  const int lNbLinesRegion   = this->GetIORegion().GetSize()[1];
+  const int lNbColumnsRegion = this->GetIORegion().GetSize()[0];
+  const int lFirstLine       = this->GetIORegion().GetIndex()[1] * (1 << m_ResolutionFactor);
+  const int lFirstColumn     = this->GetIORegion().GetIndex()[0] * (1 << m_ResolutionFactor);
+  const int lNbLines         = std::min(lNbLinesRegion * (1 << m_ResolutionFactor), static_cast<int>(m_OriginalDimensions[1]) - lFirstLine);
+  const int lNbColumns       = std::min(lNbColumnsRegion * (1 << m_ResolutionFactor), static_cast<int>(m_OriginalDimensions[0]) - lFirstColumn);
+
+  const GSpacing pixelOffset = static_cast<GSpacing>(componentSize) * nbComponents;
+  const GSpacing lineOffset  = pixelOffset * lNbColumnsRegion;
+  const GSpacing bandOffset  = static_cast<GSpacing>(componentSize) * bandComponents;
+
+  otbLogMacro(Debug, << "GDAL reads [" << lFirstColumn << ", " << lFirstColumn + lNbColumns - 1 << "]x[" << lFirstLine << ", " << lFirstLine + lNbLines - 1
+                     << "] x " << bandMap.size() << " bands of type " << GDALGetDataTypeName(m_PxType->pixType) << " as "
+                     << GDALGetDataTypeName(bufferType) << " from file " << m_FileName);
+
+  otb::Stopwatch chrono  = otb::Stopwatch::StartNew();
+  CPLErr         lCrGdal = m_Dataset->GetDataSet()->RasterIO(GF_Read, lFirstColumn, lFirstLine, lNbColumns, lNbLines, buffer, lNbColumnsRegion, lNbLinesRegion,
+                                                     bufferType, static_cast<int>(bandMap.size()), bandMap.data(), pixelOffset, lineOffset, bandOffset,
+                                                     nullptr);
+  chrono.Stop();
+  if (lCrGdal == CE_Failure)
+  {
+    itkExceptionMacro(<< "Error while reading image (GDAL format) '" << m_FileName << "' : " << CPLGetLastErrorMsg());
+  }
+
+  otbLogMacro(Debug, << "GDAL read took " << chrono.GetElapsedMilliseconds() << " ms");
+  return true;
+}
+
+bool GDALImageIO::ReadThroughBlockCache(unsigned char* buffer, int firstColumn, int firstLine, int nbColumns, int nbLines, int pixelOffset, int lineOffset,
+                                        int bandOffset)
+{
+  GDALDataset* dataset = m_Dataset->GetDataSet();
+
+  // The blocks of a reduced resolution are read from the matching overview
+  std::vector<GDALRasterBand*> bands;
+  for (int band = 1; band <= m_NbBands; ++band)
+  {
+    GDALRasterBand* rasterBand = dataset->GetRasterBand(band);
+    if (m_ResolutionFactor > 0)
+    {
+      rasterBand = rasterBand->GetOverview(m_ResolutionFactor - 1);
+    }
+    if (rasterBand == nullptr || rasterBand->GetXSize() != static_cast<int>(m_Dimensions[0]) || rasterBand->GetYSize() != static_cast<int>(m_Dimensions[1]))
+    {
+      return false;
+    }
+    bands.push_back(rasterBand);
+  }
+
+  GDALBlockCache& blockCache = GDALBlockCache::GetInstance();
+
+  GDALBlockCache::KeyType key;
+  key.FileName         = m_FileName;
+  key.ModificationTime = 0;
+  VSIStatBufL fileStat;
+  if (VSIStatL(m_FileName.c_str(), &fileStat) == 0)
+  {
+    key.ModificationTime = fileStat.st_mtime;
+  }
+  key.SubDataset = m_DatasetNumber;
+  key.Overview   = m_ResolutionFactor;
+  key.PixelType  = m_PxType->pixType;
+
+  const int    pixelSize = GDALGetDataTypeSize(m_PxType->pixType) / 8;
+  unsigned int nbHits    = 0;
+  unsigned int nbMisses  = 0;
+
+  for (int band = 0; band < m_NbBands; ++band)
+  {
+    int blockSizeX = 0, blockSizeY = 0;
+    bands[band]->GetBlockSize(&blockSizeX, &blockSizeY);
+    if (blockSizeX <= 0 || blockSizeY <= 0)
+    {
+      return false;
+    }
+    key.Band = band + 1;
+
+    for (int blockY = firstLine / blockSizeY; blockY <= (firstLine + nbLines - 1) / blockSizeY; ++blockY)
+    {
+      for (int blockX = firstColumn / blockSizeX; blockX <= (firstColumn + nbColumns - 1) / blockSizeX; ++blockX)
+      {
+        const int blockFirstColumn = blockX * blockSizeX;
+        const int blockFirstLine   = blockY * blockSizeY;
+        const int blockNbColumns   = std::min(blockSizeX, static_cast<int>(m_Dimensions[0]) - blockFirstColumn);
+        const int blockNbLines     = std::min(blockSizeY, static_cast<int>(m_Dimensions[1]) - blockFirstLine);
+
+        key.BlockX                             = blockX;
+        key.BlockY                             = blockY;
+        GDALBlockCache::BlockPointerType block = blockCache.Get(key);
+        if (block)
+        {
+          ++nbHits;
+        }
+        else
+        {
+          ++nbMisses;
+          auto decoded = std::make_shared<GDALBlockCache::BlockType>(static_cast<size_t>(pixelSize) * blockNbColumns * blockNbLines);
+          CPLErr lCrGdal = bands[band]->RasterIO(GF_Read, blockFirstColumn, blockFirstLine, blockNbColumns, blockNbLines, decoded->data(), blockNbColumns,
+                                                 blockNbLines, m_PxType->pixType, 0, 0);
+          if (lCrGdal == CE_Failure)
+          {
+            itkExceptionMacro(<< "Error while reading image (GDAL format) '" << m_FileName << "' : " << CPLGetLastErrorMsg());
+          }
+          blockCache.Insert(key, decoded);
+          block = decoded;
+        }
+
+        // Copy the part of the block inside the region
+        const int startColumn = std::max(firstColumn, blockFirstColumn);
+        const int endColumn   = std::min(firstColumn + nbColumns, blockFirstColumn + blockNbColumns);
+        const int startLine   = std::max(firstLine, blockFirstLine);
+        const int endLine     = std::min(firstLine + nbLines, blockFirstLine + blockNbLines);
+        for (int line = startLine; line < endLine; ++line)
+        {
+          const unsigned char* in = block->data() + (static_cast<size_t>(line - blockFirstLine) * blockNbColumns + (startColumn - blockFirstColumn)) * pixelSize;
+          unsigned char*       out = buffer + static_cast<size_t>(line - firstLine) * lineOffset + static_cast<size_t>(startColumn - firstColumn) * pixelOffset +
+                               static_cast<size_t>(band) * bandOffset;
+          if (pixelOffset == pixelSize)
+          {
+            memcpy(out, in, static_cast<size_t>(endColumn - startColumn) * pixelSize);
+          }
+          else
+          {
+            for (int column = startColumn; column < endColumn; ++column, in += pixelSize, out += pixelOffset)
+            {
+              memcpy(out, in, pixelSize);
+            }
+          }
+        }
+      }
+    }
   }
+
+  otbLogMacro(Debug, << "GDAL block cache: " << nbHits << " hits, " << nbMisses << " misses while reading " << m_FileName << " (process total: "
+                     << blockCache.GetNumberOfHits() << " hits, " << blockCache.GetNumberOfMisses() << " misses, "
+                     << blockCache.GetSize() / (1024 * 1024) << " MB cached)");
+  return true;
 }
 
 bool GDALImageIO::GetSubDatasetInfo(std::vector<std::string>& names, std::vector<std::string>& desc)
@@ -317,6 +653,11 @@ bool GDALImageIO::GetSubDatasetInfo(std::vector<std::string>& names, std::vector
   return true;
 }
 
+GDALDataset* GDALImageIO::GetGDALDataset() const
+{
+  return m_Dataset.IsNotNull() ? m_Dataset->GetDataSet() : nullptr;
+}
+
 bool GDALImageIO::GDALPixelTypeIsComplex()
 {
   return GDALDataTypeIsComplex(m_PxType->pixType);
@@ -1164,6 +1505,21 @@ bool GDALImageIO::CanStreamWrite()
   std::string gdalDriverShortName = FilenameToGdalDriverShortName(m_FileName);
   GDALDriver* driver              = GDALDriverManagerWrapper::GetInstance().GetDriverByName(gdalDriverShortName);
 
+  m_CloudOptimizedWrite = false;
+  if (m_WriteCloudOptimizedGeoTIFF && gdalDriverShortName == "GTiff")
+  {
+    // The COG driver only implements CreateCopy: regions are streamed into a
+    // tiled GTiff dataset which is copied to the COG once complete
+    if (GDALDriverManagerWrapper::GetInstance().GetDriverByName("COG") != nullptr)
+    {
+      m_CloudOptimizedWrite = true;
+    }
+    else
+    {
+      otbLogMacro(Warning, << "GDAL COG driver is not available (GDAL >= 3.1 is required), " << m_FileName << " will be written as a regular GeoTIFF");
+    }
+  }
+
   if (driver == nullptr)
   {
     m_CanStreamWrite = false;
@@ -1253,6 +1609,11 @@ void GDALImageIO::Write(const void* buffer)
         // Flush dataset cache
         m_Dataset->GetDataSet()
             ->FlushCache();
+
+    if (m_CloudOptimizedWrite)
+    {
+      this->UpdateCloudOptimizedOverviews(lFirstLine, lNbLines, lFirstColumn, lNbColumns);
+    }
   }
   else
   {
@@ -1284,6 +1645,10 @@ void GDALImageIO::Write(const void* buffer)
   if (lFirstLine + lNbLines == m_Dimensions[1] && lFirstColumn + lNbColumns == m_Dimensions[0])
   {
     // Last pixel written
+    if (m_CloudOptimizedWrite)
+    {
+      this->FinalizeCloudOptimizedGeoTIFF();
+    }
     // Reinitialize to close the file
     m_Dataset = GDALDatasetWrapperPointer();
   }
@@ -1416,13 +1781,28 @@ void GDALImageIO::InternalWriteImageInformation(const void* buffer)
   // Automatically set the Type to Binary for GDAL data
   this->SetFileTypeToBinary();
 
+  // Blocks read from a previous version of the file are outdated
+  GDALBlockCache::GetInstance().Invalidate(m_FileName);
+
   driverShortName = FilenameToGdalDriverShortName(m_FileName);
   if (driverShortName == "NOT-FOUND")
   {
     itkExceptionMacro(<< "GDAL Writing failed: the image file name '" << m_FileName << "' is not recognized by GDAL.");
   }
 
-  if (m_CanStreamWrite)
+  if (m_CloudOptimizedWrite)
+  {
+    // Tiles of the intermediate dataset match the COG blocks, so that the
+    // COG driver copies them without re-tiling. Compression is deferred to
+    // the multi-threaded CreateCopy()
+    const std::string       blockSize = GetCreationOptionValue("BLOCKSIZE", "512");
+    GDALCreationOptionsType creationOptions{"TILED=YES", "BLOCKXSIZE=" + blockSize, "BLOCKYSIZE=" + blockSize, "BIGTIFF=IF_SAFER", "COMPRESS=NONE"};
+    std::string             intermediateDriverShortName = "GTiff";
+    m_Dataset = GDALDriverManagerWrapper::GetInstance().Create(intermediateDriverShortName, GetCloudOptimizedIntermediateFileName(), m_Dimensions[0],
+                                                               m_Dimensions[1], m_NbBands, m_PxType->pixType,
+                                                               otb::ogr::StringListConverter(creationOptions).to_ogr());
+  }
+  else if (m_CanStreamWrite)
   {
     GDALCreationOptionsType creationOptions = m_CreationOptions;
     m_Dataset =
@@ -1649,6 +2029,11 @@ void GDALImageIO::InternalWriteImageInformation(const void* buffer)
   {
     dataset->GetRasterBand(noData.first)->SetNoDataValue(noData.second);
   }
+
+  if (m_CloudOptimizedWrite)
+  {
+    this->CreateCloudOptimizedOverviews();
+  }
 }
 
 std::string GDALImageIO::FilenameToGdalDriverShortName(const std::string& name) const
@@ -1816,6 +2201,215 @@ bool GDALImageIO::CreationOptionContains(std::string partialOption) const
   return (i != m_CreationOptions.size());
 }
 
+std::string GDALImageIO::GetCreationOptionValue(const std::string& key, const std::string& defaultValue) const
+{
+  const std::string prefix = key + "=";
+  for (auto const& option : m_CreationOptions)
+  {
+    if (boost::algorithm::istarts_with(option, prefix))
+    {
+      return option.substr(prefix.size());
+    }
+  }
+  return defaultValue;
+}
+
+std::string GDALImageIO::GetCloudOptimizedIntermediateFileName() const
+{
+  return System::GetRootName(m_FileName) + "_cog_tmp.tif";
+}
+
+void GDALImageIO::CreateCloudOptimizedOverviews()
+{
+  m_CloudOptimizedCompletedLines.assign(1, 0);
+
+  const std::string overviews = boost::algorithm::to_upper_copy(GetCreationOptionValue("OVERVIEWS", "AUTO"));
+  if (overviews == "NONE" || overviews == "IGNORE_EXISTING")
+  {
+    // The COG driver does not use the overviews of the source
+    return;
+  }
+
+  // Same default as the COG driver: halve the resolution until the image
+  // fits in a single block
+  const unsigned int blockSize = std::max(1, atoi(GetCreationOptionValue("BLOCKSIZE", "512").c_str()));
+  unsigned int       nbLevels  = 0;
+  unsigned int       maxSize   = std::max(m_Dimensions[0], m_Dimensions[1]);
+  while (maxSize > blockSize)
+  {
+    maxSize = (maxSize + 1) / 2;
+    ++nbLevels;
+  }
+  const std::string overviewCount = GetCreationOptionValue("OVERVIEW_COUNT", "");
+  if (!overviewCount.empty())
+  {
+    nbLevels = std::max(0, atoi(overviewCount.c_str()));
+  }
+  if (nbLevels == 0)
+  {
+    return;
+  }
+
+  std::vector<int> levels;
+  for (unsigned int i = 1; i <= nbLevels; ++i)
+  {
+    levels.push_back(1 << i);
+  }
+
+  // Overviews are created empty, and filled while the image is streamed
+  CPLErr lCrGdal = m_Dataset->GetDataSet()->BuildOverviews("NONE", nbLevels, levels.data(), 0, nullptr, nullptr, nullptr);
+  if (lCrGdal == CE_Failure)
+  {
+    itkExceptionMacro(<< "Error while creating overviews of the Cloud Optimized GeoTIFF '" << m_FileName << "' : " << CPLGetLastErrorMsg());
+  }
+  m_CloudOptimizedCompletedLines.assign(nbLevels + 1, 0);
+}
+
+void GDALImageIO::UpdateCloudOptimizedOverviews(int firstLine, unsigned int nbLines, int firstColumn, unsigned int nbColumns)
+{
+  // Splits are written in row-major order: lines are complete once the
+  // region reaching the right border of the image has been written
+  if (m_CloudOptimizedCompletedLines.size() < 2 || firstColumn + nbColumns != m_Dimensions[0])
+  {
+    return;
+  }
+  m_CloudOptimizedCompletedLines[0] = firstLine + nbLines;
+
+  const std::string resampling =
+      boost::algorithm::to_upper_copy(GetCreationOptionValue("OVERVIEW_RESAMPLING", GetCreationOptionValue("RESAMPLING", "CUBIC")));
+
+  GDALRasterIOExtraArg extraArg;
+  INIT_RASTERIO_EXTRA_ARG(extraArg);
+  // Radius of the GDAL resampling kernel, in pixels of the overview: it
+  // spans twice as many lines of the source
+  unsigned int kernelRadius = 0;
+  if (resampling == "NEAREST")
+  {
+    extraArg.eResampleAlg = GRIORA_NearestNeighbour;
+  }
+  else if (resampling == "AVERAGE")
+  {
+    extraArg.eResampleAlg = GRIORA_Average;
+  }
+  else if (resampling == "MODE")
+  {
+    extraArg.eResampleAlg = GRIORA_Mode;
+  }
+  else if (resampling == "BILINEAR")
+  {
+    extraArg.eResampleAlg = GRIORA_Bilinear;
+    kernelRadius          = 1;
+  }
+  else if (resampling == "CUBICSPLINE")
+  {
+    extraArg.eResampleAlg = GRIORA_CubicSpline;
+    kernelRadius          = 2;
+  }
+  else if (resampling == "LANCZOS")
+  {
+    extraArg.eResampleAlg = GRIORA_Lanczos;
+    kernelRadius          = 3;
+  }
+  else
+  {
+    extraArg.eResampleAlg = GRIORA_Cubic;
+    kernelRadius          = 2;
+  }
+  // Number of overview lines held back until the source lines under the
+  // kernel are complete, with one more line for the rounding of the kernel
+  // window by GDAL
+  const unsigned int margin = kernelRadius > 0 ? kernelRadius + 1 : 0;
+
+  GDALDataset*      dataset = m_Dataset->GetDataSet();
+  std::vector<char> buffer;
+  for (unsigned int level = 1; level < m_CloudOptimizedCompletedLines.size(); ++level)
+  {
+    GDALRasterBand* firstOverview  = dataset->GetRasterBand(1)->GetOverview(level - 1);
+    GDALRasterBand* firstSource    = level == 1 ? dataset->GetRasterBand(1) : dataset->GetRasterBand(1)->GetOverview(level - 2);
+    const int       width          = firstOverview->GetXSize();
+    const int       height         = firstOverview->GetYSize();
+    const int       sourceWidth    = firstSource->GetXSize();
+    const int       sourceHeight   = firstSource->GetYSize();
+    const int       sourceComplete = m_CloudOptimizedCompletedLines[level - 1];
+
+    int complete = height;
+    if (sourceComplete < sourceHeight)
+    {
+      complete = std::max(0, sourceComplete / 2 - static_cast<int>(margin));
+    }
+    const int done = m_CloudOptimizedCompletedLines[level];
+    if (complete <= done)
+    {
+      break;
+    }
+
+    const int sourceFirstLine = 2 * done;
+    const int sourceNbLines   = std::min(2 * complete, sourceHeight) - sourceFirstLine;
+    const int nbOverviewLines = complete - done;
+    buffer.resize(static_cast<size_t>(m_BytePerPixel) * width * nbOverviewLines);
+    for (int band = 1; band <= m_NbBands; ++band)
+    {
+      GDALRasterBand* overview = dataset->GetRasterBand(band)->GetOverview(level - 1);
+      GDALRasterBand* source   = level == 1 ? dataset->GetRasterBand(band) : dataset->GetRasterBand(band)->GetOverview(level - 2);
+
+      CPLErr lCrGdal = source->RasterIO(GF_Read, 0, sourceFirstLine, sourceWidth, sourceNbLines, buffer.data(), width, nbOverviewLines, m_PxType->pixType, 0, 0,
+                                        &extraArg);
+      if (lCrGdal != CE_Failure)
+      {
+        lCrGdal = overview->RasterIO(GF_Write, 0, done, width, nbOverviewLines, buffer.data(), width, nbOverviewLines, m_PxType->pixType, 0, 0, nullptr);
+      }
+      if (lCrGdal == CE_Failure)
+      {
+        itkExceptionMacro(<< "Error while updating overview " << level << " of the Cloud Optimized GeoTIFF '" << m_FileName << "' : " << CPLGetLastErrorMsg());
+      }
+    }
+    m_CloudOptimizedCompletedLines[level] = complete;
+  }
+}
+
+void GDALImageIO::FinalizeCloudOptimizedGeoTIFF()
+{
+  GDALDriver* driver = GDALDriverManagerWrapper::GetInstance().GetDriverByName("COG");
+  if (driver == nullptr)
+  {
+    itkExceptionMacro(<< "Unable to instantiate driver COG to write " << m_FileName);
+  }
+
+  // Tiles are compressed in parallel, and the overviews filled while
+  // streaming are copied instead of being recomputed
+  GDALCreationOptionsType creationOptions = m_CreationOptions;
+  if (!CreationOptionContains("NUM_THREADS="))
+  {
+    creationOptions.push_back("NUM_THREADS=ALL_CPUS");
+  }
+  if (!CreationOptionContains("OVERVIEWS=") && m_CloudOptimizedCompletedLines.size() > 1)
+  {
+    creationOptions.push_back("OVERVIEWS=FORCE_USE_EXISTING");
+  }
+
+  m_Dataset->GetDataSet()->FlushCache();
+
+  otb::Stopwatch chrono    = otb::Stopwatch::StartNew();
+  GDALDataset*   hOutputDS = driver->CreateCopy(m_FileName.c_str(), m_Dataset->GetDataSet(), FALSE,
+                                              otb::ogr::StringListConverter(creationOptions).to_ogr(), nullptr, nullptr);
+  chrono.Stop();
+  if (!hOutputDS)
+  {
+    itkExceptionMacro(<< "Error while writing image (GDAL format) '" << m_FileName << "' : " << CPLGetLastErrorMsg());
+  }
+  GDALClose(hOutputDS);
+  otbLogMacro(Debug, << "GDAL COG copy took " << chrono.GetElapsedMilliseconds() << " ms");
+
+  // Close and remove the intermediate dataset
+  m_Dataset = GDALDatasetWrapperPointer();
+  GDALDriver* intermediateDriver = GDALDriverManagerWrapper::GetInstance().GetDriverByName("GTiff");
+  if (intermediateDriver->Delete(GetCloudOptimizedIntermediateFileName().c_str()) == CE_Failure)
+  {
+    otbLogMacro(Warning, << "Unable to remove intermediate file " << GetCloudOptimizedIntermediateFileName());
+  }
+  m_CloudOptimizedWrite = false;
+}
+
 
 std::string GDALImageIO::GetGdalPixelTypeAsString() const
 {
@@ -0,0 +1,766 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "otbMappedImageIO.h"
+#include "otbMacro.h"
+#include "otbStopwatch.h"
+#include "otbMetaDataKey.h"
+#include "itkMetaDataObject.h"
+#include "itksys/SystemTools.hxx"
+
+#include "gdal_priv.h"
+#include "cpl_port.h"
+
+namespace otb
+{
+
+/** \class MappedFile
+ *
+ * \brief Memory mapping of a file, or of a range of bytes of a file
+ *
+ * The whole file is mapped read-only. A range is mapped privately and
+ * writable: pages written by the pipeline are copied, so that neither the
+ * file nor the other mappings of the same range see the changes.
+ *
+ * \ingroup OTBIOGDAL
+ */
+class MappedFile
+{
+public:
+  /** Map the whole file, read-only */
+  explicit MappedFile(const std::string& fileName) : MappedFile(fileName, 0, 0, false)
+  {
+  }
+
+  /** Map size bytes of the file from offset, privately and writable.
+   *  The mapping starts at the page holding offset. */
+  MappedFile(const std::string& fileName, unsigned long long offset, unsigned long long size) : MappedFile(fileName, offset, size, true)
+  {
+  }
+
+  ~MappedFile()
+  {
+#if defined(_WIN32)
+    if (m_Data != nullptr)
+      UnmapViewOfFile(m_Data);
+    if (m_Mapping != nullptr)
+      CloseHandle(m_Mapping);
+    if (m_File != INVALID_HANDLE_VALUE)
+      CloseHandle(m_File);
+#else
+    if (m_Data != nullptr)
+      munmap(m_Data, static_cast<size_t>(m_Size));
+#endif
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /** First mapped byte, at the requested offset in the file */
+  unsigned char* GetData() const
+  {
+    return m_Data == nullptr ? nullptr : static_cast<unsigned char*>(m_Data) + m_Delta;
+  }
+
+  /** Number of mapped bytes from GetData() */
+  unsigned long long GetSize() const
+  {
+    return m_Data == nullptr ? 0 : m_Size - m_Delta;
+  }
+
+private:
+  MappedFile(const std::string& fileName, unsigned long long offset, unsigned long long size, bool writable) : m_Data(nullptr), m_Size(0), m_Delta(0)
+  {
+#if defined(_WIN32)
+    m_File    = INVALID_HANDLE_VALUE;
+    m_Mapping = nullptr;
+    m_File    = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_File == INVALID_HANDLE_VALUE)
+      return;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(m_File, &fileSize) || !this->ComputeRange(static_cast<unsigned long long>(fileSize.QuadPart), offset, size))
+      return;
+    m_Mapping = CreateFileMappingA(m_File, nullptr, writable ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+    if (m_Mapping == nullptr)
+    {
+      m_Size = 0;
+      return;
+    }
+    const unsigned long long start = offset - m_Delta;
+    m_Data = MapViewOfFile(m_Mapping, writable ? FILE_MAP_COPY : FILE_MAP_READ, static_cast<DWORD>(start >> 32), static_cast<DWORD>(start & 0xFFFFFFFFULL),
+                           static_cast<SIZE_T>(m_Size));
+    if (m_Data == nullptr)
+      m_Size = 0;
+#else
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && this->ComputeRange(static_cast<unsigned long long>(st.st_size), offset, size))
+    {
+      void* data = mmap(nullptr, static_cast<size_t>(m_Size), writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd,
+                        static_cast<off_t>(offset - m_Delta));
+      if (data != MAP_FAILED)
+        m_Data = data;
+      else
+        m_Size = 0;
+    }
+    // The mapping stays valid once the descriptor is closed
+    close(fd);
+#endif
+  }
+
+  /** Compute the mapped size and the distance from the page boundary to
+   *  offset. size 0 maps up to the end of the file. Returns false if the
+   *  range is empty or past the end of the file. */
+  bool ComputeRange(unsigned long long fileSize, unsigned long long offset, unsigned long long size)
+  {
+    if (size == 0)
+      size = fileSize > offset ? fileSize - offset : 0;
+    if (size == 0 || offset + size > fileSize)
+      return false;
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const unsigned long long granularity = info.dwAllocationGranularity;
+#else
+    const unsigned long long granularity = static_cast<unsigned long long>(sysconf(_SC_PAGESIZE));
+#endif
+    m_Delta = offset % granularity;
+    m_Size  = size + m_Delta;
+    return true;
+  }
+
+  void*              m_Data;
+  unsigned long long m_Size;
+  unsigned long long m_Delta;
+#if defined(_WIN32)
+  HANDLE m_File;
+  HANDLE m_Mapping;
+#endif
+};
+
+namespace
+{
+std::string ToLower(std::string s)
+{
+  std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+  return s;
+}
+
+std::string Trim(const std::string& s)
+{
+  const std::size_t first = s.find_first_not_of(" \t\r\n");
+  if (first == std::string::npos)
+    return std::string();
+  const std::size_t last = s.find_last_not_of(" \t\r\n");
+  return s.substr(first, last - first + 1);
+}
+
+bool ParseUnsigned(const std::string& s, unsigned long long& value)
+{
+  const std::string trimmed = Trim(s);
+  if (trimmed.empty() || !std::isdigit(static_cast<unsigned char>(trimmed[0])))
+    return false;
+  char* end = nullptr;
+  value     = std::strtoull(trimmed.c_str(), &end, 10);
+  return end != nullptr && *end == '\0';
+}
+
+/** Copy count samples of N bytes, read every inStride bytes, to every
+ *  outStride bytes */
+template <unsigned int N>
+void CopySamples(const unsigned char* in, unsigned long long inStride, unsigned char* out, unsigned long long outStride, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; ++i, in += inStride, out += outStride)
+  {
+    std::memcpy(out, in, N);
+  }
+}
+
+void CopySamples(const unsigned char* in, unsigned long long inStride, unsigned char* out, unsigned long long outStride, unsigned int count,
+                 unsigned int sampleSize)
+{
+  switch (sampleSize)
+  {
+  case 1:
+    CopySamples<1>(in, inStride, out, outStride, count);
+    break;
+  case 2:
+    CopySamples<2>(in, inStride, out, outStride, count);
+    break;
+  case 4:
+    CopySamples<4>(in, inStride, out, outStride, count);
+    break;
+  case 8:
+    CopySamples<8>(in, inStride, out, outStride, count);
+    break;
+  case 16:
+    CopySamples<16>(in, inStride, out, outStride, count);
+    break;
+  default:
+    for (unsigned int i = 0; i < count; ++i, in += inStride, out += outStride)
+    {
+      std::memcpy(out, in, sampleSize);
+    }
+  }
+}
+
+/** Header file labelling a raw data file: "file.hdr" or "file.ext.hdr" */
+std::string FindHeaderFile(const std::string& fileName)
+{
+  const std::string candidates[] = {itksys::SystemTools::GetFilenameWithoutLastExtension(fileName), fileName};
+  const std::string path         = itksys::SystemTools::GetFilenamePath(fileName);
+  for (const auto& candidate : candidates)
+  {
+    for (const char* extension : {".hdr", ".HDR"})
+    {
+      std::string header = itksys::SystemTools::GetFilenameName(candidate) + extension;
+      if (!path.empty())
+        header = path + "/" + header;
+      if (itksys::SystemTools::FileExists(header, true))
+        return header;
+    }
+  }
+  return std::string();
+}
+
+/** True if the file starts with a classic or BigTIFF signature */
+bool HasTIFFSignature(const std::string& fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  char          signature[4];
+  if (!file.read(signature, 4))
+    return false;
+  return (signature[0] == 'I' && signature[1] == 'I' && (signature[2] == 42 || signature[2] == 43) && signature[3] == 0) ||
+         (signature[0] == 'M' && signature[1] == 'M' && signature[2] == 0 && (signature[3] == 42 || signature[3] == 43));
+}
+} // end anonymous namespace
+
+MappedImageIO::MappedImageIO() : m_Mappable(false)
+{
+}
+
+MappedImageIO::~MappedImageIO()
+{
+}
+
+bool MappedImageIO::CanReadFile(const char* file)
+{
+  m_Mappable = false;
+  m_MappedFile.reset();
+
+  // Cheap checks first, so that other files are only opened by GDALImageIO
+  if (file == nullptr || !itksys::SystemTools::FileExists(file, true))
+  {
+    return false;
+  }
+  if (FindHeaderFile(file).empty() && !HasTIFFSignature(file))
+  {
+    return false;
+  }
+
+  if (!Superclass::CanReadFile(file))
+  {
+    return false;
+  }
+
+  // The dataset is kept open even if the pixels can not be mapped: they are
+  // then read by GDALImageIO, instead of opening the file again from
+  // another ImageIO
+  Layout layout;
+  if (this->ComputeLayout(layout))
+  {
+    m_Layout   = layout;
+    m_Mappable = true;
+  }
+  return true;
+}
+
+void MappedImageIO::ReadImageInformation()
+{
+  Superclass::ReadImageInformation();
+
+  // The layout describes the full resolution of the main dataset
+  unsigned int resolutionFactor = 0;
+  itk::ExposeMetaData<unsigned int>(this->GetMetaDataDictionary(), MetaDataKey::ResolutionFactor, resolutionFactor);
+  if (resolutionFactor > 0 || m_DatasetNumber > 0)
+  {
+    m_Mappable = false;
+  }
+}
+
+bool MappedImageIO::ComputeLayout(Layout& layout) const
+{
+  GDALDataset* dataset = this->GetGDALDataset();
+  if (dataset == nullptr || dataset->GetRasterCount() == 0 || dataset->GetDriver() == nullptr)
+  {
+    return false;
+  }
+
+  const GDALDataType type = dataset->GetRasterBand(1)->GetRasterDataType();
+  for (int band = 1; band <= dataset->GetRasterCount(); ++band)
+  {
+    GDALRasterBand* rasterBand = dataset->GetRasterBand(band);
+    // Indexed and packed samples are expanded by GDAL
+    const char* nbits = rasterBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
+    if (rasterBand->GetRasterDataType() != type || rasterBand->GetColorTable() != nullptr ||
+        (nbits != nullptr && std::atoi(nbits) != 8 * GDALGetDataTypeSizeBytes(type)))
+    {
+      return false;
+    }
+  }
+  layout.SampleSize = GDALGetDataTypeSizeBytes(type);
+  if (layout.SampleSize == 0)
+  {
+    return false;
+  }
+
+  char** fileList = dataset->GetFileList();
+  if (fileList == nullptr || fileList[0] == nullptr)
+  {
+    CSLDestroy(fileList);
+    return false;
+  }
+  layout.FileName = fileList[0];
+  CSLDestroy(fileList);
+
+  const std::string driverName = GDALGetDriverShortName(dataset->GetDriver());
+  bool              success    = false;
+  if (driverName == "ENVI")
+  {
+    success = this->ComputeENVILayout(FindHeaderFile(layout.FileName), layout);
+  }
+  else if (driverName == "EHdr")
+  {
+    success = this->ComputeEHdrLayout(FindHeaderFile(layout.FileName), layout);
+  }
+  else if (driverName == "GTiff")
+  {
+    success = HasTIFFSignature(layout.FileName) && this->ComputeGTiffLayout(layout);
+  }
+
+  if (success)
+  {
+    otbLogMacro(Debug, << "Pixels of " << layout.FileName << " can be read from a memory mapping (" << driverName << ", pixel stride "
+                       << layout.PixelStride << ", line stride " << layout.LineStride << ")");
+  }
+  return success;
+}
+
+bool MappedImageIO::ComputeENVILayout(const std::string& header, Layout& layout) const
+{
+  std::ifstream file(header.c_str());
+  if (header.empty() || !file)
+  {
+    return false;
+  }
+
+  unsigned long long headerOffset = 0;
+  unsigned long long byteOrder    = CPL_IS_LSB ? 0 : 1;
+  std::string        interleave   = "bsq";
+  std::string        line;
+  while (std::getline(file, line))
+  {
+    const std::size_t equal = line.find('=');
+    if (equal == std::string::npos)
+      continue;
+    const std::string key   = ToLower(Trim(line.substr(0, equal)));
+    const std::string value = Trim(line.substr(equal + 1));
+    if ((key == "header offset" && !ParseUnsigned(value, headerOffset)) || (key == "byte order" && !ParseUnsigned(value, byteOrder)))
+    {
+      return false;
+    }
+    if (key == "interleave")
+    {
+      interleave = ToLower(value);
+    }
+  }
+
+  // 0 is little endian, 1 is big endian
+  if (byteOrder != (CPL_IS_LSB ? 0U : 1U))
+  {
+    return false;
+  }
+
+  GDALDataset*             dataset = this->GetGDALDataset();
+  const unsigned long long width   = dataset->GetRasterXSize();
+  const unsigned long long height  = dataset->GetRasterYSize();
+  const unsigned int       nbBands = dataset->GetRasterCount();
+  const unsigned int       size    = layout.SampleSize;
+  layout.BandOffsets.resize(nbBands);
+  for (unsigned int band = 0; band < nbBands; ++band)
+  {
+    if (interleave == "bip")
+    {
+      layout.BandOffsets[band] = headerOffset + band * size;
+      layout.PixelStride       = nbBands * size;
+      layout.LineStride        = width * nbBands * size;
+    }
+    else if (interleave == "bil")
+    {
+      layout.BandOffsets[band] = headerOffset + band * width * size;
+      layout.PixelStride       = size;
+      layout.LineStride        = width * nbBands * size;
+    }
+    else if (interleave == "bsq")
+    {
+      layout.BandOffsets[band] = headerOffset + band * width * height * size;
+      layout.PixelStride       = size;
+      layout.LineStride        = width * size;
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MappedImageIO::ComputeEHdrLayout(const std::string& header, Layout& layout) const
+{
+  std::ifstream file(header.c_str());
+  if (header.empty() || !file)
+  {
+    return false;
+  }
+
+  GDALDataset*             dataset = this->GetGDALDataset();
+  const unsigned long long width   = dataset->GetRasterXSize();
+  const unsigned long long height  = dataset->GetRasterYSize();
+  const unsigned int       nbBands = dataset->GetRasterCount();
+  const unsigned int       size    = layout.SampleSize;
+
+  std::string        layoutName = "bil";
+  std::string        byteOrder  = CPL_IS_LSB ? "i" : "m";
+  unsigned long long skipBytes  = 0;
+  unsigned long long bandRowBytes = 0, totalRowBytes = 0, bandGapBytes = 0;
+  std::string        line;
+  while (std::getline(file, line))
+  {
+    std::istringstream iss(line);
+    std::string        key, value;
+    if (!(iss >> key >> value))
+      continue;
+    key   = ToLower(key);
+    value = ToLower(value);
+    if (key == "layout")
+      layoutName = value;
+    else if (key == "byteorder")
+      byteOrder = value;
+    else if ((key == "skipbytes" && !ParseUnsigned(value, skipBytes)) || (key == "bandrowbytes" && !ParseUnsigned(value, bandRowBytes)) ||
+             (key == "totalrowbytes" && !ParseUnsigned(value, totalRowBytes)) || (key == "bandgapbytes" && !ParseUnsigned(value, bandGapBytes)))
+      return false;
+  }
+
+  const bool littleEndian = (byteOrder == "i" || byteOrder == "lsbfirst");
+  if (littleEndian != static_cast<bool>(CPL_IS_LSB))
+  {
+    return false;
+  }
+
+  layout.BandOffsets.resize(nbBands);
+  if (layoutName == "bip")
+  {
+    layout.PixelStride = nbBands * size;
+    layout.LineStride  = totalRowBytes > 0 ? totalRowBytes : width * nbBands * size;
+    for (unsigned int band = 0; band < nbBands; ++band)
+      layout.BandOffsets[band] = skipBytes + band * size;
+  }
+  else if (layoutName == "bil")
+  {
+    bandRowBytes       = bandRowBytes > 0 ? bandRowBytes : width * size;
+    layout.PixelStride = size;
+    layout.LineStride  = totalRowBytes > 0 ? totalRowBytes : nbBands * bandRowBytes;
+    for (unsigned int band = 0; band < nbBands; ++band)
+      layout.BandOffsets[band] = skipBytes + band * bandRowBytes;
+  }
+  else if (layoutName == "bsq")
+  {
+    layout.PixelStride = size;
+    layout.LineStride  = width * size;
+    for (unsigned int band = 0; band < nbBands; ++band)
+      layout.BandOffsets[band] = skipBytes + band * (width * height * size + bandGapBytes);
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+bool MappedImageIO::ComputeGTiffLayout(Layout& layout) const
+{
+  GDALDataset* dataset = this->GetGDALDataset();
+
+  // TIFF files in the other byte order are swapped by GDAL
+  std::ifstream file(layout.FileName.c_str(), std::ios::binary);
+  char          byteOrder[2];
+  if (!file.read(byteOrder, 2) || (byteOrder[0] == 'I') != static_cast<bool>(CPL_IS_LSB))
+  {
+    return false;
+  }
+
+  if (dataset->GetMetadataItem("COMPRESSION", "IMAGE_STRUCTURE") != nullptr)
+  {
+    return false;
+  }
+
+  const unsigned long long width   = dataset->GetRasterXSize();
+  const unsigned long long height  = dataset->GetRasterYSize();
+  const unsigned int       nbBands = dataset->GetRasterCount();
+  const unsigned int       size    = layout.SampleSize;
+
+  int blockSizeX = 0, blockSizeY = 0;
+  dataset->GetRasterBand(1)->GetBlockSize(&blockSizeX, &blockSizeY);
+  if (static_cast<unsigned long long>(blockSizeX) != width || blockSizeY <= 0)
+  {
+    return false;
+  }
+
+  const char* interleave = dataset->GetMetadataItem("INTERLEAVE", "IMAGE_STRUCTURE");
+  const bool  pixelInterleaved = nbBands == 1 || (interleave != nullptr && ToLower(interleave) == "pixel");
+
+  layout.PixelStride = pixelInterleaved ? nbBands * size : size;
+  layout.LineStride  = width * layout.PixelStride;
+  layout.BandOffsets.resize(nbBands);
+
+  // The strips of each plane must follow each other in the file. All the
+  // bands share the strips of the first one when they are pixel interleaved
+  const unsigned int       nbPlanes = pixelInterleaved ? 1 : nbBands;
+  const unsigned long long nbStrips = (height + blockSizeY - 1) / blockSizeY;
+  for (unsigned int plane = 0; plane < nbPlanes; ++plane)
+  {
+    GDALRasterBand*    rasterBand  = dataset->GetRasterBand(plane + 1);
+    unsigned long long firstOffset = 0;
+    for (unsigned long long strip = 0; strip < nbStrips; ++strip)
+    {
+      std::ostringstream offsetKey, sizeKey;
+      offsetKey << "BLOCK_OFFSET_0_" << strip;
+      sizeKey << "BLOCK_SIZE_0_" << strip;
+      const char*        offsetItem = rasterBand->GetMetadataItem(offsetKey.str().c_str(), "TIFF");
+      const char*        sizeItem   = rasterBand->GetMetadataItem(sizeKey.str().c_str(), "TIFF");
+      unsigned long long offset = 0, stripSize = 0;
+      if (offsetItem == nullptr || sizeItem == nullptr || !ParseUnsigned(offsetItem, offset) || !ParseUnsigned(sizeItem, stripSize))
+      {
+        return false;
+      }
+      if (strip == 0)
+      {
+        firstOffset = offset;
+      }
+      const unsigned long long linesInStrip = std::min<unsigned long long>(blockSizeY, height - strip * blockSizeY);
+      if (offset != firstOffset + strip * blockSizeY * layout.LineStride || stripSize < linesInStrip * layout.LineStride)
+      {
+        return false;
+      }
+    }
+    if (pixelInterleaved)
+    {
+      for (unsigned int band = 0; band < nbBands; ++band)
+        layout.BandOffsets[band] = firstOffset + band * size;
+    }
+    else
+    {
+      layout.BandOffsets[plane] = firstOffset;
+    }
+  }
+  return true;
+}
+
+bool MappedImageIO::MapFile()
+{
+  if (m_MappedFile)
+  {
+    return true;
+  }
+
+  auto mappedFile = std::make_shared<MappedFile>(m_Layout.FileName);
+  if (mappedFile->GetData() == nullptr)
+  {
+    otbLogMacro(Debug, << "Unable to map " << m_Layout.FileName << " in memory, reading it with GDAL");
+    m_Mappable = false;
+    return false;
+  }
+
+  // Check that the last sample of each band lies in the file
+  GDALDataset*             dataset = this->GetGDALDataset();
+  const unsigned long long lastSample =
+      (dataset->GetRasterYSize() - 1) * m_Layout.LineStride + (dataset->GetRasterXSize() - 1) * m_Layout.PixelStride + m_Layout.SampleSize;
+  for (unsigned long long offset : m_Layout.BandOffsets)
+  {
+    if (offset + lastSample > mappedFile->GetSize())
+    {
+      otbLogMacro(Warning, << "File " << m_Layout.FileName << " is smaller than described by its header, reading it with GDAL");
+      m_Mappable = false;
+      return false;
+    }
+  }
+
+  m_MappedFile = mappedFile;
+  return true;
+}
+
+bool MappedImageIO::CanReadFromMapping()
+{
+  // Complex pixels built from pairs of real bands are interleaved by GDAL
+  const bool realBandPairs = !this->GDALPixelTypeIsComplex() && this->GetIsComplex() && this->GetIsVectorImage() &&
+                             m_Layout.BandOffsets.size() > 1;
+  return m_Mappable && !m_IsIndexed && !realBandPairs && static_cast<int>(m_Layout.BandOffsets.size()) == m_NbBands;
+}
+
+void* MappedImageIO::GetIORegionPointer(MappedFilePointerType& regionMapping)
+{
+  regionMapping.reset();
+  if (!this->CanReadFromMapping() || !this->MapFile())
+  {
+    return nullptr;
+  }
+
+  const unsigned long long nbBands     = m_Layout.BandOffsets.size();
+  const unsigned long long pixelSize   = nbBands * m_Layout.SampleSize;
+  const unsigned int       firstColumn = this->GetIORegion().GetIndex()[0];
+  const unsigned int       firstLine   = this->GetIORegion().GetIndex()[1];
+  const unsigned int       nbColumns   = this->GetIORegion().GetSize()[0];
+  const unsigned int       nbLines     = this->GetIORegion().GetSize()[1];
+
+  // The bands of a pixel must be consecutive, and so must be the lines
+  if (nbLines == 0 || nbColumns == 0 || m_Layout.PixelStride != pixelSize || (nbLines > 1 && m_Layout.LineStride != nbColumns * pixelSize))
+  {
+    return nullptr;
+  }
+  for (unsigned int band = 1; band < nbBands; ++band)
+  {
+    if (m_Layout.BandOffsets[band] != m_Layout.BandOffsets[0] + band * m_Layout.SampleSize)
+    {
+      return nullptr;
+    }
+  }
+
+  // Components must be aligned to be accessed in place
+  const unsigned long long offset = m_Layout.BandOffsets[0] + firstLine * m_Layout.LineStride + firstColumn * m_Layout.PixelStride;
+  if (offset % this->GetComponentSize() != 0)
+  {
+    return nullptr;
+  }
+
+  // Each region gets a private mapping of its own: the pipeline may write
+  // into the pixels, which must not be seen by the other reads of the file
+  const unsigned long long size    = (nbLines - 1) * m_Layout.LineStride + nbColumns * pixelSize;
+  auto                     mapping = std::make_shared<MappedFile>(m_Layout.FileName, offset, size);
+  if (mapping->GetData() == nullptr)
+  {
+    otbLogMacro(Debug, << "Unable to map the IORegion of " << m_Layout.FileName << " in memory, copying it");
+    return nullptr;
+  }
+  regionMapping = mapping;
+  return mapping->GetData();
+}
+
+void MappedImageIO::Read(void* buffer)
+{
+  unsigned char* p = static_cast<unsigned char*>(buffer);
+  if (p == nullptr)
+  {
+    itkExceptionMacro(<< "Buffer passed to MappedImageIO for reading is NULL.");
+  }
+
+  if (!this->CanReadFromMapping() || !this->MapFile())
+  {
+    Superclass::Read(buffer);
+    return;
+  }
+
+  const unsigned int nbBands     = m_Layout.BandOffsets.size();
+  const unsigned int sampleSize  = m_Layout.SampleSize;
+  const unsigned int firstColumn = this->GetIORegion().GetIndex()[0];
+  const unsigned int firstLine   = this->GetIORegion().GetIndex()[1];
+  const unsigned int nbColumns   = this->GetIORegion().GetSize()[0];
+  const unsigned int nbLines     = this->GetIORegion().GetSize()[1];
+
+  GDALDataset* dataset = this->GetGDALDataset();
+  if (firstColumn + nbColumns > static_cast<unsigned int>(dataset->GetRasterXSize()) ||
+      firstLine + nbLines > static_cast<unsigned int>(dataset->GetRasterYSize()))
+  {
+    itkExceptionMacro(<< "MappedImageIO::Read() Image region out of range (" << m_Layout.FileName << ")");
+  }
+
+  otbLogMacro(Debug, << "Mapped read [" << firstColumn << ", " << firstColumn + nbColumns - 1 << "]x[" << firstLine << ", " << firstLine + nbLines - 1
+                     << "] x " << nbBands << " bands from file " << m_Layout.FileName);
+  otb::Stopwatch chrono = otb::Stopwatch::StartNew();
+
+  const unsigned long long pixelSize = static_cast<unsigned long long>(nbBands) * sampleSize;
+  bool                     interleaved = (m_Layout.PixelStride == pixelSize);
+  for (unsigned int band = 1; band < nbBands && interleaved; ++band)
+  {
+    interleaved = (m_Layout.BandOffsets[band] == m_Layout.BandOffsets[0] + band * sampleSize);
+  }
+
+  const unsigned char* data = m_MappedFile->GetData();
+  for (unsigned int line = 0; line < nbLines; ++line)
+  {
+    const unsigned long long lineOffset = (firstLine + line) * m_Layout.LineStride + firstColumn * m_Layout.PixelStride;
+    unsigned char*           out        = p + static_cast<unsigned long long>(line) * nbColumns * pixelSize;
+    if (interleaved)
+    {
+      std::memcpy(out, data + m_Layout.BandOffsets[0] + lineOffset, nbColumns * pixelSize);
+    }
+    else
+    {
+      for (unsigned int band = 0; band < nbBands; ++band)
+      {
+        CopySamples(data + m_Layout.BandOffsets[band] + lineOffset, m_Layout.PixelStride, out + band * sampleSize, pixelSize, nbColumns, sampleSize);
+      }
+    }
+  }
+
+  chrono.Stop();
+  otbLogMacro(Debug, << "Mapped read took " << chrono.GetElapsedMilliseconds() << " ms")
+}
+
+void MappedImageIO::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Mappable : " << m_Mappable << "\n";
+  os << indent << "Data file : " << m_Layout.FileName << "\n";
+  os << indent << "Pixel stride : " << m_Layout.PixelStride << "\n";
+  os << indent << "Line stride : " << m_Layout.LineStride << "\n";
+}
+
+} // end namespace otb
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMappedImageIOFactory.h"
+
+#include "itkCreateObjectFunction.h"
+#include "otbMappedImageIO.h"
+#include "itkVersion.h"
+
+namespace otb
+{
+
+MappedImageIOFactory::MappedImageIOFactory()
+{
+  this->RegisterOverride("otbImageIOBase", "otbMappedImageIO", "Memory mapped Image IO", 1, itk::CreateObjectFunction<MappedImageIO>::New());
+}
+
+MappedImageIOFactory::~MappedImageIOFactory()
+{
+}
+
+const char* MappedImageIOFactory::GetITKSourceVersion(void) const
+{
+  return ITK_SOURCE_VERSION;
+}
+
+const char* MappedImageIOFactory::GetDescription() const
+{
+  return "Mapped ImageIO Factory, enabling loading uncompressed raw, ENVI and GeoTIFF images through a memory mapping in OTB";
+}
+
+// Undocumented API used to register during static initialization.
+// DO NOT CALL DIRECTLY.
+
+static bool MappedImageIOFactoryHasBeenRegistered;
+
+void MappedImageIOFactoryRegister__Private(void)
+{
+  if (!MappedImageIOFactoryHasBeenRegistered)
+  {
+    MappedImageIOFactoryHasBeenRegistered = true;
+    MappedImageIOFactory::RegisterOneFactory();
+  }
+}
+} // end namespace otb
@@ -19,6 +19,8 @@
  */
 
 
+#include <vector>
+
 #include "itkMacro.h"
 #include "otbDEMHandler.h"
 
@@ -102,6 +104,51 @@ int otbDEMHandlerTest(int argc, char* argv[])
     fail = true;
   }
 
+  // The batch queries must give the same heights as the single point ones,
+  // including around the tested point
+  const std::vector<double> lons = {longitude, longitude + 0.001, longitude - 0.0137, longitude};
+  const std::vector<double> lats = {latitude, latitude - 0.0021, latitude + 0.0042, latitude};
+  std::vector<double>       batchHeights(lons.size());
+  if (aboveMSL)
+  {
+    demHandler.GetHeightAboveMSL(lons.size(), lons.data(), lats.data(), batchHeights.data());
+  }
+  else
+  {
+    demHandler.GetHeightAboveEllipsoid(lons.size(), lons.data(), lats.data(), batchHeights.data());
+  }
+  for (std::size_t i = 0; i < lons.size(); ++i)
+  {
+    const double single = aboveMSL ? demHandler.GetHeightAboveMSL(lons[i], lats[i]) : demHandler.GetHeightAboveEllipsoid(lons[i], lats[i]);
+    if (std::abs(batchHeights[i] - single) > 1e-9)
+    {
+      std::cerr << "Batch query gives " << batchHeights[i] << " meters at (" << lons[i] << ", " << lats[i] << "), single point query gives " << single
+                << " meters" << std::endl;
+      fail = true;
+    }
+  }
+
+  // Heights interpolated in a preloaded area must stay close to the
+  // computed ones
+  if (!aboveMSL)
+  {
+    if (demHandler.PreloadArea(longitude - 0.05, latitude - 0.05, longitude + 0.05, latitude + 0.05))
+    {
+      const double preloaded = demHandler.GetHeightAboveEllipsoid(point);
+      if (std::abs(preloaded - height) > tolerance)
+      {
+        std::cerr << "Height in the preloaded area is " << preloaded << " meters, computed height is " << height << " meters" << std::endl;
+        fail = true;
+      }
+      demHandler.ClearPreloadedArea();
+    }
+    if (demHandler.HasPreloadedArea())
+    {
+      std::cerr << "ClearPreloadedArea didn't release the preloaded area" << std::endl;
+      fail = true;
+    }
+  }
+
   double error = std::abs(height - target);
 
   if (error > tolerance)
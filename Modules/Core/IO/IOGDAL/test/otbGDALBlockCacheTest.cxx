@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <iostream>
+#include <vector>
+
+#include "otbGDALImageIO.h"
+#include "otbGDALBlockCache.h"
+
+// Read the same region with two GDALImageIO: the second read must be served
+// by the block cache, and produce the same pixels
+int otbGDALBlockCacheTest(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <input image>" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  otb::GDALBlockCache& blockCache = otb::GDALBlockCache::GetInstance();
+  blockCache.SetMaximumSize(64 * 1024 * 1024);
+  blockCache.Clear();
+  blockCache.ResetStatistics();
+
+  std::vector<std::vector<unsigned char>> buffers(2);
+  for (unsigned int i = 0; i < buffers.size(); ++i)
+  {
+    otb::GDALImageIO::Pointer io = otb::GDALImageIO::New();
+    if (!io->CanReadFile(argv[1]))
+    {
+      std::cerr << "Unable to read " << argv[1] << std::endl;
+      return EXIT_FAILURE;
+    }
+    io->SetFileName(argv[1]);
+    io->ReadImageInformation();
+
+    // A region which does not start on a block boundary
+    itk::ImageIORegion region(2);
+    region.SetIndex(0, io->GetDimensions(0) / 3);
+    region.SetIndex(1, io->GetDimensions(1) / 3);
+    region.SetSize(0, io->GetDimensions(0) / 2);
+    region.SetSize(1, io->GetDimensions(1) / 2);
+    io->SetIORegion(region);
+
+    buffers[i].resize(region.GetNumberOfPixels() * io->GetNumberOfComponents() * io->GetComponentSize());
+    io->Read(buffers[i].data());
+
+    if (i == 0 && (blockCache.GetNumberOfHits() != 0 || blockCache.GetNumberOfMisses() == 0))
+    {
+      std::cerr << "The first read should only miss the cache" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (blockCache.GetNumberOfHits() != blockCache.GetNumberOfMisses())
+  {
+    std::cerr << "The second read should hit the cache for every block: " << blockCache.GetNumberOfHits() << " hits, " << blockCache.GetNumberOfMisses()
+              << " misses" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (buffers[0] != buffers[1])
+  {
+    std::cerr << "Pixels read through the cache differ from the decoded ones" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  blockCache.SetMaximumSize(0);
+  return EXIT_SUCCESS;
+}
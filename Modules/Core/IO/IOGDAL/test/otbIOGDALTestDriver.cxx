@@ -36,4 +36,6 @@ void RegisterTests()
   REGISTER_TEST(otbDEMHandlerTest);
   REGISTER_TEST(otbGDALRPCTransformerTest);
   REGISTER_TEST(otbGDALRPCTransformerTest2);
+  REGISTER_TEST(otbGDALBlockCacheTest);
+  REGISTER_TEST(otbMappedImageIOTest);
 }
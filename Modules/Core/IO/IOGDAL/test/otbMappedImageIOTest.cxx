@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "otbGDALImageIO.h"
+#include "otbMappedImageIO.h"
+#include "otbGDALDriverManagerWrapper.h"
+
+#include "gdal_priv.h"
+
+namespace
+{
+// Read region with io, returns the pixels
+std::vector<unsigned char> ReadRegion(otb::GDALImageIO* io, const itk::ImageIORegion& region)
+{
+  io->SetIORegion(region);
+  std::vector<unsigned char> buffer(region.GetNumberOfPixels() * io->GetNumberOfComponents() * io->GetComponentSize());
+  io->Read(buffer.data());
+  return buffer;
+}
+
+// Copy the input in fileName with the driver and options, then check that
+// MappedImageIO reads the same pixels as GDALImageIO
+bool CheckMappedRead(GDALDataset* input, const char* driverName, const std::string& fileName, const char* interleave, bool expectInPlace,
+                     const char* compress = nullptr)
+{
+  GDALDriver* driver  = GetGDALDriverManager()->GetDriverByName(driverName);
+  char**      options = CSLSetNameValue(nullptr, "INTERLEAVE", interleave);
+  if (compress != nullptr)
+  {
+    options = CSLSetNameValue(options, "COMPRESS", compress);
+  }
+  GDALDataset* copy   = driver->CreateCopy(fileName.c_str(), input, FALSE, options, nullptr, nullptr);
+  CSLDestroy(options);
+  if (copy == nullptr)
+  {
+    std::cerr << "Unable to write " << fileName << std::endl;
+    return false;
+  }
+  GDALClose(copy);
+
+  otb::MappedImageIO::Pointer mappedIO = otb::MappedImageIO::New();
+  otb::GDALImageIO::Pointer   gdalIO   = otb::GDALImageIO::New();
+  if (!mappedIO->CanReadFile(fileName.c_str()) || !gdalIO->CanReadFile(fileName.c_str()))
+  {
+    std::cerr << "MappedImageIO can not read " << fileName << std::endl;
+    return false;
+  }
+  mappedIO->SetFileName(fileName);
+  mappedIO->ReadImageInformation();
+  gdalIO->SetFileName(fileName);
+  gdalIO->ReadImageInformation();
+
+  // Whole lines, then a region starting inside a line
+  itk::ImageIORegion lines(2);
+  lines.SetIndex(0, 0);
+  lines.SetIndex(1, mappedIO->GetDimensions(1) / 4);
+  lines.SetSize(0, mappedIO->GetDimensions(0));
+  lines.SetSize(1, mappedIO->GetDimensions(1) / 2);
+
+  itk::ImageIORegion inner(2);
+  inner.SetIndex(0, mappedIO->GetDimensions(0) / 3);
+  inner.SetIndex(1, mappedIO->GetDimensions(1) / 3);
+  inner.SetSize(0, mappedIO->GetDimensions(0) / 2);
+  inner.SetSize(1, mappedIO->GetDimensions(1) / 2);
+
+  for (const auto& region : {lines, inner})
+  {
+    const std::vector<unsigned char> expected = ReadRegion(gdalIO, region);
+    if (ReadRegion(mappedIO, region) != expected)
+    {
+      std::cerr << "MappedImageIO and GDALImageIO read different pixels in " << fileName << std::endl;
+      return false;
+    }
+  }
+
+  mappedIO->SetIORegion(lines);
+  otb::MappedImageIO::MappedFilePointerType mapping;
+  unsigned char*                            pixels = static_cast<unsigned char*>(mappedIO->GetIORegionPointer(mapping));
+  if ((pixels != nullptr) != expectInPlace)
+  {
+    std::cerr << "Lines of " << fileName << (expectInPlace ? " should" : " should not") << " be referenced in place" << std::endl;
+    return false;
+  }
+  if (pixels == nullptr)
+  {
+    return true;
+  }
+  const std::vector<unsigned char> expected = ReadRegion(gdalIO, lines);
+  if (std::memcmp(pixels, expected.data(), expected.size()) != 0)
+  {
+    std::cerr << "Pixels referenced in the mapping of " << fileName << " are wrong" << std::endl;
+    return false;
+  }
+
+  // Pixels written in place, as by an in place filter, must not be seen by
+  // the next reads of the same lines
+  std::memset(pixels, 0xFF, expected.size());
+  otb::MappedImageIO::MappedFilePointerType otherMapping;
+  const void*                               otherPixels = mappedIO->GetIORegionPointer(otherMapping);
+  if (ReadRegion(mappedIO, lines) != expected || otherPixels == nullptr || std::memcmp(otherPixels, expected.data(), expected.size()) != 0)
+  {
+    std::cerr << "Pixels written in the mapping of " << fileName << " are seen by the next reads" << std::endl;
+    return false;
+  }
+  return true;
+}
+} // end anonymous namespace
+
+int otbMappedImageIOTest(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " <input multiband image> <output prefix>" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Registers the GDAL drivers
+  otb::GDALDriverManagerWrapper::GetInstance();
+
+  GDALDataset* input = static_cast<GDALDataset*>(GDALOpen(argv[1], GA_ReadOnly));
+  if (input == nullptr || input->GetRasterCount() < 2)
+  {
+    std::cerr << "Unable to read a multiband image from " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string prefix = argv[2];
+  const bool        success = CheckMappedRead(input, "ENVI", prefix + "_bip.img", "BIP", true) &&
+                       CheckMappedRead(input, "ENVI", prefix + "_bsq.img", "BSQ", false) &&
+                       CheckMappedRead(input, "GTiff", prefix + "_pixel.tif", "PIXEL", true) &&
+                       CheckMappedRead(input, "GTiff", prefix + "_band.tif", "BAND", false) &&
+                       CheckMappedRead(input, "GTiff", prefix + "_deflate.tif", "PIXEL", false, "DEFLATE");
+  GDALClose(input);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
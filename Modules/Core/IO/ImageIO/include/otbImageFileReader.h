@@ -129,6 +129,13 @@ public:
    * Returns: overview info, empty if none.*/
   std::vector<std::string> GetOverviewsInfo();
 
+  /** Get the resolution factor of the coarsest overview having at least
+   * numberOfPixels pixels, to be set with the resol option of the extended
+   * filename. Only the overviews stored in the file are considered. The
+   * size of the output image is the full resolution size.
+   * Returns: 0 if no stored overview has enough pixels. */
+  unsigned int GetOverviewResolutionFactor(unsigned long numberOfPixels);
+
   // Retrieve the real source file name if derived dataset */
   static std::string GetDerivedDatasetSourceFileName(const std::string& filename);
 
@@ -41,6 +41,9 @@
 #include "otbImageMetadataInterfaceFactory.h"
 #include "otbImageCommons.h"
 #include "otbGeomMetadataSupplier.h"
+#include "otbGDALImageIO.h"
+#include "otbMappedImageIO.h"
+#include "otbMappedImportImageContainer.h"
 
 #include "otbMacro.h"
 
@@ -120,16 +123,23 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
 
   typename TOutputImage::Pointer output = this->GetOutput();
 
-  // allocate the output buffer
+  typedef typename TOutputImage::PixelContainer PixelContainerType;
+  typedef MappedImportImageContainer<typename PixelContainerType::ElementIdentifier, typename PixelContainerType::Element> MappedPixelContainerType;
+
+  // An output which referenced a mapped file gets a buffer of its own again
+  if (dynamic_cast<MappedPixelContainerType*>(output->GetPixelContainer()) != nullptr)
+  {
+    output->SetPixelContainer(PixelContainerType::New());
+  }
+
+  // The output buffer is allocated, or referenced, once the IORegion is known
   output->SetBufferedRegion(output->GetRequestedRegion());
-  output->Allocate();
 
   // Raise an exception if the file could not be opened
   // i.e. if this->m_ImageIO is Null
   this->TestValidImageIO();
 
   // Tell the ImageIO to read the file
-  OutputImagePixelType* buffer = output->GetPixelContainer()->GetBufferPointer();
   this->m_ImageIO->SetFileName(this->m_FileName);
 
   itk::ImageIORegion ioRegion(TOutputImage::ImageDimension);
@@ -180,15 +190,52 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   typedef otb::DefaultConvertPixelTraits<typename TOutputImage::IOPixelType> ConvertIOPixelTraits;
   typedef otb::DefaultConvertPixelTraits<typename TOutputImage::PixelType>   ConvertOutputPixelTraits;
 
+  const bool isVectorImage = strcmp(output->GetNameOfClass(), "VectorImage") == 0;
+
   if (this->m_ImageIO->GetComponentTypeInfo() == typeid(typename ConvertOutputPixelTraits::ComponentType) &&
       (this->m_ImageIO->GetNumberOfComponents() == ConvertIOPixelTraits::GetNumberOfComponents()) && !m_FilenameHelper->BandRangeIsSet())
   {
+    // Reference the pixels in place when the file is memory mapped with
+    // the layout of the output buffer
+    MappedImageIO* mappedImageIO = dynamic_cast<MappedImageIO*>(this->m_ImageIO.GetPointer());
+    if (mappedImageIO != nullptr)
+    {
+      MappedImageIO::MappedFilePointerType regionMapping;
+      void*                                mappedPixels = mappedImageIO->GetIORegionPointer(regionMapping);
+      if (mappedPixels != nullptr)
+      {
+        const typename PixelContainerType::ElementIdentifier nbElements =
+            output->GetBufferedRegion().GetNumberOfPixels() * (isVectorImage ? output->GetNumberOfComponentsPerPixel() : 1);
+        typename MappedPixelContainerType::Pointer container = MappedPixelContainerType::New();
+        container->SetMappedPointer(static_cast<typename PixelContainerType::Element*>(mappedPixels), nbElements, regionMapping);
+        output->SetPixelContainer(container);
+        otbLogMacro(Debug, << "Output of the reader references the memory mapped file " << this->m_FileName);
+        return;
+      }
+    }
+
     // Have the ImageIO read directly into the allocated buffer
-    this->m_ImageIO->Read(buffer);
+    output->Allocate();
+    this->m_ImageIO->Read(output->GetPixelContainer()->GetBufferPointer());
     return;
   }
   else // a type conversion is necessary
   {
+    output->Allocate();
+    OutputImagePixelType* buffer = output->GetPixelContainer()->GetBufferPointer();
+
+    // GDAL can cast the pixels and select the bands while reading
+    // directly into the allocated buffer
+    GDALImageIO* gdalImageIO = dynamic_cast<GDALImageIO*>(this->m_ImageIO.GetPointer());
+    if (gdalImageIO != nullptr)
+    {
+      const unsigned int nbComponents = isVectorImage ? output->GetNumberOfComponentsPerPixel() : ConvertOutputPixelTraits::GetNumberOfComponents();
+      if (gdalImageIO->ReadWithLayout(buffer, typeid(typename ConvertOutputPixelTraits::ComponentType), nbComponents, m_BandList))
+      {
+        return;
+      }
+    }
+
     // note: char is used here because the buffer is read in bytes
     // regardless of the actual type of the pixels.
     ImageRegionType region = output->GetBufferedRegion();
@@ -661,6 +708,40 @@ std::vector<std::string> ImageFileReader<TOutputImage, ConvertPixelTraits>::GetO
   return this->m_ImageIO->GetOverviewsInfo();
 }
 
+template <class TOutputImage, class ConvertPixelTraits>
+unsigned int ImageFileReader<TOutputImage, ConvertPixelTraits>::GetOverviewResolutionFactor(unsigned long numberOfPixels)
+{
+  this->UpdateOutputInformation();
+
+  // Only the overviews stored in the file are used: GDAL would compute the
+  // other ones from the full resolution
+  const GDALImageIO* gdalImageIO = dynamic_cast<const GDALImageIO*>(this->m_ImageIO.GetPointer());
+  if (gdalImageIO == nullptr)
+  {
+    return 0;
+  }
+
+  // Overview r is read with a size of ceil(size / 2^r)
+  const unsigned int overviewsCount = gdalImageIO->GetStoredOverviewsCount() + 1;
+  const auto         size           = this->GetOutput()->GetLargestPossibleRegion().GetSize();
+
+  unsigned int resolutionFactor = 0;
+  for (unsigned int resolution = 1; resolution < overviewsCount; ++resolution)
+  {
+    unsigned long overviewPixels = 1;
+    for (unsigned int i = 0; i < TOutputImage::ImageDimension; ++i)
+    {
+      overviewPixels *= (size[i] + (1UL << resolution) - 1) >> resolution;
+    }
+    if (overviewPixels < numberOfPixels)
+    {
+      break;
+    }
+    resolutionFactor = resolution;
+  }
+  return resolutionFactor;
+}
+
 template <class TOutputImage, class ConvertPixelTraits>
 void ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(void* inputData, size_t numberOfPixels)
 {
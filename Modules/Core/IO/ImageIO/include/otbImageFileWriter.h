@@ -28,11 +28,21 @@
 #include "otbExtendedFilenameToWriterOptions.h"
 #include "itkFastMutexLock.h"
 #include <string>
+#include <map>
+#include <vector>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <exception>
 #include "OTBImageIOExport.h"
 
 namespace otb
 {
 
+class MultiImageFileWriter;
+
 /** \class ImageFileWriter
  * \brief Writes image data to a single file with streaming process.
  *
@@ -50,6 +60,21 @@ namespace otb
  * ImageFileWriter will write directly the streaming buffer in the image file, so
  * that the output image never needs to be completely allocated
  *
+ * When the number of stream buffers is greater than 1 (see
+ * SetNumberOfStreamBuffers() or the streaming:buffers extended filename
+ * option), each computed piece is copied into its own buffer and handed to a
+ * dedicated writer thread, so that the ImageIO writes piece N while the
+ * upstream pipeline computes piece N+1. At most NumberOfStreamBuffers-1
+ * pieces are pending or being written at any time.
+ *
+ * When a pipeline factory is set (see SetPipelineFactory()) and the number
+ * of concurrent splits is greater than 1, the writer builds that many
+ * independent clones of the upstream pipeline and evaluates several pieces
+ * at the same time, one per clone. The pieces are written in order by the
+ * writer thread. The streaming manager divides the available RAM between the
+ * concurrent splits so that the memory print of the pipelines stays within
+ * budget.
+ *
  * ImageFileWriter supports extended filenames, which allow controlling
  * some properties of the output file. See
  * http://wiki.orfeo-toolbox.org/index.php/ExtendedFileName for more
@@ -162,6 +187,59 @@ public:
    *   is set from the CMake configuration option */
   void SetAutomaticAdaptativeStreaming(unsigned int availableRAM = 0, double bias = 1.0);
 
+  /**  Set the streaming mode to 'measured' and configure the number of MB
+   *   available. The first strips are computed from the estimated memory
+   *   consumption of the pipeline, then the remaining strips are re-planned
+   *   from the memory actually consumed by the first numberOfProbeSplits
+   *   strips.
+   *   Setting the availableRAM parameter to 0 means that the available RAM
+   *   is set from the CMake configuration option */
+  void SetAutomaticMeasuredStreaming(unsigned int availableRAM = 0, double bias = 1.0, unsigned int numberOfProbeSplits = 1);
+
+  /**  Set the streaming mode to 'block aligned' and configure the number of
+   *   MB available. The splits are chosen to minimize the number of blocks
+   *   of the pipeline input files decoded several times, taking into account
+   *   the halos requested by the filters.
+   *   Setting the availableRAM parameter to 0 means that the available RAM
+   *   is set from the CMake configuration option */
+  void SetAutomaticBlockAlignedStreaming(unsigned int availableRAM = 0, double bias = 1.0);
+
+  /** Set the number of stream buffers used to overlap computation and
+   *  writing. A value of 0 or 1 (default) keeps the synchronous behaviour:
+   *  each piece is written before the next one is computed. A value of N > 1
+   *  lets up to N-1 computed pieces wait for (or be in) the write while the
+   *  pipeline computes the next one. Each pending piece costs one copy of the
+   *  streamed region in memory. */
+  itkSetMacro(NumberOfStreamBuffers, unsigned int);
+  itkGetConstMacro(NumberOfStreamBuffers, unsigned int);
+
+  /** An independent clone of the upstream pipeline: its output image, and
+   *  the objects to keep alive while the output is updated (filters are
+   *  only weakly referenced by their outputs) */
+  struct PipelineCloneType
+  {
+    InputImagePointer                      Output;
+    std::vector<itk::LightObject::Pointer> Holders;
+  };
+
+  /** Function building a new clone of the upstream pipeline. The output of
+   *  each clone must have the same largest possible region as the input of
+   *  the writer. Clones must not share any filter or reader. */
+  typedef std::function<PipelineCloneType()> PipelineFactoryType;
+
+  /** Set the factory used to build pipeline clones for concurrent splits */
+  void SetPipelineFactory(const PipelineFactoryType& factory)
+  {
+    m_PipelineFactory = factory;
+    this->Modified();
+  }
+
+  /** Set the number of splits evaluated concurrently, each one by its own
+   *  pipeline clone. Only used when a pipeline factory is set. Default is 1
+   *  (no concurrent splits). */
+  itkSetMacro(NumberOfConcurrentSplits, unsigned int);
+  itkGetConstMacro(NumberOfConcurrentSplits, unsigned int);
+
   /** Set the only input of the writer */
   using Superclass::SetInput;
   virtual void SetInput(const InputImageType* input);
@@ -220,6 +298,9 @@ protected:
   void GenerateOutputInformation(void) override;
 
 private:
+  /** The multi-writer drives the pipeline and the stream buffers itself */
+  friend class MultiImageFileWriter;
+
   ImageFileWriter(const ImageFileWriter&) = delete;
   void operator=(const ImageFileWriter&) = delete;
 
@@ -244,6 +325,62 @@ private:
     this->UpdateProgress((m_DivisionProgress + m_CurrentDivision) / m_NumberOfDivisions);
   }
 
+  /** Set the pixel type and number of components of the ImageIO from the
+   *  input, and resolve the band range if any */
+  void ConfigureImageIOPixelType();
+
+  /** Copy the ioRegion of the input into a newly allocated buffer, large
+   *  enough to hold the band remapping if any */
+  InputImagePointer CopyToStreamBuffer(const InputImageType* input, const InputImageRegionType& ioRegion);
+
+  /** Send the buffer to the ImageIO, after the band remapping if any */
+  void WriteStreamBuffer(void* dataPtr, size_t numberOfPixels);
+
+  /** A computed piece waiting to be written by the writer thread */
+  struct StreamBufferType
+  {
+    InputImagePointer  Image;
+    itk::ImageIORegion IORegion;
+  };
+
+  /** Hand a computed piece over to the writer thread. Blocks while the
+   *  maximum number of buffers is in flight, unless the piece is the next
+   *  one to be written */
+  void EnqueueStreamBuffer(unsigned int division, const InputImageType* image, const itk::ImageIORegion& ioRegion);
+
+  /** Body of the writer thread: write the stream buffers in division order
+   *  until the queue is closed and empty */
+  void AsynchronousWriteLoop();
+
+  /** Close the queue and wait for the writer thread. Rethrow any exception
+   *  raised during writing */
+  void FinishAsynchronousWrite();
+
+  /** Compute and write the pieces with several pipeline clones */
+  void ConcurrentStreaming();
+
+  /** Body of a concurrent split thread: compute the next pieces with the
+   *  given pipeline clone until there is none left */
+  void ConcurrentStreamingLoop(PipelineCloneType& clone, std::exception_ptr& error);
+
+  unsigned int                             m_NumberOfStreamBuffers;
+  std::map<unsigned int, StreamBufferType> m_StreamBuffers;
+  unsigned int                             m_NextDivisionToWrite;
+  unsigned int                             m_NumberOfWrittenDivisions;
+  unsigned int                             m_MaximumStreamBuffersInFlight;
+  unsigned int                             m_StreamBuffersInFlight;
+  bool                                     m_StreamBufferQueueClosed;
+  std::exception_ptr                       m_AsynchronousWriteError;
+  std::mutex                               m_StreamBufferMutex;
+  std::condition_variable                  m_StreamBufferCondition;
+  std::thread                              m_WriterThread;
+
+  unsigned int                      m_NumberOfConcurrentSplits;
+  PipelineFactoryType               m_PipelineFactory;
+  std::vector<InputImageRegionType> m_Splits;
+  std::atomic<unsigned int>         m_NextDivisionToCompute;
+  unsigned int                      m_RunningConcurrentSplits;
+
   unsigned int m_NumberOfDivisions;
   unsigned int m_CurrentDivision;
   float        m_DivisionProgress;
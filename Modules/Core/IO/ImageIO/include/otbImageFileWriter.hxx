@@ -45,12 +45,16 @@
 #include "otbTileDimensionTiledStreamingManager.h"
 #include "otbRAMDrivenTiledStreamingManager.h"
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbRAMMeasuredStrippedStreamingManager.h"
+#include "otbRAMDrivenBlockAlignedStreamingManager.h"
 
 #include "otb_boost_tokenizer_header.h"
 
 #include "otbStringUtils.h"
 #include "otbUtils.h"
 
+#include <algorithm>
+
 namespace otb
 {
 
@@ -59,7 +63,16 @@ namespace otb
  */
 template <class TInputImage>
 ImageFileWriter<TInputImage>::ImageFileWriter()
-  : m_NumberOfDivisions(0),
+  : m_NumberOfStreamBuffers(1),
+    m_NextDivisionToWrite(0),
+    m_NumberOfWrittenDivisions(0),
+    m_MaximumStreamBuffersInFlight(0),
+    m_StreamBuffersInFlight(0),
+    m_StreamBufferQueueClosed(false),
+    m_NumberOfConcurrentSplits(1),
+    m_NextDivisionToCompute(0),
+    m_RunningConcurrentSplits(0),
+    m_NumberOfDivisions(0),
     m_CurrentDivision(0),
     m_DivisionProgress(0.0),
     m_UserSpecifiedImageIO(true),
@@ -89,6 +102,16 @@ ImageFileWriter<TInputImage>::ImageFileWriter()
 template <class TInputImage>
 ImageFileWriter<TInputImage>::~ImageFileWriter()
 {
+  if (m_WriterThread.joinable())
+  {
+    try
+    {
+      this->FinishAsynchronousWrite();
+    }
+    catch (...)
+    {
+    }
+  }
 }
 
 template <class TInputImage>
@@ -157,6 +180,27 @@ void ImageFileWriter<TInputImage>::SetAutomaticAdaptativeStreaming(unsigned int
   m_StreamingManager = streamingManager;
 }
 
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::SetAutomaticMeasuredStreaming(unsigned int availableRAM, double bias, unsigned int numberOfProbeSplits)
+{
+  typedef RAMMeasuredStrippedStreamingManager<TInputImage>  RAMMeasuredStrippedStreamingManagerType;
+  typename RAMMeasuredStrippedStreamingManagerType::Pointer streamingManager = RAMMeasuredStrippedStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(availableRAM);
+  streamingManager->SetBias(bias);
+  streamingManager->SetNumberOfProbeSplits(numberOfProbeSplits);
+  m_StreamingManager = streamingManager;
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::SetAutomaticBlockAlignedStreaming(unsigned int availableRAM, double bias)
+{
+  typedef RAMDrivenBlockAlignedStreamingManager<TInputImage>  RAMDrivenBlockAlignedStreamingManagerType;
+  typename RAMDrivenBlockAlignedStreamingManagerType::Pointer streamingManager = RAMDrivenBlockAlignedStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(availableRAM);
+  streamingManager->SetBias(bias);
+  m_StreamingManager = streamingManager;
+}
+
 /**
  *
  */
@@ -179,6 +223,10 @@ void ImageFileWriter<TInputImage>::PrintSelf(std::ostream& os, itk::Indent inden
 
   os << indent << "IO Region: " << m_IORegion << "\n";
 
+  os << indent << "Number of stream buffers: " << m_NumberOfStreamBuffers << "\n";
+
+  os << indent << "Number of concurrent splits: " << m_NumberOfConcurrentSplits << (m_PipelineFactory ? "\n" : " (no pipeline factory)\n");
+
   if (m_UseCompression)
   {
     os << indent << "Compression: On\n";
@@ -355,6 +403,32 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
         this->SetNumberOfLinesStrippedStreaming(sizevalue);
       }
     }
+    else if (type == "measured")
+    {
+      if (sizemode != "auto")
+      {
+        otbLogMacro(Warning, << "In measured streaming type, the sizemode option will be ignored.");
+      }
+      if (sizevalue == 0)
+      {
+        otbLogMacro(Warning, << "sizemode is auto but sizevalue is 0. Value will be fetched from the OTB_MAX_RAM_HINT environment variable if set, or else use "
+                                "the default value");
+      }
+      this->SetAutomaticMeasuredStreaming(sizevalue);
+    }
+    else if (type == "blockaligned")
+    {
+      if (sizemode != "auto")
+      {
+        otbLogMacro(Warning, << "In blockaligned streaming type, the sizemode option will be ignored.");
+      }
+      if (sizevalue == 0)
+      {
+        otbLogMacro(Warning, << "sizemode is auto but sizevalue is 0. Value will be fetched from the OTB_MAX_RAM_HINT environment variable if set, or else use "
+                                "the default value");
+      }
+      this->SetAutomaticBlockAlignedStreaming(sizevalue);
+    }
     else if (type == "none")
     {
       if (sizemode != "" || sizevalue != 0)
@@ -376,6 +450,11 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
     }
   }
 
+  if (m_FilenameHelper->StreamingBuffersIsSet())
+  {
+    this->SetNumberOfStreamBuffers(m_FilenameHelper->GetStreamingBuffers());
+  }
+
   /** Prepare ImageIO  : create ImageFactory */
 
   if (m_FileName == "")
@@ -421,7 +500,8 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
 
   // Manage extended filename
   if ((strcmp(m_ImageIO->GetNameOfClass(), "GDALImageIO") == 0) &&
-      (m_FilenameHelper->gdalCreationOptionsIsSet() || m_FilenameHelper->WriteRPCTagsIsSet() || m_FilenameHelper->NoDataValueIsSet() || m_FilenameHelper->SrsValueIsSet()))
+      (m_FilenameHelper->gdalCreationOptionsIsSet() || m_FilenameHelper->WriteRPCTagsIsSet() || m_FilenameHelper->CloudOptimizedGeoTIFFIsSet() ||
+       m_FilenameHelper->NoDataValueIsSet() || m_FilenameHelper->SrsValueIsSet()))
   {
     typename GDALImageIO::Pointer imageIO = dynamic_cast<GDALImageIO*>(m_ImageIO.GetPointer());
 
@@ -436,6 +516,7 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
 
     imageIO->SetOptions(m_FilenameHelper->GetgdalCreationOptions());
     imageIO->SetWriteRPCTags(m_FilenameHelper->GetWriteRPCTags());
+    imageIO->SetWriteCloudOptimizedGeoTIFF(m_FilenameHelper->GetCloudOptimizedGeoTIFF());
     if (m_FilenameHelper->NoDataValueIsSet())
       imageIO->SetNoDataList(m_FilenameHelper->GetNoDataList());
     if  (m_FilenameHelper->SrsValueIsSet())
@@ -514,6 +595,9 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
     otbLogMacro(Debug, << "Buffered region is the largest possible region, there is no need for streaming.");
     this->SetNumberOfDivisionsStrippedStreaming(1);
   }
+
+  // Each concurrent split gets its share of the available RAM
+  m_StreamingManager->SetNumberOfConcurrentSplits(m_PipelineFactory ? std::max(m_NumberOfConcurrentSplits, 1U) : 1U);
   m_StreamingManager->PrepareStreaming(inputPtr, inputRegion);
   m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
 
@@ -611,34 +695,109 @@ void ImageFileWriter<TInputImage>::Update()
     otbLogMacro(Warning, << "Could not get the source process object. Progress report might be buggy");
   }
 
+  /**
+   * When several stream buffers are allowed, the pieces are handed over to a
+   * writer thread so that writing overlaps the computation of the next piece.
+   * There is nothing to overlap with a single piece. Concurrent splits always
+   * go through the writer thread, which restores the order of the pieces.
+   */
+  const bool concurrentStreaming = (m_NumberOfConcurrentSplits > 1) && (m_NumberOfDivisions > 1) && m_PipelineFactory;
+  const bool asynchronousWrite   = concurrentStreaming || ((m_NumberOfStreamBuffers > 1) && (m_NumberOfDivisions > 1));
+
+  if (asynchronousWrite)
+  {
+    otbLogMacro(Debug, << "Asynchronous writing of " << m_FileName << " with " << m_NumberOfStreamBuffers << " stream buffers");
+
+    // The ImageIO belongs to the writer thread from now on
+    this->ConfigureImageIOPixelType();
+
+    m_StreamBuffers.clear();
+    m_NextDivisionToWrite          = 0;
+    m_NumberOfWrittenDivisions     = 0;
+    m_MaximumStreamBuffersInFlight = std::max(m_NumberOfStreamBuffers, 1U) - 1;
+    if (concurrentStreaming)
+    {
+      m_MaximumStreamBuffersInFlight += m_NumberOfConcurrentSplits;
+    }
+    m_StreamBuffersInFlight   = 0;
+    m_StreamBufferQueueClosed = false;
+    m_AsynchronousWriteError  = nullptr;
+    m_WriterThread            = std::thread(&Self::AsynchronousWriteLoop, this);
+  }
+
   /**
    * Loop over the number of pieces, execute the upstream pipeline on each
    * piece, and copy the results into the output image.
    */
   InputImageRegionType streamRegion;
 
-  for (m_CurrentDivision = 0; m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
-       m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
+  try
   {
-    streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+    if (concurrentStreaming)
+    {
+      this->ConcurrentStreaming();
+    }
+    else
+    {
+      for (m_CurrentDivision = 0; m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
+           m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
+      {
+        streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
 
-    inputPtr->SetRequestedRegion(streamRegion);
-    inputPtr->PropagateRequestedRegion();
-    inputPtr->UpdateOutputData();
+        inputPtr->SetRequestedRegion(streamRegion);
+        inputPtr->PropagateRequestedRegion();
+        inputPtr->UpdateOutputData();
 
-    // Write the whole image
-    itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
-    for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+        // Write the whole image
+        itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
+        for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+        {
+          ioRegion.SetSize(i, streamRegion.GetSize(i));
+          // Set the ioRegion index using the shifted index ( (0,0 without box parameter))
+          ioRegion.SetIndex(i, streamRegion.GetIndex(i) - m_ShiftOutputIndex[i]);
+        }
+        this->SetIORegion(ioRegion);
+
+        if (asynchronousWrite)
+        {
+          this->EnqueueStreamBuffer(m_CurrentDivision, inputPtr, m_IORegion);
+        }
+        else
+        {
+          m_ImageIO->SetIORegion(m_IORegion);
+
+          // Start writing stream region in the image file
+          this->GenerateData();
+        }
+
+        // The streaming manager may re-plan the next pieces from the memory actually used
+        if (m_StreamingManager->NotifySplitProcessed(m_CurrentDivision))
+        {
+          m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
+        }
+      }
+    }
+  }
+  catch (...)
+  {
+    if (asynchronousWrite)
     {
-      ioRegion.SetSize(i, streamRegion.GetSize(i));
-      // Set the ioRegion index using the shifted index ( (0,0 without box parameter))
-      ioRegion.SetIndex(i, streamRegion.GetIndex(i) - m_ShiftOutputIndex[i]);
+      // The pipeline error takes precedence over any write error
+      try
+      {
+        this->FinishAsynchronousWrite();
+      }
+      catch (...)
+      {
+      }
     }
-    this->SetIORegion(ioRegion);
-    m_ImageIO->SetIORegion(m_IORegion);
+    throw;
+  }
 
-    // Start writing stream region in the image file
-    this->GenerateData();
+  if (asynchronousWrite)
+  {
+    // Wait for the pending pieces to be written
+    this->FinishAsynchronousWrite();
   }
 
   /**
@@ -686,6 +845,53 @@ void ImageFileWriter<TInputImage>::GenerateData(void)
   const InputImageType* input = this->GetInput();
   InputImagePointer     cacheImage;
 
+  this->ConfigureImageIOPixelType();
+
+  // Setup the image IO for writing.
+  //
+  // okay, now extract the data as a raw buffer pointer
+  const void* dataPtr = (const void*)input->GetBufferPointer();
+
+  // check that the image's buffered region is the same as
+  // ImageIO is expecting and we requested
+  InputImageRegionType ioRegion;
+
+  // No shift of the ioRegion from the buffered region is expected
+  itk::ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(m_ImageIO->GetIORegion(), ioRegion, m_ShiftOutputIndex);
+  InputImageRegionType bufferedRegion = input->GetBufferedRegion();
+
+  // before this test, bad stuff would happened when they don't match.
+  // In case of the buffer has not enough components, adapt the region.
+  if ((bufferedRegion != ioRegion) || (m_FilenameHelper->BandRangeIsSet() && (m_IOComponents < m_BandList.size())))
+  {
+    if (m_NumberOfDivisions > 1 || m_UserSpecifiedIORegion)
+    {
+      cacheImage = this->CopyToStreamBuffer(input, ioRegion);
+      dataPtr    = (const void*)cacheImage->GetBufferPointer();
+    }
+    else
+    {
+      itk::ImageFileWriterException e(__FILE__, __LINE__);
+      std::ostringstream            msg;
+      msg << "Did not get requested region!" << std::endl;
+      msg << "Requested:" << std::endl;
+      msg << ioRegion;
+      msg << "Actual:" << std::endl;
+      msg << bufferedRegion;
+      e.SetDescription(msg.str());
+      e.SetLocation(ITK_LOCATION);
+      throw e;
+    }
+  }
+
+  this->WriteStreamBuffer(const_cast<void*>(dataPtr), bufferedRegion.GetNumberOfPixels());
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::ConfigureImageIOPixelType()
+{
+  const InputImageType* input = this->GetInput();
+
   // Make sure that the image is the right type and no more than
   // four components.
   typedef typename InputImageType::PixelType ImagePixelType;
@@ -716,82 +922,272 @@ void ImageFileWriter<TInputImage>::GenerateData(void)
     // Set the pixel and component type; the number of components.
     m_ImageIO->SetPixelTypeInfo(typeid(ImagePixelType));
   }
+}
 
-  // Setup the image IO for writing.
-  //
-  // okay, now extract the data as a raw buffer pointer
-  const void* dataPtr = (const void*)input->GetBufferPointer();
+template <class TInputImage>
+typename ImageFileWriter<TInputImage>::InputImagePointer ImageFileWriter<TInputImage>::CopyToStreamBuffer(const InputImageType*       input,
+                                                                                                          const InputImageRegionType& ioRegion)
+{
+  InputImagePointer cacheImage = InputImageType::New();
+  cacheImage->CopyInformation(input);
 
-  // check that the image's buffered region is the same as
-  // ImageIO is expecting and we requested
-  InputImageRegionType ioRegion;
+  // set number of components at the band range size
+  if (m_FilenameHelper->BandRangeIsSet() && (m_IOComponents < m_BandList.size()))
+  {
+    cacheImage->SetNumberOfComponentsPerPixel(m_BandList.size());
+  }
 
-  // No shift of the ioRegion from the buffered region is expected
-  itk::ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(m_ImageIO->GetIORegion(), ioRegion, m_ShiftOutputIndex);
-  InputImageRegionType bufferedRegion = input->GetBufferedRegion();
+  cacheImage->SetBufferedRegion(ioRegion);
+  cacheImage->Allocate();
 
-  // before this test, bad stuff would happened when they don't match.
-  // In case of the buffer has not enough components, adapt the region.
-  if ((bufferedRegion != ioRegion) || (m_FilenameHelper->BandRangeIsSet() && (m_IOComponents < m_BandList.size())))
+  // set number of components at the initial size
+  if (m_FilenameHelper->BandRangeIsSet() && (m_IOComponents < m_BandList.size()))
   {
-    if (m_NumberOfDivisions > 1 || m_UserSpecifiedIORegion)
-    {
-      cacheImage = InputImageType::New();
-      cacheImage->CopyInformation(input);
+    cacheImage->SetNumberOfComponentsPerPixel(m_IOComponents);
+  }
+
+  typedef itk::ImageRegionConstIterator<TInputImage> ConstIteratorType;
+  typedef itk::ImageRegionIterator<TInputImage>      IteratorType;
+
+  ConstIteratorType in(input, ioRegion);
+  IteratorType      out(cacheImage, ioRegion);
+
+  // copy the data into a buffer to match the ioregion
+  for (in.GoToBegin(), out.GoToBegin(); !in.IsAtEnd(); ++in, ++out)
+  {
+    out.Set(in.Get());
+  }
 
-      // set number of components at the band range size
-      if (m_FilenameHelper->BandRangeIsSet() && (m_IOComponents < m_BandList.size()))
+  return cacheImage;
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::WriteStreamBuffer(void* dataPtr, size_t numberOfPixels)
+{
+  if (m_FilenameHelper->BandRangeIsSet() && (!m_BandList.empty()))
+  {
+    // Adapt the image size with the region and take into account a potential
+    // remapping of the components. m_BandList is empty if no band range is set
+    m_ImageIO->SetNumberOfComponents(m_IOComponents);
+    m_ImageIO->DoMapBuffer(dataPtr, numberOfPixels, this->m_BandList);
+    m_ImageIO->SetNumberOfComponents(m_BandList.size());
+  }
+
+  m_ImageIO->Write(dataPtr);
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::EnqueueStreamBuffer(unsigned int division, const InputImageType* image, const itk::ImageIORegion& ioRegion)
+{
+  InputImageRegionType region;
+  itk::ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(ioRegion, region, m_ShiftOutputIndex);
+
+  // The pipeline output will be overwritten by the next piece: keep a copy
+  StreamBufferType buffer;
+  buffer.Image    = this->CopyToStreamBuffer(image, region);
+  buffer.IORegion = ioRegion;
+
+  // The next piece to write is always accepted when the writer thread is
+  // idle, otherwise it could wait for it forever while the buffers are full
+  // of later pieces
+  std::unique_lock<std::mutex> lock(m_StreamBufferMutex);
+  m_StreamBufferCondition.wait(lock, [this, division] {
+    return (m_StreamBuffersInFlight < m_MaximumStreamBuffersInFlight) || (division == m_NextDivisionToWrite) || m_AsynchronousWriteError;
+  });
+
+  if (m_AsynchronousWriteError)
+  {
+    // The error is kept to be rethrown by FinishAsynchronousWrite() as well
+    std::rethrow_exception(m_AsynchronousWriteError);
+  }
+
+  m_StreamBuffers[division] = std::move(buffer);
+  ++m_StreamBuffersInFlight;
+  lock.unlock();
+  m_StreamBufferCondition.notify_all();
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::AsynchronousWriteLoop()
+{
+  while (true)
+  {
+    unsigned int     division = 0;
+    StreamBufferType buffer;
+    {
+      // Once the queue is closed, no gap can be filled anymore: the
+      // remaining pieces are written in order
+      std::unique_lock<std::mutex> lock(m_StreamBufferMutex);
+      m_StreamBufferCondition.wait(lock, [this] {
+        return (!m_StreamBuffers.empty() && m_StreamBuffers.begin()->first == m_NextDivisionToWrite) || m_StreamBufferQueueClosed;
+      });
+      if (m_StreamBuffers.empty())
       {
-        cacheImage->SetNumberOfComponentsPerPixel(m_BandList.size());
+        return;
       }
+      auto next = m_StreamBuffers.begin();
+      division  = next->first;
+      buffer    = std::move(next->second);
+      m_StreamBuffers.erase(next);
+    }
 
-      cacheImage->SetBufferedRegion(ioRegion);
-      cacheImage->Allocate();
-
-      // set number of components at the initial size
-      if (m_FilenameHelper->BandRangeIsSet() && (m_IOComponents < m_BandList.size()))
+    try
+    {
+      m_ImageIO->SetIORegion(buffer.IORegion);
+      this->WriteStreamBuffer(buffer.Image->GetBufferPointer(), buffer.Image->GetBufferedRegion().GetNumberOfPixels());
+    }
+    catch (...)
+    {
       {
-        cacheImage->SetNumberOfComponentsPerPixel(m_IOComponents);
+        std::lock_guard<std::mutex> lock(m_StreamBufferMutex);
+        m_AsynchronousWriteError = std::current_exception();
+        m_StreamBuffers.clear();
+        m_StreamBuffersInFlight = 0;
       }
+      m_StreamBufferCondition.notify_all();
+      return;
+    }
 
-      typedef itk::ImageRegionConstIterator<TInputImage> ConstIteratorType;
-      typedef itk::ImageRegionIterator<TInputImage>      IteratorType;
+    // Release the buffer before letting the pipeline allocate a new one
+    buffer.Image = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(m_StreamBufferMutex);
+      --m_StreamBuffersInFlight;
+      ++m_NumberOfWrittenDivisions;
+      m_NextDivisionToWrite = division + 1;
+    }
+    m_StreamBufferCondition.notify_all();
+  }
+}
 
-      ConstIteratorType in(input, ioRegion);
-      IteratorType      out(cacheImage, ioRegion);
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::ConcurrentStreaming()
+{
+  const unsigned int numberOfClones = std::min(m_NumberOfConcurrentSplits, m_NumberOfDivisions);
 
-      // copy the data into a buffer to match the ioregion
-      for (in.GoToBegin(), out.GoToBegin(); !in.IsAtEnd(); ++in, ++out)
-      {
-        out.Set(in.Get());
-      }
+  otbLogMacro(Info, << "File " << m_FileName << " will be computed with " << numberOfClones << " concurrent splits");
 
-      dataPtr = (const void*)cacheImage->GetBufferPointer();
+  // The splits are computed once, the streaming manager is not meant to be
+  // shared between threads
+  m_Splits.clear();
+  for (unsigned int i = 0; i < m_NumberOfDivisions; ++i)
+  {
+    m_Splits.push_back(m_StreamingManager->GetSplit(i));
+  }
+
+  // The clones are built here: opening files while building a pipeline is
+  // not guaranteed to be thread-safe
+  const InputImageRegionType largestRegion = this->GetInput()->GetLargestPossibleRegion();
+  std::vector<PipelineCloneType> clones(numberOfClones);
+  for (auto& clone : clones)
+  {
+    clone = m_PipelineFactory();
+    if (clone.Output.IsNull())
+    {
+      itkExceptionMacro(<< "The pipeline factory returned a clone without output");
     }
-    else
+    clone.Output->UpdateOutputInformation();
+    if (clone.Output->GetLargestPossibleRegion() != largestRegion)
     {
-      itk::ImageFileWriterException e(__FILE__, __LINE__);
-      std::ostringstream            msg;
-      msg << "Did not get requested region!" << std::endl;
-      msg << "Requested:" << std::endl;
-      msg << ioRegion;
-      msg << "Actual:" << std::endl;
-      msg << bufferedRegion;
-      e.SetDescription(msg.str());
-      e.SetLocation(ITK_LOCATION);
-      throw e;
+      itkExceptionMacro(<< "The pipeline factory returned a clone with largest possible region " << clone.Output->GetLargestPossibleRegion()
+                        << " instead of " << largestRegion);
     }
   }
 
-  if (m_FilenameHelper->BandRangeIsSet() && (!m_BandList.empty()))
+  std::vector<std::exception_ptr> errors(numberOfClones);
+  std::vector<std::thread>        threads;
+  m_NextDivisionToCompute   = 0;
+  m_RunningConcurrentSplits = numberOfClones;
+  for (unsigned int i = 0; i < numberOfClones; ++i)
   {
-    // Adapt the image size with the region and take into account a potential
-    // remapping of the components. m_BandList is empty if no band range is set
-    m_ImageIO->DoMapBuffer(const_cast<void*>(dataPtr), bufferedRegion.GetNumberOfPixels(), this->m_BandList);
-    m_ImageIO->SetNumberOfComponents(m_BandList.size());
+    threads.emplace_back(&Self::ConcurrentStreamingLoop, this, std::ref(clones[i]), std::ref(errors[i]));
   }
 
-  m_ImageIO->Write(dataPtr);
+  // Report progress as the pieces get written
+  {
+    std::unique_lock<std::mutex> lock(m_StreamBufferMutex);
+    while (m_RunningConcurrentSplits > 0)
+    {
+      m_StreamBufferCondition.wait(lock);
+      const float progress = static_cast<float>(m_NumberOfWrittenDivisions) / m_NumberOfDivisions;
+      lock.unlock();
+      this->UpdateProgress(progress);
+      lock.lock();
+    }
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  for (const auto& error : errors)
+  {
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::ConcurrentStreamingLoop(PipelineCloneType& clone, std::exception_ptr& error)
+{
+  try
+  {
+    for (unsigned int division = m_NextDivisionToCompute++; division < m_NumberOfDivisions && !this->GetAbortGenerateData();
+         division               = m_NextDivisionToCompute++)
+    {
+      const InputImageRegionType& streamRegion = m_Splits[division];
+
+      clone.Output->SetRequestedRegion(streamRegion);
+      clone.Output->PropagateRequestedRegion();
+      clone.Output->UpdateOutputData();
+
+      itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
+      for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+      {
+        ioRegion.SetSize(i, streamRegion.GetSize(i));
+        ioRegion.SetIndex(i, streamRegion.GetIndex(i) - m_ShiftOutputIndex[i]);
+      }
+
+      this->EnqueueStreamBuffer(division, clone.Output, ioRegion);
+    }
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+    // Stop the other splits as well
+    this->SetAbortGenerateData(true);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_StreamBufferMutex);
+    --m_RunningConcurrentSplits;
+  }
+  m_StreamBufferCondition.notify_all();
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::FinishAsynchronousWrite()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_StreamBufferMutex);
+    m_StreamBufferQueueClosed = true;
+  }
+  m_StreamBufferCondition.notify_all();
+
+  if (m_WriterThread.joinable())
+  {
+    m_WriterThread.join();
+  }
+
+  std::exception_ptr error = m_AsynchronousWriteError;
+  m_AsynchronousWriteError = nullptr;
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
 }
 
 template <class TInputImage>
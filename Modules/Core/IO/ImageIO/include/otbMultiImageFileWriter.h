@@ -28,7 +28,13 @@
 #include "itkImageIOBase.h"
 #include "OTBImageIOExport.h"
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 namespace otb
 {
@@ -42,6 +48,16 @@ namespace otb
  *  is interpreted on the first input to deduce the number of streams. This
  *  number of streams is then used to split the other inputs.
  *
+ *  The pipelines of the inputs are updated one after the other, as they
+ *  usually share upstream filters. When several stream buffers are allowed
+ *  (see SetNumberOfStreamBuffers() or the streaming:buffers extended
+ *  filename option of the inputs), each computed piece is copied into its
+ *  own buffer and handed to the writer thread of its output. Each output is
+ *  written through its own ImageIO, so that the files are written
+ *  concurrently while the pipelines compute the next pieces. The number of
+ *  pieces waiting for (or being in) the write is bounded for all outputs
+ *  together.
+ *
  * \ingroup OTBImageIO
  */
 class OTBImageIO_EXPORT MultiImageFileWriter : public itk::ProcessObject
@@ -113,6 +129,17 @@ public:
    *   is set from the CMake configuration option */
   void SetAutomaticAdaptativeStreaming(unsigned int availableRAM = 0, double bias = 1.0);
 
+  /** Set the number of stream buffers shared by all outputs. A value of 0
+   *  or 1 (default) keeps the synchronous behaviour: the pieces of all
+   *  outputs are written before the next ones are computed. A value of N > 1
+   *  lets up to N-1 computed pieces, all outputs together, wait for (or be
+   *  in) the write while the pipelines compute the next ones. The
+   *  streaming:buffers extended filename option of each input adds its own
+   *  pending pieces to this budget. Each pending piece costs one copy of the
+   *  streamed region of its output in memory. */
+  itkSetMacro(NumberOfStreamBuffers, unsigned int);
+  itkGetConstMacro(NumberOfStreamBuffers, unsigned int);
+
   virtual void UpdateOutputData(itk::DataObject* itkNotUsed(output)) override;
 
   /** Connect a new input to the multi-writer. Only the input pointer is
@@ -239,6 +266,22 @@ private:
 
     virtual itk::ImageRegion<2> GetRegionToWrite() const = 0;
 
+    /** Number of stream buffers requested by the writer of this input */
+    virtual unsigned int GetNumberOfStreamBuffers() const = 0;
+
+    /** Configure the ImageIO before handing it over to the writer thread */
+    virtual void PrepareAsynchronousWrite() = 0;
+
+    /** Update the pipeline of the input on its requested region, and return
+     *  the task writing a copy of inputRegion at streamRegion in the file */
+    virtual std::function<void()> PrepareStreamBuffer(const RegionType& inputRegion, const RegionType& streamRegion) = 0;
+
+    /** Pieces waiting for the writer thread of this input */
+    std::deque<std::function<void()>> m_PendingWrites;
+
+    /** Thread writing the pieces of this input */
+    std::thread m_WriterThread;
+
   protected:
     /** The image on which streaming is performed */
     ImageBaseType::ConstPointer m_InputImage;
@@ -272,6 +315,12 @@ private:
      * of the input image, but this might be overridden by the box extended filename parameter of 
      * the input writer */
     itk::ImageRegion<2> GetRegionToWrite() const override;
+
+    unsigned int GetNumberOfStreamBuffers() const override;
+
+    void PrepareAsynchronousWrite() override;
+
+    std::function<void()> PrepareStreamBuffer(const RegionType& inputRegion, const RegionType& streamRegion) override;
   
   private:
     /** Actual writer for this image */
@@ -286,6 +335,34 @@ private:
   SinkListType                                   m_SinkList;
 
   std::vector<RegionType> m_StreamRegionList;
+
+  /** Returns the current stream region of the given input, in the
+   *  coordinates of its output file */
+  RegionType GetStreamRegionToWrite(int inputIndex);
+
+  /** Start the writer threads, one per input */
+  void StartAsynchronousWrite(unsigned int maximumStreamBuffersInFlight);
+
+  /** Update the pipelines on the current stream regions and hand the
+   *  pieces over to the writer threads. Blocks while the maximum number of
+   *  buffers is in flight */
+  void EnqueueStreamBuffers();
+
+  /** Body of the writer thread of an input: write its pieces in order
+   *  until the queue is closed and empty */
+  void AsynchronousWriteLoop(SinkBase* sink);
+
+  /** Close the queue and wait for the writer threads. Rethrow any exception
+   *  raised during writing */
+  void FinishAsynchronousWrite();
+
+  unsigned int            m_NumberOfStreamBuffers;
+  unsigned int            m_MaximumStreamBuffersInFlight;
+  unsigned int            m_StreamBuffersInFlight;
+  bool                    m_StreamBufferQueueClosed;
+  std::exception_ptr      m_AsynchronousWriteError;
+  std::mutex              m_StreamBufferMutex;
+  std::condition_variable m_StreamBufferCondition;
 };
 
 } // end of namespace otb
@@ -104,6 +104,42 @@ MultiImageFileWriter::Sink<TImage>::GetRegionToWrite() const
   }
 }
 
+template <class TImage>
+unsigned int MultiImageFileWriter::Sink<TImage>::GetNumberOfStreamBuffers() const
+{
+  return m_Writer->GetNumberOfStreamBuffers();
+}
+
+template <class TImage>
+void MultiImageFileWriter::Sink<TImage>::PrepareAsynchronousWrite()
+{
+  // The ImageIO belongs to the writer thread from now on
+  m_Writer->ConfigureImageIOPixelType();
+}
+
+template <class TImage>
+std::function<void()> MultiImageFileWriter::Sink<TImage>::PrepareStreamBuffer(const RegionType& inputRegion, const RegionType& streamRegion)
+{
+  TImage* input = const_cast<TImage*>(m_Writer->GetInput());
+  input->UpdateOutputData();
+
+  // The pipeline output will be overwritten by the next piece: keep a copy
+  typename TImage::Pointer buffer = m_Writer->CopyToStreamBuffer(input, inputRegion);
+
+  itk::ImageIORegion ioRegion(TImage::ImageDimension);
+  for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
+  {
+    ioRegion.SetSize(i, streamRegion.GetSize(i));
+    ioRegion.SetIndex(i, streamRegion.GetIndex(i));
+  }
+
+  otb::ImageFileWriter<TImage>* writer = m_Writer.GetPointer();
+  return [writer, buffer, ioRegion]() {
+    writer->GetImageIO()->SetIORegion(ioRegion);
+    writer->WriteStreamBuffer(buffer->GetBufferPointer(), buffer->GetBufferedRegion().GetNumberOfPixels());
+  };
+}
+
 template <class TWriter>
 void MultiImageFileWriter::AddInputWriter(typename TWriter::Pointer writer)
 {
@@ -26,6 +26,7 @@
 #include "otbConfigure.h"
 
 #include "otbGDALImageIOFactory.h"
+#include "otbMappedImageIOFactory.h"
 
 namespace otb
 {
@@ -80,6 +81,9 @@ void ImageIOFactory::RegisterBuiltInFactories()
     itk::MutexLockHolder<itk::SimpleMutexLock> mutexHolder(mutex);
     if (firstTime)
     {
+      // Registered first: it only accepts the files it can map, the
+      // other ones are read by GDALImageIO
+      itk::ObjectFactoryBase::RegisterFactory(MappedImageIOFactory::New());
       itk::ObjectFactoryBase::RegisterFactory(GDALImageIOFactory::New());
       firstTime = false;
     }
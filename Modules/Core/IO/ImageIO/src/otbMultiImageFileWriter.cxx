@@ -21,10 +21,21 @@
 #include "otbMultiImageFileWriter.h"
 #include "otbImageIOFactory.h"
 
+#include <algorithm>
+
 namespace otb
 {
 
-MultiImageFileWriter::MultiImageFileWriter() : m_NumberOfDivisions(0), m_CurrentDivision(0), m_DivisionProgress(0.0), m_IsObserving(true), m_ObserverID(0)
+MultiImageFileWriter::MultiImageFileWriter()
+  : m_NumberOfDivisions(0),
+    m_CurrentDivision(0),
+    m_DivisionProgress(0.0),
+    m_IsObserving(true),
+    m_ObserverID(0),
+    m_NumberOfStreamBuffers(1),
+    m_MaximumStreamBuffersInFlight(0),
+    m_StreamBuffersInFlight(0),
+    m_StreamBufferQueueClosed(false)
 {
   // By default, we use tiled streaming, with automatic tile size
   // We don't set any parameter, so the memory size is retrieved from the OTB configuration options
@@ -268,48 +279,96 @@ void MultiImageFileWriter::UpdateOutputData(itk::DataObject* itkNotUsed(output))
     }
   }
 
-  for (m_CurrentDivision = 0; m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
-       m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
+  /**
+   * Each input may add its own pending pieces to the shared budget through
+   * the streaming:buffers extended filename option. There is nothing to
+   * overlap with a single piece.
+   */
+  unsigned int maximumStreamBuffersInFlight = std::max(m_NumberOfStreamBuffers, 1U) - 1;
+  for (const auto& sink : m_SinkList)
   {
-    // Update all stream regions
-    for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
-    {
-      m_StreamRegionList[inputIndex] = GetStreamRegion(inputIndex);
-    }
+    maximumStreamBuffersInFlight += std::max(sink->GetNumberOfStreamBuffers(), 1U) - 1;
+  }
+  const bool asynchronousWrite = (maximumStreamBuffersInFlight > 0) && (m_NumberOfDivisions > 1);
 
-    // NOTE : this reset was probably designed to work with the next section
-    // Where the final requested region is the "union" between the computed
-    // requested region and the current requested region.
+  if (asynchronousWrite)
+  {
+    this->StartAsynchronousWrite(maximumStreamBuffersInFlight);
+  }
 
-    // Reset requested regions for all images
-    for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
+  try
+  {
+    for (m_CurrentDivision = 0; m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
+         m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
     {
-      ResetAllRequestedRegions(m_SinkList[inputIndex]->GetInput());
-    }
+      // Update all stream regions
+      for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
+      {
+        m_StreamRegionList[inputIndex] = GetStreamRegion(inputIndex);
+      }
 
-    for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
-    {
-      ImageBaseType::Pointer inputPtr                    = m_SinkList[inputIndex]->GetInput();
-      RegionType             inputRequestedRegion        = m_StreamRegionList[inputIndex];
-      const RegionType&      currentInputRequestedRegion = inputPtr->GetRequestedRegion();
-      if (currentInputRequestedRegion != inputPtr->GetLargestPossibleRegion() && currentInputRequestedRegion.GetNumberOfPixels() != 0)
+      // NOTE : this reset was probably designed to work with the next section
+      // Where the final requested region is the "union" between the computed
+      // requested region and the current requested region.
+
+      // Reset requested regions for all images
+      for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
+      {
+        ResetAllRequestedRegions(m_SinkList[inputIndex]->GetInput());
+      }
+
+      for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
       {
-        IndexType startIndex = currentInputRequestedRegion.GetIndex();
-        IndexType lastIndex  = currentInputRequestedRegion.GetUpperIndex();
-        startIndex[0]        = std::min(startIndex[0], inputRequestedRegion.GetIndex(0));
-        startIndex[1]        = std::min(startIndex[1], inputRequestedRegion.GetIndex(1));
-        lastIndex[0]         = std::max(lastIndex[0], inputRequestedRegion.GetUpperIndex()[0]);
-        lastIndex[1]         = std::max(lastIndex[1], inputRequestedRegion.GetUpperIndex()[1]);
-        inputRequestedRegion.SetIndex(startIndex);
-        inputRequestedRegion.SetUpperIndex(lastIndex);
+        ImageBaseType::Pointer inputPtr                    = m_SinkList[inputIndex]->GetInput();
+        RegionType             inputRequestedRegion        = m_StreamRegionList[inputIndex];
+        const RegionType&      currentInputRequestedRegion = inputPtr->GetRequestedRegion();
+        if (currentInputRequestedRegion != inputPtr->GetLargestPossibleRegion() && currentInputRequestedRegion.GetNumberOfPixels() != 0)
+        {
+          IndexType startIndex = currentInputRequestedRegion.GetIndex();
+          IndexType lastIndex  = currentInputRequestedRegion.GetUpperIndex();
+          startIndex[0]        = std::min(startIndex[0], inputRequestedRegion.GetIndex(0));
+          startIndex[1]        = std::min(startIndex[1], inputRequestedRegion.GetIndex(1));
+          lastIndex[0]         = std::max(lastIndex[0], inputRequestedRegion.GetUpperIndex()[0]);
+          lastIndex[1]         = std::max(lastIndex[1], inputRequestedRegion.GetUpperIndex()[1]);
+          inputRequestedRegion.SetIndex(startIndex);
+          inputRequestedRegion.SetUpperIndex(lastIndex);
+        }
+
+        inputPtr->SetRequestedRegion(inputRequestedRegion);
+        inputPtr->PropagateRequestedRegion();
       }
 
-      inputPtr->SetRequestedRegion(inputRequestedRegion);
-      inputPtr->PropagateRequestedRegion();
+      if (asynchronousWrite)
+      {
+        this->EnqueueStreamBuffers();
+      }
+      else
+      {
+        /** Call GenerateData to write streams to files if needed */
+        this->GenerateData();
+      }
     }
+  }
+  catch (...)
+  {
+    if (asynchronousWrite)
+    {
+      // The pipeline error takes precedence over any write error
+      try
+      {
+        this->FinishAsynchronousWrite();
+      }
+      catch (...)
+      {
+      }
+    }
+    throw;
+  }
 
-    /** Call GenerateData to write streams to files if needed */
-    this->GenerateData();
+  if (asynchronousWrite)
+  {
+    // Wait for the pending pieces to be written
+    this->FinishAsynchronousWrite();
   }
 
   /**
@@ -386,15 +445,136 @@ void MultiImageFileWriter::GenerateData()
   int numInputs = m_SinkList.size();
   for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
   {
-    auto region = m_StreamRegionList[inputIndex];
-    
-    auto shiftIndex =  m_SinkList[inputIndex]->GetRegionToWrite().GetIndex();
-    auto index = region.GetIndex();
-    index[0] -= shiftIndex[0];
-    index[1] -= shiftIndex[1];
-    
-    region.SetIndex(index);
-    m_SinkList[inputIndex]->Write(region);
+    m_SinkList[inputIndex]->Write(GetStreamRegionToWrite(inputIndex));
+  }
+}
+
+MultiImageFileWriter::RegionType MultiImageFileWriter::GetStreamRegionToWrite(int inputIndex)
+{
+  auto region = m_StreamRegionList[inputIndex];
+
+  auto shiftIndex =  m_SinkList[inputIndex]->GetRegionToWrite().GetIndex();
+  auto index = region.GetIndex();
+  index[0] -= shiftIndex[0];
+  index[1] -= shiftIndex[1];
+
+  region.SetIndex(index);
+  return region;
+}
+
+void MultiImageFileWriter::StartAsynchronousWrite(unsigned int maximumStreamBuffersInFlight)
+{
+  otbLogMacro(Debug, << "Asynchronous writing of " << m_SinkList.size() << " output images with " << maximumStreamBuffersInFlight
+                     << " shared stream buffers");
+
+  m_MaximumStreamBuffersInFlight = maximumStreamBuffersInFlight;
+  m_StreamBuffersInFlight        = 0;
+  m_StreamBufferQueueClosed      = false;
+  m_AsynchronousWriteError       = nullptr;
+
+  for (const auto& sink : m_SinkList)
+  {
+    sink->PrepareAsynchronousWrite();
+    sink->m_PendingWrites.clear();
+  }
+
+  for (const auto& sink : m_SinkList)
+  {
+    sink->m_WriterThread = std::thread(&Self::AsynchronousWriteLoop, this, sink.get());
+  }
+}
+
+void MultiImageFileWriter::EnqueueStreamBuffers()
+{
+  int numInputs = m_SinkList.size();
+  for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
+  {
+    // The pieces are computed in order: the next input may overwrite a
+    // shared upstream buffer
+    auto write = m_SinkList[inputIndex]->PrepareStreamBuffer(m_StreamRegionList[inputIndex], GetStreamRegionToWrite(inputIndex));
+
+    std::unique_lock<std::mutex> lock(m_StreamBufferMutex);
+    m_StreamBufferCondition.wait(lock, [this] { return (m_StreamBuffersInFlight < m_MaximumStreamBuffersInFlight) || m_AsynchronousWriteError; });
+
+    if (m_AsynchronousWriteError)
+    {
+      // The error is kept to be rethrown by FinishAsynchronousWrite() as well
+      std::rethrow_exception(m_AsynchronousWriteError);
+    }
+
+    m_SinkList[inputIndex]->m_PendingWrites.push_back(std::move(write));
+    ++m_StreamBuffersInFlight;
+    lock.unlock();
+    m_StreamBufferCondition.notify_all();
+  }
+}
+
+void MultiImageFileWriter::AsynchronousWriteLoop(SinkBase* sink)
+{
+  while (true)
+  {
+    std::function<void()> write;
+    {
+      std::unique_lock<std::mutex> lock(m_StreamBufferMutex);
+      m_StreamBufferCondition.wait(lock, [this, sink] { return !sink->m_PendingWrites.empty() || m_StreamBufferQueueClosed || m_AsynchronousWriteError; });
+      if (m_AsynchronousWriteError || sink->m_PendingWrites.empty())
+      {
+        return;
+      }
+      write = std::move(sink->m_PendingWrites.front());
+      sink->m_PendingWrites.pop_front();
+    }
+
+    try
+    {
+      write();
+    }
+    catch (...)
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_StreamBufferMutex);
+        if (!m_AsynchronousWriteError)
+        {
+          m_AsynchronousWriteError = std::current_exception();
+        }
+      }
+      m_StreamBufferCondition.notify_all();
+      return;
+    }
+
+    // Release the buffer before letting the pipeline allocate a new one
+    write = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(m_StreamBufferMutex);
+      --m_StreamBuffersInFlight;
+    }
+    m_StreamBufferCondition.notify_all();
+  }
+}
+
+void MultiImageFileWriter::FinishAsynchronousWrite()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_StreamBufferMutex);
+    m_StreamBufferQueueClosed = true;
+  }
+  m_StreamBufferCondition.notify_all();
+
+  for (const auto& sink : m_SinkList)
+  {
+    if (sink->m_WriterThread.joinable())
+    {
+      sink->m_WriterThread.join();
+    }
+    // Pieces left behind by a write error
+    sink->m_PendingWrites.clear();
+  }
+
+  std::exception_ptr error = m_AsynchronousWriteError;
+  m_AsynchronousWriteError = nullptr;
+  if (error)
+  {
+    std::rethrow_exception(error);
   }
 }
 
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+#include <iostream>
+#include <string>
+
+#include "otbImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "otbGDALOverviewsBuilder.h"
+
+namespace
+{
+typedef otb::Image<float, 2> FloatImageType;
+
+bool CheckResolutionFactor(const std::string& fileName, unsigned long numberOfPixels, unsigned int expected)
+{
+  typedef otb::ImageFileReader<FloatImageType> ReaderType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  const unsigned int resolutionFactor = reader->GetOverviewResolutionFactor(numberOfPixels);
+  if (resolutionFactor != expected)
+  {
+    std::cout << "Resolution factor for " << numberOfPixels << " pixels is " << resolutionFactor << " instead of " << expected << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int otbImageFileReaderOverviewResolutionFactorTest(int itkNotUsed(argc), char* argv[])
+{
+  const std::string fileName = argv[1];
+
+  FloatImageType::Pointer    image = FloatImageType::New();
+  FloatImageType::RegionType region;
+  region.SetSize(0, 256);
+  region.SetSize(1, 256);
+  image->SetRegions(region);
+  image->Allocate();
+  image->FillBuffer(1.f);
+
+  typedef otb::ImageFileWriter<FloatImageType> WriterType;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName(fileName);
+  writer->SetInput(image);
+  writer->Update();
+
+  // Without overviews in the file, the full resolution is always read
+  bool ok = CheckResolutionFactor(fileName, 1, 0);
+
+  // Overviews of 128x128 and 64x64 pixels
+  {
+    otb::GDALOverviewsBuilder::Pointer builder = otb::GDALOverviewsBuilder::New();
+    builder->SetInputFileName(fileName);
+    builder->SetNbResolutions(3);
+    builder->SetResamplingMethod(otb::GDAL_RESAMPLING_AVERAGE);
+    builder->Update();
+  }
+
+  ok = CheckResolutionFactor(fileName, 1, 2) && ok;
+  ok = CheckResolutionFactor(fileName, 64 * 64, 2) && ok;
+  ok = CheckResolutionFactor(fileName, 64 * 64 + 1, 1) && ok;
+  ok = CheckResolutionFactor(fileName, 128 * 128 + 1, 0) && ok;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+#include <iostream>
+#include <string>
+
+#include "otbImage.h"
+#include "otbVectorImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+
+namespace
+{
+typedef otb::VectorImage<float, 2> FloatImageType;
+
+/** Read the file as TImage, and check that each component of the first
+ *  band selected by firstBand is the one of the float image cast to the
+ *  component type */
+template <class TImage>
+bool CheckTypeCast(const std::string& fileName, const FloatImageType* reference, unsigned int firstBand, const char* description)
+{
+  typedef typename TImage::InternalPixelType ComponentType;
+  typedef otb::ImageFileReader<TImage>       ReaderType;
+
+  typename ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  reader->Update();
+
+  typedef otb::DefaultConvertPixelTraits<typename TImage::PixelType> TraitsType;
+  const unsigned int nbComponents = reader->GetOutput()->GetNumberOfComponentsPerPixel();
+
+  itk::ImageRegionConstIterator<FloatImageType> refIt(reference, reference->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<TImage>         it(reader->GetOutput(), reader->GetOutput()->GetLargestPossibleRegion());
+  for (refIt.GoToBegin(), it.GoToBegin(); !refIt.IsAtEnd(); ++refIt, ++it)
+  {
+    const typename TImage::PixelType pixel = it.Get();
+    for (unsigned int c = 0; c < nbComponents; ++c)
+    {
+      const ComponentType expected = static_cast<ComponentType>(refIt.Get()[firstBand + c]);
+      const ComponentType value    = TraitsType::GetNthComponent(c, pixel);
+      if (value != expected)
+      {
+        std::cout << description << ": component " << c << " of pixel " << it.GetIndex() << " is " << +value << " instead of " << +expected << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int otbImageFileReaderTypeCastTest(int itkNotUsed(argc), char* argv[])
+{
+  const std::string fileName = argv[1];
+
+  // Values with a fractional part, negative values in the last two bands
+  FloatImageType::Pointer    image = FloatImageType::New();
+  FloatImageType::RegionType region;
+  region.SetSize(0, 17);
+  region.SetSize(1, 13);
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(3);
+  image->Allocate();
+  itk::ImageRegionIterator<FloatImageType> it(image, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const float               x = static_cast<float>(it.GetIndex()[0]);
+    const float               y = static_cast<float>(it.GetIndex()[1]);
+    FloatImageType::PixelType pixel(3);
+    pixel[0] = 10.f * x + 0.7f * y + 0.25f;
+    pixel[1] = 0.9f * x - 1.6f * y;
+    pixel[2] = -37.5f * x + 120.3f * y - 0.5f;
+    it.Set(pixel);
+  }
+
+  typedef otb::ImageFileWriter<FloatImageType> WriterType;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName(fileName);
+  writer->SetInput(image);
+  writer->Update();
+
+  // Integer outputs truncate like a static_cast, with and without band
+  // selection, and the lossless conversions give the same values
+  bool ok = CheckTypeCast<otb::VectorImage<unsigned char, 2>>(fileName + "?bands=1", image, 0, "uint8 vector image");
+  ok      = CheckTypeCast<otb::VectorImage<short, 2>>(fileName, image, 0, "int16 vector image") && ok;
+  ok      = CheckTypeCast<otb::VectorImage<int, 2>>(fileName + "?bands=2:3", image, 1, "int32 vector image, bands 2 and 3") && ok;
+  ok      = CheckTypeCast<otb::Image<short, 2>>(fileName + "?bands=3", image, 2, "int16 image, band 3") && ok;
+  ok      = CheckTypeCast<otb::VectorImage<double, 2>>(fileName, image, 0, "float64 vector image") && ok;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
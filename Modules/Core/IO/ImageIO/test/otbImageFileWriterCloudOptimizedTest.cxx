@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "otbImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "otbGDALImageIO.h"
+
+namespace
+{
+typedef otb::Image<float, 2> FloatImageType;
+
+/** Check that the overviews of a COG written in many strips are the ones
+ *  of the same COG written in a single strip */
+bool CheckOverviews(const std::string& streamedFileName, const std::string& singleFileName, const std::string& resampling)
+{
+  typedef otb::ImageFileReader<FloatImageType> ReaderType;
+
+  otb::GDALImageIO::Pointer io = otb::GDALImageIO::New();
+  io->SetFileName(streamedFileName);
+  io->ReadImageInformation();
+  const unsigned int nbOverviews = io->GetStoredOverviewsCount();
+  if (nbOverviews == 0)
+  {
+    std::cout << resampling << ": no overview in " << streamedFileName << std::endl;
+    return false;
+  }
+
+  for (unsigned int resol = 1; resol <= nbOverviews; ++resol)
+  {
+    std::ostringstream option;
+    option << "?&resol=" << resol;
+    ReaderType::Pointer streamedReader = ReaderType::New();
+    streamedReader->SetFileName(streamedFileName + option.str());
+    streamedReader->Update();
+    ReaderType::Pointer singleReader = ReaderType::New();
+    singleReader->SetFileName(singleFileName + option.str());
+    singleReader->Update();
+
+    const FloatImageType* streamed = streamedReader->GetOutput();
+    const FloatImageType* single   = singleReader->GetOutput();
+    if (streamed->GetLargestPossibleRegion() != single->GetLargestPossibleRegion())
+    {
+      std::cout << resampling << ": overview " << resol << " sizes differ" << std::endl;
+      return false;
+    }
+    itk::ImageRegionConstIterator<FloatImageType> streamedIt(streamed, streamed->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<FloatImageType> singleIt(single, single->GetLargestPossibleRegion());
+    for (; !singleIt.IsAtEnd(); ++streamedIt, ++singleIt)
+    {
+      if (std::abs(streamedIt.Get() - singleIt.Get()) > 1e-4 * std::max(1.f, std::abs(singleIt.Get())))
+      {
+        std::cout << resampling << ": pixel " << singleIt.GetIndex() << " of overview " << resol << " is " << streamedIt.Get() << " instead of " << singleIt.Get()
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int otbImageFileWriterCloudOptimizedTest(int itkNotUsed(argc), char* argv[])
+{
+  const std::string prefix = argv[1];
+
+  // High frequencies, so that the resampling kernels see the missing lines
+  FloatImageType::Pointer    image = FloatImageType::New();
+  FloatImageType::RegionType region;
+  region.SetSize(0, 600);
+  region.SetSize(1, 500);
+  image->SetRegions(region);
+  image->Allocate();
+  itk::ImageRegionIterator<FloatImageType> it(image, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0];
+    const double y = it.GetIndex()[1];
+    it.Set(static_cast<float>(100. * std::sin(0.9 * x) * std::cos(1.3 * y) + 0.5 * y));
+  }
+
+  typedef otb::ImageFileWriter<FloatImageType> WriterType;
+
+  bool ok = true;
+  for (const std::string resampling : {"BILINEAR", "CUBIC", "LANCZOS"})
+  {
+    const std::string options = "?&cog=true&gdal:co:BLOCKSIZE=128&gdal:co:OVERVIEW_RESAMPLING=" + resampling;
+    const std::string streamedFileName = prefix + "_" + resampling + "_streamed.tif";
+    const std::string singleFileName   = prefix + "_" + resampling + "_single.tif";
+
+    // Strips of 20 lines, shorter than the kernels of the first overviews
+    WriterType::Pointer writer = WriterType::New();
+    writer->SetFileName(streamedFileName + options + "&streaming:type=stripped&streaming:sizemode=nbsplits&streaming:sizevalue=25");
+    writer->SetInput(image);
+    writer->Update();
+
+    writer = WriterType::New();
+    writer->SetFileName(singleFileName + options + "&streaming:type=none");
+    writer->SetInput(image);
+    writer->Update();
+
+    ok = CheckOverviews(streamedFileName, singleFileName, resampling) && ok;
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
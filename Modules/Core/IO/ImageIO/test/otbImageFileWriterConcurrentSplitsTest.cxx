@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "itkMacro.h"
+#include <iostream>
+
+#include "otbVectorImage.h"
+
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+
+int otbImageFileWriterConcurrentSplitsTest(int itkNotUsed(argc), char* argv[])
+{
+  // Verify the number of parameters in the command line
+  const char*  inputFilename  = argv[1];
+  const char*  outputFilename = argv[2];
+  unsigned int numberOfConcurrentSplits(::atoi(argv[3]));
+  unsigned int numberOfStreamDivisions(::atoi(argv[4]));
+
+  typedef otb::VectorImage<unsigned short, 2> ImageType;
+  typedef otb::ImageFileReader<ImageType>     ReaderType;
+  typedef otb::ImageFileWriter<ImageType>     WriterType;
+
+  // Each clone opens its own reader on the input file
+  auto factory = [inputFilename]() {
+    ReaderType::Pointer reader = ReaderType::New();
+    reader->SetFileName(inputFilename);
+
+    WriterType::PipelineCloneType clone;
+    clone.Output = reader->GetOutput();
+    clone.Holders.push_back(reader.GetPointer());
+    return clone;
+  };
+
+  WriterType::PipelineCloneType pipeline = factory();
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName(outputFilename);
+  writer->SetInput(pipeline.Output);
+  writer->SetNumberOfDivisionsTiledStreaming(numberOfStreamDivisions);
+  writer->SetPipelineFactory(factory);
+  writer->SetNumberOfConcurrentSplits(numberOfConcurrentSplits);
+  writer->Update();
+
+  return EXIT_SUCCESS;
+}
@@ -139,4 +139,8 @@ void RegisterTests()
   REGISTER_TEST(otbImageFileReaderOptBandTest);
   REGISTER_TEST(otbImageFileWriterOptBandTest);
   REGISTER_TEST(otbMultiImageFileWriterTest);
+  REGISTER_TEST(otbImageFileWriterConcurrentSplitsTest);
+  REGISTER_TEST(otbImageFileReaderTypeCastTest);
+  REGISTER_TEST(otbImageFileReaderOverviewResolutionFactorTest);
+  REGISTER_TEST(otbImageFileWriterCloudOptimizedTest);
 }
@@ -37,7 +37,7 @@ int otbMultiImageFileWriterTest(int argc, char* argv[])
 
   if (argc < 6)
   {
-    std::cout << "Usage: " << argv[0] << " inputImageFileName1 inputImageFileName2 outputImageFileName1 outputImageFileName2 numberOfLinesPerStrip\n";
+    std::cout << "Usage: " << argv[0] << " inputImageFileName1 inputImageFileName2 outputImageFileName1 outputImageFileName2 numberOfLinesPerStrip [numberOfStreamBuffers]\n";
     return EXIT_FAILURE;
   }
 
@@ -46,6 +46,7 @@ int otbMultiImageFileWriterTest(int argc, char* argv[])
   const std::string outputImageFileName1  = argv[3];
   const std::string outputImageFileName2  = argv[4];
   const int         numberOfLinesPerStrip = atoi(argv[5]);
+  const int         numberOfStreamBuffers = argc > 6 ? atoi(argv[6]) : 1;
 
   ReaderType1::Pointer reader1 = ReaderType1::New();
   reader1->SetFileName(inputImageFileName1);
@@ -61,6 +62,7 @@ int otbMultiImageFileWriterTest(int argc, char* argv[])
   writer->AddInputImage(reader1->GetOutput(), outputImageFileName1);
   writer->AddInputWriter<WriterType2>(writer2);
   writer->SetNumberOfLinesStrippedStreaming(numberOfLinesPerStrip);
+  writer->SetNumberOfStreamBuffers(numberOfStreamBuffers);
 
   writer->Update();
 
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbAdaptiveTransformToDisplacementFieldSource_h
+#define otbAdaptiveTransformToDisplacementFieldSource_h
+
+#include <vector>
+
+#include "itkTransformToDisplacementFieldSource.h"
+#include "otbTransform.h"
+
+namespace otb
+{
+
+/** \class AdaptiveTransformToDisplacementFieldSource
+ *  \brief Displacement field source evaluating the transform only where
+ *  the field is not linear
+ *
+ * The field is divided into cells of CellSize pixels. The transform is
+ * evaluated at the corners of each cell, and at the middle of its edges
+ * and at its center. If the displacements bilinearly interpolated from
+ * the corners are within MaximumError of the exact ones at these five
+ * points, the whole cell is filled by bilinear interpolation. Otherwise
+ * the cell is split in four and each part is checked the same way, down
+ * to cells of one pixel where every displacement is exact.
+ *
+ * Errors are measured in pixels of ErrorSpacing, the spacing of the image
+ * the displacements point into. After an update,
+ * GetEstimatedMaximumError() gives the largest error measured in the
+ * interpolated cells since the last GenerateOutputInformation(), and
+ * GetNumberOfTransformEvaluations() the number of points it transformed.
+ *
+ * Cells are aligned on the largest possible region, so that the field
+ * does not depend on the streaming or the threading of the output.
+ *
+ * When MaximumError is 0 (the default), or for images which are not 2D,
+ * the transform is evaluated at every pixel as in
+ * itk::TransformToDisplacementFieldSource. Non linear transforms are then
+ * evaluated line by line through otb::Transform::TransformPoints().
+ *
+ * \ingroup OTBImageManipulation
+ */
+template <class TOutputImage, class TTransformPrecisionType = double>
+class ITK_EXPORT AdaptiveTransformToDisplacementFieldSource : public itk::TransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>
+{
+public:
+  /** Standard class typedefs. */
+  typedef AdaptiveTransformToDisplacementFieldSource                                   Self;
+  typedef itk::TransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType> Superclass;
+  typedef itk::SmartPointer<Self>                                                      Pointer;
+  typedef itk::SmartPointer<const Self>                                                ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(AdaptiveTransformToDisplacementFieldSource, itk::TransformToDisplacementFieldSource);
+
+  itkStaticConstMacro(ImageDimension, unsigned int, Superclass::ImageDimension);
+
+  typedef typename Superclass::OutputImageType       OutputImageType;
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+  typedef typename Superclass::TransformType         TransformType;
+  typedef typename Superclass::PixelType             PixelType;
+  typedef typename Superclass::PixelValueType        PixelValueType;
+  typedef typename Superclass::RegionType            RegionType;
+  typedef typename Superclass::SizeType              SizeType;
+  typedef typename Superclass::IndexType             IndexType;
+  typedef typename Superclass::PointType             PointType;
+  typedef typename Superclass::SpacingType           SpacingType;
+  typedef typename Superclass::OriginType            OriginType;
+  typedef typename Superclass::DirectionType         DirectionType;
+
+  /** Size of the cells, in pixels of the field */
+  itkSetMacro(CellSize, SizeType);
+  itkGetConstReferenceMacro(CellSize, SizeType);
+
+  /** Spacing of the image the displacements point into */
+  itkSetMacro(ErrorSpacing, SpacingType);
+  itkGetConstReferenceMacro(ErrorSpacing, SpacingType);
+
+  /** Maximum interpolation error, in pixels of ErrorSpacing. 0 evaluates
+   *  the transform at every pixel. */
+  itkSetMacro(MaximumError, double);
+  itkGetConstMacro(MaximumError, double);
+
+  /** Largest interpolation error measured, in pixels of ErrorSpacing */
+  itkGetConstMacro(EstimatedMaximumError, double);
+
+  /** Number of points transformed in the adaptive mode */
+  itkGetConstMacro(NumberOfTransformEvaluations, unsigned long);
+
+  /** Resets the error and evaluation counters */
+  void GenerateOutputInformation() override;
+
+  void BeforeThreadedGenerateData() override;
+
+protected:
+  AdaptiveTransformToDisplacementFieldSource();
+  ~AdaptiveTransformToDisplacementFieldSource() override
+  {
+  }
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void AfterThreadedGenerateData() override;
+
+private:
+  AdaptiveTransformToDisplacementFieldSource(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** True if the field is built from cells */
+  bool IsAdaptive() const;
+
+  /** Exact displacement at field index (x, y) */
+  PixelType EvaluateDisplacement(long x, long y, itk::ThreadIdType threadId);
+
+  /** Exact displacements at field indices (xs[i], y) */
+  void EvaluateDisplacements(const std::vector<long>& xs, long y, PixelType* displacements, itk::ThreadIdType threadId);
+
+  /** Evaluate the transform at every pixel of the region, one line at a time */
+  void LineThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId);
+
+  /** Error between the exact and the interpolated displacements, in pixels */
+  double ComputeError(const PixelType& exact, const PixelType& interpolated) const;
+
+  /** Check the cell [x0, x1] x [y0, y1] whose corner displacements are
+   *  d00, d10, d01 and d11, then fill it or split it */
+  void RefineCell(long x0, long y0, long x1, long y1, const PixelType& d00, const PixelType& d10, const PixelType& d01, const PixelType& d11,
+                  const OutputImageRegionType& region, itk::ThreadIdType threadId);
+
+  /** Linear interpolation between a (t = 0) and b (t = 1), exact at both ends */
+  static PixelType Interpolate(const PixelType& a, const PixelType& b, double t);
+
+  /** Fill the pixels of the cell inside region by bilinear interpolation */
+  void FillCell(long x0, long y0, long x1, long y1, const PixelType& d00, const PixelType& d10, const PixelType& d01, const PixelType& d11,
+                const OutputImageRegionType& region);
+
+  SizeType    m_CellSize;
+  SpacingType m_ErrorSpacing;
+  double      m_MaximumError;
+
+  double        m_EstimatedMaximumError;
+  unsigned long m_NumberOfTransformEvaluations;
+
+  std::vector<double>        m_ThreadMaximumError;
+  std::vector<unsigned long> m_ThreadTransformEvaluations;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbAdaptiveTransformToDisplacementFieldSource.hxx"
+#endif
+
+#endif
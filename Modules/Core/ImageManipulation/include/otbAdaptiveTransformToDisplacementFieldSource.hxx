@@ -0,0 +1,393 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbAdaptiveTransformToDisplacementFieldSource_hxx
+#define otbAdaptiveTransformToDisplacementFieldSource_hxx
+
+#include "otbAdaptiveTransformToDisplacementFieldSource.h"
+#include "itkImageScanlineIterator.h"
+#include "itkProgressReporter.h"
+#include "otbMacro.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace otb
+{
+
+template <class TOutputImage, class TTransformPrecisionType>
+AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::AdaptiveTransformToDisplacementFieldSource()
+  : m_MaximumError(0.), m_EstimatedMaximumError(0.), m_NumberOfTransformEvaluations(0)
+{
+  m_CellSize.Fill(1);
+  m_ErrorSpacing.Fill(1.);
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  m_EstimatedMaximumError        = 0.;
+  m_NumberOfTransformEvaluations = 0;
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+bool AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::IsAdaptive() const
+{
+  if (ImageDimension != 2 || m_MaximumError <= 0.)
+  {
+    return false;
+  }
+
+  // Cells need two pixels along each axis
+  const SizeType& size = this->GetOutput()->GetLargestPossibleRegion().GetSize();
+  return size[0] > 1 && size[1] > 1;
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::BeforeThreadedGenerateData()
+{
+  Superclass::BeforeThreadedGenerateData();
+
+  m_ThreadMaximumError.assign(this->GetNumberOfThreads(), 0.);
+  m_ThreadTransformEvaluations.assign(this->GetNumberOfThreads(), 0);
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::AfterThreadedGenerateData()
+{
+  for (unsigned int threadId = 0; threadId < m_ThreadMaximumError.size(); ++threadId)
+  {
+    m_EstimatedMaximumError = std::max(m_EstimatedMaximumError, m_ThreadMaximumError[threadId]);
+    m_NumberOfTransformEvaluations += m_ThreadTransformEvaluations[threadId];
+  }
+
+  otbMsgDevMacro(<< "Adaptive displacement field: " << m_NumberOfTransformEvaluations << " transformed points, estimated maximum error "
+                 << m_EstimatedMaximumError << " pixels");
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                             itk::ThreadIdType            threadId)
+{
+  if (!this->IsAdaptive())
+  {
+    if (this->GetTransform()->IsLinear())
+    {
+      Superclass::ThreadedGenerateData(outputRegionForThread, threadId);
+    }
+    else
+    {
+      this->LineThreadedGenerateData(outputRegionForThread, threadId);
+    }
+    return;
+  }
+
+  // Cells are aligned on the largest possible region
+  const RegionType& largest = this->GetOutput()->GetLargestPossibleRegion();
+  const long        startX  = largest.GetIndex()[0];
+  const long        startY  = largest.GetIndex()[1];
+  const long        endX    = startX + static_cast<long>(largest.GetSize()[0]) - 1;
+  const long        endY    = startY + static_cast<long>(largest.GetSize()[1]) - 1;
+  const long        cellX   = std::max(1L, static_cast<long>(m_CellSize[0]));
+  const long        cellY   = std::max(1L, static_cast<long>(m_CellSize[1]));
+
+  auto cornerX = [&](long cx) { return std::min(startX + cx * cellX, endX); };
+  auto cornerY = [&](long cy) { return std::min(startY + cy * cellY, endY); };
+
+  // Cells covering the region of the thread. The last corner line belongs
+  // to the last cell, a region starting on it starts in this cell.
+  const long regionEndX = outputRegionForThread.GetIndex()[0] + static_cast<long>(outputRegionForThread.GetSize()[0]) - 1;
+  const long regionEndY = outputRegionForThread.GetIndex()[1] + static_cast<long>(outputRegionForThread.GetSize()[1]) - 1;
+  const long finalCellX = (endX - startX - 1) / cellX;
+  const long finalCellY = (endY - startY - 1) / cellY;
+  const long firstCellX = std::min((outputRegionForThread.GetIndex()[0] - startX) / cellX, finalCellX);
+  const long firstCellY = std::min((outputRegionForThread.GetIndex()[1] - startY) / cellY, finalCellY);
+  const long lastCellX  = std::min((regionEndX - startX) / cellX, finalCellX);
+  const long lastCellY  = std::min((regionEndY - startY) / cellY, finalCellY);
+
+  itk::ProgressReporter progress(this, threadId, lastCellY - firstCellY + 1);
+
+  // Corner displacements of the current row of cells, the bottom ones
+  // being the top ones of the next row
+  std::vector<long> xs(lastCellX - firstCellX + 2);
+  for (long cx = firstCellX; cx <= lastCellX + 1; ++cx)
+  {
+    xs[cx - firstCellX] = cornerX(cx);
+  }
+  std::vector<PixelType> top(xs.size());
+  std::vector<PixelType> bottom(xs.size());
+  this->EvaluateDisplacements(xs, cornerY(firstCellY), top.data(), threadId);
+
+  for (long cy = firstCellY; cy <= lastCellY; ++cy)
+  {
+    const long y0 = cornerY(cy);
+    const long y1 = cornerY(cy + 1);
+    this->EvaluateDisplacements(xs, y1, bottom.data(), threadId);
+
+    for (long cx = firstCellX; cx <= lastCellX; ++cx)
+    {
+      const long i = cx - firstCellX;
+      this->RefineCell(cornerX(cx), y0, cornerX(cx + 1), y1, top[i], top[i + 1], bottom[i], bottom[i + 1], outputRegionForThread, threadId);
+    }
+
+    std::swap(top, bottom);
+    progress.CompletedPixel();
+  }
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+typename AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::PixelType
+AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::EvaluateDisplacement(long x, long y, itk::ThreadIdType threadId)
+{
+  IndexType index;
+  index[0] = x;
+  index[1] = y;
+
+  PointType outputPoint;
+  this->GetOutput()->TransformIndexToPhysicalPoint(index, outputPoint);
+  const PointType transformedPoint = this->GetTransform()->TransformPoint(outputPoint);
+  ++m_ThreadTransformEvaluations[threadId];
+
+  PixelType displacement;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    displacement[i] = static_cast<PixelValueType>(transformedPoint[i] - outputPoint[i]);
+  }
+  return displacement;
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::EvaluateDisplacements(const std::vector<long>& xs, long y,
+                                                                                                              PixelType*        displacements,
+                                                                                                              itk::ThreadIdType threadId)
+{
+  IndexType index;
+  index[1] = y;
+
+  std::vector<PointType> outputPoints(xs.size());
+  for (std::size_t i = 0; i < xs.size(); ++i)
+  {
+    index[0] = xs[i];
+    this->GetOutput()->TransformIndexToPhysicalPoint(index, outputPoints[i]);
+  }
+
+  std::vector<PointType> transformedPoints(xs.size());
+  internal::TransformPoints(this->GetTransform(), outputPoints.data(), transformedPoints.data(), xs.size());
+  m_ThreadTransformEvaluations[threadId] += xs.size();
+
+  for (std::size_t i = 0; i < xs.size(); ++i)
+  {
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      displacements[i][dim] = static_cast<PixelValueType>(transformedPoints[i][dim] - outputPoints[i][dim]);
+    }
+  }
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::LineThreadedGenerateData(
+    const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  OutputImageType* outputPtr = this->GetOutput();
+
+  const std::size_t      lineSize = outputRegionForThread.GetSize()[0];
+  std::vector<PointType> outputPoints(lineSize);
+  std::vector<PointType> transformedPoints(lineSize);
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels() / lineSize);
+
+  itk::ImageScanlineIterator<OutputImageType> it(outputPtr, outputRegionForThread);
+  for (it.GoToBegin(); !it.IsAtEnd(); it.NextLine())
+  {
+    IndexType index = it.GetIndex();
+    for (std::size_t i = 0; i < lineSize; ++i, ++index[0])
+    {
+      outputPtr->TransformIndexToPhysicalPoint(index, outputPoints[i]);
+    }
+
+    internal::TransformPoints(this->GetTransform(), outputPoints.data(), transformedPoints.data(), lineSize);
+
+    for (std::size_t i = 0; i < lineSize; ++i, ++it)
+    {
+      PixelType displacement;
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        displacement[dim] = static_cast<PixelValueType>(transformedPoints[i][dim] - outputPoints[i][dim]);
+      }
+      it.Set(displacement);
+    }
+    progress.CompletedPixel();
+  }
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+double AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::ComputeError(const PixelType& exact,
+                                                                                                       const PixelType& interpolated) const
+{
+  double error = 0.;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    const double componentError = std::abs(static_cast<double>(exact[i] - interpolated[i]) / m_ErrorSpacing[i]);
+
+    // Points the transform fails on are never interpolated
+    if (std::isnan(componentError))
+    {
+      return std::numeric_limits<double>::infinity();
+    }
+    error = std::max(error, componentError);
+  }
+  return error;
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+typename AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::PixelType
+AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::Interpolate(const PixelType& a, const PixelType& b, double t)
+{
+  if (t == 0.)
+  {
+    return a;
+  }
+  if (t == 1.)
+  {
+    return b;
+  }
+  return a * (1. - t) + b * t;
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::RefineCell(long x0, long y0, long x1, long y1, const PixelType& d00,
+                                                                                                   const PixelType& d10, const PixelType& d01,
+                                                                                                   const PixelType& d11, const OutputImageRegionType& region,
+                                                                                                   itk::ThreadIdType threadId)
+{
+  // Skip the cells outside the region of the thread
+  const long regionX = region.GetIndex()[0];
+  const long regionY = region.GetIndex()[1];
+  if (x1 < regionX || y1 < regionY || x0 >= regionX + static_cast<long>(region.GetSize()[0]) || y0 >= regionY + static_cast<long>(region.GetSize()[1]))
+  {
+    return;
+  }
+
+  // All the pixels of the cell are corners
+  const bool splitX = x1 - x0 > 1;
+  const bool splitY = y1 - y0 > 1;
+  if (!splitX && !splitY)
+  {
+    this->FillCell(x0, y0, x1, y1, d00, d10, d01, d11, region);
+    return;
+  }
+
+  const long   xm = x0 + (x1 - x0) / 2;
+  const long   ym = y0 + (y1 - y0) / 2;
+  const double tx = static_cast<double>(xm - x0) / (x1 - x0);
+  const double ty = static_cast<double>(ym - y0) / (y1 - y0);
+
+  // Exact displacements in the middle of the edges and at the center
+  const PixelType dm0 = splitX ? this->EvaluateDisplacement(xm, y0, threadId) : d00;
+  const PixelType dm1 = splitX ? this->EvaluateDisplacement(xm, y1, threadId) : d01;
+  const PixelType d0m = splitY ? this->EvaluateDisplacement(x0, ym, threadId) : d00;
+  const PixelType d1m = splitY ? this->EvaluateDisplacement(x1, ym, threadId) : d10;
+  const PixelType dmm = (splitX && splitY) ? this->EvaluateDisplacement(xm, ym, threadId) : (splitX ? dm0 : d0m);
+
+  double error = 0.;
+  if (splitX)
+  {
+    error = std::max({error, this->ComputeError(dm0, Interpolate(d00, d10, tx)), this->ComputeError(dm1, Interpolate(d01, d11, tx))});
+  }
+  if (splitY)
+  {
+    error = std::max({error, this->ComputeError(d0m, Interpolate(d00, d01, ty)), this->ComputeError(d1m, Interpolate(d10, d11, ty))});
+  }
+  if (splitX && splitY)
+  {
+    error = std::max(error, this->ComputeError(dmm, Interpolate(Interpolate(d00, d01, ty), Interpolate(d10, d11, ty), tx)));
+  }
+
+  if (error <= m_MaximumError)
+  {
+    m_ThreadMaximumError[threadId] = std::max(m_ThreadMaximumError[threadId], error);
+    this->FillCell(x0, y0, x1, y1, d00, d10, d01, d11, region);
+    return;
+  }
+
+  // Split the cell along the axes it spans more than one pixel
+  if (splitX && splitY)
+  {
+    this->RefineCell(x0, y0, xm, ym, d00, dm0, d0m, dmm, region, threadId);
+    this->RefineCell(xm, y0, x1, ym, dm0, d10, dmm, d1m, region, threadId);
+    this->RefineCell(x0, ym, xm, y1, d0m, dmm, d01, dm1, region, threadId);
+    this->RefineCell(xm, ym, x1, y1, dmm, d1m, dm1, d11, region, threadId);
+  }
+  else if (splitX)
+  {
+    this->RefineCell(x0, y0, xm, y1, d00, dm0, d01, dm1, region, threadId);
+    this->RefineCell(xm, y0, x1, y1, dm0, d10, dm1, d11, region, threadId);
+  }
+  else
+  {
+    this->RefineCell(x0, y0, x1, ym, d00, d10, d0m, d1m, region, threadId);
+    this->RefineCell(x0, ym, x1, y1, d0m, d1m, d01, d11, region, threadId);
+  }
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::FillCell(long x0, long y0, long x1, long y1, const PixelType& d00,
+                                                                                                 const PixelType& d10, const PixelType& d01, const PixelType& d11,
+                                                                                                 const OutputImageRegionType& region)
+{
+  const long fillX0 = std::max(x0, static_cast<long>(region.GetIndex()[0]));
+  const long fillY0 = std::max(y0, static_cast<long>(region.GetIndex()[1]));
+  const long fillX1 = std::min(x1, static_cast<long>(region.GetIndex()[0]) + static_cast<long>(region.GetSize()[0]) - 1);
+  const long fillY1 = std::min(y1, static_cast<long>(region.GetIndex()[1]) + static_cast<long>(region.GetSize()[1]) - 1);
+
+  OutputImageType* outputPtr = this->GetOutput();
+  IndexType        index;
+  for (long y = fillY0; y <= fillY1; ++y)
+  {
+    const double    ty    = static_cast<double>(y - y0) / (y1 - y0);
+    const PixelType left  = Interpolate(d00, d01, ty);
+    const PixelType right = Interpolate(d10, d11, ty);
+
+    index[1] = y;
+    for (long x = fillX0; x <= fillX1; ++x)
+    {
+      index[0] = x;
+      outputPtr->SetPixel(index, Interpolate(left, right, static_cast<double>(x - x0) / (x1 - x0)));
+    }
+  }
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "CellSize: " << m_CellSize << std::endl;
+  os << indent << "ErrorSpacing: " << m_ErrorSpacing << std::endl;
+  os << indent << "MaximumError: " << m_MaximumError << std::endl;
+  os << indent << "EstimatedMaximumError: " << m_EstimatedMaximumError << std::endl;
+  os << indent << "NumberOfTransformEvaluations: " << m_NumberOfTransformEvaluations << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -27,6 +27,7 @@
 #include "itkDefaultConvertPixelTraits.h"
 
 #include "otbMacro.h"
+#include "otbSeparableRowInterpolator.h"
 
 namespace otb
 {
@@ -52,6 +53,9 @@ namespace otb
  *  interpolated value will be checked for output pixel type range
  *  prior to casting.
  *
+ *  Interpolators implementing SeparableRowInterpolator (BCO, windowed
+ *  sinc) interpolate each output row in a single call.
+ *
  * \ingroup OTBImageManipulation
  * \ingroup Streamed
  * \ingroup Threaded
@@ -94,6 +98,7 @@ public:
   typedef typename InterpolatorType::OutputType                  InterpolatorOutputType;
   typedef itk::DefaultConvertPixelTraits<InterpolatorOutputType> InterpolatorConvertType;
   typedef typename InterpolatorConvertType::ComponentType        InterpolatorComponentType;
+  typedef SeparableRowInterpolator<TInterpolatorPrecision>       RowInterpolatorType;
 
   /** Input pixel continuous index typdef */
   typedef typename itk::ContinuousIndex<double, InputImageDimension> ContinuousInputIndexType;
@@ -180,6 +185,30 @@ protected:
   }
 
 
+  /** Same as CastPixelWithBoundsChecking, for the nComponents values of
+   *  a SeparableRowInterpolator. outputValue must have nComponents. */
+  inline void CastComponentsWithBoundsChecking(const double* value, unsigned int nComponents, const InterpolatorComponentType& minComponent,
+                                               const InterpolatorComponentType& maxComponent, OutputPixelType& outputValue) const
+  {
+    for (unsigned int n = 0; n < nComponents; n++)
+    {
+      const InterpolatorComponentType component = static_cast<InterpolatorComponentType>(value[n]);
+
+      if (m_CheckOutputBounds && component < minComponent)
+      {
+        OutputPixelConvertType::SetNthComponent(n, outputValue, static_cast<OutputPixelComponentType>(minComponent));
+      }
+      else if (m_CheckOutputBounds && component > maxComponent)
+      {
+        OutputPixelConvertType::SetNthComponent(n, outputValue, static_cast<OutputPixelComponentType>(maxComponent));
+      }
+      else
+      {
+        OutputPixelConvertType::SetNthComponent(n, outputValue, static_cast<OutputPixelComponentType>(component));
+      }
+    }
+  }
+
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
 private:
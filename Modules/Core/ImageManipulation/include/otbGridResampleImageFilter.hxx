@@ -31,6 +31,8 @@
 #include "itkImageScanlineIterator.h"
 #include "itkContinuousIndex.h"
 
+#include <vector>
+
 namespace otb
 {
 
@@ -325,6 +327,41 @@ void GridResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecision>:
   // Iterate through the output region
   outIt.GoToBegin();
 
+  // Interpolators with separable weights interpolate whole rows
+  const RowInterpolatorType* rowInterpolator = dynamic_cast<const RowInterpolatorType*>(m_Interpolator.GetPointer());
+  if (rowInterpolator != nullptr && rowInterpolator->CanEvaluateRows())
+  {
+    const unsigned int  nComponents = inputPtr->GetNumberOfComponentsPerPixel();
+    const unsigned int  rowSize     = regionToCompute.GetSize()[0];
+    std::vector<double> rowValues(rowSize * nComponents);
+    itk::NumericTraits<OutputPixelType>::SetLength(outputValue, nComponents);
+
+    typename RowInterpolatorType::ContinuousIndexType rowStart;
+
+    while (!outIt.IsAtEnd())
+    {
+      outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), outPoint);
+      inputPtr->TransformPhysicalPointToContinuousIndex(outPoint, inCIndex);
+      rowStart[0] = inCIndex[0];
+      rowStart[1] = inCIndex[1];
+
+      rowInterpolator->EvaluateRowAtContinuousIndex(rowStart, delta, rowSize, rowValues.data());
+
+      const double* value = rowValues.data();
+      while (!outIt.IsAtEndOfLine())
+      {
+        this->CastComponentsWithBoundsChecking(value, nComponents, minOutputValue, maxOutputValue, outputValue);
+        outIt.Set(outputValue);
+        ++outIt;
+        value += nComponents;
+      }
+
+      progress.CompletedPixel();
+      outIt.NextLine();
+    }
+    return;
+  }
+
   while (!outIt.IsAtEnd())
   {
     // Map output index to input continuous index
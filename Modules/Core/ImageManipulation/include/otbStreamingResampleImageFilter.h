@@ -23,7 +23,7 @@
 
 #include "itkImageToImageFilter.h"
 #include "otbStreamingWarpImageFilter.h"
-#include "itkTransformToDisplacementFieldSource.h"
+#include "otbAdaptiveTransformToDisplacementFieldSource.h"
 #include "itkLinearInterpolateImageFunction.h"
 #include "otbImage.h"
 #include "itkVector.h"
@@ -83,7 +83,7 @@ public:
   typedef StreamingWarpImageFilter<InputImageType, OutputImageType, DisplacementFieldType> WarpImageFilterType;
 
   /** Internal filters typedefs*/
-  typedef itk::TransformToDisplacementFieldSource<DisplacementFieldType, double> DisplacementFieldGeneratorType;
+  typedef AdaptiveTransformToDisplacementFieldSource<DisplacementFieldType, double> DisplacementFieldGeneratorType;
   typedef typename DisplacementFieldGeneratorType::TransformType TransformType;
   typedef typename DisplacementFieldGeneratorType::SizeType      SizeType;
   typedef typename DisplacementFieldGeneratorType::SpacingType   SpacingType;
@@ -116,6 +116,27 @@ public:
     return m_SignedOutputSpacing;
   };
 
+  /** Maximum error of the displacement field, in input pixels. When it is
+   * positive, the field is generated at the output spacing: the transform
+   * is evaluated on the DisplacementFieldSpacing grid, refined only where
+   * interpolating it would exceed this error. 0 (the default) interpolates
+   * the DisplacementFieldSpacing grid everywhere. */
+  void SetDisplacementFieldMaximumError(double error)
+  {
+    m_DisplacementFilter->SetMaximumError(error);
+    this->Modified();
+  }
+  double GetDisplacementFieldMaximumError() const
+  {
+    return m_DisplacementFilter->GetMaximumError();
+  }
+
+  /** Largest error measured when refining the displacement field, in input pixels */
+  double GetDisplacementFieldEstimatedError() const
+  {
+    return m_DisplacementFilter->GetEstimatedMaximumError();
+  }
+
   /** The resampled image parameters */
   // Output Origin
   void SetOutputOrigin(const OriginType& origin)
@@ -178,6 +199,10 @@ private:
   StreamingResampleImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Set the spacing of the displacement field filter, flipping its
+   * direction for negative spacings */
+  void ApplyDisplacementFieldSpacing(SpacingType spacing);
+
   // We need this to respect ConstRef macro and to be compliant with itk positive
   // spacing
   SpacingType m_SignedOutputSpacing;
@@ -24,6 +24,9 @@
 #include "otbStreamingResampleImageFilter.h"
 #include "itkProgressAccumulator.h"
 #include "otbImage.h"
+#include "itkMath.h"
+
+#include <algorithm>
 
 namespace otb
 {
@@ -68,6 +71,25 @@ void StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecis
     this->SetDisplacementFieldSpacing(2. * this->GetOutputSpacing());
   }
 
+  // The transform is evaluated on the displacement field spacing grid,
+  // refined where needed, and the field is generated at the output spacing
+  SpacingType gridSpacing = this->GetDisplacementFieldSpacing();
+  if (m_DisplacementFilter->GetMaximumError() > 0.)
+  {
+    SizeType cellSize;
+    for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+    {
+      cellSize[dim] = std::max(1L, itk::Math::Round<long>(std::abs(gridSpacing[dim] / this->GetOutputSpacing()[dim])));
+    }
+    m_DisplacementFilter->SetCellSize(cellSize);
+    if (this->GetInput() != nullptr)
+    {
+      m_DisplacementFilter->SetErrorSpacing(internal::GetSignedSpacing(this->GetInput()));
+    }
+    gridSpacing = this->GetOutputSpacing();
+  }
+  this->ApplyDisplacementFieldSpacing(gridSpacing);
+
   // Retrieve output largest region
   SizeType largestSize = this->GetOutputSize();
 
@@ -83,7 +105,7 @@ void StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecis
     // 4 neighbors and in the edges we can need 1 neighbor pixel
     // outside the field
     displacementFieldLargestSize[dim] =
-        static_cast<unsigned int>(std::ceil(largestSize[dim] * std::abs(this->GetOutputSpacing()[dim] / this->GetDisplacementFieldSpacing()[dim]))) + 1;
+        static_cast<unsigned int>(std::ceil(largestSize[dim] * std::abs(this->GetOutputSpacing()[dim] / gridSpacing[dim]))) + 1;
   }
   m_DisplacementFilter->SetOutputSize(displacementFieldLargestSize);
   m_DisplacementFilter->SetOutputIndex(this->GetOutputStartIndex());
@@ -120,7 +142,14 @@ void StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecis
 template <class TInputImage, class TOutputImage, class TInterpolatorPrecisionType>
 void StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::SetDisplacementFieldSpacing(SpacingType outputSpacing)
 {
-  m_SignedOutputSpacing                         = outputSpacing;
+  m_SignedOutputSpacing = outputSpacing;
+  this->ApplyDisplacementFieldSpacing(outputSpacing);
+  this->Modified();
+}
+
+template <class TInputImage, class TOutputImage, class TInterpolatorPrecisionType>
+void StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::ApplyDisplacementFieldSpacing(SpacingType outputSpacing)
+{
   typename TInputImage::DirectionType direction = this->m_DisplacementFilter->GetOutputDirection();
   for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
   {
@@ -138,7 +167,6 @@ void StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecis
   }
   this->m_DisplacementFilter->SetOutputSpacing(outputSpacing);
   this->m_DisplacementFilter->SetOutputDirection(direction);
-  this->Modified();
 }
 
 template <class TInputImage, class TOutputImage, class TInterpolatorPrecisionType>
@@ -149,6 +177,7 @@ void StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecis
   os << indent << "OutputSpacing: " << this->GetOutputSpacing() << std::endl;
   os << indent << "OutputStartIndex: " << this->GetOutputStartIndex() << std::endl;
   os << indent << "OutputSize: " << this->GetOutputSize() << std::endl;
+  os << indent << "DisplacementFieldMaximumError: " << this->GetDisplacementFieldMaximumError() << std::endl;
 }
 }
 #endif
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include "otbAdaptiveTransformToDisplacementFieldSource.h"
+#include "otbImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkThinPlateSplineKernelTransform.h"
+
+int otbAdaptiveTransformToDisplacementFieldSource(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef itk::Vector<double, 2>                                             DisplacementType;
+  typedef otb::Image<DisplacementType, 2>                                    FieldType;
+  typedef itk::TransformToDisplacementFieldSource<FieldType, double>         ExactSourceType;
+  typedef otb::AdaptiveTransformToDisplacementFieldSource<FieldType, double> AdaptiveSourceType;
+  typedef itk::ThinPlateSplineKernelTransform<double, 2>                     TransformType;
+  typedef TransformType::PointSetType                                        PointSetType;
+
+  // Smooth non linear transform
+  const double landmarks[][4] = {{0, 0, 3, -2}, {250, 0, 245, 6}, {0, 180, -4, 183}, {250, 180, 252, 176}, {120, 90, 131, 84}};
+
+  PointSetType::Pointer source = PointSetType::New();
+  PointSetType::Pointer target = PointSetType::New();
+  unsigned int          id     = 0;
+  for (const auto& landmark : landmarks)
+  {
+    PointSetType::PointType p, q;
+    p[0] = landmark[0];
+    p[1] = landmark[1];
+    q[0] = landmark[2];
+    q[1] = landmark[3];
+    source->SetPoint(id, p);
+    target->SetPoint(id, q);
+    ++id;
+  }
+
+  TransformType::Pointer transform = TransformType::New();
+  transform->SetSourceLandmarks(source);
+  transform->SetTargetLandmarks(target);
+  transform->ComputeWMatrix();
+
+  FieldType::SizeType size;
+  size[0] = 251;
+  size[1] = 181;
+  FieldType::IndexType index;
+  index[0] = -3;
+  index[1] = 7;
+
+  ExactSourceType::Pointer exact = ExactSourceType::New();
+  exact->SetTransform(transform);
+  exact->SetOutputSize(size);
+  exact->SetOutputIndex(index);
+  exact->Update();
+
+  const double maximumError = 0.01;
+
+  AdaptiveSourceType::SizeType cellSize;
+  cellSize[0] = 16;
+  cellSize[1] = 12;
+
+  // With 20 threads, the 181 rows are split by 10 and the last thread only
+  // has the last corner line of the cells
+  for (const itk::ThreadIdType numberOfThreads : {0, 20})
+  {
+    AdaptiveSourceType::Pointer adaptive = AdaptiveSourceType::New();
+    adaptive->SetTransform(transform);
+    adaptive->SetOutputSize(size);
+    adaptive->SetOutputIndex(index);
+    adaptive->SetCellSize(cellSize);
+    adaptive->SetMaximumError(maximumError);
+    if (numberOfThreads > 0)
+    {
+      adaptive->SetNumberOfThreads(numberOfThreads);
+    }
+    adaptive->Update();
+
+    // Errors are only measured at the points tested during the refinement
+    double                                   error = 0.;
+    itk::ImageRegionConstIterator<FieldType> exactIt(exact->GetOutput(), exact->GetOutput()->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<FieldType> adaptiveIt(adaptive->GetOutput(), exact->GetOutput()->GetLargestPossibleRegion());
+    for (exactIt.GoToBegin(), adaptiveIt.GoToBegin(); !exactIt.IsAtEnd(); ++exactIt, ++adaptiveIt)
+    {
+      for (unsigned int i = 0; i < 2; ++i)
+      {
+        // A pixel left unwritten may hold a NaN
+        const double difference = std::abs(exactIt.Get()[i] - adaptiveIt.Get()[i]);
+        error                   = std::isnan(difference) ? std::numeric_limits<double>::infinity() : std::max(error, difference);
+      }
+    }
+
+    std::cout << "Threads: " << adaptive->GetNumberOfThreads() << ", transformed points: " << adaptive->GetNumberOfTransformEvaluations() << " for "
+              << size[0] * size[1] << " pixels" << std::endl;
+    std::cout << "Estimated error: " << adaptive->GetEstimatedMaximumError() << ", actual error: " << error << std::endl;
+
+    if (adaptive->GetEstimatedMaximumError() > maximumError || error > 4 * maximumError)
+    {
+      std::cerr << "Displacement field error is too large" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (adaptive->GetNumberOfTransformEvaluations() >= size[0] * size[1])
+    {
+      std::cerr << "The transform was evaluated at every pixel" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -69,6 +69,7 @@ void RegisterTests()
   REGISTER_TEST(otbChangeNoDataValueFilter);
   REGISTER_TEST(otbImageToNoDataMaskFilter);
   REGISTER_TEST(otbGridResampleImageFilter);
+  REGISTER_TEST(otbAdaptiveTransformToDisplacementFieldSource);
   REGISTER_TEST(otbMaskedIteratorDecoratorNominal);
   REGISTER_TEST(otbMaskedIteratorDecoratorDegenerate);
   REGISTER_TEST(otbMaskedIteratorDecoratorExtended);
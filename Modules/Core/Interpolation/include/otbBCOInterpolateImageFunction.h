@@ -21,11 +21,14 @@
 #ifndef otbBCOInterpolateImageFunction_h
 #define otbBCOInterpolateImageFunction_h
 
+#include <type_traits>
+
 #include <boost/version.hpp>
 #include <boost/container/small_vector.hpp>
 
 #include "itkInterpolateImageFunction.h"
 #include "otbMath.h"
+#include "otbSeparableRowInterpolator.h"
 
 #include "otbVectorImage.h"
 
@@ -50,12 +53,15 @@ namespace otb
  * spline) is known to produce the best approximation of the original
  * function.
  *
+ * Rows of positions can be interpolated in one call through the
+ * SeparableRowInterpolator interface.
+ *
  * \ingroup ImageFunctions ImageInterpolators
  *
  * \ingroup OTBInterpolation
  */
 template <class TInputImage, class TCoordRep = double>
-class ITK_EXPORT BCOInterpolateImageFunctionBase : public itk::InterpolateImageFunction<TInputImage, TCoordRep>
+class ITK_EXPORT BCOInterpolateImageFunctionBase : public itk::InterpolateImageFunction<TInputImage, TCoordRep>, public SeparableRowInterpolator<TCoordRep>
 {
 public:
   /** Standard class typedefs. */
@@ -94,6 +100,9 @@ public:
   /** Coefficients container type. */
   typedef boost::container::small_vector<double, 7> CoefContainerType;
 
+  /** ContinuousIndex of the SeparableRowInterpolator interface */
+  typedef typename SeparableRowInterpolator<TCoordRep>::ContinuousIndexType RowContinuousIndexType;
+
   /** Set/Get the window radius */
   virtual void         SetRadius(unsigned int radius);
   virtual unsigned int GetRadius() const;
@@ -112,12 +121,21 @@ public:
    * calling the method. */
   OutputType EvaluateAtContinuousIndex(const ContinuousIndexType& index) const override = 0;
 
+  /** SeparableRowInterpolator implementation, for 2D images whose
+   *  components are arithmetic values. Results are those of
+   *  EvaluateAtContinuousIndex(). */
+  bool CanEvaluateRows() const override;
+  void EvaluateRowAtContinuousIndex(const RowContinuousIndexType& start, double step, unsigned int count, double* values) const override;
+  void EvaluateAtContinuousIndices(const RowContinuousIndexType* indices, unsigned int count, double* values) const override;
+
 protected:
   BCOInterpolateImageFunctionBase() : m_Radius(2), m_WinSize(5), m_Alpha(-0.5){};
   ~BCOInterpolateImageFunctionBase() override{};
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
   /** Compute the BCO coefficients. */
   CoefContainerType EvaluateCoef(const ContinuousIndexValueType& indexValue) const;
+  /** Compute the m_WinSize BCO coefficients into bcoCoef, without allocation */
+  void EvaluateCoef(const ContinuousIndexValueType& indexValue, double* bcoCoef) const;
 
   /** Used radius for the BCO */
   unsigned int m_Radius;
@@ -129,6 +147,18 @@ protected:
 private:
   BCOInterpolateImageFunctionBase(const Self&) = delete;
   void operator=(const Self&) = delete;
+
+  /** Component type of the pixel buffer, double when the components are
+   *  not arithmetic (CanEvaluateRows() is then false) */
+  typedef typename InputImageType::InternalPixelType BufferPixelType;
+  typedef typename std::conditional<std::is_arithmetic<BufferPixelType>::value, BufferPixelType, double>::type ComponentType;
+
+  /** Compute the coefficients of the window around position, returns
+   *  the index of its first pixel */
+  long EvaluateWindowCoef(double position, double* bcoCoef) const;
+
+  /** Kernel reading the buffer of the input image */
+  internal::SeparableRowKernel<ComponentType> GetRowKernel() const;
 };
 
 
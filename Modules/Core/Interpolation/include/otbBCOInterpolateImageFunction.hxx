@@ -72,10 +72,18 @@ template <class TInputImage, class TCoordRep>
 typename BCOInterpolateImageFunctionBase<TInputImage, TCoordRep>::CoefContainerType
 BCOInterpolateImageFunctionBase<TInputImage, TCoordRep>::EvaluateCoef(const ContinuousIndexValueType& indexValue) const
 {
-  double offset, dist, position, step;
-
   typename BCOInterpolateImageFunctionBase<TInputImage, TCoordRep>::CoefContainerType bcoCoef(this->m_WinSize);
 
+  this->EvaluateCoef(indexValue, bcoCoef.data());
+
+  return bcoCoef;
+}
+
+template <class TInputImage, class TCoordRep>
+void BCOInterpolateImageFunctionBase<TInputImage, TCoordRep>::EvaluateCoef(const ContinuousIndexValueType& indexValue, double* bcoCoef) const
+{
+  double offset, dist, position, step;
+
   offset = indexValue - itk::Math::Floor<IndexValueType>(indexValue + 0.5);
 
   // Compute BCO coefficients
@@ -115,8 +123,54 @@ BCOInterpolateImageFunctionBase<TInputImage, TCoordRep>::EvaluateCoef(const Cont
 
   for (unsigned int i = 0; i < m_WinSize; ++i)
     bcoCoef[i] /= sum;
+}
 
-  return bcoCoef;
+template <class TInputImage, class TCoordRep>
+long BCOInterpolateImageFunctionBase<TInputImage, TCoordRep>::EvaluateWindowCoef(double position, double* bcoCoef) const
+{
+  this->EvaluateCoef(position, bcoCoef);
+
+  // The window is centered on the closest index
+  return static_cast<long>(itk::Math::Floor<IndexValueType>(position + 0.5)) - static_cast<long>(m_Radius);
+}
+
+template <class TInputImage, class TCoordRep>
+bool BCOInterpolateImageFunctionBase<TInputImage, TCoordRep>::CanEvaluateRows() const
+{
+  return ImageDimension == 2 && std::is_arithmetic<BufferPixelType>::value && this->GetInputImage() != nullptr;
+}
+
+template <class TInputImage, class TCoordRep>
+internal::SeparableRowKernel<typename BCOInterpolateImageFunctionBase<TInputImage, TCoordRep>::ComponentType>
+BCOInterpolateImageFunctionBase<TInputImage, TCoordRep>::GetRowKernel() const
+{
+  if (!this->CanEvaluateRows())
+  {
+    itkExceptionMacro(<< "Rows can only be interpolated in 2D images with arithmetic components");
+  }
+
+  // The window is clamped to the buffered region, as in EvaluateAtContinuousIndex()
+  const InputImageType* image = this->GetInputImage();
+  const auto&           region = image->GetBufferedRegion();
+  return internal::SeparableRowKernel<ComponentType>(reinterpret_cast<const ComponentType*>(image->GetBufferPointer()), region.GetIndex()[0],
+                                                     region.GetIndex()[1], region.GetSize()[0], region.GetSize()[1],
+                                                     image->GetNumberOfComponentsPerPixel(), m_WinSize, true);
+}
+
+template <class TInputImage, class TCoordRep>
+void BCOInterpolateImageFunctionBase<TInputImage, TCoordRep>::EvaluateRowAtContinuousIndex(const RowContinuousIndexType& start, double step,
+                                                                                           unsigned int count, double* values) const
+{
+  auto weights = [this](double position, double* coefs) { return this->EvaluateWindowCoef(position, coefs); };
+  this->GetRowKernel().EvaluateRow(start[0], start[1], step, count, weights, values);
+}
+
+template <class TInputImage, class TCoordRep>
+void BCOInterpolateImageFunctionBase<TInputImage, TCoordRep>::EvaluateAtContinuousIndices(const RowContinuousIndexType* indices, unsigned int count,
+                                                                                          double* values) const
+{
+  auto weights = [this](double position, double* coefs) { return this->EvaluateWindowCoef(position, coefs); };
+  this->GetRowKernel().EvaluatePoints(indices, count, weights, values);
 }
 
 template <class TInputImage, class TCoordRep>
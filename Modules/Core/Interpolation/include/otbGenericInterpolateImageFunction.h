@@ -21,9 +21,13 @@
 #ifndef otbGenericInterpolateImageFunction_h
 #define otbGenericInterpolateImageFunction_h
 
+#include <type_traits>
+#include <vector>
+
 #include "itkInterpolateImageFunction.h"
 #include "itkConstNeighborhoodIterator.h"
 #include "itkConstantBoundaryCondition.h"
+#include "otbSeparableRowInterpolator.h"
 
 namespace otb
 {
@@ -36,12 +40,16 @@ namespace otb
  *
  * The Initialize() method need to be call to create the filter.
  *
+ * With the default boundary conditions (zero flux Neumann or constant),
+ * rows of positions can be interpolated in one call through the
+ * SeparableRowInterpolator interface.
+ *
  * \ingroup ImageFunctions ImageInterpolators
  *
  * \ingroup OTBInterpolation
  */
 template <class TInputImage, class TFunction, class TBoundaryCondition = itk::ZeroFluxNeumannBoundaryCondition<TInputImage>, class TCoordRep = double>
-class ITK_EXPORT GenericInterpolateImageFunction : public itk::InterpolateImageFunction<TInputImage, TCoordRep>
+class ITK_EXPORT GenericInterpolateImageFunction : public itk::InterpolateImageFunction<TInputImage, TCoordRep>, public SeparableRowInterpolator<TCoordRep>
 {
 public:
   /** Standard class typedefs. */
@@ -73,6 +81,9 @@ public:
   /** ContinuousIndex typedef support. */
   typedef typename Superclass::ContinuousIndexType ContinuousIndexType;
 
+  /** ContinuousIndex of the SeparableRowInterpolator interface */
+  typedef typename SeparableRowInterpolator<TCoordRep>::ContinuousIndexType RowContinuousIndexType;
+
   /** Dimension underlying input image. */
   itkStaticConstMacro(ImageDimension, unsigned int, Superclass::ImageDimension);
 
@@ -86,6 +97,13 @@ public:
    * calling the method. */
   OutputType EvaluateAtContinuousIndex(const ContinuousIndexType& index) const override;
 
+  /** SeparableRowInterpolator implementation, for 2D images whose
+   *  components are arithmetic values, with a zero flux Neumann or a
+   *  constant boundary condition. */
+  bool CanEvaluateRows() const override;
+  void EvaluateRowAtContinuousIndex(const RowContinuousIndexType& start, double step, unsigned int count, double* values) const override;
+  void EvaluateAtContinuousIndices(const RowContinuousIndexType* indices, unsigned int count, double* values) const override;
+
   /** Set/Get the window radius*/
   virtual void SetRadius(unsigned int rad);
   virtual unsigned int GetRadius() const
@@ -111,6 +129,19 @@ public:
   itkSetMacro(NormalizeWeight, bool);
   itkGetMacro(NormalizeWeight, bool);
 
+  /** Set/Get the boundary condition used outside the buffered region,
+   *  e.g. to give the constant of an itk::ConstantBoundaryCondition */
+  void SetBoundaryCondition(const TBoundaryCondition& condition)
+  {
+    m_BoundaryCondition = condition;
+    // The tables do not depend on the boundary condition
+    Superclass::Modified();
+  }
+  const TBoundaryCondition& GetBoundaryCondition() const
+  {
+    return m_BoundaryCondition;
+  }
+
 protected:
   GenericInterpolateImageFunction();
   ~GenericInterpolateImageFunction() override;
@@ -130,6 +161,27 @@ protected:
 private:
   GenericInterpolateImageFunction(const Self&) = delete;
   void operator=(const Self&) = delete;
+
+  /** Component type of the pixel buffer, double when the components are
+   *  not arithmetic (CanEvaluateRows() is then false) */
+  typedef typename InputImageType::InternalPixelType BufferPixelType;
+  typedef typename std::conditional<std::is_arithmetic<BufferPixelType>::value, BufferPixelType, double>::type ComponentType;
+
+  /** Compute the weights of the window around position, returns the
+   *  index of its first pixel */
+  long EvaluateWindowWeights(double position, double* weights) const;
+
+  /** Kernel reading the buffer of the input image */
+  internal::SeparableRowKernel<ComponentType> GetRowKernel() const;
+
+  /** Components of the pixel outside the buffered region, empty when
+   *  they are all zero or when the condition is not a constant one */
+  template <class TCondition>
+  static std::vector<ComponentType> GetBorderComponents(const TCondition&)
+  {
+    return std::vector<ComponentType>();
+  }
+  static std::vector<ComponentType> GetBorderComponents(const itk::ConstantBoundaryCondition<TInputImage>& condition);
   /** Store the window radius. */
   // unsigned int m_Radius;
   // Constant to store twice the radius
@@ -154,6 +206,9 @@ private:
   mutable bool m_TablesHaveBeenGenerated;
   /** Weights normalization */
   bool m_NormalizeWeight;
+  /** Boundary condition of the neighborhood iterators, mutable as they
+   *  are given a non const pointer to it */
+  mutable TBoundaryCondition m_BoundaryCondition;
 };
 
 } // end namespace itk
@@ -22,6 +22,10 @@
 #define otbGenericInterpolateImageFunction_hxx
 #include "otbGenericInterpolateImageFunction.h"
 #include "vnl/vnl_math.h"
+#include "itkZeroFluxNeumannBoundaryCondition.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include <cmath>
+#include <utility>
 
 namespace otb
 {
@@ -212,6 +216,7 @@ GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoo
   SizeType radius;
   radius.Fill(this->GetRadius());
   IteratorType nit = IteratorType(radius, this->GetInputImage(), this->GetInputImage()->GetBufferedRegion());
+  nit.OverrideBoundaryCondition(&m_BoundaryCondition);
   nit.SetLocation(baseIndex);
 
   const unsigned int twiceRadius = static_cast<const unsigned int>(2 * this->GetRadius());
@@ -303,6 +308,117 @@ GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoo
   return static_cast<OutputType>(xPixelValue);
 }
 
+template <class TInputImage, class TFunction, class TBoundaryCondition, class TCoordRep>
+bool GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoordRep>::CanEvaluateRows() const
+{
+  const bool knownBoundary = std::is_same<TBoundaryCondition, itk::ZeroFluxNeumannBoundaryCondition<TInputImage>>::value ||
+                             std::is_same<TBoundaryCondition, itk::ConstantBoundaryCondition<TInputImage>>::value;
+  return ImageDimension == 2 && knownBoundary && std::is_arithmetic<BufferPixelType>::value && this->GetInputImage() != nullptr;
+}
+
+template <class TInputImage, class TFunction, class TBoundaryCondition, class TCoordRep>
+long GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoordRep>::EvaluateWindowWeights(double position, double* weights) const
+{
+  // Same weights as EvaluateAtContinuousIndex(): the window spans
+  // [floor(position) - radius + 1, floor(position) + radius]
+  const long   baseIndex = static_cast<long>(std::floor(position));
+  const double distance  = position - static_cast<double>(baseIndex);
+
+  double x = distance + this->GetRadius();
+  for (unsigned int i = 0; i < m_WindowSize; ++i)
+  {
+    x -= 1.0;
+    weights[i] = m_Function(x);
+  }
+  if (m_NormalizeWeight == true)
+  {
+    double sum = 0.;
+    for (unsigned int i = 0; i < m_WindowSize; ++i)
+    {
+      sum += weights[i];
+    }
+    if (sum != 1.)
+    {
+      for (unsigned int i = 0; i < m_WindowSize; ++i)
+      {
+        weights[i] = weights[i] / sum;
+      }
+    }
+  }
+  return baseIndex - static_cast<long>(this->GetRadius()) + 1;
+}
+
+template <class TInputImage, class TFunction, class TBoundaryCondition, class TCoordRep>
+internal::SeparableRowKernel<typename GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoordRep>::ComponentType>
+GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoordRep>::GetRowKernel() const
+{
+  if (!m_TablesHaveBeenGenerated)
+  {
+    itkExceptionMacro(<< "The Interpolation functor need to be explicitly intanciated with the method Initialize()");
+  }
+  if (!this->CanEvaluateRows())
+  {
+    itkExceptionMacro(<< "Rows can only be interpolated in 2D images with arithmetic components");
+  }
+
+  // The boundary condition applies to the buffered region, as the
+  // neighborhood iterator of EvaluateAtContinuousIndex() does
+  const bool            clamp        = std::is_same<TBoundaryCondition, itk::ZeroFluxNeumannBoundaryCondition<TInputImage>>::value;
+  const InputImageType* image        = this->GetInputImage();
+  const auto&           region       = image->GetBufferedRegion();
+  const unsigned int    nbComponents = image->GetNumberOfComponentsPerPixel();
+
+  std::vector<ComponentType> border = GetBorderComponents(m_BoundaryCondition);
+  if (!border.empty())
+  {
+    border.resize(nbComponents, 0);
+  }
+  return internal::SeparableRowKernel<ComponentType>(reinterpret_cast<const ComponentType*>(image->GetBufferPointer()), region.GetIndex()[0],
+                                                     region.GetIndex()[1], region.GetSize()[0], region.GetSize()[1], nbComponents, m_WindowSize,
+                                                     clamp, std::move(border));
+}
+
+template <class TInputImage, class TFunction, class TBoundaryCondition, class TCoordRep>
+std::vector<typename GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoordRep>::ComponentType>
+GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoordRep>::GetBorderComponents(
+    const itk::ConstantBoundaryCondition<TInputImage>& condition)
+{
+  typedef typename InputImageType::PixelType        PixelType;
+  typedef itk::DefaultConvertPixelTraits<PixelType> PixelTraitsType;
+
+  const PixelType&           constant     = condition.GetConstant();
+  const unsigned int         nbComponents = itk::NumericTraits<PixelType>::GetLength(constant);
+  std::vector<ComponentType> border(nbComponents);
+  bool                       zero = true;
+  for (unsigned int k = 0; k < nbComponents; ++k)
+  {
+    border[k] = static_cast<ComponentType>(PixelTraitsType::GetNthComponent(k, constant));
+    zero      = zero && border[k] == 0;
+  }
+  if (zero)
+  {
+    border.clear();
+  }
+  return border;
+}
+
+template <class TInputImage, class TFunction, class TBoundaryCondition, class TCoordRep>
+void GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoordRep>::EvaluateRowAtContinuousIndex(const RowContinuousIndexType& start,
+                                                                                                                          double step, unsigned int count,
+                                                                                                                          double* values) const
+{
+  auto weights = [this](double position, double* w) { return this->EvaluateWindowWeights(position, w); };
+  this->GetRowKernel().EvaluateRow(start[0], start[1], step, count, weights, values);
+}
+
+template <class TInputImage, class TFunction, class TBoundaryCondition, class TCoordRep>
+void GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoordRep>::EvaluateAtContinuousIndices(const RowContinuousIndexType* indices,
+                                                                                                                         unsigned int count, double* values) const
+{
+  auto weights = [this](double position, double* w) { return this->EvaluateWindowWeights(position, w); };
+  this->GetRowKernel().EvaluatePoints(indices, count, weights, values);
+}
+
 template <class TInputImage, class TFunction, class TBoundaryCondition, class TCoordRep>
 void GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoordRep>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
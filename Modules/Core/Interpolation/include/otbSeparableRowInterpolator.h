@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSeparableRowInterpolator_h
+#define otbSeparableRowInterpolator_h
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+#include "itkContinuousIndex.h"
+
+namespace otb
+{
+
+/** \class SeparableRowInterpolator
+ *  \brief Interface of the interpolators evaluating many positions in one call
+ *
+ * Interpolators whose weights are separable (BCO, windowed sinc,
+ * prolate) implement this interface besides itk::InterpolateImageFunction,
+ * so that resampling filters can interpolate a whole output row at once:
+ * the weights along the lines are computed once per row, each input
+ * column of the window is filtered once for all the output pixels
+ * sharing it, and all the bands of a pixel are accumulated together,
+ * without any allocation per pixel.
+ *
+ * The interpolated values are written as doubles, all the components of
+ * the first position, then all the components of the second one, and so
+ * on. These methods can only be used when CanEvaluateRows() is true,
+ * i.e. for 2D images of scalar or vector pixels with arithmetic
+ * components.
+ *
+ * \ingroup ImageInterpolators
+ *
+ * \ingroup OTBInterpolation
+ */
+template <class TCoordRep = double>
+class SeparableRowInterpolator
+{
+public:
+  /** ContinuousIndex typedef support. */
+  typedef itk::ContinuousIndex<TCoordRep, 2> ContinuousIndexType;
+
+  virtual ~SeparableRowInterpolator() = default;
+
+  /** True if the input image can be interpolated through this interface */
+  virtual bool CanEvaluateRows() const = 0;
+
+  /** Interpolate the count positions start + n * (step, 0). values must
+   *  hold count times the number of components per pixel. */
+  virtual void EvaluateRowAtContinuousIndex(const ContinuousIndexType& start, double step, unsigned int count, double* values) const = 0;
+
+  /** Interpolate count positions anywhere in the image. values must hold
+   *  count times the number of components per pixel. */
+  virtual void EvaluateAtContinuousIndices(const ContinuousIndexType* indices, unsigned int count, double* values) const = 0;
+};
+
+namespace internal
+{
+
+/** \class SeparableRowKernel
+ *  \brief Interpolation of a 2D pixel buffer with separable weights
+ *
+ * The weights are given by a function object with the signature
+ * long (double position, double* weights), which fills the weights of
+ * the window along one axis and returns the index of its first pixel.
+ *
+ * Samples outside the buffer are either those of the nearest border
+ * pixel (Clamp) or those of a constant border pixel, zero when no border
+ * pixel is given.
+ *
+ * \ingroup OTBInterpolation
+ */
+template <class TComponent>
+class SeparableRowKernel
+{
+public:
+  typedef boost::container::small_vector<double, 16> WeightsType;
+
+  SeparableRowKernel(const TComponent* buffer, long startX, long startY, long sizeX, long sizeY, unsigned int nbComponents, unsigned int windowSize,
+                     bool clamp, std::vector<TComponent> border = std::vector<TComponent>())
+    : m_Buffer(buffer),
+      m_StartX(startX),
+      m_StartY(startY),
+      m_SizeX(sizeX),
+      m_SizeY(sizeY),
+      m_NbComponents(nbComponents),
+      m_WindowSize(windowSize),
+      m_Clamp(clamp),
+      m_Border(std::move(border))
+  {
+  }
+
+  /** Interpolate the count positions (x + n * step, y) */
+  template <class TWeightsFunction>
+  void EvaluateRow(double x, double y, double step, unsigned int count, const TWeightsFunction& weights, double* values) const
+  {
+    if (count == 0)
+      return;
+
+    WeightsType wx(m_WindowSize), wy(m_WindowSize);
+    const long  firstY = weights(y, wy.data());
+
+    // Past this step, the columns would be filtered for more pixels
+    // than they are used for
+    if (std::abs(step) >= m_WindowSize - 1)
+    {
+      WeightsType lineRes(m_NbComponents);
+      for (unsigned int n = 0; n < count; ++n)
+      {
+        const long firstX = weights(x + n * step, wx.data());
+        this->EvaluateWindow(firstX, firstY, wx.data(), wy.data(), lineRes.data(), values + n * m_NbComponents);
+      }
+      return;
+    }
+
+    // Filter once the input columns covered by the row
+    const double xLast  = x + (count - 1) * step;
+    const long   firstX = weights(std::min(x, xLast), wx.data());
+    const long   lastX  = weights(std::max(x, xLast), wx.data()) + static_cast<long>(m_WindowSize) - 1;
+
+    std::vector<double> columns((lastX - firstX + 1) * m_NbComponents, 0.);
+    for (unsigned int j = 0; j < m_WindowSize; ++j)
+    {
+      const TComponent* line = this->GetLine(firstY + static_cast<long>(j));
+      if (line == nullptr && m_Border.empty())
+        continue;
+      const double w      = wy[j];
+      double*      column = columns.data();
+      for (long c = firstX; c <= lastX; ++c, column += m_NbComponents)
+      {
+        const TComponent* pixel = this->GetPixel(line, c);
+        if (pixel == nullptr)
+          continue;
+        for (unsigned int k = 0; k < m_NbComponents; ++k)
+          column[k] += static_cast<double>(pixel[k]) * w;
+      }
+    }
+
+    // Then combine the filtered columns of each window
+    for (unsigned int n = 0; n < count; ++n)
+    {
+      const long    first  = weights(x + n * step, wx.data());
+      const double* column = columns.data() + (first - firstX) * m_NbComponents;
+      double*       value  = values + n * m_NbComponents;
+      std::fill(value, value + m_NbComponents, 0.);
+      for (unsigned int i = 0; i < m_WindowSize; ++i, column += m_NbComponents)
+      {
+        const double w = wx[i];
+        for (unsigned int k = 0; k < m_NbComponents; ++k)
+          value[k] += column[k] * w;
+      }
+    }
+  }
+
+  /** Interpolate count positions anywhere in the buffer */
+  template <class TContinuousIndex, class TWeightsFunction>
+  void EvaluatePoints(const TContinuousIndex* indices, unsigned int count, const TWeightsFunction& weights, double* values) const
+  {
+    WeightsType wx(m_WindowSize), wy(m_WindowSize), lineRes(m_NbComponents);
+    for (unsigned int n = 0; n < count; ++n)
+    {
+      const long firstX = weights(indices[n][0], wx.data());
+      const long firstY = weights(indices[n][1], wy.data());
+      this->EvaluateWindow(firstX, firstY, wx.data(), wy.data(), lineRes.data(), values + n * m_NbComponents);
+    }
+  }
+
+private:
+  /** Weighted sum of the window starting at (firstX, firstY) */
+  void EvaluateWindow(long firstX, long firstY, const double* wx, const double* wy, double* lineRes, double* value) const
+  {
+    std::fill(value, value + m_NbComponents, 0.);
+    for (unsigned int i = 0; i < m_WindowSize; ++i)
+    {
+      std::fill(lineRes, lineRes + m_NbComponents, 0.);
+      for (unsigned int j = 0; j < m_WindowSize; ++j)
+      {
+        const TComponent* line = this->GetLine(firstY + static_cast<long>(j));
+        if (line == nullptr && m_Border.empty())
+          continue;
+        const TComponent* pixel = this->GetPixel(line, firstX + static_cast<long>(i));
+        if (pixel == nullptr)
+          continue;
+        const double w = wy[j];
+        for (unsigned int k = 0; k < m_NbComponents; ++k)
+          lineRes[k] += static_cast<double>(pixel[k]) * w;
+      }
+      const double w = wx[i];
+      for (unsigned int k = 0; k < m_NbComponents; ++k)
+        value[k] += lineRes[k] * w;
+    }
+  }
+
+  /** First sample of line y, nullptr if it is outside the buffer and not clamped */
+  const TComponent* GetLine(long y) const
+  {
+    y -= m_StartY;
+    if (y < 0 || y >= m_SizeY)
+    {
+      if (!m_Clamp)
+        return nullptr;
+      y = y < 0 ? 0 : m_SizeY - 1;
+    }
+    return m_Buffer + y * m_SizeX * m_NbComponents;
+  }
+
+  /** First sample of pixel x of the line, the border pixel if the line
+   *  or the pixel are outside the buffer and not clamped (nullptr if
+   *  there is no border pixel) */
+  const TComponent* GetPixel(const TComponent* line, long x) const
+  {
+    if (line == nullptr)
+      return m_Border.empty() ? nullptr : m_Border.data();
+    x -= m_StartX;
+    if (x < 0 || x >= m_SizeX)
+    {
+      if (!m_Clamp)
+        return m_Border.empty() ? nullptr : m_Border.data();
+      x = x < 0 ? 0 : m_SizeX - 1;
+    }
+    return line + x * m_NbComponents;
+  }
+
+  const TComponent*  m_Buffer;
+  const long         m_StartX;
+  const long         m_StartY;
+  const long         m_SizeX;
+  const long         m_SizeY;
+  const unsigned int m_NbComponents;
+  const unsigned int m_WindowSize;
+  const bool         m_Clamp;
+  /** Components of the pixel outside the buffer, empty for zero */
+  const std::vector<TComponent> m_Border;
+};
+
+} // end namespace internal
+
+} // end namespace otb
+
+#endif
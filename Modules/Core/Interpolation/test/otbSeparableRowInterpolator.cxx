@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "otbBCOInterpolateImageFunction.h"
+#include "otbWindowedSincInterpolateImageLanczosFunction.h"
+#include "otbWindowedSincInterpolateImageHammingFunction.h"
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+
+namespace
+{
+// Compare rows and scattered positions interpolated through the
+// SeparableRowInterpolator interface with EvaluateAtContinuousIndex()
+template <class TInterpolator>
+bool CheckRows(const TInterpolator* interpolator, unsigned int nbComponents, const char* name)
+{
+  typedef typename TInterpolator::ContinuousIndexType    ContinuousIndexType;
+  typedef typename TInterpolator::RowContinuousIndexType RowContinuousIndexType;
+
+  if (!interpolator->CanEvaluateRows())
+  {
+    std::cerr << name << " can not evaluate rows" << std::endl;
+    return false;
+  }
+
+  const double tolerance = 1e-9;
+  bool         success   = true;
+
+  // Upsampling, downsampling, reversed rows, and rows crossing the borders
+  const double       starts[][2] = {{10.25, 20.7}, {-3.4, 1.1}, {200.6, 120.35}, {0.5, -2.2}};
+  const double       steps[]     = {0.37, 1., 2.5, 11., -0.8};
+  const unsigned int count       = 40;
+
+  std::vector<double>                 values(count * nbComponents);
+  std::vector<RowContinuousIndexType> indices(count);
+  for (const auto& start : starts)
+  {
+    for (double step : steps)
+    {
+      RowContinuousIndexType rowStart;
+      rowStart[0] = start[0];
+      rowStart[1] = start[1];
+      interpolator->EvaluateRowAtContinuousIndex(rowStart, step, count, values.data());
+
+      for (unsigned int n = 0; n < count; ++n)
+      {
+        ContinuousIndexType index;
+        index[0]            = start[0] + n * step;
+        index[1]            = start[1];
+        const auto expected = interpolator->EvaluateAtContinuousIndex(index);
+        for (unsigned int k = 0; k < nbComponents; ++k)
+        {
+          if (std::abs(values[n * nbComponents + k] - expected[k]) > tolerance)
+          {
+            std::cerr << name << ": row value " << values[n * nbComponents + k] << " at " << index << " band " << k << " instead of " << expected[k]
+                      << std::endl;
+            success = false;
+          }
+        }
+
+        // Scattered positions around the row
+        indices[n][0] = index[0];
+        indices[n][1] = start[1] + 0.13 * n;
+      }
+
+      interpolator->EvaluateAtContinuousIndices(indices.data(), count, values.data());
+      for (unsigned int n = 0; n < count; ++n)
+      {
+        ContinuousIndexType index;
+        index[0]            = indices[n][0];
+        index[1]            = indices[n][1];
+        const auto expected = interpolator->EvaluateAtContinuousIndex(index);
+        for (unsigned int k = 0; k < nbComponents; ++k)
+        {
+          if (std::abs(values[n * nbComponents + k] - expected[k]) > tolerance)
+          {
+            std::cerr << name << ": value " << values[n * nbComponents + k] << " at " << index << " band " << k << " instead of " << expected[k]
+                      << std::endl;
+            success = false;
+          }
+        }
+      }
+    }
+  }
+  return success;
+}
+} // end anonymous namespace
+
+int otbSeparableRowInterpolator(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <input multiband image>" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  typedef otb::VectorImage<double, 2>                                                       ImageType;
+  typedef otb::ImageFileReader<ImageType>                                                   ReaderType;
+  typedef otb::BCOInterpolateImageFunction<ImageType>                                       BCOInterpolatorType;
+  typedef otb::WindowedSincInterpolateImageLanczosFunction<ImageType>                       LanczosInterpolatorType;
+  typedef itk::ZeroFluxNeumannBoundaryCondition<ImageType>                                  NeumannConditionType;
+  typedef otb::WindowedSincInterpolateImageHammingFunction<ImageType, NeumannConditionType> HammingInterpolatorType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+  reader->Update();
+  const unsigned int nbComponents = reader->GetOutput()->GetNumberOfComponentsPerPixel();
+
+  BCOInterpolatorType::Pointer bco = BCOInterpolatorType::New();
+  bco->SetRadius(3);
+  bco->SetInputImage(reader->GetOutput());
+
+  // Constant boundary condition
+  LanczosInterpolatorType::Pointer lanczos = LanczosInterpolatorType::New();
+  lanczos->SetRadius(3);
+  lanczos->SetInputImage(reader->GetOutput());
+  lanczos->Initialize();
+
+  // Non zero constant boundary condition
+  typedef itk::ConstantBoundaryCondition<ImageType> ConstantConditionType;
+  ImageType::PixelType                              constant(nbComponents);
+  for (unsigned int k = 0; k < nbComponents; ++k)
+    constant[k] = 100. + 10. * k;
+  ConstantConditionType condition;
+  condition.SetConstant(constant);
+  LanczosInterpolatorType::Pointer lanczosConstant = LanczosInterpolatorType::New();
+  lanczosConstant->SetRadius(3);
+  lanczosConstant->SetBoundaryCondition(condition);
+  lanczosConstant->SetInputImage(reader->GetOutput());
+  lanczosConstant->Initialize();
+
+  // Zero flux Neumann boundary condition, normalized weights
+  HammingInterpolatorType::Pointer hamming = HammingInterpolatorType::New();
+  hamming->SetRadius(2);
+  hamming->SetNormalizeWeight(true);
+  hamming->SetInputImage(reader->GetOutput());
+  hamming->Initialize();
+
+  const bool success = CheckRows(bco.GetPointer(), nbComponents, "BCO") && CheckRows(lanczos.GetPointer(), nbComponents, "Lanczos") &&
+                       CheckRows(lanczosConstant.GetPointer(), nbComponents, "Lanczos with a constant") &&
+                       CheckRows(hamming.GetPointer(), nbComponents, "Hamming");
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
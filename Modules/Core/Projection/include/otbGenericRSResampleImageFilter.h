@@ -106,6 +106,15 @@ public:
 
   otbGetObjectMemberConstReferenceMacro(Resampler, DisplacementFieldSpacing, SpacingType);
 
+  /** Maximum error of the displacement field in input pixels, 0 to
+   * interpolate the DisplacementFieldSpacing grid everywhere.
+   * \sa StreamingResampleImageFilter::SetDisplacementFieldMaximumError() */
+  otbSetObjectMemberMacro(Resampler, DisplacementFieldMaximumError, double);
+  otbGetObjectMemberConstMacro(Resampler, DisplacementFieldMaximumError, double);
+
+  /** Largest error measured when refining the displacement field, in input pixels */
+  otbGetObjectMemberConstMacro(Resampler, DisplacementFieldEstimatedError, double);
+
   /** The resampled image parameters */
   /** Output Origin */
   void SetOutputOrigin(const OriginType& origin)
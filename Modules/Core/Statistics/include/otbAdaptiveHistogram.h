@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbAdaptiveHistogram_h
+#define otbAdaptiveHistogram_h
+
+#include "OTBStatisticsExport.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace otb
+{
+
+/** \class AdaptiveHistogram
+ * \brief Histogram of values whose range is not known in advance.
+ *
+ * The bins have a width of a power of two and are aligned on the multiples
+ * of this width. The bin width starts as fine as the double precision
+ * allows, and is doubled as many times as needed for the values added so
+ * far to fit in the bins. Two histograms are merged exactly: the bins of
+ * the finer one fall in exactly one bin of the coarser one.
+ *
+ * Once all the values are added, Rebin() gives the frequencies of any set
+ * of equal width bins. Each value is counted in the bin containing the
+ * center of its fine bin, so it is misplaced by at most half of
+ * GetBinWidth(). The fine bins cover at least half of the value range each
+ * time they are widened, hence GetBinWidth() is less than
+ * 4 * (GetMaximum() - GetMinimum()) / GetNumberOfBins(), or than the
+ * spacing of the doubles around the values if it is larger. When all the
+ * values are integers and the fine bins are not wider than 1, the lower
+ * bound of the fine bins is used instead and the values are counted
+ * exactly.
+ *
+ * Non finite values are ignored.
+ *
+ * \ingroup OTBStatistics
+ */
+class OTBStatistics_EXPORT AdaptiveHistogram
+{
+public:
+  typedef std::uint64_t              FrequencyType;
+  typedef std::vector<FrequencyType> FrequencyVectorType;
+
+  /** Build an empty histogram with numberOfBins fine bins */
+  explicit AdaptiveHistogram(unsigned int numberOfBins = 4096);
+
+  /** Add one occurrence of value */
+  void Add(double value);
+
+  /** Add the values of other */
+  void Merge(const AdaptiveHistogram& other);
+
+  bool IsEmpty() const
+  {
+    return m_TotalFrequency == 0;
+  }
+
+  FrequencyType GetTotalFrequency() const
+  {
+    return m_TotalFrequency;
+  }
+
+  /** Smallest and largest values added, exactly */
+  double GetMinimum() const
+  {
+    return m_Minimum;
+  }
+  double GetMaximum() const
+  {
+    return m_Maximum;
+  }
+
+  /** Number of fine bins */
+  unsigned int GetNumberOfBins() const
+  {
+    return m_NumberOfBins;
+  }
+
+  /** Width of the fine bins */
+  double GetBinWidth() const;
+
+  /** Frequencies of numberOfBins bins of equal width between lower and
+   *  upper. The values below lower (resp. above upper) are counted in the
+   *  first (resp. last) bin. */
+  FrequencyVectorType Rebin(double lower, double upper, unsigned int numberOfBins) const;
+
+private:
+  /** Widen the bins until they cover [lower, upper], with a bin width of
+   *  at least 2^minimumExponent */
+  void Cover(double lower, double upper, int minimumExponent);
+
+  unsigned int m_NumberOfBins;
+
+  /** The bins are [k * 2^m_Exponent, (k + 1) * 2^m_Exponent) for k starting
+   *  at m_Offset */
+  int          m_Exponent;
+  std::int64_t m_Offset;
+
+  double              m_Minimum;
+  double              m_Maximum;
+  bool                m_Integral;
+  FrequencyType       m_TotalFrequency;
+  FrequencyVectorType m_Frequencies;
+};
+
+} // end namespace otb
+
+#endif
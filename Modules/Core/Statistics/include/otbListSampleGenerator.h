@@ -26,6 +26,7 @@
 #include "itkListSample.h"
 #include "itkPreOrderTreeIterator.h"
 #include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "otbSampleStore.h"
 #include <string>
 
 namespace otb
@@ -47,6 +48,11 @@ namespace otb
  *
  *  The input VectorData is supposed to be fully contained within the image extent
  *
+ *  Instead of an image and a VectorData, the samples can be read from a
+ *  sample store written by SampleExtraction (see SetSampleStoreFileName()).
+ *  The size of a class is then its number of samples, and its label the
+ *  label of the store, cast to an integer.
+ *
  *
  * \ingroup OTBStatistics
  */
@@ -96,6 +102,11 @@ public:
   void                  SetInputVectorData(const VectorDataType*);
   const VectorDataType* GetInputVectorData() const;
 
+  /** Read the samples from a sample store instead of the image and the
+   *  vector data, which are then not needed (empty name to use them) */
+  void SetSampleStoreFileName(const std::string& fileName);
+  itkGetStringMacro(SampleStoreFileName);
+
   // Build the outputs
   typedef itk::DataObject::Pointer DataObjectPointer;
   DataObjectPointer MakeOutput(DataObjectPointerArraySizeType idx) override;
@@ -165,6 +176,9 @@ protected:
   /** Compute the class statistics*/
   void GenerateClassStatistics();
 
+  /** Fill the outputs from the sample store */
+  void GenerateDataFromSampleStore();
+
 private:
   ListSampleGenerator(const Self&) = delete;
   void operator=(const Self&) = delete;
@@ -195,6 +209,7 @@ private:
   unsigned short m_NumberOfClasses;
   std::string    m_ClassKey;
   double         m_ClassMinSize;
+  std::string    m_SampleStoreFileName;
 
   std::map<ClassLabelType, double> m_ClassesSize;
   std::map<ClassLabelType, double> m_ClassesProbTraining;
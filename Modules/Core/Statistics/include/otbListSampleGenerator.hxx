@@ -24,6 +24,7 @@
 #include "otbListSampleGenerator.h"
 
 #include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkDefaultConvertPixelTraits.h"
 #include "otbVectorDataProjectionFilter.h"
 
 #include "otbMacro.h"
@@ -119,6 +120,18 @@ const TVectorData* ListSampleGenerator<TImage, TVectorData>::GetInputVectorData(
   return static_cast<const VectorDataType*>(this->ProcessObject::GetInput(1));
 }
 
+template <class TImage, class TVectorData>
+void ListSampleGenerator<TImage, TVectorData>::SetSampleStoreFileName(const std::string& fileName)
+{
+  if (fileName != m_SampleStoreFileName)
+  {
+    m_SampleStoreFileName = fileName;
+    // The image and the vector data are not needed with a sample store
+    this->SetNumberOfRequiredInputs(fileName.empty() ? 2 : 0);
+    this->Modified();
+  }
+}
+
 template <class TImage, class TVectorData>
 typename ListSampleGenerator<TImage, TVectorData>::DataObjectPointer ListSampleGenerator<TImage, TVectorData>::MakeOutput(DataObjectPointerArraySizeType idx)
 {
@@ -194,6 +207,12 @@ void ListSampleGenerator<TImage, TVectorData>::GenerateInputRequestedRegion()
 template <class TImage, class TVectorData>
 void ListSampleGenerator<TImage, TVectorData>::GenerateData()
 {
+  if (!m_SampleStoreFileName.empty())
+  {
+    this->GenerateDataFromSampleStore();
+    return;
+  }
+
   // Get the inputs
   ImagePointerType      image      = const_cast<ImageType*>(this->GetInput());
   VectorDataPointerType vectorData = const_cast<VectorDataType*>(this->GetInputVectorData());
@@ -301,6 +320,87 @@ void ListSampleGenerator<TImage, TVectorData>::GenerateData()
   this->UpdateProgress(1.0f);
 }
 
+template <class TImage, class TVectorData>
+void ListSampleGenerator<TImage, TVectorData>::GenerateDataFromSampleStore()
+{
+  SampleStoreReader reader;
+  reader.Open(m_SampleStoreFileName);
+  const unsigned int nbFeatures = reader.GetNumberOfFeatures();
+
+  // Get the outputs
+  ListSamplePointerType trainingListSample   = this->GetTrainingListSample();
+  ListLabelPointerType  trainingListLabel    = this->GetTrainingListLabel();
+  ListSamplePointerType validationListSample = this->GetValidationListSample();
+  ListLabelPointerType  validationListLabel  = this->GetValidationListLabel();
+
+  // The size of a class is its number of samples, a first pass reads
+  // the labels only
+  std::vector<unsigned int> columns(nbFeatures);
+  std::vector<float>        features(static_cast<std::size_t>(reader.GetChunkSize()) * nbFeatures);
+  std::vector<double>       labels(reader.GetChunkSize());
+  m_ClassesSize.clear();
+  for (std::uint64_t chunk = 0; chunk < reader.GetNumberOfChunks(); ++chunk)
+  {
+    const std::size_t count = reader.ReadChunk(chunk, std::vector<unsigned int>(), nullptr, labels.data());
+    for (std::size_t k = 0; k < count; ++k)
+    {
+      m_ClassesSize[static_cast<ClassLabelType>(labels[k])] += 1.0;
+    }
+  }
+  m_NumberOfClasses = m_ClassesSize.size();
+
+  this->ComputeClassSelectionProbability();
+
+  // Clear the sample lists
+  trainingListSample->Clear();
+  trainingListLabel->Clear();
+  validationListSample->Clear();
+  validationListLabel->Clear();
+
+  trainingListSample->SetMeasurementVectorSize(nbFeatures);
+  trainingListLabel->SetMeasurementVectorSize(1);
+  validationListSample->SetMeasurementVectorSize(nbFeatures);
+  validationListLabel->SetMeasurementVectorSize(1);
+
+  m_ClassesSamplesNumberTraining.clear();
+  m_ClassesSamplesNumberValidation.clear();
+
+  for (unsigned int i = 0; i < nbFeatures; ++i)
+  {
+    columns[i] = i;
+  }
+  SampleType sample;
+  itk::NumericTraits<SampleType>::SetLength(sample, nbFeatures);
+  for (std::uint64_t chunk = 0; chunk < reader.GetNumberOfChunks(); ++chunk)
+  {
+    const std::size_t count = reader.ReadChunk(chunk, columns, features.data(), labels.data());
+    for (std::size_t k = 0; k < count; ++k)
+    {
+      const ClassLabelType label = static_cast<ClassLabelType>(labels[k]);
+      for (unsigned int i = 0; i < nbFeatures; ++i)
+      {
+        itk::DefaultConvertPixelTraits<SampleType>::SetNthComponent(i, sample, features[k * nbFeatures + i]);
+      }
+
+      double randomValue = m_RandomGenerator->GetUniformVariate(0.0, 1.0);
+      if (randomValue < m_ClassesProbTraining[label])
+      {
+        trainingListSample->PushBack(sample);
+        trainingListLabel->PushBack(label);
+        m_ClassesSamplesNumberTraining[label] += 1;
+      }
+      else if (randomValue < m_ClassesProbTraining[label] + m_ClassesProbValidation[label])
+      {
+        validationListSample->PushBack(sample);
+        validationListLabel->PushBack(label);
+        m_ClassesSamplesNumberValidation[label] += 1;
+      }
+    }
+  }
+
+  this->UpdateProgress(1.0f);
+}
+
 template <class TImage, class TVectorData>
 void ListSampleGenerator<TImage, TVectorData>::GenerateClassStatistics()
 {
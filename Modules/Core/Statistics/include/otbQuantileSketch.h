@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbQuantileSketch_h
+#define otbQuantileSketch_h
+
+#include "OTBStatisticsExport.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace otb
+{
+
+/** \class QuantileSketch
+ * \brief Approximate quantiles of a stream of values in bounded memory.
+ *
+ * This is a KLL sketch (Karnin, Lang and Liberty, "Optimal Quantile
+ * Approximation in Streams", 2016). The values are kept in levels: a
+ * value of level h stands for 2^h values of the stream. When a level is
+ * full, it is sorted and one value out of two is promoted to the next
+ * level. The capacity of the top level is K, and it decreases by a factor
+ * 2/3 at each level below, so the sketch keeps at most about 3K values
+ * whatever the number of values added.
+ *
+ * The rank of the value returned by Quantile(q) differs from
+ * q * GetCount() by a fraction of GetCount() that decreases as 1/K: with
+ * the default K = 200, it is below about 2% with 99% confidence. The
+ * minimum and maximum are exact. Two sketches are merged with the same
+ * error bound as a sketch of all the values.
+ *
+ * The values promoted at each compaction are chosen by a pseudo random
+ * generator with a fixed seed: adding the same values in the same order,
+ * and merging the same sketches, gives the same result.
+ *
+ * Non finite values are ignored.
+ *
+ * \ingroup OTBStatistics
+ */
+class OTBStatistics_EXPORT QuantileSketch
+{
+public:
+  typedef std::uint64_t CountType;
+
+  /** Build an empty sketch with a top level capacity of k (at least 8) */
+  explicit QuantileSketch(unsigned int k = 200);
+
+  /** Add one occurrence of value */
+  void Add(double value);
+
+  /** Add the values of other */
+  void Merge(const QuantileSketch& other);
+
+  bool IsEmpty() const
+  {
+    return m_Count == 0;
+  }
+
+  /** Number of values added */
+  CountType GetCount() const
+  {
+    return m_Count;
+  }
+
+  /** Smallest and largest values added, exactly */
+  double GetMinimum() const
+  {
+    return m_Minimum;
+  }
+  double GetMaximum() const
+  {
+    return m_Maximum;
+  }
+
+  unsigned int GetK() const
+  {
+    return m_K;
+  }
+
+  /** Number of values currently kept */
+  std::size_t GetNumberOfRetainedValues() const;
+
+  /** Approximate q-quantile, q in [0, 1]. Quantile(0) and Quantile(1) are
+   *  the exact minimum and maximum. Returns NaN if the sketch is empty. */
+  double Quantile(double q) const;
+
+private:
+  /** Capacity of a level, given the current number of levels */
+  std::size_t GetCapacity(std::size_t level) const;
+
+  /** Add numberOfLevels levels on top of the others, and update the
+   *  capacity of level 0 */
+  void AddLevels(std::size_t numberOfLevels);
+
+  /** Compact the levels that are over their capacity */
+  void Compress();
+
+  /** Sort level and promote one value out of two to the next level */
+  void CompactLevel(std::size_t level);
+
+  unsigned int m_K;
+  CountType    m_Count;
+  double       m_Minimum;
+  double       m_Maximum;
+
+  std::vector<std::vector<double>> m_Levels;
+
+  /** Capacity of level 0, which is checked for each value added */
+  std::size_t m_BottomCapacity;
+
+  std::minstd_rand m_Random;
+};
+
+} // end namespace otb
+
+#endif
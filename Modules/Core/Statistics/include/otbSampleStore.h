@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSampleStore_h
+#define otbSampleStore_h
+
+#include "OTBStatisticsExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+/** \class SampleStoreWriter
+ * \brief Write samples in a columnar binary file.
+ *
+ * A sample store keeps, for each sample, a label (64 bits float) and a
+ * fixed number of features (32 bits floats), with a name for the label
+ * and for each feature. The file is made of:
+ *
+ * - a header: the magic string "OTBSAMPL", then as unsigned integers in
+ *   the byte order of the writer the version (1), the byte order mark
+ *   0x01020304, the number of features, the chunk size (32 bits each),
+ *   the number of samples and the offset of the first chunk (64 bits
+ *   each), then the label name and the feature names, each as a 32 bits
+ *   length followed by the characters;
+ * - chunks of ChunkSize samples, starting at an offset multiple of 64:
+ *   the label column, then one column per feature. The last chunk is
+ *   padded with zeros.
+ *
+ * Every column starts at a fixed offset aligned on 64 bytes, so the
+ * file can be memory-mapped, and a reader only needing some features
+ * reads only their columns.
+ *
+ * \sa SampleStoreReader
+ *
+ * \ingroup OTBStatistics
+ */
+class OTBStatistics_EXPORT SampleStoreWriter
+{
+public:
+  /** Default number of samples per chunk */
+  static const unsigned int DefaultChunkSize = 4096;
+
+  SampleStoreWriter();
+
+  /** Close the file if it is open, without throwing */
+  ~SampleStoreWriter();
+
+  /** Create the file. The chunk size is rounded up to a multiple of 16. */
+  void Open(const std::string& fileName, const std::vector<std::string>& featureNames, const std::string& labelName,
+            unsigned int chunkSize = DefaultChunkSize);
+
+  /** Append a sample, features has GetNumberOfFeatures() values */
+  void Append(const float* features, double label);
+
+  /** Write the last chunk and the number of samples */
+  void Close();
+
+  bool IsOpen() const
+  {
+    return m_File.is_open();
+  }
+
+  unsigned int GetNumberOfFeatures() const
+  {
+    return static_cast<unsigned int>(m_FeatureNames.size());
+  }
+
+  std::uint64_t GetNumberOfSamples() const
+  {
+    return m_NumberOfSamples;
+  }
+
+private:
+  SampleStoreWriter(const SampleStoreWriter&) = delete;
+  void operator=(const SampleStoreWriter&) = delete;
+
+  void WriteChunk();
+
+  std::ofstream            m_File;
+  std::string              m_FileName;
+  std::vector<std::string> m_FeatureNames;
+  unsigned int             m_ChunkSize;
+  std::uint64_t            m_NumberOfSamples;
+
+  /** Current chunk, in the layout of the file */
+  std::vector<double> m_Labels;
+  std::vector<float>  m_Features;
+  unsigned int        m_ChunkCount;
+};
+
+/** \class SampleStoreReader
+ * \brief Read samples from a file written by SampleStoreWriter.
+ *
+ * The samples are read by chunks, with only the feature columns needed.
+ *
+ * \sa SampleStoreWriter
+ *
+ * \ingroup OTBStatistics
+ */
+class OTBStatistics_EXPORT SampleStoreReader
+{
+public:
+  SampleStoreReader();
+
+  /** Check the magic string of a file */
+  static bool CanReadFile(const std::string& fileName);
+
+  void Open(const std::string& fileName);
+
+  void Close();
+
+  std::uint64_t GetNumberOfSamples() const
+  {
+    return m_NumberOfSamples;
+  }
+
+  unsigned int GetNumberOfFeatures() const
+  {
+    return static_cast<unsigned int>(m_FeatureNames.size());
+  }
+
+  const std::vector<std::string>& GetFeatureNames() const
+  {
+    return m_FeatureNames;
+  }
+
+  const std::string& GetLabelName() const
+  {
+    return m_LabelName;
+  }
+
+  unsigned int GetChunkSize() const
+  {
+    return m_ChunkSize;
+  }
+
+  std::uint64_t GetNumberOfChunks() const
+  {
+    return (m_NumberOfSamples + m_ChunkSize - 1) / m_ChunkSize;
+  }
+
+  /** Index of a feature, -1 if there is no feature with this name */
+  int GetFeatureIndex(const std::string& name) const;
+
+  /** Read the samples of a chunk and return their number. labels (if not
+   *  null) receives their labels and features the features listed in
+   *  columns, one sample per row. Both must hold GetChunkSize() samples. */
+  std::size_t ReadChunk(std::uint64_t chunk, const std::vector<unsigned int>& columns, float* features, double* labels);
+
+private:
+  SampleStoreReader(const SampleStoreReader&) = delete;
+  void operator=(const SampleStoreReader&) = delete;
+
+  std::ifstream            m_File;
+  std::string              m_FileName;
+  std::string              m_LabelName;
+  std::vector<std::string> m_FeatureNames;
+  unsigned int             m_ChunkSize;
+  std::uint64_t            m_NumberOfSamples;
+  std::uint64_t            m_DataOffset;
+
+  std::vector<float> m_Column;
+};
+
+} // end namespace otb
+
+#endif
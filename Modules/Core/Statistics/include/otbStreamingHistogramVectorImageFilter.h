@@ -22,7 +22,7 @@
 #ifndef otbStreamingHistogramVectorImageFilter_h
 #define otbStreamingHistogramVectorImageFilter_h
 
-#include "otbPersistentImageFilter.h"
+#include "otbPersistentReductionImageFilter.h"
 #include "otbPersistentFilterStreamingDecorator.h"
 
 #include "otbObjectList.h"
@@ -30,9 +30,77 @@
 #include "itkNumericTraits.h"
 #include "itkHistogram.h"
 
+#include <vector>
+
 namespace otb
 {
 
+/** \class HistogramVectorAccumulator
+ * \brief Frequencies of the bins of one histogram per band.
+ *
+ * \sa PersistentHistogramVectorImageFilter
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TInputImage>
+class HistogramVectorAccumulator
+{
+public:
+  typedef itk::Statistics::Histogram<typename itk::NumericTraits<typename TInputImage::InternalPixelType>::RealType, itk::Statistics::DenseFrequencyContainer2>
+                                                        HistogramType;
+  typedef typename HistogramType::AbsoluteFrequencyType FrequencyType;
+  typedef std::vector<FrequencyType>                    FrequencyVectorType;
+
+  HistogramVectorAccumulator()
+  {
+  }
+
+  /** One histogram per element of numberOfBins, with that many bins */
+  explicit HistogramVectorAccumulator(const std::vector<std::size_t>& numberOfBins)
+  {
+    for (auto size : numberOfBins)
+    {
+      m_Frequencies.emplace_back(size, 0);
+    }
+  }
+
+  void Accumulate(unsigned int band, std::size_t bin)
+  {
+    ++m_Frequencies[band][bin];
+  }
+
+  void Merge(const HistogramVectorAccumulator& other)
+  {
+    if (m_Frequencies.empty())
+    {
+      m_Frequencies = other.m_Frequencies;
+      return;
+    }
+    for (std::size_t band = 0; band < m_Frequencies.size() && band < other.m_Frequencies.size(); ++band)
+    {
+      auto&       frequencies      = m_Frequencies[band];
+      const auto& otherFrequencies = other.m_Frequencies[band];
+      for (std::size_t bin = 0; bin < frequencies.size() && bin < otherFrequencies.size(); ++bin)
+      {
+        frequencies[bin] += otherFrequencies[bin];
+      }
+    }
+  }
+
+  std::size_t GetNumberOfBands() const
+  {
+    return m_Frequencies.size();
+  }
+
+  const FrequencyVectorType& GetFrequencies(unsigned int band) const
+  {
+    return m_Frequencies[band];
+  }
+
+private:
+  std::vector<FrequencyVectorType> m_Frequencies;
+};
+
 /** \class PersistentHistogramVectorImageFilter
  * \brief Compute the histogram of a large image using streaming
  *
@@ -43,7 +111,7 @@ namespace otb
  *
  * To get the histogram once the regions have been processed via the pipeline, use the Synthetize() method.
  *
- * \sa PersistentImageFilter
+ * \sa PersistentReductionImageFilter
  * \ingroup Streamed
  * \ingroup Multithreaded
  * \ingroup MathematicalStatisticsImageFilters
@@ -52,12 +120,12 @@ namespace otb
  * \ingroup OTBStatistics
  */
 template <class TInputImage>
-class ITK_EXPORT PersistentHistogramVectorImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+class ITK_EXPORT PersistentHistogramVectorImageFilter : public PersistentReductionImageFilter<TInputImage, HistogramVectorAccumulator<TInputImage>>
 {
 public:
   /** Standard Self typedef */
   typedef PersistentHistogramVectorImageFilter Self;
-  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef PersistentReductionImageFilter<TInputImage, HistogramVectorAccumulator<TInputImage>> Superclass;
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
@@ -65,7 +133,7 @@ public:
   itkNewMacro(Self);
 
   /** Runtime information support. */
-  itkTypeMacro(PersistentHistogramVectorImageFilter, PersistentImageFilter);
+  itkTypeMacro(PersistentHistogramVectorImageFilter, PersistentReductionImageFilter);
 
   /** Image related typedefs. */
   typedef TInputImage                             ImageType;
@@ -103,6 +171,8 @@ public:
   typedef typename HistogramListType::Pointer            HistogramListPointerType;
   typedef typename std::vector<HistogramListPointerType> ArrayHistogramListType;
 
+  typedef typename Superclass::AccumulatorType AccumulatorType;
+
 
   /** Set the no data value. These value are ignored in histogram
    *  computation if NoDataFlag is On
@@ -167,12 +237,7 @@ public:
   DataObjectPointer MakeOutput(DataObjectPointerArraySizeType idx) override;
   using Superclass::MakeOutput;
 
-  /** Pass the input through unmodified. Do this by Grafting in the
-   *  AllocateOutputs method.
-   */
-  void AllocateOutputs() override;
-  void GenerateOutputInformation() override;
-  void Synthetize(void) override;
+  /** Set up the output histograms and restart from empty ones */
   void Reset(void) override;
 
 protected:
@@ -181,14 +246,15 @@ protected:
   {
   }
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
-  /** Multi-thread version GenerateData. */
-  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  AccumulatorType CreateAccumulator() const override;
+  void AccumulateRegion(AccumulatorType& accumulator, const RegionType& region) const override;
+  void Finalize(const AccumulatorType& accumulator) override;
 
 private:
   PersistentHistogramVectorImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
-  ArrayHistogramListType m_ThreadHistogramList;
   CountVectorType        m_Size;
   MeasurementVectorType  m_HistogramMin;
   MeasurementVectorType  m_HistogramMax;
@@ -23,9 +23,7 @@
 #define otbStreamingHistogramVectorImageFilter_hxx
 #include "otbStreamingHistogramVectorImageFilter.h"
 
-#include "itkImageRegionIterator.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
-#include "itkProgressReporter.h"
 #include "otbMacro.h"
 
 namespace otb
@@ -33,8 +31,7 @@ namespace otb
 
 template <class TInputImage>
 PersistentHistogramVectorImageFilter<TInputImage>::PersistentHistogramVectorImageFilter()
-  : m_ThreadHistogramList(),
-    m_Size(),
+  : m_Size(),
     m_HistogramMin(),
     m_HistogramMax(),
     m_NoDataFlag(false),
@@ -82,39 +79,12 @@ PersistentHistogramVectorImageFilter<TInputImage>::GetHistogramListOutput() cons
   return static_cast<const HistogramListType*>(this->itk::ProcessObject::GetOutput(1));
 }
 
-template <class TInputImage>
-void PersistentHistogramVectorImageFilter<TInputImage>::GenerateOutputInformation()
-{
-  Superclass::GenerateOutputInformation();
-  if (this->GetInput())
-  {
-    this->GetOutput()->CopyInformation(this->GetInput());
-    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
-
-    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
-    {
-      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
-    }
-  }
-}
-
-template <class TInputImage>
-void PersistentHistogramVectorImageFilter<TInputImage>::AllocateOutputs()
-{
-  // This is commented to prevent the streaming of the whole image for the first stream strip
-  // It shall not cause any problem because the output image of this filter is not intended to be used.
-  // InputImagePointer image = const_cast< TInputImage * >( this->GetInput() );
-  // this->GraftOutput( image );
-  // Nothing that needs to be allocated for the remaining outputs
-}
-
 template <class TInputImage>
 void PersistentHistogramVectorImageFilter<TInputImage>::Reset()
 {
   TInputImage* inputPtr = const_cast<TInputImage*>(this->GetInput());
   inputPtr->UpdateOutputInformation();
 
-  unsigned int numberOfThreads   = this->GetNumberOfThreads();
   unsigned int numberOfComponent = inputPtr->GetNumberOfComponentsPerPixel();
 
   // TODO which is the good value ? (false in MVD2)
@@ -154,88 +124,64 @@ void PersistentHistogramVectorImageFilter<TInputImage>::Reset()
   }
 
 
-  // Setup HistogramLists for each thread
-  m_ThreadHistogramList.clear();
-  for (unsigned int i = 0; i < numberOfThreads; ++i)
+  // Restart from empty histograms
+  Superclass::Reset();
+}
+
+template <class TInputImage>
+typename PersistentHistogramVectorImageFilter<TInputImage>::AccumulatorType PersistentHistogramVectorImageFilter<TInputImage>::CreateAccumulator() const
+{
+  const HistogramListType* outputHisto = this->GetHistogramListOutput();
+
+  std::vector<std::size_t> numberOfBins;
+  for (unsigned int j = 0; j < outputHisto->Size(); ++j)
   {
-    HistogramListPointerType histoList = HistogramListType::New();
-    histoList->Clear();
-    for (unsigned int k = 0; k < numberOfComponent; ++k)
-    {
-      typename HistogramType::MeasurementVectorType bandMin, bandMax;
-      bandMin.SetSize(1);
-      bandMax.SetSize(1);
-      bandMin.Fill(m_HistogramMin[k]);
-      bandMax.Fill(m_HistogramMax[k]);
-
-      typename HistogramType::Pointer histogram = HistogramType::New();
-      histogram->SetClipBinsAtEnds(clipBins);
-
-      typename HistogramType::SizeType size;
-      size.SetSize(1);
-      size.Fill(m_Size[k]);
-      histogram->SetMeasurementVectorSize(1);
-      histogram->Initialize(size, bandMin, bandMax);
-
-      histoList->PushBack(histogram);
-    }
-    m_ThreadHistogramList.push_back(histoList);
+    numberOfBins.push_back(outputHisto->GetNthElement(j)->Size());
   }
+  return AccumulatorType(numberOfBins);
 }
 
 template <class TInputImage>
-void PersistentHistogramVectorImageFilter<TInputImage>::Synthetize()
+void PersistentHistogramVectorImageFilter<TInputImage>::Finalize(const AccumulatorType& accumulator)
 {
   HistogramListType* outputHisto = this->GetHistogramListOutput();
 
-  int          numberOfThreads   = this->GetNumberOfThreads();
-  unsigned int numberOfComponent = this->GetInput()->GetNumberOfComponentsPerPixel();
-
   // copy histograms to output
-  for (int i = 0; i < numberOfThreads; ++i)
+  for (unsigned int j = 0; j < outputHisto->Size() && j < accumulator.GetNumberOfBands(); ++j)
   {
-    for (unsigned int j = 0; j < numberOfComponent; ++j)
-    {
-      HistogramType* outHisto    = outputHisto->GetNthElement(j);
-      HistogramType* threadHisto = m_ThreadHistogramList[i]->GetNthElement(j);
+    HistogramType* histogram   = outputHisto->GetNthElement(j);
+    const auto&    frequencies = accumulator.GetFrequencies(j);
 
-      typename HistogramType::Iterator iterOutput = outHisto->Begin();
-      typename HistogramType::Iterator iterThread = threadHisto->Begin();
-
-      while (iterOutput != outHisto->End() && iterThread != threadHisto->End())
-      {
-        iterOutput.SetFrequency(iterOutput.GetFrequency() + iterThread.GetFrequency());
-
-        ++iterOutput;
-        ++iterThread;
-      }
+    for (std::size_t bin = 0; bin < frequencies.size(); ++bin)
+    {
+      histogram->SetFrequency(bin, frequencies[bin]);
     }
   }
 }
 
 template <class TInputImage>
-void PersistentHistogramVectorImageFilter<TInputImage>::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+void PersistentHistogramVectorImageFilter<TInputImage>::AccumulateRegion(AccumulatorType& accumulator, const RegionType& region) const
 {
-  /**
-   * Grab the input
-   */
-  InputImagePointer inputPtr = const_cast<TInputImage*>(this->GetInput());
-  // support progress methods/callbacks
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
-
-  typename HistogramType::IndexType index;
+  // The output histograms only give the bins here: they are not modified
+  // until Finalize()
+  const HistogramListType*          outputHisto = this->GetHistogramListOutput();
+  std::vector<const HistogramType*> histograms;
+  for (unsigned int j = 0; j < outputHisto->Size(); ++j)
+  {
+    histograms.push_back(outputHisto->GetNthElement(j).GetPointer());
+  }
 
-  itk::ImageRegionConstIteratorWithIndex<TInputImage> it(inputPtr, outputRegionForThread);
-  it.GoToBegin();
+  typename HistogramType::IndexType             index;
+  typename HistogramType::MeasurementVectorType value;
+  value.SetSize(1);
 
-  bool skipSample = false;
+  itk::ImageRegionConstIteratorWithIndex<TInputImage> it(this->GetInput(), region);
 
-  // do the work
-  while (!it.IsAtEnd())
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
   {
     if (m_SubSamplingRate > 1)
     {
-      skipSample = false;
+      bool skipSample = false;
       for (unsigned int i = 0; i < InputImageDimension; ++i)
       {
         if (it.GetIndex()[i] % m_SubSamplingRate != 0)
@@ -246,8 +192,6 @@ void PersistentHistogramVectorImageFilter<TInputImage>::ThreadedGenerateData(con
       }
       if (skipSample)
       {
-        ++it;
-        progress.CompletedPixel();
         continue;
       }
     }
@@ -275,14 +219,12 @@ void PersistentHistogramVectorImageFilter<TInputImage>::ThreadedGenerateData(con
 
     if (!skipSampleNoData)
     {
-      for (unsigned int j = 0; j < vectorValue.GetSize(); ++j)
+      for (unsigned int j = 0; j < vectorValue.GetSize() && j < histograms.size(); ++j)
       {
-        typename HistogramType::MeasurementVectorType value;
-        value.SetSize(1);
         value.Fill(vectorValue[j]);
 
-        m_ThreadHistogramList[threadId]->GetNthElement(j)->GetIndex(value, index);
-        if (!m_ThreadHistogramList[threadId]->GetNthElement(j)->IsIndexOutOfBounds(index))
+        histograms[j]->GetIndex(value, index);
+        if (!histograms[j]->IsIndexOutOfBounds(index))
         {
           // if the measurement vector is out of bound then
           // the GetIndex method has returned an index set to the max size of
@@ -290,13 +232,10 @@ void PersistentHistogramVectorImageFilter<TInputImage>::ThreadedGenerateData(con
           // bin value.
           // If the index isn't valid, we don't increase the frequency.
           // See the comments in Histogram->GetIndex() for more info.
-          m_ThreadHistogramList[threadId]->GetNthElement(j)->IncreaseFrequencyOfIndex(index, 1);
+          accumulator.Accumulate(j, histograms[j]->GetInstanceIdentifier(index));
         }
       }
     }
-
-    ++it;
-    progress.CompletedPixel();
   }
 }
 
@@ -22,8 +22,7 @@
 #ifndef otbStreamingMinMaxImageFilter_h
 #define otbStreamingMinMaxImageFilter_h
 
-#include <vector>
-#include "otbPersistentImageFilter.h"
+#include "otbPersistentReductionImageFilter.h"
 #include "itkNumericTraits.h"
 #include "itkSimpleDataObjectDecorator.h"
 #include "otbPersistentFilterStreamingDecorator.h"
@@ -31,6 +30,80 @@
 namespace otb
 {
 
+/** \class MinMaxAccumulator
+ * \brief Minimum and maximum of a set of pixels, and the index of their
+ * first occurrence.
+ *
+ * \sa PersistentMinMaxImageFilter
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TInputImage>
+class MinMaxAccumulator
+{
+public:
+  typedef typename TInputImage::PixelType PixelType;
+  typedef typename TInputImage::IndexType IndexType;
+
+  MinMaxAccumulator() : m_Minimum(itk::NumericTraits<PixelType>::max()), m_Maximum(itk::NumericTraits<PixelType>::NonpositiveMin())
+  {
+    m_MinimumIndex.Fill(0);
+    m_MaximumIndex.Fill(0);
+  }
+
+  void Accumulate(const PixelType& value, const IndexType& index)
+  {
+    if (value < m_Minimum)
+    {
+      m_Minimum      = value;
+      m_MinimumIndex = index;
+    }
+    if (value > m_Maximum)
+    {
+      m_Maximum      = value;
+      m_MaximumIndex = index;
+    }
+  }
+
+  /** On ties, the index of this accumulator is kept */
+  void Merge(const MinMaxAccumulator& other)
+  {
+    if (other.m_Minimum < m_Minimum)
+    {
+      m_Minimum      = other.m_Minimum;
+      m_MinimumIndex = other.m_MinimumIndex;
+    }
+    if (other.m_Maximum > m_Maximum)
+    {
+      m_Maximum      = other.m_Maximum;
+      m_MaximumIndex = other.m_MaximumIndex;
+    }
+  }
+
+  const PixelType& GetMinimum() const
+  {
+    return m_Minimum;
+  }
+  const PixelType& GetMaximum() const
+  {
+    return m_Maximum;
+  }
+  const IndexType& GetMinimumIndex() const
+  {
+    return m_MinimumIndex;
+  }
+  const IndexType& GetMaximumIndex() const
+  {
+    return m_MaximumIndex;
+  }
+
+private:
+  PixelType m_Minimum;
+  PixelType m_Maximum;
+  IndexType m_MinimumIndex;
+  IndexType m_MaximumIndex;
+};
+
 /** \class PersistentMinMaxImageFilter
  * \brief Compute min. max of an image using the output requested region.
  *
@@ -41,7 +114,7 @@ namespace otb
  *
  * To get the min/max once the regions have been processed via the pipeline, use the Synthetize() method.
  *
- * \sa PersistentImageFilter
+ * \sa PersistentReductionImageFilter
  * \ingroup Streamed
  * \ingroup Multithreaded
  * \ingroup MathematicalStatisticsImageFilters
@@ -49,12 +122,12 @@ namespace otb
  * \ingroup OTBStatistics
  */
 template <class TInputImage>
-class ITK_EXPORT PersistentMinMaxImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+class ITK_EXPORT PersistentMinMaxImageFilter : public PersistentReductionImageFilter<TInputImage, MinMaxAccumulator<TInputImage>>
 {
 public:
   /** Standard Self typedef */
   typedef PersistentMinMaxImageFilter Self;
-  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef PersistentReductionImageFilter<TInputImage, MinMaxAccumulator<TInputImage>> Superclass;
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
@@ -62,7 +135,7 @@ public:
   itkNewMacro(Self);
 
   /** Runtime information support. */
-  itkTypeMacro(PersistentMinMaxImageFilter, PersistentImageFilter);
+  itkTypeMacro(PersistentMinMaxImageFilter, PersistentReductionImageFilter);
 
   /** Image related typedefs. */
   typedef TInputImage                   ImageType;
@@ -73,6 +146,8 @@ public:
   typedef typename TInputImage::IndexType  IndexType;
   typedef typename TInputImage::PixelType  PixelType;
 
+  typedef typename Superclass::AccumulatorType AccumulatorType;
+
   itkStaticConstMacro(InputImageDimension, unsigned int, TInputImage::ImageDimension);
 
   /** Image related typedefs. */
@@ -124,14 +199,6 @@ public:
   DataObjectPointer MakeOutput(DataObjectPointerArraySizeType idx) override;
   using Superclass::MakeOutput;
 
-  /** Pass the input through unmodified. Do this by Grafting in the
-   *  AllocateOutputs method.
-   */
-  void AllocateOutputs() override;
-  void GenerateOutputInformation() override;
-  void Synthetize(void) override;
-  void Reset(void) override;
-
 protected:
   PersistentMinMaxImageFilter();
   ~PersistentMinMaxImageFilter() override
@@ -139,17 +206,12 @@ protected:
   }
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
-  /** Multi-thread version GenerateData. */
-  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+  void AccumulateRegion(AccumulatorType& accumulator, const RegionType& region) const override;
+  void Finalize(const AccumulatorType& accumulator) override;
 
 private:
   PersistentMinMaxImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
-
-  std::vector<PixelType> m_ThreadMin;
-  std::vector<PixelType> m_ThreadMax;
-  std::vector<IndexType> m_ThreadMinIndex;
-  std::vector<IndexType> m_ThreadMaxIndex;
 }; // end of class PersistentMinMaxImageFilter
 
 
@@ -23,9 +23,7 @@
 #define otbStreamingMinMaxImageFilter_hxx
 #include "otbStreamingMinMaxImageFilter.h"
 
-#include <algorithm>
-#include "itkImageRegionIterator.h"
-#include "itkProgressReporter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "otbMacro.h"
 
 namespace otb
@@ -123,105 +121,22 @@ const typename PersistentMinMaxImageFilter<TInputImage>::IndexObjectType* Persis
 }
 
 template <class TInputImage>
-void PersistentMinMaxImageFilter<TInputImage>::GenerateOutputInformation()
+void PersistentMinMaxImageFilter<TInputImage>::Finalize(const AccumulatorType& accumulator)
 {
-  Superclass::GenerateOutputInformation();
-  if (this->GetInput())
-  {
-    this->GetOutput()->CopyInformation(this->GetInput());
-    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
-
-    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
-    {
-      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
-    }
-  }
-}
-template <class TInputImage>
-void PersistentMinMaxImageFilter<TInputImage>::AllocateOutputs()
-{
-  // This is commented to prevent the streaming of the whole image for the first stream strip
-  // It shall not cause any problem because the output image of this filter is not intended to be used.
-  // InputImagePointer image = const_cast< TInputImage * >( this->GetInput() );
-  // this->GraftOutput( image );
-  // Nothing that needs to be allocated for the remaining outputs
-}
-
-template <class TInputImage>
-void PersistentMinMaxImageFilter<TInputImage>::Synthetize()
-{
-  int i;
-  int numberOfThreads = this->GetNumberOfThreads();
-
-  PixelType minimum = itk::NumericTraits<PixelType>::max();
-  PixelType maximum = itk::NumericTraits<PixelType>::NonpositiveMin();
-  IndexType minimumIdx;
-  IndexType maximumIdx;
-
-  for (i = 0; i < numberOfThreads; ++i)
-  {
-    if (m_ThreadMin[i] < minimum)
-    {
-      minimum    = m_ThreadMin[i];
-      minimumIdx = m_ThreadMinIndex[i];
-    }
-    if (m_ThreadMax[i] > maximum)
-    {
-      maximum    = m_ThreadMax[i];
-      maximumIdx = m_ThreadMaxIndex[i];
-    }
-  }
-
   // Set the outputs
-  this->GetMinimumOutput()->Set(minimum);
-  this->GetMaximumOutput()->Set(maximum);
-  this->GetMinimumIndexOutput()->Set(minimumIdx);
-  this->GetMaximumIndexOutput()->Set(maximumIdx);
-}
-
-template <class TInputImage>
-void PersistentMinMaxImageFilter<TInputImage>::Reset()
-{
-  int numberOfThreads = this->GetNumberOfThreads();
-
-  m_ThreadMin.resize(numberOfThreads);
-  m_ThreadMax.resize(numberOfThreads);
-  std::fill(m_ThreadMin.begin(), m_ThreadMin.end(), itk::NumericTraits<PixelType>::max());
-  std::fill(m_ThreadMax.begin(), m_ThreadMax.end(), itk::NumericTraits<PixelType>::NonpositiveMin());
-
-  IndexType zeroIdx;
-  zeroIdx.Fill(0);
-  m_ThreadMinIndex.resize(numberOfThreads);
-  m_ThreadMaxIndex.resize(numberOfThreads);
-  std::fill(m_ThreadMinIndex.begin(), m_ThreadMinIndex.end(), zeroIdx);
-  std::fill(m_ThreadMaxIndex.begin(), m_ThreadMaxIndex.end(), zeroIdx);
+  this->GetMinimumOutput()->Set(accumulator.GetMinimum());
+  this->GetMaximumOutput()->Set(accumulator.GetMaximum());
+  this->GetMinimumIndexOutput()->Set(accumulator.GetMinimumIndex());
+  this->GetMaximumIndexOutput()->Set(accumulator.GetMaximumIndex());
 }
 
 template <class TInputImage>
-void PersistentMinMaxImageFilter<TInputImage>::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+void PersistentMinMaxImageFilter<TInputImage>::AccumulateRegion(AccumulatorType& accumulator, const RegionType& region) const
 {
-  // support progress methods/callbacks
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
-
-  InputImagePointer                          inputPtr = const_cast<TInputImage*>(this->GetInput(0));
-  itk::ImageRegionConstIterator<TInputImage> it(inputPtr, outputRegionForThread);
-  it.GoToBegin();
-  // do the work
-  while (!it.IsAtEnd())
+  itk::ImageRegionConstIteratorWithIndex<TInputImage> it(this->GetInput(), region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
   {
-    PixelType value = it.Get();
-    if (value < m_ThreadMin[threadId])
-    {
-      m_ThreadMin[threadId]      = value;
-      m_ThreadMinIndex[threadId] = it.GetIndex();
-    }
-    if (value > m_ThreadMax[threadId])
-    {
-      m_ThreadMax[threadId]      = value;
-      m_ThreadMaxIndex[threadId] = it.GetIndex();
-    }
-    ++it;
-    progress.CompletedPixel();
+    accumulator.Accumulate(it.Get(), it.GetIndex());
   }
 }
 
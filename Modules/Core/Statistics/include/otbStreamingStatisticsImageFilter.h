@@ -22,15 +22,123 @@
 #ifndef otbStreamingStatisticsImageFilter_h
 #define otbStreamingStatisticsImageFilter_h
 
-#include "otbPersistentImageFilter.h"
+#include "otbPersistentReductionImageFilter.h"
 #include "itkNumericTraits.h"
-#include "itkArray.h"
 #include "itkSimpleDataObjectDecorator.h"
 #include "otbPersistentFilterStreamingDecorator.h"
 
 namespace otb
 {
 
+/** \class StatisticsAccumulator
+ * \brief Count, sum, sum of squares, minimum and maximum of a set of
+ * pixels, and the number of pixels ignored.
+ *
+ * \sa PersistentStatisticsImageFilter
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TInputImage>
+class StatisticsAccumulator
+{
+public:
+  typedef typename TInputImage::PixelType                  PixelType;
+  typedef typename itk::NumericTraits<PixelType>::RealType RealType;
+
+  StatisticsAccumulator()
+    : m_Count(0),
+      m_Sum(itk::NumericTraits<RealType>::Zero),
+      m_SumOfSquares(itk::NumericTraits<RealType>::Zero),
+      m_Minimum(itk::NumericTraits<PixelType>::max()),
+      m_Maximum(itk::NumericTraits<PixelType>::NonpositiveMin()),
+      m_IgnoredInfinitePixelCount(0),
+      m_IgnoredUserPixelCount(0)
+  {
+  }
+
+  void Accumulate(const PixelType& value, const RealType& realValue)
+  {
+    if (value < m_Minimum)
+    {
+      m_Minimum = value;
+    }
+    if (value > m_Maximum)
+    {
+      m_Maximum = value;
+    }
+
+    m_Sum += realValue;
+    m_SumOfSquares += realValue * realValue;
+    ++m_Count;
+  }
+
+  void IgnoreInfinitePixel()
+  {
+    ++m_IgnoredInfinitePixelCount;
+  }
+
+  void IgnoreUserPixel()
+  {
+    ++m_IgnoredUserPixelCount;
+  }
+
+  void Merge(const StatisticsAccumulator& other)
+  {
+    if (other.m_Minimum < m_Minimum)
+    {
+      m_Minimum = other.m_Minimum;
+    }
+    if (other.m_Maximum > m_Maximum)
+    {
+      m_Maximum = other.m_Maximum;
+    }
+
+    m_Sum += other.m_Sum;
+    m_SumOfSquares += other.m_SumOfSquares;
+    m_Count += other.m_Count;
+    m_IgnoredInfinitePixelCount += other.m_IgnoredInfinitePixelCount;
+    m_IgnoredUserPixelCount += other.m_IgnoredUserPixelCount;
+  }
+
+  long GetCount() const
+  {
+    return m_Count;
+  }
+  const RealType& GetSum() const
+  {
+    return m_Sum;
+  }
+  const RealType& GetSumOfSquares() const
+  {
+    return m_SumOfSquares;
+  }
+  const PixelType& GetMinimum() const
+  {
+    return m_Minimum;
+  }
+  const PixelType& GetMaximum() const
+  {
+    return m_Maximum;
+  }
+  unsigned long GetIgnoredInfinitePixelCount() const
+  {
+    return m_IgnoredInfinitePixelCount;
+  }
+  unsigned long GetIgnoredUserPixelCount() const
+  {
+    return m_IgnoredUserPixelCount;
+  }
+
+private:
+  long          m_Count;
+  RealType      m_Sum;
+  RealType      m_SumOfSquares;
+  PixelType     m_Minimum;
+  PixelType     m_Maximum;
+  unsigned long m_IgnoredInfinitePixelCount;
+  unsigned long m_IgnoredUserPixelCount;
+};
+
 /** \class PersistentStatisticsImageFilter
  * \brief Compute min. max, variance and mean of an image using the output requested region.
  *
@@ -41,7 +149,7 @@ namespace otb
  *
  * To get the statistics once the regions have been processed via the pipeline, use the Synthetize() method.
  *
- * \sa PersistentImageFilter
+ * \sa PersistentReductionImageFilter
  * \ingroup Streamed
  * \ingroup Multithreaded
  * \ingroup MathematicalStatisticsImageFilters
@@ -49,12 +157,12 @@ namespace otb
  * \ingroup OTBStatistics
  */
 template <class TInputImage>
-class ITK_EXPORT PersistentStatisticsImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+class ITK_EXPORT PersistentStatisticsImageFilter : public PersistentReductionImageFilter<TInputImage, StatisticsAccumulator<TInputImage>>
 {
 public:
   /** Standard Self typedef */
   typedef PersistentStatisticsImageFilter Self;
-  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef PersistentReductionImageFilter<TInputImage, StatisticsAccumulator<TInputImage>> Superclass;
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
@@ -62,7 +170,7 @@ public:
   itkNewMacro(Self);
 
   /** Runtime information support. */
-  itkTypeMacro(PersistentStatisticsImageFilter, PersistentImageFilter);
+  itkTypeMacro(PersistentStatisticsImageFilter, PersistentReductionImageFilter);
 
   /** Image related typedefs. */
   typedef TInputImage                   ImageType;
@@ -81,6 +189,8 @@ public:
   /** Type to use for computations. */
   typedef typename itk::NumericTraits<PixelType>::RealType RealType;
 
+  typedef typename Superclass::AccumulatorType AccumulatorType;
+
   /** Smart Pointer type to a DataObject. */
   typedef typename itk::DataObject::Pointer                  DataObjectPointer;
   typedef itk::ProcessObject::DataObjectPointerArraySizeType DataObjectPointerArraySizeType;
@@ -142,14 +252,6 @@ public:
   DataObjectPointer MakeOutput(DataObjectPointerArraySizeType idx) override;
   using Superclass::MakeOutput;
 
-  /** Pass the input through unmodified. Do this by Grafting in the
-   *  AllocateOutputs method.
-   */
-  void AllocateOutputs() override;
-  void GenerateOutputInformation() override;
-  void Synthetize(void) override;
-  void Reset(void) override;
-
   itkSetMacro(IgnoreInfiniteValues, bool);
   itkGetMacro(IgnoreInfiniteValues, bool);
 
@@ -166,25 +268,17 @@ protected:
   }
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
-  /** Multi-thread version GenerateData. */
-  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+  void AccumulateRegion(AccumulatorType& accumulator, const RegionType& region) const override;
+  void Finalize(const AccumulatorType& accumulator) override;
 
 private:
   PersistentStatisticsImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
-  itk::Array<RealType>  m_ThreadSum;
-  itk::Array<RealType>  m_SumOfSquares;
-  itk::Array<long>      m_Count;
-  itk::Array<PixelType> m_ThreadMin;
-  itk::Array<PixelType> m_ThreadMax;
-
   /* Ignored values */
-  bool                      m_IgnoreInfiniteValues;
-  bool                      m_IgnoreUserDefinedValue;
-  RealType                  m_UserIgnoredValue;
-  std::vector<unsigned int> m_IgnoredInfinitePixelCount;
-  std::vector<unsigned int> m_IgnoredUserPixelCount;
+  bool     m_IgnoreInfiniteValues;
+  bool     m_IgnoreUserDefinedValue;
+  RealType m_UserIgnoredValue;
 
 
 }; // end of class PersistentStatisticsImageFilter
@@ -23,8 +23,7 @@
 #define otbStreamingStatisticsImageFilter_hxx
 #include "otbStreamingStatisticsImageFilter.h"
 
-#include "itkImageRegionIterator.h"
-#include "itkProgressReporter.h"
+#include "itkImageRegionConstIterator.h"
 #include "otbMacro.h"
 
 namespace otb
@@ -32,7 +31,7 @@ namespace otb
 
 template <class TInputImage>
 PersistentStatisticsImageFilter<TInputImage>::PersistentStatisticsImageFilter()
-  : m_ThreadSum(1), m_SumOfSquares(1), m_Count(1), m_ThreadMin(1), m_ThreadMax(1), m_IgnoreInfiniteValues(true), m_IgnoreUserDefinedValue(false)
+  : m_IgnoreInfiniteValues(true), m_IgnoreUserDefinedValue(false)
 {
   // first output is a copy of the image, DataObject created by
   // superclass
@@ -59,10 +58,6 @@ PersistentStatisticsImageFilter<TInputImage>::PersistentStatisticsImageFilter()
   this->GetVarianceOutput()->Set(itk::NumericTraits<RealType>::max());
   this->GetSumOutput()->Set(itk::NumericTraits<RealType>::Zero);
 
-  // Initiate the infinite ignored pixel counters
-  m_IgnoredInfinitePixelCount = std::vector<unsigned int>(this->GetNumberOfThreads(), 0);
-  m_IgnoredUserPixelCount     = std::vector<unsigned int>(this->GetNumberOfThreads(), 0);
-
   this->Reset();
 }
 
@@ -165,68 +160,16 @@ const typename PersistentStatisticsImageFilter<TInputImage>::RealObjectType* Per
   return static_cast<const RealObjectType*>(this->itk::ProcessObject::GetOutput(6));
 }
 template <class TInputImage>
-void PersistentStatisticsImageFilter<TInputImage>::GenerateOutputInformation()
-{
-  Superclass::GenerateOutputInformation();
-  if (this->GetInput())
-  {
-    this->GetOutput()->CopyInformation(this->GetInput());
-    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
-
-    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
-    {
-      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
-    }
-  }
-}
-template <class TInputImage>
-void PersistentStatisticsImageFilter<TInputImage>::AllocateOutputs()
-{
-  // This is commented to prevent the streaming of the whole image for the first stream strip
-  // It shall not cause any problem because the output image of this filter is not intended to be used.
-  // InputImagePointer image = const_cast< TInputImage * >( this->GetInput() );
-  // this->GraftOutput( image );
-  // Nothing that needs to be allocated for the remaining outputs
-}
-
-template <class TInputImage>
-void PersistentStatisticsImageFilter<TInputImage>::Synthetize()
+void PersistentStatisticsImageFilter<TInputImage>::Finalize(const AccumulatorType& accumulator)
 {
-  int      i;
-  long     count;
-  RealType sumOfSquares;
-
-  int numberOfThreads = this->GetNumberOfThreads();
-
-  PixelType minimum;
-  PixelType maximum;
-  RealType  mean     = itk::NumericTraits<RealType>::Zero;
-  RealType  sigma    = itk::NumericTraits<RealType>::Zero;
-  RealType  variance = itk::NumericTraits<RealType>::Zero;
-  RealType  sum;
+  const long     count        = accumulator.GetCount();
+  const RealType sum          = accumulator.GetSum();
+  const RealType sumOfSquares = accumulator.GetSumOfSquares();
 
-  sum = sumOfSquares = itk::NumericTraits<RealType>::Zero;
-  count              = 0;
+  RealType mean     = itk::NumericTraits<RealType>::Zero;
+  RealType sigma    = itk::NumericTraits<RealType>::Zero;
+  RealType variance = itk::NumericTraits<RealType>::Zero;
 
-  // Find the min/max over all threads and accumulate count, sum and
-  // sum of squares
-  minimum = itk::NumericTraits<PixelType>::max();
-  maximum = itk::NumericTraits<PixelType>::NonpositiveMin();
-  for (i = 0; i < numberOfThreads; ++i)
-  {
-    count += m_Count[i];
-    sum += m_ThreadSum[i];
-    sumOfSquares += m_SumOfSquares[i];
-
-    if (m_ThreadMin[i] < minimum)
-    {
-      minimum = m_ThreadMin[i];
-    }
-    if (m_ThreadMax[i] > maximum)
-    {
-      maximum = m_ThreadMax[i];
-    }
-  }
   if (count > 0)
   {
     // compute statistics
@@ -245,8 +188,8 @@ void PersistentStatisticsImageFilter<TInputImage>::Synthetize()
   }
 
   // Set the outputs
-  this->GetMinimumOutput()->Set(minimum);
-  this->GetMaximumOutput()->Set(maximum);
+  this->GetMinimumOutput()->Set(accumulator.GetMinimum());
+  this->GetMaximumOutput()->Set(accumulator.GetMaximum());
   this->GetMeanOutput()->Set(mean);
   this->GetSigmaOutput()->Set(sigma);
   this->GetVarianceOutput()->Set(variance);
@@ -254,84 +197,28 @@ void PersistentStatisticsImageFilter<TInputImage>::Synthetize()
 }
 
 template <class TInputImage>
-void PersistentStatisticsImageFilter<TInputImage>::Reset()
+void PersistentStatisticsImageFilter<TInputImage>::AccumulateRegion(AccumulatorType& accumulator, const RegionType& region) const
 {
-  int numberOfThreads = this->GetNumberOfThreads();
-
-  // Resize the thread temporaries
-  m_Count.SetSize(numberOfThreads);
-  m_SumOfSquares.SetSize(numberOfThreads);
-  m_ThreadSum.SetSize(numberOfThreads);
-  m_ThreadMin.SetSize(numberOfThreads);
-  m_ThreadMax.SetSize(numberOfThreads);
-  // Initialize the temporaries
-  m_Count.Fill(itk::NumericTraits<long>::Zero);
-  m_ThreadSum.Fill(itk::NumericTraits<RealType>::Zero);
-  m_SumOfSquares.Fill(itk::NumericTraits<RealType>::Zero);
-  m_ThreadMin.Fill(itk::NumericTraits<PixelType>::max());
-  m_ThreadMax.Fill(itk::NumericTraits<PixelType>::NonpositiveMin());
-  if (m_IgnoreInfiniteValues)
-  {
-    m_IgnoredInfinitePixelCount = std::vector<unsigned int>(numberOfThreads, 0);
-  }
-
-  if (m_IgnoreUserDefinedValue)
+  itk::ImageRegionConstIterator<TInputImage> it(this->GetInput(), region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
   {
-    m_IgnoredUserPixelCount = std::vector<unsigned int>(this->GetNumberOfThreads(), 0);
-  }
-}
-
-template <class TInputImage>
-void PersistentStatisticsImageFilter<TInputImage>::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
-{
-  /**
-   * Grab the input
-   */
-  InputImagePointer inputPtr = const_cast<TInputImage*>(this->GetInput(0));
-  // support progress methods/callbacks
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
-
-  RealType  realValue;
-  PixelType value;
-
-  itk::ImageRegionConstIterator<TInputImage> it(inputPtr, outputRegionForThread);
-
-  it.GoToBegin();
-  // do the work
-  while (!it.IsAtEnd())
-  {
-    value     = it.Get();
-    realValue = static_cast<RealType>(value);
+    const PixelType value     = it.Get();
+    const RealType  realValue = static_cast<RealType>(value);
     if (m_IgnoreInfiniteValues && !(vnl_math_isfinite(realValue)))
     {
-      m_IgnoredInfinitePixelCount[threadId]++;
+      accumulator.IgnoreInfinitePixel();
+    }
+    else if (m_IgnoreUserDefinedValue && (value == m_UserIgnoredValue))
+    {
+      accumulator.IgnoreUserPixel();
     }
     else
     {
-      if (m_IgnoreUserDefinedValue && (value == m_UserIgnoredValue))
-      {
-        m_IgnoredUserPixelCount[threadId]++;
-      }
-      else
-      {
-        if (value < m_ThreadMin[threadId])
-        {
-          m_ThreadMin[threadId] = value;
-        }
-        if (value > m_ThreadMax[threadId])
-        {
-          m_ThreadMax[threadId] = value;
-        }
-
-        m_ThreadSum[threadId] += realValue;
-        m_SumOfSquares[threadId] += (realValue * realValue);
-        m_Count[threadId]++;
-      }
+      accumulator.Accumulate(value, realValue);
     }
-    ++it;
-    progress.CompletedPixel();
   }
 }
+
 template <class TImage>
 void PersistentStatisticsImageFilter<TImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
@@ -27,7 +27,9 @@
 #include "itkArray.h"
 #include "itkSimpleDataObjectDecorator.h"
 #include "otbPersistentFilterStreamingDecorator.h"
+#include "otbQuantileSketch.h"
 #include <unordered_map>
+#include <vector>
 
 namespace otb
 {
@@ -41,6 +43,7 @@ namespace otb
  * -sum of squared values
  * -min
  * -max
+ * -quantile sketches (optional, see QuantileSketch)
  *
  * TODO:
  * -Better architecture?
@@ -56,16 +59,22 @@ public:
   typedef typename TRealVectorPixelType::ValueType  RealValueType;
   typedef uint64_t                                  PixelCountType;
   typedef itk::VariableLengthVector<PixelCountType> PixelCountVectorType;
+  typedef std::vector<QuantileSketch>               QuantileSketchVectorType;
 
   // Constructor (default)
   StatisticsAccumulator() : m_Count(), m_NoDataValue(), m_UseNoDataValue()
   {
   }
 
-  // Constructor (initialize the accumulator with the given pixel)
-  StatisticsAccumulator(RealValueType noDataValue, bool useNoDataValue, const TRealVectorPixelType& pixel)
+  // Constructor (initialize the accumulator with the given pixel, with one
+  // quantile sketch of the given size per band if it is not 0)
+  StatisticsAccumulator(RealValueType noDataValue, bool useNoDataValue, const TRealVectorPixelType& pixel, unsigned int quantileSketchSize = 0)
     : m_NoDataValue(noDataValue), m_Count(1), m_UseNoDataValue(useNoDataValue)
   {
+    if (quantileSketchSize > 0)
+    {
+      m_QuantileSketches.assign(pixel.GetSize(), QuantileSketch(quantileSketchSize));
+    }
     m_Count = 1;
     m_BandCount.SetSize(pixel.GetSize());
     m_Sum.SetSize(pixel.GetSize());
@@ -82,6 +91,7 @@ public:
         m_Min[band]       = val;
         m_Max[band]       = val;
         m_SqSum[band]     = val * val;
+        AddToQuantileSketch(band, val);
       }
       else
       {
@@ -107,6 +117,7 @@ public:
       if (!m_UseNoDataValue || value != m_NoDataValue)
       {
         UpdateValues(1, value, sqValue, value, value, m_BandCount[band], m_Sum[band], m_SqSum[band], m_Min[band], m_Max[band]);
+        AddToQuantileSketch(band, value);
       }
     }
   }
@@ -121,6 +132,10 @@ public:
       UpdateValues(other.m_BandCount[band], other.m_Sum[band], other.m_SqSum[band], other.m_Min[band], other.m_Max[band], m_BandCount[band], m_Sum[band],
                    m_SqSum[band], m_Min[band], m_Max[band]);
     }
+    for (unsigned int band = 0; band < m_QuantileSketches.size(); band++)
+    {
+      m_QuantileSketches[band].Merge(other.m_QuantileSketches[band]);
+    }
   }
 
   // Accessors
@@ -131,7 +146,21 @@ public:
   itkGetMacro(Max, TRealVectorPixelType);
   itkGetMacro(Count, double);
 
+  // Quantile sketches of each band (empty if not enabled)
+  const QuantileSketchVectorType& GetQuantileSketches() const
+  {
+    return m_QuantileSketches;
+  }
+
 private:
+  void AddToQuantileSketch(unsigned int band, RealValueType value)
+  {
+    if (band < m_QuantileSketches.size())
+    {
+      m_QuantileSketches[band].Add(value);
+    }
+  }
+
   void UpdateValues(PixelCountType otherCount, RealValueType otherSum, RealValueType otherSqSum, RealValueType otherMin, RealValueType otherMax,
                     PixelCountType& count, RealValueType& sum, RealValueType& sqSum, RealValueType& min, RealValueType& max)
   {
@@ -153,6 +182,8 @@ protected:
   RealValueType        m_NoDataValue;
   PixelCountType       m_Count;
   bool                 m_UseNoDataValue;
+
+  QuantileSketchVectorType m_QuantileSketches;
 };
 
 /** \class PersistentStreamingStatisticsMapFromLabelImageFilter
@@ -165,6 +196,10 @@ protected:
  *
  * To get the statistics once the regions have been processed via the pipeline, use the Synthetize() method.
  *
+ * When QuantileSketchSize is not 0, a QuantileSketch of this size is kept
+ * for each label and band, and GetQuantileValueMap() gives approximate
+ * quantiles of each label. Each sketch holds up to about 3 *
+ * QuantileSketchSize values, per thread until Synthetize().
  *
  * \sa StreamingStatisticsMapFromLabelImageFilter
  * \ingroup Streamed
@@ -206,6 +241,9 @@ public:
   typedef std::unordered_map<LabelPixelType, RealVectorPixelType> PixelValueMapType;
   typedef std::unordered_map<LabelPixelType, double>              LabelPopulationMapType;
 
+  typedef typename AccumulatorType::QuantileSketchVectorType           QuantileSketchVectorType;
+  typedef std::unordered_map<LabelPixelType, QuantileSketchVectorType> QuantileSketchMapType;
+
   itkStaticConstMacro(InputImageDimension, unsigned int, TInputVectorImage::ImageDimension);
 
   /** Image related typedefs. */
@@ -216,6 +254,11 @@ public:
   itkGetMacro(UseNoDataValue, bool);
   itkSetMacro(UseNoDataValue, bool);
 
+  /** Size of the quantile sketches of each label and band. Default is 0:
+   *  quantiles are not computed. */
+  itkGetMacro(QuantileSketchSize, unsigned int);
+  itkSetMacro(QuantileSketchSize, unsigned int);
+
   /** Smart Pointer type to a DataObject. */
   typedef typename itk::DataObject::Pointer                  DataObjectPointer;
   typedef itk::ProcessObject::DataObjectPointerArraySizeType DataObjectPointerArraySizeType;
@@ -247,6 +290,11 @@ public:
   /** Return the computed number of labeled pixels for each label in the input label image */
   LabelPopulationMapType GetLabelPopulationMap() const;
 
+  /** Return the approximate q-quantile, q in [0, 1], for each label in the
+   *  input label image. A band without valid pixels gets the no data value
+   *  if it is used, NaN otherwise. */
+  PixelValueMapType GetQuantileValueMap(double q) const;
+
   /** Make a DataObject of the correct type to be used as the specified
    * output. */
   DataObjectPointer MakeOutput(DataObjectPointerArraySizeType idx) override;
@@ -282,6 +330,7 @@ private:
 
   VectorPixelValueType m_NoDataValue;
   bool                 m_UseNoDataValue;
+  unsigned int         m_QuantileSketchSize;
 
   AccumulatorMapCollectionType m_AccumulatorMaps;
 
@@ -292,6 +341,8 @@ private:
 
   LabelPopulationMapType m_LabelPopulation;
 
+  QuantileSketchMapType m_QuantileSketches;
+
 }; // end of class PersistentStreamingStatisticsMapFromLabelImageFilter
 
 
@@ -422,6 +473,24 @@ public:
     return this->GetFilter()->GetLabelPopulationMap();
   }
 
+  /** Return the approximate q-quantile for each label */
+  PixelValueMapType GetQuantileValueMap(double q) const
+  {
+    return this->GetFilter()->GetQuantileValueMap(q);
+  }
+
+  /** Set the size of the quantile sketches, 0 to disable the quantiles */
+  void SetQuantileSketchSize(unsigned int size)
+  {
+    this->GetFilter()->SetQuantileSketchSize(size);
+  }
+
+  /** Return the size of the quantile sketches */
+  unsigned int GetQuantileSketchSize() const
+  {
+    return this->GetFilter()->GetQuantileSketchSize();
+  }
+
   /** Set the no data value */
   void SetNoDataValue(VectorPixelValueType value)
   {
@@ -35,7 +35,7 @@ namespace otb
 
 template <class TInputVectorImage, class TLabelImage>
 PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>::PersistentStreamingStatisticsMapFromLabelImageFilter()
-  : m_UseNoDataValue()
+  : m_UseNoDataValue(), m_QuantileSketchSize(0)
 {
   // first output is a copy of the image, DataObject created by
   // superclass
@@ -104,6 +104,36 @@ PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelIm
   return m_LabelPopulation;
 }
 
+template <class TInputVectorImage, class TLabelImage>
+typename PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>::PixelValueMapType
+PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>::GetQuantileValueMap(double q) const
+{
+  if (m_QuantileSketchSize == 0)
+  {
+    itkExceptionMacro("Quantiles are not computed, set a quantile sketch size before streaming the image.");
+  }
+
+  PixelValueMapType quantileMap;
+  for (const auto& it : m_QuantileSketches)
+  {
+    const auto&         sketches = it.second;
+    RealVectorPixelType quantiles(sketches.size());
+    for (unsigned int band = 0; band < sketches.size(); band++)
+    {
+      if (sketches[band].IsEmpty() && this->GetUseNoDataValue())
+      {
+        quantiles[band] = this->GetNoDataValue();
+      }
+      else
+      {
+        quantiles[band] = sketches[band].Quantile(q);
+      }
+    }
+    quantileMap.emplace(it.first, std::move(quantiles));
+  }
+  return quantileMap;
+}
+
 template <class TInputVectorImage, class TLabelImage>
 void PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>::GenerateOutputInformation()
 {
@@ -195,6 +225,12 @@ void PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLa
     // Min & max
     m_MinRadiometricValue.emplace(label, std::move(min));
     m_MaxRadiometricValue.emplace(label, std::move(max));
+
+    // Quantile sketches
+    if (m_QuantileSketchSize > 0)
+    {
+      m_QuantileSketches.emplace(label, it.second.GetQuantileSketches());
+    }
   }
 }
 
@@ -208,6 +244,7 @@ void PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLa
   m_MinRadiometricValue.clear();
   m_MaxRadiometricValue.clear();
   m_LabelPopulation.clear();
+  m_QuantileSketches.clear();
   m_AccumulatorMaps.resize(this->GetNumberOfThreads());
 }
 
@@ -266,7 +303,7 @@ void PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLa
     auto itAcc = acc.find(label);
     if (itAcc == endAcc)
     {
-      acc.emplace(label, AccumulatorType(this->GetNoDataValue(), this->GetUseNoDataValue(), value));
+      acc.emplace(label, AccumulatorType(this->GetNoDataValue(), this->GetUseNoDataValue(), value, m_QuantileSketchSize));
     }
     else
     {
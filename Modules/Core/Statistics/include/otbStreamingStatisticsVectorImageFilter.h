@@ -22,16 +22,277 @@
 #ifndef otbStreamingStatisticsVectorImageFilter_h
 #define otbStreamingStatisticsVectorImageFilter_h
 
-#include "otbPersistentImageFilter.h"
+#include "otbPersistentReductionImageFilter.h"
 #include "otbPersistentFilterStreamingDecorator.h"
+#include "otbAdaptiveHistogram.h"
+#include "otbQuantileSketch.h"
+#include "otbObjectList.h"
 #include "itkSimpleDataObjectDecorator.h"
 #include "itkImageRegionSplitter.h"
 #include "itkVariableSizeMatrix.h"
 #include "itkVariableLengthVector.h"
+#include "itkHistogram.h"
+
+#include <vector>
 
 namespace otb
 {
 
+/** \class StatisticsVectorAccumulator
+ * \brief Running sums, extrema, histograms and quantile sketches of a set
+ * of vector pixels.
+ *
+ * Only the statistics enabled at construction are accumulated. The
+ * histograms are AdaptiveHistogram, one per band, with
+ * histogramResolution fine bins (none if histogramResolution is 0). The
+ * quantile sketches are QuantileSketch, one per band, of size
+ * quantileSketchSize (none if quantileSketchSize is 0).
+ *
+ * \sa PersistentStreamingStatisticsVectorImageFilter
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TInputImage, class TPrecision>
+class StatisticsVectorAccumulator
+{
+public:
+  typedef typename TInputImage::PixelType         PixelType;
+  typedef typename TInputImage::InternalPixelType InternalPixelType;
+  typedef TPrecision                              RealType;
+  typedef itk::VariableLengthVector<TPrecision>   RealPixelType;
+  typedef itk::VariableSizeMatrix<TPrecision>     MatrixType;
+  typedef std::vector<AdaptiveHistogram>          HistogramVectorType;
+  typedef std::vector<QuantileSketch>             QuantileSketchVectorType;
+
+  StatisticsVectorAccumulator()
+    : m_NumberOfComponents(0),
+      m_EnableMinMax(false),
+      m_EnableFirstOrderStats(false),
+      m_EnableSecondOrderStats(false),
+      m_Count(0),
+      m_IgnoredInfinitePixelCount(0),
+      m_IgnoredUserPixelCount(0),
+      m_FirstOrderComponentAccumulator(itk::NumericTraits<RealType>::ZeroValue()),
+      m_SecondOrderComponentAccumulator(itk::NumericTraits<RealType>::ZeroValue())
+  {
+  }
+
+  StatisticsVectorAccumulator(unsigned int numberOfComponents, bool enableMinMax, bool enableFirstOrderStats, bool enableSecondOrderStats,
+                              unsigned int histogramResolution, unsigned int quantileSketchSize = 0)
+    : m_NumberOfComponents(numberOfComponents),
+      m_EnableMinMax(enableMinMax),
+      m_EnableFirstOrderStats(enableFirstOrderStats || enableSecondOrderStats),
+      m_EnableSecondOrderStats(enableSecondOrderStats),
+      m_Count(0),
+      m_IgnoredInfinitePixelCount(0),
+      m_IgnoredUserPixelCount(0),
+      m_FirstOrderComponentAccumulator(itk::NumericTraits<RealType>::ZeroValue()),
+      m_SecondOrderComponentAccumulator(itk::NumericTraits<RealType>::ZeroValue())
+  {
+    if (m_EnableMinMax)
+    {
+      m_Minimum.SetSize(numberOfComponents);
+      m_Minimum.Fill(itk::NumericTraits<InternalPixelType>::max());
+      m_Maximum.SetSize(numberOfComponents);
+      m_Maximum.Fill(itk::NumericTraits<InternalPixelType>::NonpositiveMin());
+    }
+    if (m_EnableFirstOrderStats)
+    {
+      m_FirstOrderAccumulator.SetSize(numberOfComponents);
+      m_FirstOrderAccumulator.Fill(itk::NumericTraits<RealType>::ZeroValue());
+    }
+    if (m_EnableSecondOrderStats)
+    {
+      m_SecondOrderAccumulator.SetSize(numberOfComponents, numberOfComponents);
+      m_SecondOrderAccumulator.Fill(itk::NumericTraits<RealType>::ZeroValue());
+    }
+    if (histogramResolution > 0)
+    {
+      m_Histograms.assign(numberOfComponents, AdaptiveHistogram(histogramResolution));
+    }
+    if (quantileSketchSize > 0)
+    {
+      m_QuantileSketches.assign(numberOfComponents, QuantileSketch(quantileSketchSize));
+    }
+  }
+
+  void Accumulate(const PixelType& vectorValue)
+  {
+    ++m_Count;
+
+    if (m_EnableMinMax)
+    {
+      for (unsigned int j = 0; j < m_NumberOfComponents; ++j)
+      {
+        if (vectorValue[j] < m_Minimum[j])
+        {
+          m_Minimum[j] = vectorValue[j];
+        }
+        if (vectorValue[j] > m_Maximum[j])
+        {
+          m_Maximum[j] = vectorValue[j];
+        }
+      }
+    }
+
+    if (m_EnableFirstOrderStats)
+    {
+      for (unsigned int j = 0; j < m_NumberOfComponents; ++j)
+      {
+        m_FirstOrderAccumulator[j] += vectorValue[j];
+        m_FirstOrderComponentAccumulator += vectorValue[j];
+      }
+    }
+
+    if (m_EnableSecondOrderStats)
+    {
+      for (unsigned int r = 0; r < m_NumberOfComponents; ++r)
+      {
+        for (unsigned int c = 0; c < m_NumberOfComponents; ++c)
+        {
+          m_SecondOrderAccumulator(r, c) += static_cast<RealType>(vectorValue[r]) * static_cast<RealType>(vectorValue[c]);
+        }
+      }
+      m_SecondOrderComponentAccumulator += vectorValue.GetSquaredNorm();
+    }
+
+    for (unsigned int j = 0; j < m_Histograms.size(); ++j)
+    {
+      m_Histograms[j].Add(static_cast<double>(vectorValue[j]));
+    }
+
+    for (unsigned int j = 0; j < m_QuantileSketches.size(); ++j)
+    {
+      m_QuantileSketches[j].Add(static_cast<double>(vectorValue[j]));
+    }
+  }
+
+  void IgnoreInfinitePixel()
+  {
+    ++m_IgnoredInfinitePixelCount;
+  }
+
+  void IgnoreUserPixel()
+  {
+    ++m_IgnoredUserPixelCount;
+  }
+
+  void Merge(const StatisticsVectorAccumulator& other)
+  {
+    if (m_NumberOfComponents == 0)
+    {
+      *this = other;
+      return;
+    }
+
+    if (m_EnableMinMax)
+    {
+      for (unsigned int j = 0; j < m_NumberOfComponents; ++j)
+      {
+        if (other.m_Minimum[j] < m_Minimum[j])
+        {
+          m_Minimum[j] = other.m_Minimum[j];
+        }
+        if (other.m_Maximum[j] > m_Maximum[j])
+        {
+          m_Maximum[j] = other.m_Maximum[j];
+        }
+      }
+    }
+
+    if (m_EnableFirstOrderStats)
+    {
+      m_FirstOrderAccumulator += other.m_FirstOrderAccumulator;
+      m_FirstOrderComponentAccumulator += other.m_FirstOrderComponentAccumulator;
+    }
+
+    if (m_EnableSecondOrderStats)
+    {
+      m_SecondOrderAccumulator += other.m_SecondOrderAccumulator;
+      m_SecondOrderComponentAccumulator += other.m_SecondOrderComponentAccumulator;
+    }
+
+    for (unsigned int j = 0; j < m_Histograms.size(); ++j)
+    {
+      m_Histograms[j].Merge(other.m_Histograms[j]);
+    }
+
+    for (unsigned int j = 0; j < m_QuantileSketches.size(); ++j)
+    {
+      m_QuantileSketches[j].Merge(other.m_QuantileSketches[j]);
+    }
+
+    m_Count += other.m_Count;
+    m_IgnoredInfinitePixelCount += other.m_IgnoredInfinitePixelCount;
+    m_IgnoredUserPixelCount += other.m_IgnoredUserPixelCount;
+  }
+
+  unsigned long GetCount() const
+  {
+    return m_Count;
+  }
+  unsigned long GetIgnoredInfinitePixelCount() const
+  {
+    return m_IgnoredInfinitePixelCount;
+  }
+  unsigned long GetIgnoredUserPixelCount() const
+  {
+    return m_IgnoredUserPixelCount;
+  }
+  const PixelType& GetMinimum() const
+  {
+    return m_Minimum;
+  }
+  const PixelType& GetMaximum() const
+  {
+    return m_Maximum;
+  }
+  const RealPixelType& GetFirstOrderAccumulator() const
+  {
+    return m_FirstOrderAccumulator;
+  }
+  const RealType& GetFirstOrderComponentAccumulator() const
+  {
+    return m_FirstOrderComponentAccumulator;
+  }
+  const MatrixType& GetSecondOrderAccumulator() const
+  {
+    return m_SecondOrderAccumulator;
+  }
+  const RealType& GetSecondOrderComponentAccumulator() const
+  {
+    return m_SecondOrderComponentAccumulator;
+  }
+  const HistogramVectorType& GetHistograms() const
+  {
+    return m_Histograms;
+  }
+  const QuantileSketchVectorType& GetQuantileSketches() const
+  {
+    return m_QuantileSketches;
+  }
+
+private:
+  unsigned int m_NumberOfComponents;
+  bool         m_EnableMinMax;
+  bool         m_EnableFirstOrderStats;
+  bool         m_EnableSecondOrderStats;
+
+  unsigned long m_Count;
+  unsigned long m_IgnoredInfinitePixelCount;
+  unsigned long m_IgnoredUserPixelCount;
+
+  PixelType           m_Minimum;
+  PixelType           m_Maximum;
+  RealPixelType       m_FirstOrderAccumulator;
+  RealType            m_FirstOrderComponentAccumulator;
+  MatrixType          m_SecondOrderAccumulator;
+  RealType            m_SecondOrderComponentAccumulator;
+  HistogramVectorType m_Histograms;
+
+  QuantileSketchVectorType m_QuantileSketches;
+};
+
 /** \class PersistentStreamingStatisticsVectorImageFilter
  * \brief Compute covariance & correlation of a large image using streaming
  *
@@ -42,7 +303,35 @@ namespace otb
  *
  * To get the statistics once the regions have been processed via the pipeline, use the Synthetize() method.
  *
- * \sa PersistentImageFilter
+ * All the enabled statistics are computed during the same pass over the
+ * image: minimum and maximum (EnableMinMax), mean and sum
+ * (EnableFirstOrderStats), covariance and correlation
+ * (EnableSecondOrderStats) and histograms (EnableHistograms). The
+ * histograms do not need the range of the image beforehand: they are
+ * accumulated in AdaptiveHistogram with HistogramResolution fine bins per
+ * band, and rebinned in NumberOfHistogramBins bins at the end of the pass.
+ *
+ * Approximate quantiles of each band are also available after the pass
+ * with ComputeQuantiles() when EnableQuantiles is set. They are estimated
+ * by a QuantileSketch per band, whose rank error decreases as
+ * 1 / QuantileSketchSize (about 2% for the default size of 200). Non
+ * finite band values are left out of the quantiles even when
+ * IgnoreInfiniteValues is off.
+ *
+ * All the statistics can be estimated on a subset of the pixels: when
+ * NumberOfSamples is not 0, only one pixel out of GetSamplingStride() in
+ * each dimension is used, the stride being the largest one keeping at
+ * least NumberOfSamples pixels. The pixels used are the ones whose
+ * indices are multiples of the stride, whatever the streaming. Treating
+ * them as a random sample, GetMeanConfidenceRadius() and
+ * GetRankErrorBound() bound the error on the means and on the ranks of
+ * the histograms and quantiles. The upstream pipeline still produces
+ * every pixel: to reduce the amount of data read, read an overview of the
+ * image instead (see ImageFileReader::GetOverviewResolutionFactor()).
+ *
+ * \sa PersistentReductionImageFilter
+ * \sa AdaptiveHistogram
+ * \sa QuantileSketch
  * \ingroup Streamed
  * \ingroup Multithreaded
  * \ingroup MathematicalStatisticsImageFilters
@@ -51,12 +340,13 @@ namespace otb
  * \ingroup OTBStatistics
  */
 template <class TInputImage, class TPrecision>
-class ITK_EXPORT PersistentStreamingStatisticsVectorImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+class ITK_EXPORT PersistentStreamingStatisticsVectorImageFilter
+    : public PersistentReductionImageFilter<TInputImage, StatisticsVectorAccumulator<TInputImage, TPrecision>>
 {
 public:
   /** Standard Self typedef */
   typedef PersistentStreamingStatisticsVectorImageFilter Self;
-  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef PersistentReductionImageFilter<TInputImage, StatisticsVectorAccumulator<TInputImage, TPrecision>> Superclass;
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
@@ -64,7 +354,7 @@ public:
   itkNewMacro(Self);
 
   /** Runtime information support. */
-  itkTypeMacro(PersistentStreamingStatisticsVectorImageFilter, PersistentImageFilter);
+  itkTypeMacro(PersistentStreamingStatisticsVectorImageFilter, PersistentReductionImageFilter);
 
   /** Image related typedefs. */
   typedef TInputImage                           ImageType;
@@ -98,6 +388,13 @@ public:
   typedef itk::SimpleDataObjectDecorator<MatrixType>    MatrixObjectType;
   typedef itk::SimpleDataObjectDecorator<CountType>     CountObjectType;
 
+  /** Types for histograms */
+  typedef itk::Statistics::Histogram<PrecisionType, itk::Statistics::DenseFrequencyContainer2> HistogramType;
+  typedef ObjectList<HistogramType>                                                            HistogramListType;
+  typedef typename HistogramListType::Pointer                                                  HistogramListPointerType;
+
+  typedef typename Superclass::AccumulatorType AccumulatorType;
+
   /** Return the number of relevant pixels **/
   CountType GetNbRelevantPixels() const
   {
@@ -181,6 +478,35 @@ public:
   MatrixObjectType*       GetCovarianceOutput();
   const MatrixObjectType* GetCovarianceOutput() const;
 
+  /** Return the computed histograms, one per band. The centers of the first
+   *  and last bins are the minimum and maximum of the band. */
+  HistogramListType*       GetHistogramListOutput();
+  const HistogramListType* GetHistogramListOutput() const;
+
+  /** Compute the histograms of the last pass again, with
+   *  NumberOfHistogramBins bins whose centers are evenly spaced from
+   *  minimum to maximum. */
+  HistogramListPointerType ComputeHistograms(const RealPixelType& minimum, const RealPixelType& maximum) const;
+
+  /** Approximate q-quantile of each band over the last pass, q in [0, 1].
+   *  A band without any finite value gets NaN. */
+  RealPixelType ComputeQuantiles(double q) const;
+
+  /** Stride between the pixels used in each dimension, computed from
+   *  NumberOfSamples when streaming starts. 1 if every pixel is used. */
+  itkGetConstMacro(SamplingStride, unsigned long);
+
+  /** Radius of the confidence interval of the mean of each band, for the
+   *  given confidence level: z * sigma / sqrt(n). Needs the second order
+   *  statistics. */
+  RealPixelType GetMeanConfidenceRadius(double confidence = 0.95) const;
+
+  /** Bound on the difference between the fraction of pixels below any
+   *  value in the sample and in the whole image, holding with the given
+   *  confidence (Dvoretzky-Kiefer-Wolfowitz inequality). It adds to the
+   *  error of the quantile sketches. 0 if every pixel is used. */
+  double GetRankErrorBound(double confidence = 0.95) const;
+
   /** Make a DataObject of the correct type to be used as the specified
    * output.
    */
@@ -189,8 +515,6 @@ public:
 
   void Reset(void) override;
 
-  void Synthetize(void) override;
-
   itkSetMacro(EnableMinMax, bool);
   itkGetMacro(EnableMinMax, bool);
 
@@ -200,6 +524,32 @@ public:
   itkSetMacro(EnableSecondOrderStats, bool);
   itkGetMacro(EnableSecondOrderStats, bool);
 
+  itkSetMacro(EnableHistograms, bool);
+  itkGetMacro(EnableHistograms, bool);
+
+  /** Number of bins of the output histograms. Default is 256. */
+  itkSetMacro(NumberOfHistogramBins, unsigned int);
+  itkGetMacro(NumberOfHistogramBins, unsigned int);
+
+  /** Number of fine bins of the histograms accumulated during the pass,
+   *  see AdaptiveHistogram. Each chunk of a streamed piece holds its own
+   *  histograms (8 bytes per fine bin and band) until the piece is reduced.
+   *  Default is 4096. */
+  itkSetMacro(HistogramResolution, unsigned int);
+  itkGetMacro(HistogramResolution, unsigned int);
+
+  itkSetMacro(EnableQuantiles, bool);
+  itkGetMacro(EnableQuantiles, bool);
+
+  /** Size of the quantile sketches, see QuantileSketch. Default is 200. */
+  itkSetMacro(QuantileSketchSize, unsigned int);
+  itkGetMacro(QuantileSketchSize, unsigned int);
+
+  /** Minimum number of pixels to estimate the statistics on. Default is 0:
+   *  every pixel is used. */
+  itkSetMacro(NumberOfSamples, unsigned long);
+  itkGetMacro(NumberOfSamples, unsigned long);
+
   itkSetMacro(IgnoreInfiniteValues, bool);
   itkGetMacro(IgnoreInfiniteValues, bool);
 
@@ -219,43 +569,41 @@ protected:
   {
   }
 
-  /** Pass the input through unmodified. Do this by Grafting in the
-   *  AllocateOutputs method.
-   */
-  void AllocateOutputs() override;
-
-  void GenerateOutputInformation() override;
-
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
-  /** Multi-thread version GenerateData. */
-  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+  AccumulatorType CreateAccumulator() const override;
+  void AccumulateRegion(AccumulatorType& accumulator, const RegionType& region) const override;
+  void Finalize(const AccumulatorType& accumulator) override;
 
 private:
+  /** Accumulate the pixels of it, honoring the ignored values */
+  template <class TIterator>
+  void AccumulatePixels(AccumulatorType& accumulator, TIterator& it) const;
+
   PersistentStreamingStatisticsVectorImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
   bool m_EnableMinMax;
   bool m_EnableFirstOrderStats;
   bool m_EnableSecondOrderStats;
+  bool m_EnableHistograms;
+
+  unsigned int m_NumberOfHistogramBins;
+  unsigned int m_HistogramResolution;
 
+  bool         m_EnableQuantiles;
+  unsigned int m_QuantileSketchSize;
+
+  unsigned long m_NumberOfSamples;
+  unsigned long m_SamplingStride;
 
   /* use an unbiased estimator to compute the covariance */
   bool m_UseUnbiasedEstimator;
 
-  std::vector<PixelType>     m_ThreadMin;
-  std::vector<PixelType>     m_ThreadMax;
-  std::vector<RealType>      m_ThreadFirstOrderComponentAccumulators;
-  std::vector<RealType>      m_ThreadSecondOrderComponentAccumulators;
-  std::vector<RealPixelType> m_ThreadFirstOrderAccumulators;
-  std::vector<MatrixType>    m_ThreadSecondOrderAccumulators;
-
   /* Ignored values */
-  bool                      m_IgnoreInfiniteValues;
-  bool                      m_IgnoreUserDefinedValue;
-  InternalPixelType         m_UserIgnoredValue;
-  std::vector<unsigned int> m_IgnoredInfinitePixelCount;
-  std::vector<unsigned int> m_IgnoredUserPixelCount;
+  bool              m_IgnoreInfiniteValues;
+  bool              m_IgnoreUserDefinedValue;
+  InternalPixelType m_UserIgnoredValue;
 
 }; // end of class PersistentStreamingStatisticsVectorImageFilter
 
@@ -264,7 +612,8 @@ private:
 /** \class StreamingStatisticsVectorImageFilter
  * \brief This class streams the whole input image through the PersistentStatisticsImageFilter.
  *
- * This way, it allows computing the first and second order global statistics of this image. It calls the
+ * This way, it allows computing the first and second order global statistics and the histograms of this image,
+ * in a single pass. It calls the
  * Reset() method of the PersistentStreamingStatisticsVectorImageFilter before streaming the image and the
  * Synthetize() method of the PersistentStreamingStatisticsVectorImageFilter after having streamed the image
  * to compute the statistics. The accessor on the results are wrapping the accessors of the
@@ -313,6 +662,8 @@ public:
   typedef typename StatFilterType::MatrixObjectType    MatrixObjectType;
   typedef typename StatFilterType::CountType           CountType;
   typedef typename StatFilterType::CountObjectType     CountObjectType;
+  typedef typename StatFilterType::HistogramType       HistogramType;
+  typedef typename StatFilterType::HistogramListType   HistogramListType;
 
   typedef typename StatFilterType::InternalPixelType InternalPixelType;
 
@@ -467,6 +818,40 @@ public:
     return this->GetFilter()->GetComponentCorrelationOutput();
   }
 
+  /** Return the computed histograms. */
+  HistogramListType* GetHistogramList()
+  {
+    return this->GetFilter()->GetHistogramListOutput();
+  }
+  const HistogramListType* GetHistogramList() const
+  {
+    return this->GetFilter()->GetHistogramListOutput();
+  }
+
+  /** Return the approximate q-quantile of each band. */
+  RealPixelType ComputeQuantiles(double q) const
+  {
+    return this->GetFilter()->ComputeQuantiles(q);
+  }
+
+  /** Return the stride between the pixels used. */
+  unsigned long GetSamplingStride() const
+  {
+    return this->GetFilter()->GetSamplingStride();
+  }
+
+  /** Return the radius of the confidence interval of the means. */
+  RealPixelType GetMeanConfidenceRadius(double confidence = 0.95) const
+  {
+    return this->GetFilter()->GetMeanConfidenceRadius(confidence);
+  }
+
+  /** Return the bound on the rank error due to the sampling. */
+  double GetRankErrorBound(double confidence = 0.95) const
+  {
+    return this->GetFilter()->GetRankErrorBound(confidence);
+  }
+
   otbSetObjectMemberMacro(Filter, EnableMinMax, bool);
   otbGetObjectMemberMacro(Filter, EnableMinMax, bool);
 
@@ -476,6 +861,24 @@ public:
   otbSetObjectMemberMacro(Filter, EnableSecondOrderStats, bool);
   otbGetObjectMemberMacro(Filter, EnableSecondOrderStats, bool);
 
+  otbSetObjectMemberMacro(Filter, EnableHistograms, bool);
+  otbGetObjectMemberMacro(Filter, EnableHistograms, bool);
+
+  otbSetObjectMemberMacro(Filter, NumberOfHistogramBins, unsigned int);
+  otbGetObjectMemberMacro(Filter, NumberOfHistogramBins, unsigned int);
+
+  otbSetObjectMemberMacro(Filter, HistogramResolution, unsigned int);
+  otbGetObjectMemberMacro(Filter, HistogramResolution, unsigned int);
+
+  otbSetObjectMemberMacro(Filter, EnableQuantiles, bool);
+  otbGetObjectMemberMacro(Filter, EnableQuantiles, bool);
+
+  otbSetObjectMemberMacro(Filter, QuantileSketchSize, unsigned int);
+  otbGetObjectMemberMacro(Filter, QuantileSketchSize, unsigned int);
+
+  otbSetObjectMemberMacro(Filter, NumberOfSamples, unsigned long);
+  otbGetObjectMemberMacro(Filter, NumberOfSamples, unsigned long);
+
   otbSetObjectMemberMacro(Filter, IgnoreInfiniteValues, bool);
   otbGetObjectMemberMacro(Filter, IgnoreInfiniteValues, bool);
 
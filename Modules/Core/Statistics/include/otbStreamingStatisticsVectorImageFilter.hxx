@@ -22,11 +22,14 @@
 #define otbStreamingStatisticsVectorImageFilter_hxx
 #include "otbStreamingStatisticsVectorImageFilter.h"
 
-#include "itkImageRegionIterator.h"
-#include "itkImageRegionConstIteratorWithIndex.h"
-#include "itkProgressReporter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkGaussianDistribution.h"
+#include "otbSubsampledImageRegionConstIterator.h"
 #include "otbMacro.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace otb
 {
 
@@ -35,6 +38,13 @@ PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Persist
   : m_EnableMinMax(true),
     m_EnableFirstOrderStats(true),
     m_EnableSecondOrderStats(true),
+    m_EnableHistograms(false),
+    m_NumberOfHistogramBins(256),
+    m_HistogramResolution(4096),
+    m_EnableQuantiles(false),
+    m_QuantileSketchSize(200),
+    m_NumberOfSamples(0),
+    m_SamplingStride(1),
     m_UseUnbiasedEstimator(true),
     m_IgnoreInfiniteValues(true),
     m_IgnoreUserDefinedValue(false),
@@ -45,13 +55,11 @@ PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Persist
 
   // allocate the data objects for the outputs which are
   // just decorators around vector/matrix types
-  for (unsigned int i = 1; i < 11; ++i)
+  // and the histogram list
+  for (unsigned int i = 1; i < 12; ++i)
   {
     this->itk::ProcessObject::SetNthOutput(i, this->MakeOutput(i).GetPointer());
   }
-  // Initiate ignored pixel counters
-  m_IgnoredInfinitePixelCount = std::vector<unsigned int>(this->GetNumberOfThreads(), 0);
-  m_IgnoredUserPixelCount     = std::vector<unsigned int>(this->GetNumberOfThreads(), 0);
 }
 
 template <class TInputImage, class TPrecision>
@@ -86,6 +94,9 @@ itk::DataObject::Pointer PersistentStreamingStatisticsVectorImageFilter<TInputIm
   case 10:
     // relevant pixel
     return static_cast<itk::DataObject*>(CountObjectType::New().GetPointer());
+  case 11:
+    // histograms
+    return static_cast<itk::DataObject*>(HistogramListType::New().GetPointer());
   default:
     // might as well make an image
     return static_cast<itk::DataObject*>(TInputImage::New().GetPointer());
@@ -236,29 +247,17 @@ PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::GetCova
 }
 
 template <class TInputImage, class TPrecision>
-void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::GenerateOutputInformation()
+typename PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::HistogramListType*
+PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::GetHistogramListOutput()
 {
-  Superclass::GenerateOutputInformation();
-  if (this->GetInput())
-  {
-    this->GetOutput()->CopyInformation(this->GetInput());
-    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
-
-    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
-    {
-      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
-    }
-  }
+  return static_cast<HistogramListType*>(this->itk::ProcessObject::GetOutput(11));
 }
 
 template <class TInputImage, class TPrecision>
-void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::AllocateOutputs()
+const typename PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::HistogramListType*
+PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::GetHistogramListOutput() const
 {
-  // This is commented to prevent the streaming of the whole image for the first stream strip
-  // It shall not cause any problem because the output image of this filter is not intended to be used.
-  // InputImagePointer image = const_cast< TInputImage * >( this->GetInput() );
-  // this->GraftOutput( image );
-  // Nothing that needs to be allocated for the remaining outputs
+  return static_cast<const HistogramListType*>(this->itk::ProcessObject::GetOutput(11));
 }
 
 template <class TInputImage, class TPrecision>
@@ -267,7 +266,6 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Re
   TInputImage* inputPtr = const_cast<TInputImage*>(this->GetInput());
   inputPtr->UpdateOutputInformation();
 
-  unsigned int numberOfThreads   = this->GetNumberOfThreads();
   unsigned int numberOfComponent = inputPtr->GetNumberOfComponentsPerPixel();
 
   if (m_EnableMinMax)
@@ -280,14 +278,6 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Re
 
     tempPixel.Fill(itk::NumericTraits<InternalPixelType>::NonpositiveMin());
     this->GetMaximumOutput()->Set(tempPixel);
-
-    PixelType tempTemporariesPixel;
-    tempTemporariesPixel.SetSize(numberOfComponent);
-    tempTemporariesPixel.Fill(itk::NumericTraits<InternalPixelType>::max());
-    m_ThreadMin = std::vector<PixelType>(numberOfThreads, tempTemporariesPixel);
-
-    tempTemporariesPixel.Fill(itk::NumericTraits<InternalPixelType>::NonpositiveMin());
-    m_ThreadMax = std::vector<PixelType>(numberOfThreads, tempTemporariesPixel);
   }
 
   if (m_EnableSecondOrderStats)
@@ -302,12 +292,6 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Re
     zeroRealPixel.Fill(itk::NumericTraits<PrecisionType>::ZeroValue());
     this->GetMeanOutput()->Set(zeroRealPixel);
     this->GetSumOutput()->Set(zeroRealPixel);
-    m_ThreadFirstOrderAccumulators.resize(numberOfThreads);
-    std::fill(m_ThreadFirstOrderAccumulators.begin(), m_ThreadFirstOrderAccumulators.end(), zeroRealPixel);
-
-    RealType zeroReal = itk::NumericTraits<RealType>::ZeroValue();
-    m_ThreadFirstOrderComponentAccumulators.resize(numberOfThreads);
-    std::fill(m_ThreadFirstOrderComponentAccumulators.begin(), m_ThreadFirstOrderComponentAccumulators.end(), zeroReal);
   }
 
   if (m_EnableSecondOrderStats)
@@ -317,98 +301,58 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Re
     zeroMatrix.Fill(itk::NumericTraits<PrecisionType>::Zero);
     this->GetCovarianceOutput()->Set(zeroMatrix);
     this->GetCorrelationOutput()->Set(zeroMatrix);
-
-    m_ThreadSecondOrderAccumulators.resize(numberOfThreads);
-    std::fill(m_ThreadSecondOrderAccumulators.begin(), m_ThreadSecondOrderAccumulators.end(), zeroMatrix);
-
-    RealType zeroReal = itk::NumericTraits<RealType>::ZeroValue();
-    m_ThreadSecondOrderComponentAccumulators.resize(numberOfThreads);
-    std::fill(m_ThreadSecondOrderComponentAccumulators.begin(), m_ThreadSecondOrderComponentAccumulators.end(), zeroReal);
   }
 
-  if (m_IgnoreInfiniteValues)
-  {
-    m_IgnoredInfinitePixelCount = std::vector<unsigned int>(numberOfThreads, 0);
-  }
+  this->GetHistogramListOutput()->Clear();
 
-  if (m_IgnoreUserDefinedValue)
-  {
-    m_IgnoredUserPixelCount = std::vector<unsigned int>(this->GetNumberOfThreads(), 0);
-  }
-}
-
-template <class TInputImage, class TPrecision>
-void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Synthetize()
-{
-  TInputImage*       inputPtr          = const_cast<TInputImage*>(this->GetInput());
-  const unsigned int nbPixels          = inputPtr->GetLargestPossibleRegion().GetNumberOfPixels();
-  const unsigned int numberOfComponent = inputPtr->GetNumberOfComponentsPerPixel();
+  // Largest stride keeping at least m_NumberOfSamples pixels
+  m_SamplingStride = 1;
 
-  PixelType minimum;
-  minimum.SetSize(numberOfComponent);
-  minimum.Fill(itk::NumericTraits<InternalPixelType>::max());
-  PixelType maximum;
-  maximum.SetSize(numberOfComponent);
-  maximum.Fill(itk::NumericTraits<InternalPixelType>::NonpositiveMin());
-
-  RealPixelType streamFirstOrderAccumulator(numberOfComponent);
-  streamFirstOrderAccumulator.Fill(itk::NumericTraits<PrecisionType>::Zero);
-  MatrixType streamSecondOrderAccumulator(numberOfComponent, numberOfComponent);
-  streamSecondOrderAccumulator.Fill(itk::NumericTraits<PrecisionType>::Zero);
-
-  RealType streamFirstOrderComponentAccumulator  = itk::NumericTraits<RealType>::Zero;
-  RealType streamSecondOrderComponentAccumulator = itk::NumericTraits<RealType>::Zero;
-
-  unsigned int ignoredInfinitePixelCount = 0;
-  unsigned int ignoredUserPixelCount     = 0;
-
-  // Accumulate results from all threads
-  const itk::ThreadIdType numberOfThreads = this->GetNumberOfThreads();
-  for (itk::ThreadIdType threadId = 0; threadId < numberOfThreads; ++threadId)
+  const SizeType      size           = inputPtr->GetLargestPossibleRegion().GetSize();
+  const unsigned long numberOfPixels = inputPtr->GetLargestPossibleRegion().GetNumberOfPixels();
+  if (m_NumberOfSamples > 0 && numberOfPixels > m_NumberOfSamples)
   {
-    if (m_EnableMinMax)
-    {
-      const PixelType& threadMin = m_ThreadMin[threadId];
-      const PixelType& threadMax = m_ThreadMax[threadId];
-
-      for (unsigned int j = 0; j < numberOfComponent; ++j)
+    auto numberOfSamples = [&size](unsigned long stride) {
+      unsigned long count = 1;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
       {
-        if (threadMin[j] < minimum[j])
-        {
-          minimum[j] = threadMin[j];
-        }
-        if (threadMax[j] > maximum[j])
-        {
-          maximum[j] = threadMax[j];
-        }
+        count *= (size[i] + stride - 1) / stride;
       }
-    }
+      return count;
+    };
 
-    if (m_EnableFirstOrderStats)
+    m_SamplingStride = std::max(1UL, static_cast<unsigned long>(std::pow(static_cast<double>(numberOfPixels) / m_NumberOfSamples, 1. / ImageDimension)));
+    unsigned long maximumStride = 1;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
     {
-      streamFirstOrderAccumulator += m_ThreadFirstOrderAccumulators[threadId];
-      streamFirstOrderComponentAccumulator += m_ThreadFirstOrderComponentAccumulators[threadId];
+      maximumStride = std::max(maximumStride, static_cast<unsigned long>(size[i]));
     }
-
-    if (m_EnableSecondOrderStats)
+    while (m_SamplingStride < maximumStride && numberOfSamples(m_SamplingStride + 1) >= m_NumberOfSamples)
+    {
+      ++m_SamplingStride;
+    }
+    while (m_SamplingStride > 1 && numberOfSamples(m_SamplingStride) < m_NumberOfSamples)
     {
-      streamSecondOrderAccumulator += m_ThreadSecondOrderAccumulators[threadId];
-      streamSecondOrderComponentAccumulator += m_ThreadSecondOrderComponentAccumulators[threadId];
+      --m_SamplingStride;
     }
-    // Ignored Infinite Pixels
-    ignoredInfinitePixelCount += m_IgnoredInfinitePixelCount[threadId];
-    // Ignored Pixels
-    ignoredUserPixelCount += m_IgnoredUserPixelCount[threadId];
   }
 
-  // There cannot be more ignored pixels than read pixels.
-  assert(nbPixels >= ignoredInfinitePixelCount + ignoredUserPixelCount);
-  if (nbPixels < ignoredInfinitePixelCount + ignoredUserPixelCount)
-  {
-    itkExceptionMacro("nbPixels < ignoredInfinitePixelCount + ignoredUserPixelCount");
-  }
+  Superclass::Reset();
+}
 
-  unsigned int nbRelevantPixel = nbPixels - (ignoredInfinitePixelCount + ignoredUserPixelCount);
+template <class TInputImage, class TPrecision>
+typename PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::AccumulatorType
+PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::CreateAccumulator() const
+{
+  return AccumulatorType(this->GetInput()->GetNumberOfComponentsPerPixel(), m_EnableMinMax, m_EnableFirstOrderStats, m_EnableSecondOrderStats,
+                         m_EnableHistograms ? std::max(m_HistogramResolution, 2U) : 0, m_EnableQuantiles ? std::max(m_QuantileSketchSize, 1U) : 0);
+}
+
+template <class TInputImage, class TPrecision>
+void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Finalize(const AccumulatorType& accumulator)
+{
+  const unsigned int numberOfComponent = this->GetInput()->GetNumberOfComponentsPerPixel();
+  const unsigned long nbRelevantPixel  = accumulator.GetCount();
 
   CountType nbRelevantPixels(numberOfComponent);
   nbRelevantPixels.Fill(nbRelevantPixel);
@@ -423,21 +367,21 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Sy
   // Final calculations
   if (m_EnableMinMax)
   {
-    this->GetMinimumOutput()->Set(minimum);
-    this->GetMaximumOutput()->Set(maximum);
+    this->GetMinimumOutput()->Set(accumulator.GetMinimum());
+    this->GetMaximumOutput()->Set(accumulator.GetMaximum());
   }
 
   if (m_EnableFirstOrderStats)
   {
-    this->GetComponentMeanOutput()->Set(streamFirstOrderComponentAccumulator / (nbRelevantPixel * numberOfComponent));
+    this->GetComponentMeanOutput()->Set(accumulator.GetFirstOrderComponentAccumulator() / (nbRelevantPixel * numberOfComponent));
 
-    this->GetMeanOutput()->Set(streamFirstOrderAccumulator / nbRelevantPixel);
-    this->GetSumOutput()->Set(streamFirstOrderAccumulator);
+    this->GetMeanOutput()->Set(accumulator.GetFirstOrderAccumulator() / nbRelevantPixel);
+    this->GetSumOutput()->Set(accumulator.GetFirstOrderAccumulator());
   }
 
   if (m_EnableSecondOrderStats)
   {
-    MatrixType cor = streamSecondOrderAccumulator / nbRelevantPixel;
+    MatrixType cor = accumulator.GetSecondOrderAccumulator() / nbRelevantPixel;
     this->GetCorrelationOutput()->Set(cor);
 
     const RealPixelType& mean = this->GetMeanOutput()->Get();
@@ -465,28 +409,168 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Sy
     }
     this->GetCovarianceOutput()->Set(cov);
 
-    this->GetComponentMeanOutput()->Set(streamFirstOrderComponentAccumulator / (nbRelevantPixel * numberOfComponent));
-    this->GetComponentCorrelationOutput()->Set(streamSecondOrderComponentAccumulator / (nbRelevantPixel * numberOfComponent));
+    this->GetComponentMeanOutput()->Set(accumulator.GetFirstOrderComponentAccumulator() / (nbRelevantPixel * numberOfComponent));
+    this->GetComponentCorrelationOutput()->Set(accumulator.GetSecondOrderComponentAccumulator() / (nbRelevantPixel * numberOfComponent));
     this->GetComponentCovarianceOutput()->Set(regulComponent * (this->GetComponentCorrelation() - (this->GetComponentMean() * this->GetComponentMean())));
   }
+
+  if (m_EnableHistograms)
+  {
+    // Center the first and last bins on the extrema of each band
+    const auto&   histograms = accumulator.GetHistograms();
+    RealPixelType minimum(numberOfComponent), maximum(numberOfComponent);
+    for (unsigned int j = 0; j < numberOfComponent; ++j)
+    {
+      minimum[j] = histograms[j].GetMinimum();
+      maximum[j] = histograms[j].GetMaximum();
+    }
+
+    HistogramListPointerType histogramList = this->ComputeHistograms(minimum, maximum);
+    HistogramListType*       outputHisto   = this->GetHistogramListOutput();
+    outputHisto->Clear();
+    for (unsigned int j = 0; j < histogramList->Size(); ++j)
+    {
+      outputHisto->PushBack(histogramList->GetNthElement(j));
+    }
+  }
+}
+
+template <class TInputImage, class TPrecision>
+typename PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::HistogramListPointerType
+PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::ComputeHistograms(const RealPixelType& minimum, const RealPixelType& maximum) const
+{
+  const auto& histograms = this->GetAccumulator().GetHistograms();
+  if (histograms.empty())
+  {
+    itkExceptionMacro("Histograms are not computed, enable them before streaming the image.");
+  }
+
+  const unsigned int numberOfBins = std::max(m_NumberOfHistogramBins, 1U);
+
+  HistogramListPointerType histogramList = HistogramListType::New();
+  for (unsigned int j = 0; j < histograms.size(); ++j)
+  {
+    // Bins of the same width whose centers span [minimum, maximum]
+    const double step     = numberOfBins > 1 ? (maximum[j] - minimum[j]) / (numberOfBins - 1) : 0.;
+    const double halfStep = step > 0. ? 0.5 * step : 0.5;
+
+    typename HistogramType::MeasurementVectorType lower, upper;
+    lower.SetSize(1);
+    upper.SetSize(1);
+    lower.Fill(minimum[j] - halfStep);
+    upper.Fill(maximum[j] + halfStep);
+
+    typename HistogramType::SizeType size;
+    size.SetSize(1);
+    size.Fill(numberOfBins);
+
+    typename HistogramType::Pointer histogram = HistogramType::New();
+    histogram->SetMeasurementVectorSize(1);
+    histogram->Initialize(size, lower, upper);
+
+    const AdaptiveHistogram::FrequencyVectorType frequencies = histograms[j].Rebin(lower[0], upper[0], numberOfBins);
+    for (unsigned int bin = 0; bin < numberOfBins; ++bin)
+    {
+      histogram->SetFrequency(bin, frequencies[bin]);
+    }
+
+    histogramList->PushBack(histogram);
+  }
+  return histogramList;
+}
+
+template <class TInputImage, class TPrecision>
+typename PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::RealPixelType
+PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::ComputeQuantiles(double q) const
+{
+  const auto& sketches = this->GetAccumulator().GetQuantileSketches();
+  if (sketches.empty())
+  {
+    itkExceptionMacro("Quantiles are not computed, enable them before streaming the image.");
+  }
+
+  RealPixelType quantiles(sketches.size());
+  for (unsigned int j = 0; j < sketches.size(); ++j)
+  {
+    quantiles[j] = static_cast<PrecisionType>(sketches[j].Quantile(q));
+  }
+  return quantiles;
+}
+
+template <class TInputImage, class TPrecision>
+typename PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::RealPixelType
+PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::GetMeanConfidenceRadius(double confidence) const
+{
+  if (!m_EnableSecondOrderStats)
+  {
+    itkExceptionMacro("The confidence radius of the means needs the second order statistics.");
+  }
+
+  const MatrixType&   covariance = this->GetCovarianceOutput()->Get();
+  const double        z          = itk::Statistics::GaussianDistribution::InverseCDF(0.5 + 0.5 * confidence);
+  const unsigned long count      = this->GetAccumulator().GetCount();
+
+  RealPixelType radius(covariance.Rows());
+  for (unsigned int j = 0; j < covariance.Rows(); ++j)
+  {
+    radius[j] = count > 0 ? z * std::sqrt(covariance(j, j) / count) : itk::NumericTraits<PrecisionType>::max();
+  }
+  return radius;
 }
 
 template <class TInputImage, class TPrecision>
-void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::ThreadedGenerateData(const RegionType& outputRegionForThread,
-                                                                                                   itk::ThreadIdType threadId)
+double PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::GetRankErrorBound(double confidence) const
 {
-  // Support progress methods/callbacks
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+  const unsigned long count = this->GetAccumulator().GetCount();
+  if (m_SamplingStride <= 1)
+  {
+    return 0.;
+  }
+  if (count == 0)
+  {
+    return 1.;
+  }
+  // P(sup |F_n - F| > e) <= 2 exp(-2 n e^2)
+  return std::min(1., std::sqrt(std::log(2. / (1. - confidence)) / (2. * count)));
+}
 
-  // Grab the input
-  InputImagePointer inputPtr  = const_cast<TInputImage*>(this->GetInput());
-  PixelType&        threadMin = m_ThreadMin[threadId];
-  PixelType&        threadMax = m_ThreadMax[threadId];
+template <class TInputImage, class TPrecision>
+void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::AccumulateRegion(AccumulatorType& accumulator, const RegionType& region) const
+{
+  if (m_SamplingStride <= 1)
+  {
+    itk::ImageRegionConstIterator<TInputImage> it(this->GetInput(), region);
+    AccumulatePixels(accumulator, it);
+    return;
+  }
 
+  // Restrict the region to the pixels whose indices are multiples of the
+  // stride, so that the same pixels are used whatever the streaming
+  const long stride = static_cast<long>(m_SamplingStride);
+  IndexType  index  = region.GetIndex();
+  SizeType   size   = region.GetSize();
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    const long first = index[i] >= 0 ? (index[i] + stride - 1) / stride * stride : index[i] / stride * stride;
+    const long end   = index[i] + static_cast<long>(size[i]);
+    if (first >= end)
+    {
+      return;
+    }
+    index[i] = first;
+    size[i]  = end - first;
+  }
 
-  itk::ImageRegionConstIteratorWithIndex<TInputImage> it(inputPtr, outputRegionForThread);
+  SubsampledImageRegionConstIterator<TInputImage> it(this->GetInput(), RegionType(index, size));
+  it.SetSubsampleFactor(stride);
+  AccumulatePixels(accumulator, it);
+}
 
-  for (it.GoToBegin(); !it.IsAtEnd(); ++it, progress.CompletedPixel())
+template <class TInputImage, class TPrecision>
+template <class TIterator>
+void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::AccumulatePixels(AccumulatorType& accumulator, TIterator& it) const
+{
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
   {
     const PixelType& vectorValue = it.Get();
 
@@ -500,59 +584,15 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Th
 
     if (m_IgnoreInfiniteValues && !(vnl_math_isfinite(finiteProbe)))
     {
-      m_IgnoredInfinitePixelCount[threadId]++;
+      accumulator.IgnoreInfinitePixel();
+    }
+    else if (userProbe)
+    {
+      accumulator.IgnoreUserPixel();
     }
     else
     {
-      if (userProbe)
-      {
-        m_IgnoredUserPixelCount[threadId]++;
-      }
-      else
-      {
-        if (m_EnableMinMax)
-        {
-          for (unsigned int j = 0; j < vectorValue.GetSize(); ++j)
-          {
-            if (vectorValue[j] < threadMin[j])
-            {
-              threadMin[j] = vectorValue[j];
-            }
-            if (vectorValue[j] > threadMax[j])
-            {
-              threadMax[j] = vectorValue[j];
-            }
-          }
-        }
-
-        if (m_EnableFirstOrderStats)
-        {
-          RealPixelType& threadFirstOrder          = m_ThreadFirstOrderAccumulators[threadId];
-          RealType&      threadFirstOrderComponent = m_ThreadFirstOrderComponentAccumulators[threadId];
-
-          threadFirstOrder += vectorValue;
-
-          for (unsigned int i = 0; i < vectorValue.GetSize(); ++i)
-          {
-            threadFirstOrderComponent += vectorValue[i];
-          }
-        }
-
-        if (m_EnableSecondOrderStats)
-        {
-          MatrixType& threadSecondOrder          = m_ThreadSecondOrderAccumulators[threadId];
-          RealType&   threadSecondOrderComponent = m_ThreadSecondOrderComponentAccumulators[threadId];
-
-          for (unsigned int r = 0; r < threadSecondOrder.Rows(); ++r)
-          {
-            for (unsigned int c = 0; c < threadSecondOrder.Cols(); ++c)
-            {
-              threadSecondOrder(r, c) += static_cast<PrecisionType>(vectorValue[r]) * static_cast<PrecisionType>(vectorValue[c]);
-            }
-          }
-          threadSecondOrderComponent += vectorValue.GetSquaredNorm();
-        }
-      }
+      accumulator.Accumulate(vectorValue);
     }
   }
 }
@@ -572,6 +612,13 @@ void PersistentStreamingStatisticsVectorImageFilter<TImage, TPrecision>::PrintSe
   os << indent << "Component Covariance: " << this->GetComponentCovarianceOutput()->Get() << std::endl;
   os << indent << "Component Correlation: " << this->GetComponentCorrelationOutput()->Get() << std::endl;
   os << indent << "UseUnbiasedEstimator: " << (this->m_UseUnbiasedEstimator ? "true" : "false") << std::endl;
+  os << indent << "EnableHistograms: " << (this->m_EnableHistograms ? "true" : "false") << std::endl;
+  os << indent << "NumberOfHistogramBins: " << this->m_NumberOfHistogramBins << std::endl;
+  os << indent << "HistogramResolution: " << this->m_HistogramResolution << std::endl;
+  os << indent << "EnableQuantiles: " << (this->m_EnableQuantiles ? "true" : "false") << std::endl;
+  os << indent << "QuantileSketchSize: " << this->m_QuantileSketchSize << std::endl;
+  os << indent << "NumberOfSamples: " << this->m_NumberOfSamples << std::endl;
+  os << indent << "SamplingStride: " << this->m_SamplingStride << std::endl;
 }
 
 } // end namespace otb
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbAdaptiveHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace otb
+{
+
+namespace
+{
+
+/** Index of the bin of width 2^exponent containing value */
+std::int64_t BinIndex(double value, int exponent)
+{
+  const double scaled = std::floor(std::ldexp(value, -exponent));
+  if (scaled == 0. && value < 0.)
+  {
+    // ldexp rounded a tiny negative value to zero
+    return -1;
+  }
+  return static_cast<std::int64_t>(scaled);
+}
+
+/** Index of the bin of width 2^(exponent + shift) containing the bin of
+ *  width 2^exponent with the given index */
+std::int64_t ShiftIndex(std::int64_t index, int shift)
+{
+  if (shift >= 63)
+  {
+    return index < 0 ? -1 : 0;
+  }
+  return index >= 0 ? index >> shift : -((-(index + 1)) >> shift) - 1;
+}
+
+/** Finest exponent keeping the bin indices of [lower, upper] on 54 bits */
+int FinestExponent(double lower, double upper)
+{
+  const int    minimumExponent = std::numeric_limits<double>::min_exponent - std::numeric_limits<double>::digits;
+  const double magnitude       = std::max(std::abs(lower), std::abs(upper));
+  if (magnitude == 0.)
+  {
+    return minimumExponent;
+  }
+  return std::max(std::ilogb(magnitude) - std::numeric_limits<double>::digits, minimumExponent);
+}
+
+} // end anonymous namespace
+
+AdaptiveHistogram::AdaptiveHistogram(unsigned int numberOfBins)
+  : m_NumberOfBins(std::max(numberOfBins, 2U)), m_Exponent(0), m_Offset(0), m_Minimum(0.), m_Maximum(0.), m_Integral(true), m_TotalFrequency(0)
+{
+}
+
+void AdaptiveHistogram::Add(double value)
+{
+  if (!std::isfinite(value))
+  {
+    return;
+  }
+
+  if (IsEmpty())
+  {
+    m_Minimum  = value;
+    m_Maximum  = value;
+    m_Exponent = FinestExponent(value, value);
+    m_Offset   = BinIndex(value, m_Exponent);
+    m_Integral = true;
+    m_Frequencies.assign(m_NumberOfBins, 0);
+  }
+  else
+  {
+    m_Minimum = std::min(m_Minimum, value);
+    m_Maximum = std::max(m_Maximum, value);
+  }
+  m_Integral = m_Integral && value == std::floor(value);
+
+  std::int64_t bin = BinIndex(value, m_Exponent) - m_Offset;
+  if (bin < 0 || bin >= static_cast<std::int64_t>(m_Frequencies.size()))
+  {
+    Cover(m_Minimum, m_Maximum, m_Exponent);
+    bin = BinIndex(value, m_Exponent) - m_Offset;
+  }
+
+  ++m_Frequencies[bin];
+  ++m_TotalFrequency;
+}
+
+void AdaptiveHistogram::Merge(const AdaptiveHistogram& other)
+{
+  if (other.IsEmpty())
+  {
+    return;
+  }
+  if (IsEmpty())
+  {
+    *this = other;
+    return;
+  }
+
+  m_Minimum  = std::min(m_Minimum, other.m_Minimum);
+  m_Maximum  = std::max(m_Maximum, other.m_Maximum);
+  m_Integral = m_Integral && other.m_Integral;
+  Cover(m_Minimum, m_Maximum, other.m_Exponent);
+
+  // The bins of other are at most as wide as ours and aligned on the same
+  // grid: each one falls in exactly one of our bins
+  const int shift = m_Exponent - other.m_Exponent;
+  for (std::size_t k = 0; k < other.m_Frequencies.size(); ++k)
+  {
+    if (other.m_Frequencies[k] != 0)
+    {
+      m_Frequencies[ShiftIndex(other.m_Offset + static_cast<std::int64_t>(k), shift) - m_Offset] += other.m_Frequencies[k];
+    }
+  }
+  m_TotalFrequency += other.m_TotalFrequency;
+}
+
+double AdaptiveHistogram::GetBinWidth() const
+{
+  return std::ldexp(1., m_Exponent);
+}
+
+AdaptiveHistogram::FrequencyVectorType AdaptiveHistogram::Rebin(double lower, double upper, unsigned int numberOfBins) const
+{
+  FrequencyVectorType frequencies(std::max(numberOfBins, 1U), 0);
+  if (IsEmpty())
+  {
+    return frequencies;
+  }
+
+  // Integer values are at the lower bound of their fine bin
+  const double binShift = m_Integral && m_Exponent <= 0 ? 0. : 0.5;
+  const double lastBin  = static_cast<double>(frequencies.size() - 1);
+  const double width    = (upper - lower) / frequencies.size();
+  for (std::size_t k = 0; k < m_Frequencies.size(); ++k)
+  {
+    if (m_Frequencies[k] == 0)
+    {
+      continue;
+    }
+
+    // Representative value of the fine bin, kept within the values actually
+    // seen
+    const double binValue = std::ldexp(static_cast<double>(m_Offset + static_cast<std::int64_t>(k)) + binShift, m_Exponent);
+    const double value    = std::min(std::max(binValue, m_Minimum), m_Maximum);
+
+    std::size_t bin = 0;
+    if (width > 0. && value > lower)
+    {
+      bin = static_cast<std::size_t>(std::min((value - lower) / width, lastBin));
+    }
+    frequencies[bin] += m_Frequencies[k];
+  }
+  return frequencies;
+}
+
+void AdaptiveHistogram::Cover(double lower, double upper, int minimumExponent)
+{
+  const std::int64_t numberOfBins = m_NumberOfBins;
+
+  // Start close to the coarsest exponent that is still too fine, and widen
+  // the bins until [lower, upper] fits
+  int          exponent = std::max({m_Exponent, minimumExponent, FinestExponent(lower, upper)});
+  const double binRange = upper / numberOfBins - lower / numberOfBins;
+  if (binRange > 0.)
+  {
+    exponent = std::max(exponent, std::ilogb(binRange));
+  }
+  while (BinIndex(upper, exponent) - BinIndex(lower, exponent) >= numberOfBins)
+  {
+    ++exponent;
+  }
+
+  const std::int64_t  offset = BinIndex(lower, exponent);
+  const int           shift  = exponent - m_Exponent;
+  FrequencyVectorType frequencies(m_NumberOfBins, 0);
+  for (std::size_t k = 0; k < m_Frequencies.size(); ++k)
+  {
+    if (m_Frequencies[k] != 0)
+    {
+      frequencies[ShiftIndex(m_Offset + static_cast<std::int64_t>(k), shift) - offset] += m_Frequencies[k];
+    }
+  }
+
+  m_Frequencies.swap(frequencies);
+  m_Exponent = exponent;
+  m_Offset   = offset;
+}
+
+} // end namespace otb
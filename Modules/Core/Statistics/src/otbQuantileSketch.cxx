@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbQuantileSketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace otb
+{
+
+QuantileSketch::QuantileSketch(unsigned int k)
+  : m_K(std::max(k, 8U)), m_Count(0), m_Minimum(0.), m_Maximum(0.), m_Levels(1), m_BottomCapacity(GetCapacity(0)), m_Random(1)
+{
+}
+
+void QuantileSketch::Add(double value)
+{
+  if (!std::isfinite(value))
+  {
+    return;
+  }
+
+  if (IsEmpty())
+  {
+    m_Minimum = value;
+    m_Maximum = value;
+  }
+  else
+  {
+    m_Minimum = std::min(m_Minimum, value);
+    m_Maximum = std::max(m_Maximum, value);
+  }
+  ++m_Count;
+
+  m_Levels[0].push_back(value);
+  if (m_Levels[0].size() >= m_BottomCapacity)
+  {
+    Compress();
+  }
+}
+
+void QuantileSketch::Merge(const QuantileSketch& other)
+{
+  if (other.IsEmpty())
+  {
+    return;
+  }
+
+  if (IsEmpty())
+  {
+    m_Minimum = other.m_Minimum;
+    m_Maximum = other.m_Maximum;
+  }
+  else
+  {
+    m_Minimum = std::min(m_Minimum, other.m_Minimum);
+    m_Maximum = std::max(m_Maximum, other.m_Maximum);
+  }
+  m_Count += other.m_Count;
+
+  if (m_Levels.size() < other.m_Levels.size())
+  {
+    AddLevels(other.m_Levels.size() - m_Levels.size());
+  }
+  for (std::size_t level = 0; level < other.m_Levels.size(); ++level)
+  {
+    m_Levels[level].insert(m_Levels[level].end(), other.m_Levels[level].begin(), other.m_Levels[level].end());
+  }
+
+  Compress();
+}
+
+std::size_t QuantileSketch::GetNumberOfRetainedValues() const
+{
+  std::size_t size = 0;
+  for (const auto& level : m_Levels)
+  {
+    size += level.size();
+  }
+  return size;
+}
+
+double QuantileSketch::Quantile(double q) const
+{
+  if (IsEmpty())
+  {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if (q <= 0.)
+  {
+    return m_Minimum;
+  }
+  if (q >= 1.)
+  {
+    return m_Maximum;
+  }
+
+  // Each value of level h stands for 2^h values
+  std::vector<std::pair<double, CountType>> weightedValues;
+  weightedValues.reserve(GetNumberOfRetainedValues());
+  for (std::size_t level = 0; level < m_Levels.size(); ++level)
+  {
+    for (double value : m_Levels[level])
+    {
+      weightedValues.emplace_back(value, CountType(1) << level);
+    }
+  }
+  std::sort(weightedValues.begin(), weightedValues.end());
+
+  const double rank   = q * static_cast<double>(m_Count);
+  CountType    weight = 0;
+  for (const auto& weightedValue : weightedValues)
+  {
+    weight += weightedValue.second;
+    if (static_cast<double>(weight) >= rank)
+    {
+      return weightedValue.first;
+    }
+  }
+  return m_Maximum;
+}
+
+std::size_t QuantileSketch::GetCapacity(std::size_t level) const
+{
+  // k * (2/3)^depth, depth being the distance to the top level
+  const std::size_t depth    = m_Levels.size() - level - 1;
+  const double      capacity = std::ceil(m_K * std::pow(2. / 3., static_cast<double>(depth)));
+  return std::max<std::size_t>(2, static_cast<std::size_t>(capacity));
+}
+
+void QuantileSketch::AddLevels(std::size_t numberOfLevels)
+{
+  m_Levels.resize(m_Levels.size() + numberOfLevels);
+  m_BottomCapacity = GetCapacity(0);
+}
+
+void QuantileSketch::Compress()
+{
+  // Adding a level lowers the capacity of the ones below: start again from
+  // the bottom until all the levels fit
+  bool compacted = true;
+  while (compacted)
+  {
+    compacted = false;
+    for (std::size_t level = 0; level < m_Levels.size(); ++level)
+    {
+      if (m_Levels[level].size() >= GetCapacity(level))
+      {
+        CompactLevel(level);
+        compacted = true;
+      }
+    }
+  }
+}
+
+void QuantileSketch::CompactLevel(std::size_t level)
+{
+  if (level + 1 == m_Levels.size())
+  {
+    AddLevels(1);
+  }
+
+  std::vector<double>& values = m_Levels[level];
+  std::sort(values.begin(), values.end());
+
+  // With an odd number of values, the largest one stays at this level
+  const std::size_t numberOfPairs = values.size() / 2;
+  const std::size_t offset        = (m_Random() >> 8) & 1;
+
+  std::vector<double>& nextValues = m_Levels[level + 1];
+  for (std::size_t i = 0; i < numberOfPairs; ++i)
+  {
+    nextValues.push_back(values[2 * i + offset]);
+  }
+
+  if (values.size() % 2 == 1)
+  {
+    values[0] = values.back();
+    values.resize(1);
+  }
+  else
+  {
+    values.clear();
+  }
+}
+
+} // end namespace otb
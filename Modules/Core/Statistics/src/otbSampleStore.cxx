@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbSampleStore.h"
+#include "itkMacro.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace otb
+{
+
+namespace
+{
+const char          Magic[8]       = {'O', 'T', 'B', 'S', 'A', 'M', 'P', 'L'};
+const std::uint32_t Version        = 1;
+const std::uint32_t ByteOrderMark  = 0x01020304;
+const std::uint64_t Alignment      = 64;
+const std::size_t   NumberOffset   = sizeof(Magic) + 4 * sizeof(std::uint32_t);
+const unsigned int  ChunkAlignment = Alignment / sizeof(float);
+
+std::uint64_t ChunkBytes(unsigned int chunkSize, unsigned int numberOfFeatures)
+{
+  return static_cast<std::uint64_t>(chunkSize) * (sizeof(double) + numberOfFeatures * sizeof(float));
+}
+
+template <class T>
+void WriteValue(std::ofstream& file, T value)
+{
+  file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+T ReadValue(std::ifstream& file)
+{
+  T value = T();
+  file.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return value;
+}
+
+void WriteString(std::ofstream& file, const std::string& value)
+{
+  WriteValue<std::uint32_t>(file, static_cast<std::uint32_t>(value.size()));
+  file.write(value.data(), value.size());
+}
+
+std::string ReadString(std::ifstream& file)
+{
+  const std::uint32_t length = ReadValue<std::uint32_t>(file);
+  // Names are short, a large length comes from a corrupted file
+  if (!file || length > (1u << 16))
+  {
+    file.setstate(std::ios::failbit);
+    return std::string();
+  }
+  std::string value(length, '\0');
+  file.read(&value[0], length);
+  return value;
+}
+}
+
+const unsigned int SampleStoreWriter::DefaultChunkSize;
+
+SampleStoreWriter::SampleStoreWriter() : m_ChunkSize(DefaultChunkSize), m_NumberOfSamples(0), m_ChunkCount(0)
+{
+}
+
+SampleStoreWriter::~SampleStoreWriter()
+{
+  try
+  {
+    this->Close();
+  }
+  catch (...)
+  {
+  }
+}
+
+void SampleStoreWriter::Open(const std::string& fileName, const std::vector<std::string>& featureNames, const std::string& labelName,
+                             unsigned int chunkSize)
+{
+  this->Close();
+
+  m_FileName        = fileName;
+  m_FeatureNames    = featureNames;
+  m_ChunkSize       = std::max(1u, (chunkSize + ChunkAlignment - 1) / ChunkAlignment) * ChunkAlignment;
+  m_NumberOfSamples = 0;
+  m_ChunkCount      = 0;
+  m_Labels.assign(m_ChunkSize, 0.);
+  m_Features.assign(static_cast<std::size_t>(m_ChunkSize) * m_FeatureNames.size(), 0.f);
+
+  m_File.open(fileName, std::ios::binary | std::ios::trunc);
+  if (!m_File)
+  {
+    itkGenericExceptionMacro(<< "Unable to create sample store " << fileName);
+  }
+
+  m_File.write(Magic, sizeof(Magic));
+  WriteValue<std::uint32_t>(m_File, Version);
+  WriteValue<std::uint32_t>(m_File, ByteOrderMark);
+  WriteValue<std::uint32_t>(m_File, static_cast<std::uint32_t>(m_FeatureNames.size()));
+  WriteValue<std::uint32_t>(m_File, m_ChunkSize);
+  WriteValue<std::uint64_t>(m_File, 0);
+
+  std::uint64_t headerSize = NumberOffset + 2 * sizeof(std::uint64_t) + sizeof(std::uint32_t) + labelName.size();
+  for (const auto& name : m_FeatureNames)
+  {
+    headerSize += sizeof(std::uint32_t) + name.size();
+  }
+  const std::uint64_t dataOffset = (headerSize + Alignment - 1) / Alignment * Alignment;
+  WriteValue<std::uint64_t>(m_File, dataOffset);
+  WriteString(m_File, labelName);
+  for (const auto& name : m_FeatureNames)
+  {
+    WriteString(m_File, name);
+  }
+  const std::vector<char> padding(dataOffset - headerSize, 0);
+  m_File.write(padding.data(), padding.size());
+
+  if (!m_File)
+  {
+    itkGenericExceptionMacro(<< "Unable to write the header of sample store " << fileName);
+  }
+}
+
+void SampleStoreWriter::Append(const float* features, double label)
+{
+  if (!m_File.is_open())
+  {
+    itkGenericExceptionMacro(<< "Sample store is not open");
+  }
+  m_Labels[m_ChunkCount] = label;
+  for (std::size_t i = 0; i < m_FeatureNames.size(); ++i)
+  {
+    m_Features[i * m_ChunkSize + m_ChunkCount] = features[i];
+  }
+  ++m_NumberOfSamples;
+  if (++m_ChunkCount == m_ChunkSize)
+  {
+    this->WriteChunk();
+  }
+}
+
+void SampleStoreWriter::WriteChunk()
+{
+  m_File.write(reinterpret_cast<const char*>(m_Labels.data()), m_Labels.size() * sizeof(double));
+  m_File.write(reinterpret_cast<const char*>(m_Features.data()), m_Features.size() * sizeof(float));
+  if (!m_File)
+  {
+    itkGenericExceptionMacro(<< "Unable to write sample store " << m_FileName);
+  }
+  std::fill(m_Labels.begin(), m_Labels.end(), 0.);
+  std::fill(m_Features.begin(), m_Features.end(), 0.f);
+  m_ChunkCount = 0;
+}
+
+void SampleStoreWriter::Close()
+{
+  if (!m_File.is_open())
+  {
+    return;
+  }
+  if (m_ChunkCount > 0)
+  {
+    this->WriteChunk();
+  }
+  m_File.seekp(NumberOffset);
+  WriteValue<std::uint64_t>(m_File, m_NumberOfSamples);
+  const bool ok = static_cast<bool>(m_File);
+  m_File.close();
+  if (!ok)
+  {
+    itkGenericExceptionMacro(<< "Unable to write sample store " << m_FileName);
+  }
+}
+
+SampleStoreReader::SampleStoreReader() : m_ChunkSize(0), m_NumberOfSamples(0), m_DataOffset(0)
+{
+}
+
+bool SampleStoreReader::CanReadFile(const std::string& fileName)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  char          magic[sizeof(Magic)];
+  return file.read(magic, sizeof(magic)) && std::memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+void SampleStoreReader::Open(const std::string& fileName)
+{
+  this->Close();
+  m_FileName = fileName;
+  m_File.open(fileName, std::ios::binary);
+  char magic[sizeof(Magic)];
+  if (!m_File.read(magic, sizeof(magic)) || std::memcmp(magic, Magic, sizeof(Magic)) != 0)
+  {
+    itkGenericExceptionMacro(<< fileName << " is not a sample store");
+  }
+
+  const std::uint32_t version          = ReadValue<std::uint32_t>(m_File);
+  const std::uint32_t byteOrderMark    = ReadValue<std::uint32_t>(m_File);
+  const std::uint32_t numberOfFeatures = ReadValue<std::uint32_t>(m_File);
+  m_ChunkSize                          = ReadValue<std::uint32_t>(m_File);
+  m_NumberOfSamples                    = ReadValue<std::uint64_t>(m_File);
+  m_DataOffset                         = ReadValue<std::uint64_t>(m_File);
+  if (version != Version)
+  {
+    itkGenericExceptionMacro(<< "Sample store " << fileName << " has version " << version << ", expected " << Version);
+  }
+  if (byteOrderMark != ByteOrderMark)
+  {
+    itkGenericExceptionMacro(<< "Sample store " << fileName << " was written with a different byte order");
+  }
+  if (m_ChunkSize == 0)
+  {
+    itkGenericExceptionMacro(<< "Sample store " << fileName << " has a null chunk size");
+  }
+
+  m_LabelName = ReadString(m_File);
+  m_FeatureNames.clear();
+  for (std::uint32_t i = 0; m_File && i < numberOfFeatures; ++i)
+  {
+    m_FeatureNames.push_back(ReadString(m_File));
+  }
+  if (!m_File)
+  {
+    itkGenericExceptionMacro(<< "Unable to read the header of sample store " << fileName);
+  }
+}
+
+void SampleStoreReader::Close()
+{
+  if (m_File.is_open())
+  {
+    m_File.close();
+  }
+  m_File.clear();
+  m_LabelName.clear();
+  m_FeatureNames.clear();
+  m_ChunkSize       = 0;
+  m_NumberOfSamples = 0;
+  m_DataOffset      = 0;
+}
+
+int SampleStoreReader::GetFeatureIndex(const std::string& name) const
+{
+  auto it = std::find(m_FeatureNames.begin(), m_FeatureNames.end(), name);
+  return it == m_FeatureNames.end() ? -1 : static_cast<int>(it - m_FeatureNames.begin());
+}
+
+std::size_t SampleStoreReader::ReadChunk(std::uint64_t chunk, const std::vector<unsigned int>& columns, float* features, double* labels)
+{
+  if (chunk >= this->GetNumberOfChunks())
+  {
+    itkGenericExceptionMacro(<< "Chunk " << chunk << " is outside the " << this->GetNumberOfChunks() << " chunks of " << m_FileName);
+  }
+  const std::size_t count =
+      static_cast<std::size_t>(std::min<std::uint64_t>(m_ChunkSize, m_NumberOfSamples - chunk * m_ChunkSize));
+  const std::uint64_t chunkOffset = m_DataOffset + chunk * ChunkBytes(m_ChunkSize, this->GetNumberOfFeatures());
+
+  if (labels)
+  {
+    m_File.seekg(chunkOffset);
+    m_File.read(reinterpret_cast<char*>(labels), count * sizeof(double));
+  }
+
+  m_Column.resize(count);
+  for (std::size_t c = 0; c < columns.size(); ++c)
+  {
+    if (columns[c] >= this->GetNumberOfFeatures())
+    {
+      itkGenericExceptionMacro(<< "Feature " << columns[c] << " is outside the " << this->GetNumberOfFeatures() << " features of " << m_FileName);
+    }
+    m_File.seekg(chunkOffset + m_ChunkSize * sizeof(double) + static_cast<std::uint64_t>(columns[c]) * m_ChunkSize * sizeof(float));
+    m_File.read(reinterpret_cast<char*>(m_Column.data()), count * sizeof(float));
+    for (std::size_t k = 0; k < count; ++k)
+    {
+      features[k * columns.size() + c] = m_Column[k];
+    }
+  }
+
+  if (!m_File)
+  {
+    itkGenericExceptionMacro(<< "Unable to read chunk " << chunk << " of sample store " << m_FileName);
+  }
+  return count;
+}
+
+} // end namespace otb
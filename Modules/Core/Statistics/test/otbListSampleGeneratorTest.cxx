@@ -27,6 +27,10 @@
 
 #include "otbListSampleGenerator.h"
 
+#include <iostream>
+#include <string>
+#include <vector>
+
 
 int otbListSampleGenerator(int argc, char* argv[])
 {
@@ -141,3 +145,79 @@ int otbListSampleGenerator(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbListSampleGeneratorSampleStore(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " store" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // 7 classes of 100 samples, the features of a sample giving its label
+  const unsigned int       nbSamples = 700;
+  std::vector<std::string> names     = {"value_0", "value_1"};
+
+  otb::SampleStoreWriter writer;
+  writer.Open(argv[1], names, "class", 64);
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    const float sample[2] = {0.5f * i, 0.5f * i + 1.f};
+    writer.Append(sample, i % 7 + 1);
+  }
+  writer.Close();
+
+  typedef otb::VectorImage<double, 2>                         ImageType;
+  typedef otb::VectorData<float, 2>                           VectorDataType;
+  typedef otb::ListSampleGenerator<ImageType, VectorDataType> ListSampleGeneratorType;
+  ListSampleGeneratorType::Pointer generator = ListSampleGeneratorType::New();
+  generator->SetValidationTrainingProportion(0.5);
+  generator->SetSampleStoreFileName(argv[1]);
+  generator->Update();
+
+  if (generator->GetNumberOfClasses() != 7)
+  {
+    std::cerr << "Found " << generator->GetNumberOfClasses() << " classes instead of 7" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (const auto& classSize : generator->GetClassesSize())
+  {
+    if (classSize.second != nbSamples / 7)
+    {
+      std::cerr << "Class " << classSize.first << " has " << classSize.second << " samples instead of " << nbSamples / 7 << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Each sample keeps its features and its label, in the training or the
+  // validation lists
+  unsigned int nbRead = 0;
+  for (bool training : {true, false})
+  {
+    ListSampleGeneratorType::ListSamplePointerType samples = training ? generator->GetTrainingListSample() : generator->GetValidationListSample();
+    ListSampleGeneratorType::ListLabelPointerType  labels  = training ? generator->GetTrainingListLabel() : generator->GetValidationListLabel();
+    if (samples->Size() != labels->Size() || samples->Size() == 0)
+    {
+      std::cerr << "Wrong " << (training ? "training" : "validation") << " list sizes " << samples->Size() << " and " << labels->Size() << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (unsigned int k = 0; k < samples->Size(); ++k)
+    {
+      const ListSampleGeneratorType::SampleType& sample = samples->GetMeasurementVector(k);
+      const unsigned int                         i      = static_cast<unsigned int>(2 * sample[0]);
+      if (sample.Size() != 2 || sample[1] != sample[0] + 1 || labels->GetMeasurementVector(k)[0] != static_cast<int>(i % 7 + 1))
+      {
+        std::cerr << "Wrong sample " << sample << " with label " << labels->GetMeasurementVector(k)[0] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    nbRead += samples->Size();
+  }
+  if (nbRead > nbSamples)
+  {
+    std::cerr << "Read " << nbRead << " samples from " << nbSamples << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbSampleStore.h"
+#include <iostream>
+
+int otbSampleStoreTest(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " store" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // More samples than a chunk, the last one being partial
+  const unsigned int       nbSamples = 5000;
+  std::vector<std::string> names     = {"value_0", "value_1", "value_2"};
+
+  otb::SampleStoreWriter writer;
+  writer.Open(argv[1], names, "class", 1000);
+  std::vector<float> sample(names.size());
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    for (unsigned int j = 0; j < names.size(); ++j)
+    {
+      sample[j] = 0.5f * i + j;
+    }
+    writer.Append(sample.data(), i % 7);
+  }
+  writer.Close();
+
+  if (!otb::SampleStoreReader::CanReadFile(argv[1]))
+  {
+    std::cerr << "The store is not recognized" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  otb::SampleStoreReader reader;
+  reader.Open(argv[1]);
+  if (reader.GetNumberOfSamples() != nbSamples || reader.GetFeatureNames() != names || reader.GetLabelName() != "class" ||
+      reader.GetFeatureIndex("value_2") != 2 || reader.GetFeatureIndex("other") != -1)
+  {
+    std::cerr << "Wrong header" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Read the columns in another order
+  const std::vector<unsigned int> columns = {2, 0};
+  std::vector<float>              features(reader.GetChunkSize() * columns.size());
+  std::vector<double>             labels(reader.GetChunkSize());
+  unsigned int                    i = 0;
+  for (std::uint64_t chunk = 0; chunk < reader.GetNumberOfChunks(); ++chunk)
+  {
+    const std::size_t count = reader.ReadChunk(chunk, columns, features.data(), labels.data());
+    for (std::size_t k = 0; k < count; ++k, ++i)
+    {
+      if (labels[k] != i % 7 || features[2 * k] != 0.5f * i + 2 || features[2 * k + 1] != 0.5f * i)
+      {
+        std::cerr << "Wrong values for sample " << i << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (i != nbSamples)
+  {
+    std::cerr << "Read " << i << " samples instead of " << nbSamples << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -41,14 +41,21 @@ void RegisterTests()
   REGISTER_TEST(otbStreamingStatisticsMapFromLabelImageFilterTest);
   REGISTER_TEST(otbRealAndImaginaryImageToComplexImageFilterTest);
   REGISTER_TEST(otbStreamingStatisticsImageFilter);
+  REGISTER_TEST(otbStreamingStatisticsImageFilterChunks);
+  REGISTER_TEST(otbStreamingStatisticsImageFilterThreads);
   REGISTER_TEST(otbListSampleToBalancedListSampleFilter);
   REGISTER_TEST(otbStreamingStatisticsVectorImageFilter);
+  REGISTER_TEST(otbStreamingStatisticsVectorImageFilterHistograms);
+  REGISTER_TEST(otbStreamingStatisticsVectorImageFilterQuantiles);
+  REGISTER_TEST(otbStreamingStatisticsVectorImageFilterSampling);
   REGISTER_TEST(otbStreamingMinMaxVectorImageFilter);
   REGISTER_TEST(otbListSampleGenerator);
+  REGISTER_TEST(otbListSampleGeneratorSampleStore);
   REGISTER_TEST(otbImaginaryImageToComplexImageFilterTest);
   REGISTER_TEST(otbListSampleToHistogramListGenerator);
   REGISTER_TEST(otbContinuousMinimumMaximumImageCalculatorTest);
   REGISTER_TEST(otbPeriodicSamplerTest);
   REGISTER_TEST(otbPatternSamplerTest);
   REGISTER_TEST(otbRandomSamplerTest);
+  REGISTER_TEST(otbSampleStoreTest);
 }
@@ -24,7 +24,10 @@
 #include "itkStatisticsImageFilter.h"
 #include "otbImageFileReader.h"
 #include "otbImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include <cmath>
 #include <fstream>
+#include <iomanip>
 #include "otbStreamingTraits.h"
 
 int otbStreamingStatisticsImageFilter(int argc, char* argv[])
@@ -73,3 +76,116 @@ int otbStreamingStatisticsImageFilter(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbStreamingStatisticsImageFilterChunks(int itkNotUsed(argc), char* argv[])
+{
+  const char* infname = argv[1];
+
+  const unsigned int Dimension = 2;
+  typedef double     PixelType;
+
+  typedef otb::Image<PixelType, Dimension> ImageType;
+  typedef otb::ImageFileReader<ImageType>                ReaderType;
+  typedef otb::StreamingStatisticsImageFilter<ImageType> StreamingStatisticsImageFilterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(infname);
+
+  // The chunks and the number of threads must not change the results of
+  // integer pixels
+  const unsigned int numberOfThreads[]       = {1, 3, 8};
+  const unsigned int numberOfLinesPerChunk[] = {1, 3, 16};
+
+  bool      first  = true;
+  double    refSum = 0., refVariance = 0.;
+  PixelType refMinimum = 0., refMaximum = 0.;
+  for (auto threads : numberOfThreads)
+  {
+    for (auto lines : numberOfLinesPerChunk)
+    {
+      StreamingStatisticsImageFilterType::Pointer filter = StreamingStatisticsImageFilterType::New();
+      filter->GetStreamer()->SetNumberOfLinesStrippedStreaming(10);
+      filter->GetFilter()->SetNumberOfThreads(threads);
+      filter->GetFilter()->SetNumberOfLinesPerChunk(lines);
+      filter->SetInput(reader->GetOutput());
+      filter->Update();
+
+      if (first)
+      {
+        refSum      = filter->GetSum();
+        refVariance = filter->GetVariance();
+        refMinimum  = filter->GetMinimum();
+        refMaximum  = filter->GetMaximum();
+        first       = false;
+      }
+      else if (filter->GetSum() != refSum || filter->GetVariance() != refVariance || filter->GetMinimum() != refMinimum ||
+               filter->GetMaximum() != refMaximum)
+      {
+        std::cerr << "Results differ with " << threads << " threads and " << lines << " lines per chunk" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int otbStreamingStatisticsImageFilterThreads(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  const unsigned int Dimension = 2;
+  typedef double     PixelType;
+
+  typedef otb::Image<PixelType, Dimension>               ImageType;
+  typedef otb::StreamingStatisticsImageFilter<ImageType> StreamingStatisticsImageFilterType;
+
+  // Float pixels, whose sums are rounded differently in another order
+  ImageType::RegionType region;
+  region.SetIndex(0, 0);
+  region.SetIndex(1, 0);
+  region.SetSize(0, 317);
+  region.SetSize(1, 251);
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0], y = it.GetIndex()[1];
+    it.Set(1000. * std::sin(0.37 * x + 0.11 * y) + std::sqrt(x + 2. * y) / 3. + 1e-3 * x * y);
+  }
+
+  // The number of threads must not change the results, for a given number
+  // of lines per chunk
+  const unsigned int numberOfThreads[]       = {1, 2, 3, 8};
+  const unsigned int numberOfLinesPerChunk[] = {1, 5, 16};
+
+  for (auto lines : numberOfLinesPerChunk)
+  {
+    bool   first  = true;
+    double refSum = 0., refVariance = 0.;
+    for (auto threads : numberOfThreads)
+    {
+      StreamingStatisticsImageFilterType::Pointer filter = StreamingStatisticsImageFilterType::New();
+      filter->GetStreamer()->SetNumberOfLinesStrippedStreaming(100);
+      filter->GetFilter()->SetNumberOfThreads(threads);
+      filter->GetFilter()->SetNumberOfLinesPerChunk(lines);
+      filter->SetInput(image);
+      filter->Update();
+
+      if (first)
+      {
+        refSum      = filter->GetSum();
+        refVariance = filter->GetVariance();
+        first       = false;
+      }
+      else if (filter->GetSum() != refSum || filter->GetVariance() != refVariance)
+      {
+        std::cerr << std::setprecision(17) << "Results differ with " << threads << " threads and " << lines << " lines per chunk: sum " << filter->GetSum()
+                  << " instead of " << refSum << ", variance " << filter->GetVariance() << " instead of " << refVariance << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
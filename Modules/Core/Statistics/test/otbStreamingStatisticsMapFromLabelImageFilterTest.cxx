@@ -161,6 +161,7 @@ int generic_StreamingStatisticsMapFromLabelImageFilterTest(int itkNotUsed(argc),
   m_StatisticsMapFromLabelImageFilter = StreamingStatisticsMapFromLabelImageFilterType::New();
   m_StatisticsMapFromLabelImageFilter->SetInput(supportImage);
   m_StatisticsMapFromLabelImageFilter->SetInputLabelImage(labelImage);
+  m_StatisticsMapFromLabelImageFilter->SetQuantileSketchSize(200);
   m_StatisticsMapFromLabelImageFilter->Update();
 
   LabelPopulationMapType labelPopulationMapBL;
@@ -207,6 +208,21 @@ int generic_StreamingStatisticsMapFromLabelImageFilterTest(int itkNotUsed(argc),
     return EXIT_FAILURE;
   }
 
+  // The labels are uniform: any quantile is the color of the label
+  for (double q : {0.0, 0.1, 0.5, 0.9, 1.0})
+  {
+    MeanValueMapType labelToQuantileMap = m_StatisticsMapFromLabelImageFilter->GetQuantileValueMap(q);
+    if (labelToQuantileMap != labelToMeanIntensityMapBL)
+    {
+      std::cout << "ERROR with m_StatisticsMapFromLabelImageFilter->GetQuantileValueMap(" << q << ")" << std::endl;
+      for (const auto& it : labelToQuantileMap)
+      {
+        std::cout << "    labelToQuantileMap[" << it.first << "] = " << it.second << std::endl;
+      }
+      return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
 
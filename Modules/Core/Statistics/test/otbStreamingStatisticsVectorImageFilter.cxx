@@ -21,9 +21,14 @@
 #include "itkMacro.h"
 
 #include "otbStreamingStatisticsVectorImageFilter.h"
+#include "otbStreamingHistogramVectorImageFilter.h"
 #include "otbImageFileReader.h"
 #include "otbVectorImage.h"
+#include "itkImageRegionConstIterator.h"
 #include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 #include "otbStreamingTraits.h"
 
 int otbStreamingStatisticsVectorImageFilter(int argc, char* argv[])
@@ -75,3 +80,186 @@ int otbStreamingStatisticsVectorImageFilter(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbStreamingStatisticsVectorImageFilterHistograms(int itkNotUsed(argc), char* argv[])
+{
+  const char* infname = argv[1];
+
+  const unsigned int Dimension = 2;
+  typedef double     PixelType;
+
+  typedef otb::VectorImage<PixelType, Dimension> ImageType;
+  typedef otb::ImageFileReader<ImageType>                      ReaderType;
+  typedef otb::StreamingStatisticsVectorImageFilter<ImageType> StreamingStatisticsVectorImageFilterType;
+  typedef otb::StreamingHistogramVectorImageFilter<ImageType>  StreamingHistogramVectorImageFilterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(infname);
+
+  // Statistics and histograms in a single pass
+  StreamingStatisticsVectorImageFilterType::Pointer filter = StreamingStatisticsVectorImageFilterType::New();
+  filter->GetStreamer()->SetNumberOfLinesStrippedStreaming(10);
+  filter->SetInput(reader->GetOutput());
+  filter->SetEnableHistograms(true);
+  filter->Update();
+
+  const ImageType::PixelType minimum = filter->GetMinimum();
+  const ImageType::PixelType maximum = filter->GetMaximum();
+
+  // One bin per integer value: the pixels are integers, and are counted
+  // exactly by both filters
+  for (unsigned int band = 0; band < minimum.GetSize(); ++band)
+  {
+    const unsigned int numberOfBins = static_cast<unsigned int>(maximum[band] - minimum[band]) + 1;
+
+    filter->SetNumberOfHistogramBins(numberOfBins);
+    StreamingStatisticsVectorImageFilterType::HistogramListType::Pointer histograms = filter->GetFilter()->ComputeHistograms(minimum, maximum);
+
+    StreamingHistogramVectorImageFilterType::Pointer reference = StreamingHistogramVectorImageFilterType::New();
+    reference->SetInput(reader->GetOutput());
+    StreamingHistogramVectorImageFilterType::FilterType::CountVectorType bins(minimum.GetSize());
+    bins.Fill(numberOfBins);
+    ImageType::PixelType lower(minimum), upper(maximum);
+    lower.Fill(minimum[band] - 0.5);
+    upper.Fill(maximum[band] + 0.5);
+    reference->GetFilter()->SetNumberOfBins(bins);
+    reference->GetFilter()->SetHistogramMin(lower);
+    reference->GetFilter()->SetHistogramMax(upper);
+    reference->Update();
+
+    const auto* histogram          = histograms->GetNthElement(band).GetPointer();
+    const auto* referenceHistogram = reference->GetHistogramList()->GetNthElement(band).GetPointer();
+    for (unsigned int bin = 0; bin < numberOfBins; ++bin)
+    {
+      if (histogram->GetFrequency(bin) != referenceHistogram->GetFrequency(bin))
+      {
+        std::cerr << "Band " << band << ", bin " << bin << ": frequency " << histogram->GetFrequency(bin) << " instead of "
+                  << referenceHistogram->GetFrequency(bin) << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int otbStreamingStatisticsVectorImageFilterQuantiles(int itkNotUsed(argc), char* argv[])
+{
+  const char* infname = argv[1];
+
+  const unsigned int Dimension = 2;
+  typedef double     PixelType;
+
+  typedef otb::VectorImage<PixelType, Dimension> ImageType;
+  typedef otb::ImageFileReader<ImageType>                      ReaderType;
+  typedef otb::StreamingStatisticsVectorImageFilter<ImageType> StreamingStatisticsVectorImageFilterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(infname);
+  reader->Update();
+
+  StreamingStatisticsVectorImageFilterType::Pointer filter = StreamingStatisticsVectorImageFilterType::New();
+  filter->GetStreamer()->SetNumberOfLinesStrippedStreaming(10);
+  filter->SetInput(reader->GetOutput());
+  filter->SetEnableQuantiles(true);
+  filter->Update();
+
+  // Sorted values of each band
+  const unsigned int               numberOfBands = reader->GetOutput()->GetNumberOfComponentsPerPixel();
+  std::vector<std::vector<double>> values(numberOfBands);
+  itk::ImageRegionConstIterator<ImageType> it(reader->GetOutput(), reader->GetOutput()->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    for (unsigned int band = 0; band < numberOfBands; ++band)
+    {
+      values[band].push_back(it.Get()[band]);
+    }
+  }
+  for (auto& bandValues : values)
+  {
+    std::sort(bandValues.begin(), bandValues.end());
+  }
+
+  // The rank of each estimated quantile must be within 3% of the expected
+  // one. Ties make a range of ranks for a given value.
+  const double tolerance = 0.03;
+  for (double q : {0.0, 0.02, 0.1, 0.25, 0.5, 0.75, 0.9, 0.98, 1.0})
+  {
+    const StreamingStatisticsVectorImageFilterType::RealPixelType quantiles = filter->ComputeQuantiles(q);
+    for (unsigned int band = 0; band < numberOfBands; ++band)
+    {
+      const std::vector<double>& bandValues = values[band];
+      const double               size       = static_cast<double>(bandValues.size());
+      const double               lowerRank  = (std::lower_bound(bandValues.begin(), bandValues.end(), quantiles[band]) - bandValues.begin()) / size;
+      const double               upperRank  = (std::upper_bound(bandValues.begin(), bandValues.end(), quantiles[band]) - bandValues.begin()) / size;
+      if (q < lowerRank - tolerance || q > upperRank + tolerance)
+      {
+        std::cerr << "Band " << band << ": quantile " << q << " estimated as " << quantiles[band] << ", whose ranks are [" << lowerRank << ", "
+                  << upperRank << "]" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int otbStreamingStatisticsVectorImageFilterSampling(int itkNotUsed(argc), char* argv[])
+{
+  const char* infname = argv[1];
+
+  const unsigned int Dimension = 2;
+  typedef double     PixelType;
+
+  typedef otb::VectorImage<PixelType, Dimension> ImageType;
+  typedef otb::ImageFileReader<ImageType>                      ReaderType;
+  typedef otb::StreamingStatisticsVectorImageFilter<ImageType> StreamingStatisticsVectorImageFilterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(infname);
+
+  StreamingStatisticsVectorImageFilterType::Pointer reference = StreamingStatisticsVectorImageFilterType::New();
+  reference->SetInput(reader->GetOutput());
+  reference->Update();
+
+  // The same pixels must be sampled whatever the streaming
+  const unsigned long numberOfSamples = 1000;
+  StreamingStatisticsVectorImageFilterType::RealPixelType means[2];
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    StreamingStatisticsVectorImageFilterType::Pointer filter = StreamingStatisticsVectorImageFilterType::New();
+    filter->GetStreamer()->SetNumberOfLinesStrippedStreaming(i == 0 ? 7 : 1000000);
+    filter->SetInput(reader->GetOutput());
+    filter->SetNumberOfSamples(numberOfSamples);
+    filter->Update();
+
+    const unsigned long count = filter->GetNbRelevantPixels()[0];
+    if (filter->GetSamplingStride() <= 1 || count < numberOfSamples)
+    {
+      std::cerr << "Sampling stride " << filter->GetSamplingStride() << " keeps " << count << " pixels" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Loose check of the confidence interval, to keep the test deterministic
+    const StreamingStatisticsVectorImageFilterType::RealPixelType radius = filter->GetMeanConfidenceRadius(0.999);
+
+    means[i] = filter->GetMean();
+    for (unsigned int band = 0; band < radius.GetSize(); ++band)
+    {
+      if (std::abs(means[i][band] - reference->GetMean()[band]) > radius[band])
+      {
+        std::cerr << "Band " << band << ": estimated mean " << means[i][band] << " +/- " << radius[band] << ", actual mean " << reference->GetMean()[band]
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  if (means[0] != means[1])
+  {
+    std::cerr << "The sampled means depend on the streaming: " << means[0] << " and " << means[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
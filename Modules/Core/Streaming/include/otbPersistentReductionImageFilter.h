@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPersistentReductionImageFilter_h
+#define otbPersistentReductionImageFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include "itkMultiThreader.h"
+
+#include <atomic>
+#include <vector>
+
+namespace otb
+{
+
+/** \class PersistentReductionImageFilter
+ *  \brief Base class for persistent filters reducing the pixels of the
+ *  streamed regions into a single accumulator.
+ *
+ *  The requested region of each streamed piece is cut along its last
+ *  dimension into small chunks of a fixed number of lines (see
+ *  SetNumberOfLinesPerChunk()). The threads pick the next chunk to reduce
+ *  as soon as they are done with the previous one, so that a slow chunk
+ *  does not keep the other threads idle. Each chunk is reduced by
+ *  AccumulateRegion() into its own accumulator, held by the thread until
+ *  the chunk is done. The chunk accumulators are then merged pairwise along
+ *  a binary tree, in chunk order, and merged into the persistent
+ *  accumulator. As the chunks do not depend on the number of threads, the
+ *  result depends neither on the thread scheduling nor on the number of
+ *  threads.
+ *
+ *  TAccumulator must be default constructible, copyable and provide:
+ *  - a Merge(const TAccumulator&) method, adding the content of another
+ *    accumulator. The other accumulator covers the pixels following the
+ *    ones of this accumulator.
+ *  - accumulation methods, called by the AccumulateRegion() method of the
+ *    subclass.
+ *
+ *  Subclasses create the empty accumulators (CreateAccumulator()), reduce
+ *  the pixels of a region (AccumulateRegion()) and compute their outputs
+ *  from the final accumulator (Finalize()). Reset() restarts from an empty
+ *  accumulator and Synthetize() finalizes the current one.
+ *
+ *  The output image is neither allocated nor computed.
+ *
+ * \sa PersistentImageFilter
+ *
+ * \ingroup OTBStreaming
+ */
+template <class TInputImage, class TAccumulator>
+class ITK_EXPORT PersistentReductionImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+{
+public:
+  /** Standard typedefs */
+  typedef PersistentReductionImageFilter Self;
+  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Creation through object factory macro */
+  itkTypeMacro(PersistentReductionImageFilter, PersistentImageFilter);
+
+  /** Template parameters typedefs */
+  typedef TInputImage                      InputImageType;
+  typedef typename TInputImage::RegionType RegionType;
+  typedef TAccumulator                     AccumulatorType;
+
+  /** Restart from an empty accumulator */
+  void Reset(void) override;
+
+  /** Compute the outputs from the current accumulator */
+  void Synthetize(void) override;
+
+  /** The output image is not computed: it only keeps the information of
+   *  the input */
+  void AllocateOutputs() override;
+  void GenerateOutputInformation() override;
+
+  /** Set the number of lines of the chunks each streamed piece is cut
+   *  into. Smaller chunks balance the load better between threads, at the
+   *  cost of one accumulator per chunk. Changing it may change the rounding
+   *  of the results. Default is 16. */
+  itkSetMacro(NumberOfLinesPerChunk, unsigned int);
+  itkGetConstMacro(NumberOfLinesPerChunk, unsigned int);
+
+protected:
+  PersistentReductionImageFilter();
+  ~PersistentReductionImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  /** Reduce the requested region into the persistent accumulator */
+  void GenerateData() override;
+
+  /** Return an empty accumulator. Called concurrently by the threads. */
+  virtual AccumulatorType CreateAccumulator() const
+  {
+    return AccumulatorType();
+  }
+
+  /** Reduce the pixels of region into accumulator. Called concurrently by
+   *  the threads, on different accumulators. */
+  virtual void AccumulateRegion(AccumulatorType& accumulator, const RegionType& region) const = 0;
+
+  /** Compute the outputs from the accumulator of all streamed pieces */
+  virtual void Finalize(const AccumulatorType& accumulator) = 0;
+
+  /** Accumulator of all the pieces streamed since the last Reset() */
+  const AccumulatorType& GetAccumulator() const
+  {
+    return m_Accumulator;
+  }
+
+private:
+  PersistentReductionImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Threader callback, reducing chunks until there is none left */
+  static ITK_THREAD_RETURN_TYPE ReductionThreaderCallback(void* arg);
+
+  AccumulatorType m_Accumulator;
+
+  unsigned int m_NumberOfLinesPerChunk;
+
+  /** Chunks of the piece being reduced, and their accumulators */
+  std::vector<RegionType>      m_Chunks;
+  std::vector<AccumulatorType> m_ChunkAccumulators;
+  std::atomic<std::size_t>     m_NextChunk;
+  std::atomic<std::size_t>     m_NumberOfReducedChunks;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbPersistentReductionImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPersistentReductionImageFilter_hxx
+#define otbPersistentReductionImageFilter_hxx
+
+#include "otbPersistentReductionImageFilter.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace otb
+{
+
+template <class TInputImage, class TAccumulator>
+PersistentReductionImageFilter<TInputImage, TAccumulator>::PersistentReductionImageFilter()
+  : m_Accumulator(), m_NumberOfLinesPerChunk(16), m_NextChunk(0), m_NumberOfReducedChunks(0)
+{
+}
+
+template <class TInputImage, class TAccumulator>
+void PersistentReductionImageFilter<TInputImage, TAccumulator>::Reset()
+{
+  m_Accumulator = this->CreateAccumulator();
+}
+
+template <class TInputImage, class TAccumulator>
+void PersistentReductionImageFilter<TInputImage, TAccumulator>::Synthetize()
+{
+  this->Finalize(m_Accumulator);
+}
+
+template <class TInputImage, class TAccumulator>
+void PersistentReductionImageFilter<TInputImage, TAccumulator>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (this->GetInput())
+  {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+    {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+    }
+  }
+}
+
+template <class TInputImage, class TAccumulator>
+void PersistentReductionImageFilter<TInputImage, TAccumulator>::AllocateOutputs()
+{
+  // The output image of this filter is not intended to be used: grafting
+  // the input would stream the whole image for the first stream strip.
+  // Nothing that needs to be allocated for the remaining outputs
+}
+
+template <class TInputImage, class TAccumulator>
+void PersistentReductionImageFilter<TInputImage, TAccumulator>::GenerateData()
+{
+  this->AllocateOutputs();
+
+  const RegionType requestedRegion = this->GetOutput()->GetRequestedRegion();
+  if (requestedRegion.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // Cut the requested region along its last dimension, independently of
+  // the number of threads so that the reduction order does not depend on it
+  const unsigned int splitDimension  = TInputImage::ImageDimension - 1;
+  const std::size_t  numberOfLines   = requestedRegion.GetSize(splitDimension);
+  const std::size_t  linesPerChunk   = std::max(m_NumberOfLinesPerChunk, 1U);
+  const std::size_t  numberOfChunks  = (numberOfLines + linesPerChunk - 1) / linesPerChunk;
+  const unsigned int numberOfThreads = std::max(this->GetNumberOfThreads(), 1U);
+
+  m_Chunks.clear();
+  for (std::size_t i = 0; i < numberOfChunks; ++i)
+  {
+    const std::size_t firstLine = i * linesPerChunk;
+    const std::size_t lastLine  = std::min(numberOfLines, firstLine + linesPerChunk);
+
+    RegionType chunk = requestedRegion;
+    chunk.SetIndex(splitDimension, requestedRegion.GetIndex(splitDimension) + static_cast<typename RegionType::IndexValueType>(firstLine));
+    chunk.SetSize(splitDimension, lastLine - firstLine);
+    m_Chunks.push_back(chunk);
+  }
+
+  m_ChunkAccumulators.assign(numberOfChunks, AccumulatorType());
+  m_NextChunk             = 0;
+  m_NumberOfReducedChunks = 0;
+
+  this->UpdateProgress(0.0f);
+
+  this->GetMultiThreader()->SetNumberOfThreads(static_cast<itk::ThreadIdType>(std::min<std::size_t>(numberOfThreads, numberOfChunks)));
+  this->GetMultiThreader()->SetSingleMethod(Self::ReductionThreaderCallback, this);
+  this->GetMultiThreader()->SingleMethodExecute();
+
+  if (this->GetAbortGenerateData())
+  {
+    m_ChunkAccumulators.clear();
+    itk::ProcessAborted e(__FILE__, __LINE__);
+    e.SetDescription("Process aborted.");
+    e.SetLocation(ITK_LOCATION);
+    throw e;
+  }
+
+  // Pairwise merge along a binary tree: the accumulators of neighbouring
+  // chunks are merged first
+  for (std::size_t step = 1; step < numberOfChunks; step *= 2)
+  {
+    for (std::size_t i = 0; i + step < numberOfChunks; i += 2 * step)
+    {
+      m_ChunkAccumulators[i].Merge(m_ChunkAccumulators[i + step]);
+    }
+  }
+
+  m_Accumulator.Merge(m_ChunkAccumulators[0]);
+  m_ChunkAccumulators.clear();
+
+  this->UpdateProgress(1.0f);
+}
+
+template <class TInputImage, class TAccumulator>
+ITK_THREAD_RETURN_TYPE PersistentReductionImageFilter<TInputImage, TAccumulator>::ReductionThreaderCallback(void* arg)
+{
+  itk::MultiThreader::ThreadInfoStruct* threadInfo = static_cast<itk::MultiThreader::ThreadInfoStruct*>(arg);
+  Self*                                 self       = static_cast<Self*>(threadInfo->UserData);
+  const itk::ThreadIdType               threadId   = threadInfo->ThreadID;
+
+  const std::size_t numberOfChunks = self->m_Chunks.size();
+  for (std::size_t i = self->m_NextChunk++; i < numberOfChunks && !self->GetAbortGenerateData(); i = self->m_NextChunk++)
+  {
+    // Keep the accumulator local while reducing, neighbouring chunk
+    // accumulators may share a cache line
+    AccumulatorType accumulator = self->CreateAccumulator();
+    self->AccumulateRegion(accumulator, self->m_Chunks[i]);
+    self->m_ChunkAccumulators[i] = std::move(accumulator);
+
+    const std::size_t reducedChunks = ++self->m_NumberOfReducedChunks;
+    if (threadId == 0)
+    {
+      self->UpdateProgress(static_cast<float>(reducedChunks) / numberOfChunks);
+    }
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TInputImage, class TAccumulator>
+void PersistentReductionImageFilter<TInputImage, TAccumulator>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Number of lines per chunk: " << m_NumberOfLinesPerChunk << std::endl;
+}
+
+} // end namespace otb
+
+#endif
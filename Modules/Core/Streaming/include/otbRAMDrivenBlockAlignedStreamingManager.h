@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbRAMDrivenBlockAlignedStreamingManager_h
+#define otbRAMDrivenBlockAlignedStreamingManager_h
+
+#include "otbStreamingManager.h"
+#include "itkImageBase.h"
+#include "itkImageRegionSplitter.h"
+#include <set>
+#include <vector>
+
+namespace otb
+{
+
+/** \class RAMDrivenBlockAlignedStreamingManager
+ *  \brief This class computes the divisions needed to stream an image
+ *  so that the blocks of the input files are decoded as few times as
+ *  possible, according to a user-defined available RAM.
+ *
+ * The pipeline is walked upstream from the image to write, down to the
+ * images without source or produced by a process object without
+ * inputs (typically the outputs of ImageFileReader). The block layout of
+ * those inputs is given by the TileHint of their metadata.
+ *
+ * Several splitting schemes are then evaluated for the number of
+ * divisions fitting the available RAM: tiles aligned on the TileHint of
+ * each input and of the image to write, strips and square tiles. For
+ * each scheme, the requested region of every split is propagated
+ * through the pipeline, so that the halos added by the
+ * GenerateInputRequestedRegion() of the filters, and the geometry
+ * changes of resamplers, are taken into account. The scheme decoding
+ * the fewest input pixels, summed over all the inputs, is kept.
+ *
+ * The predicted read amplification is the ratio between the number of
+ * pixels of the blocks decoded by all the splits and the number of
+ * pixels of the blocks needed to process the whole region at once. A
+ * value of 1 means that no block is decoded twice.
+ *
+ * When there are more splits than MaximumNumberOfEvaluatedSplits, only
+ * evenly spaced splits are propagated and the result is extrapolated.
+ *
+ * \sa RAMDrivenAdaptativeStreamingManager
+ * \sa ImageFileWriter
+ * \sa StreamingImageVirtualFileWriter
+ *
+ * \ingroup OTBStreaming
+ */
+template <class TImage>
+class ITK_EXPORT RAMDrivenBlockAlignedStreamingManager : public StreamingManager<TImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef RAMDrivenBlockAlignedStreamingManager Self;
+  typedef StreamingManager<TImage>              Superclass;
+  typedef itk::SmartPointer<Self>               Pointer;
+  typedef itk::SmartPointer<const Self>         ConstPointer;
+
+  typedef TImage                          ImageType;
+  typedef typename Superclass::RegionType RegionType;
+  typedef typename Superclass::SizeType   SizeType;
+
+  /** Creation through object factory macro */
+  itkNewMacro(Self);
+
+  /** Type macro */
+  itkTypeMacro(RAMDrivenBlockAlignedStreamingManager, itk::LightObject);
+
+  /** Dimension of input image. */
+  itkStaticConstMacro(ImageDimension, unsigned int, ImageType::ImageDimension);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkSetMacro(AvailableRAMInMB, unsigned int);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkGetConstMacro(AvailableRAMInMB, unsigned int);
+
+  /** The multiplier to apply to the memory print estimation */
+  itkSetMacro(Bias, double);
+
+  /** The multiplier to apply to the memory print estimation */
+  itkGetConstMacro(Bias, double);
+
+  /** The maximum number of splits propagated through the pipeline to
+   *  evaluate a splitting scheme */
+  itkSetMacro(MaximumNumberOfEvaluatedSplits, unsigned int);
+
+  /** The maximum number of splits propagated through the pipeline to
+   *  evaluate a splitting scheme */
+  itkGetConstMacro(MaximumNumberOfEvaluatedSplits, unsigned int);
+
+  /** The predicted read amplification of the selected splits, over all
+   *  the blocked inputs (1 if no blocked input was found) */
+  itkGetConstMacro(PredictedReadAmplification, double);
+
+  /** The predicted read amplification of the selected splits for each
+   *  blocked input, in the order they were found in the pipeline */
+  const std::vector<double>& GetPredictedInputReadAmplifications() const
+  {
+    return m_PredictedInputReadAmplifications;
+  }
+
+  /** Actually computes the stream divisions, according to the specified streaming mode,
+   * eventually using the input parameter to estimate memory consumption */
+  void PrepareStreaming(itk::DataObject* input, const RegionType& region) override;
+
+protected:
+  RAMDrivenBlockAlignedStreamingManager();
+  ~RAMDrivenBlockAlignedStreamingManager() override;
+
+  typedef itk::ImageBase<ImageDimension>          BlockedImageType;
+  typedef itk::ImageRegionSplitter<ImageDimension> CandidateSplitterType;
+
+  /** An input of the pipeline with a known block layout */
+  struct BlockedInputType
+  {
+    BlockedImageType* Image;
+    SizeType          BlockSize;
+  };
+
+  /** Walk the pipeline upstream of data to find the blocked inputs */
+  void FindBlockedInputs(itk::DataObject* data, std::set<itk::DataObject*>& visited, std::vector<BlockedInputType>& inputs) const;
+
+  /** Number of pixels of the blocks of the input intersecting its requested region */
+  static double GetNumberOfDecodedPixels(const BlockedInputType& input);
+
+  /** Propagate the splits of splitter through the pipeline and accumulate
+   *  the number of decoded pixels of each input. Returns false if a
+   *  requested region could not be propagated. */
+  bool EvaluateSplitter(ImageType* image, const RegionType& region, CandidateSplitterType* splitter, unsigned int nbSplits,
+                        const std::vector<BlockedInputType>& inputs, std::vector<double>& decodedPixels) const;
+
+  /** The number of MegaBytes of RAM available */
+  unsigned int m_AvailableRAMInMB;
+
+  /** The multiplier to apply to the memory print estimation */
+  double m_Bias;
+
+  /** The maximum number of splits propagated to evaluate a scheme */
+  unsigned int m_MaximumNumberOfEvaluatedSplits;
+
+  /** The predicted read amplification over all the inputs */
+  double m_PredictedReadAmplification;
+
+  /** The predicted read amplification of each input */
+  std::vector<double> m_PredictedInputReadAmplifications;
+
+private:
+  RAMDrivenBlockAlignedStreamingManager(const RAMDrivenBlockAlignedStreamingManager&) = delete;
+  void operator=(const RAMDrivenBlockAlignedStreamingManager&) = delete;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbRAMDrivenBlockAlignedStreamingManager.hxx"
+#endif
+
+#endif
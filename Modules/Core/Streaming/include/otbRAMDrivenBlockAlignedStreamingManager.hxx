@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbRAMDrivenBlockAlignedStreamingManager_hxx
+#define otbRAMDrivenBlockAlignedStreamingManager_hxx
+
+#include "otbRAMDrivenBlockAlignedStreamingManager.h"
+#include "otbMacro.h"
+#include "otbImageRegionAdaptativeSplitter.h"
+#include "otbImageRegionSquareTileSplitter.h"
+#include "otbImageCommons.h"
+#include "otbMetaDataKey.h"
+#include <algorithm>
+#include <numeric>
+
+namespace otb
+{
+
+template <class TImage>
+RAMDrivenBlockAlignedStreamingManager<TImage>::RAMDrivenBlockAlignedStreamingManager()
+  : m_AvailableRAMInMB(0), m_Bias(1.0), m_MaximumNumberOfEvaluatedSplits(256), m_PredictedReadAmplification(1.0)
+{
+}
+
+template <class TImage>
+RAMDrivenBlockAlignedStreamingManager<TImage>::~RAMDrivenBlockAlignedStreamingManager()
+{
+}
+
+template <class TImage>
+void RAMDrivenBlockAlignedStreamingManager<TImage>::FindBlockedInputs(itk::DataObject* data, std::set<itk::DataObject*>& visited,
+                                                                      std::vector<BlockedInputType>& inputs) const
+{
+  if (data == nullptr || visited.count(data))
+  {
+    return;
+  }
+  visited.insert(data);
+
+  itk::ProcessObject* source = data->GetSource();
+  if (source)
+  {
+    itk::ProcessObject::DataObjectPointerArray sourceInputs = source->GetInputs();
+    if (!sourceInputs.empty())
+    {
+      for (auto sourceInput : sourceInputs)
+      {
+        this->FindBlockedInputs(sourceInput, visited, inputs);
+      }
+      return;
+    }
+  }
+
+  // data is an input of the pipeline: keep it if its block layout is known
+  auto blockedImage = dynamic_cast<BlockedImageType*>(data);
+  auto imageCommons = dynamic_cast<ImageCommons*>(data);
+  if (blockedImage && imageCommons)
+  {
+    const auto& imd = imageCommons->GetImageMetadata();
+    if (imd.Has(MDNum::TileHintX) && imd.Has(MDNum::TileHintY) && imd[MDNum::TileHintX] > 0 && imd[MDNum::TileHintY] > 0)
+    {
+      BlockedInputType blockedInput;
+      blockedInput.Image = blockedImage;
+      blockedInput.BlockSize.Fill(1);
+      blockedInput.BlockSize[0] = imd[MDNum::TileHintX];
+      blockedInput.BlockSize[1] = imd[MDNum::TileHintY];
+      inputs.push_back(blockedInput);
+    }
+  }
+}
+
+template <class TImage>
+double RAMDrivenBlockAlignedStreamingManager<TImage>::GetNumberOfDecodedPixels(const BlockedInputType& input)
+{
+  const auto& requested = input.Image->GetRequestedRegion();
+  const auto& largest   = input.Image->GetLargestPossibleRegion();
+
+  double pixels = 1.;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    const long long origin = largest.GetIndex(dim);
+    const long long end    = origin + static_cast<long long>(largest.GetSize(dim));
+    const long long start  = std::max(origin, static_cast<long long>(requested.GetIndex(dim)));
+    const long long stop   = std::min(end, static_cast<long long>(requested.GetIndex(dim)) + static_cast<long long>(requested.GetSize(dim)));
+    if (stop <= start)
+    {
+      return 0.;
+    }
+
+    // Blocks are aligned on the origin of the largest possible region
+    const long long block        = input.BlockSize[dim];
+    const long long blockedStart = origin + (start - origin) / block * block;
+    const long long blockedStop  = std::min(end, origin + ((stop - origin + block - 1) / block) * block);
+    pixels *= static_cast<double>(blockedStop - blockedStart);
+  }
+  return pixels;
+}
+
+template <class TImage>
+bool RAMDrivenBlockAlignedStreamingManager<TImage>::EvaluateSplitter(ImageType* image, const RegionType& region, CandidateSplitterType* splitter,
+                                                                     unsigned int nbSplits, const std::vector<BlockedInputType>& inputs,
+                                                                     std::vector<double>& decodedPixels) const
+{
+  decodedPixels.assign(inputs.size(), 0.);
+
+  const unsigned int nbEvaluatedSplits = std::max(1u, std::min(nbSplits, m_MaximumNumberOfEvaluatedSplits));
+  for (unsigned int k = 0; k < nbEvaluatedSplits; ++k)
+  {
+    const unsigned int i     = static_cast<unsigned int>(static_cast<unsigned long long>(k) * nbSplits / nbEvaluatedSplits);
+    RegionType         split = splitter->GetSplit(i, nbSplits, region);
+
+    image->SetRequestedRegion(split);
+    try
+    {
+      image->PropagateRequestedRegion();
+    }
+    catch (itk::ExceptionObject& err)
+    {
+      otbLogMacro(Debug, << "Split " << split << " of " << splitter->GetNameOfClass() << " could not be propagated: " << err.GetDescription());
+      return false;
+    }
+
+    for (unsigned int j = 0; j < inputs.size(); ++j)
+    {
+      decodedPixels[j] += GetNumberOfDecodedPixels(inputs[j]);
+    }
+  }
+
+  // Extrapolate from the evaluated splits
+  const double scale = static_cast<double>(nbSplits) / nbEvaluatedSplits;
+  for (auto& pixels : decodedPixels)
+  {
+    pixels *= scale;
+  }
+  return true;
+}
+
+template <class TImage>
+void RAMDrivenBlockAlignedStreamingManager<TImage>::PrepareStreaming(itk::DataObject* input, const RegionType& region)
+{
+  unsigned long nbDivisions = this->EstimateOptimalNumberOfDivisions(input, region, m_AvailableRAMInMB, m_Bias);
+
+  typedef otb::ImageRegionAdaptativeSplitter<itkGetStaticConstMacro(ImageDimension)> AdaptativeSplitterType;
+  typedef otb::ImageRegionSquareTileSplitter<itkGetStaticConstMacro(ImageDimension)> SquareTileSplitterType;
+
+  m_PredictedReadAmplification = 1.;
+  m_PredictedInputReadAmplifications.clear();
+
+  std::vector<BlockedInputType>  inputs;
+  std::set<itk::DataObject*>     visited;
+  this->FindBlockedInputs(input, visited, inputs);
+
+  // Candidate schemes: tiles aligned on each known block layout, then
+  // strips and square tiles
+  std::vector<SizeType> tileHints;
+  auto                  image = dynamic_cast<ImageType*>(input);
+  if (image)
+  {
+    const auto& imd = image->GetImageMetadata();
+    if (imd.Has(MDNum::TileHintX) && imd.Has(MDNum::TileHintY))
+    {
+      SizeType tileHint;
+      tileHint.Fill(0);
+      tileHint[0] = imd[MDNum::TileHintX];
+      tileHint[1] = imd[MDNum::TileHintY];
+      tileHints.push_back(tileHint);
+    }
+  }
+  for (auto const& blockedInput : inputs)
+  {
+    if (std::find(tileHints.begin(), tileHints.end(), blockedInput.BlockSize) == tileHints.end())
+    {
+      tileHints.push_back(blockedInput.BlockSize);
+    }
+  }
+  if (tileHints.empty())
+  {
+    SizeType tileHint;
+    tileHint.Fill(0);
+    tileHints.push_back(tileHint);
+  }
+
+  std::vector<typename CandidateSplitterType::Pointer> candidates;
+  for (auto const& tileHint : tileHints)
+  {
+    typename AdaptativeSplitterType::Pointer splitter = AdaptativeSplitterType::New();
+    splitter->SetTileHint(tileHint);
+    candidates.push_back(splitter.GetPointer());
+  }
+  candidates.push_back(CandidateSplitterType::New());
+  candidates.push_back(SquareTileSplitterType::New().GetPointer());
+
+  // Without blocked input, fall back to the adaptative splitting
+  unsigned int selected = 0;
+
+  if (image && !inputs.empty())
+  {
+    // Pixels of the blocks needed to process the whole region at once
+    std::vector<double> neededPixels(inputs.size(), 0.);
+    bool                evaluated = false;
+    image->SetRequestedRegion(region);
+    try
+    {
+      image->PropagateRequestedRegion();
+      for (unsigned int j = 0; j < inputs.size(); ++j)
+      {
+        neededPixels[j] = GetNumberOfDecodedPixels(inputs[j]);
+      }
+      evaluated = true;
+    }
+    catch (itk::ExceptionObject& err)
+    {
+      otbLogMacro(Warning, << "Unable to propagate the requested region through the pipeline, block alignment is not evaluated: " << err.GetDescription());
+    }
+
+    std::vector<double> bestDecodedPixels;
+    for (unsigned int c = 0; evaluated && c < candidates.size(); ++c)
+    {
+      const unsigned int  nbSplits = candidates[c]->GetNumberOfSplits(region, nbDivisions);
+      std::vector<double> decodedPixels;
+      if (!this->EvaluateSplitter(image, region, candidates[c], nbSplits, inputs, decodedPixels))
+      {
+        continue;
+      }
+
+      const double total = std::accumulate(decodedPixels.begin(), decodedPixels.end(), 0.);
+      otbLogMacro(Debug, << candidates[c]->GetNameOfClass() << ": " << nbSplits << " splits, " << total << " decoded input pixels");
+      if (bestDecodedPixels.empty() || total < std::accumulate(bestDecodedPixels.begin(), bestDecodedPixels.end(), 0.))
+      {
+        selected          = c;
+        bestDecodedPixels = decodedPixels;
+      }
+    }
+
+    if (!bestDecodedPixels.empty())
+    {
+      double totalNeeded = 0.;
+      for (unsigned int j = 0; j < inputs.size(); ++j)
+      {
+        const double amplification = neededPixels[j] > 0 ? bestDecodedPixels[j] / neededPixels[j] : 1.;
+        m_PredictedInputReadAmplifications.push_back(amplification);
+        totalNeeded += neededPixels[j];
+        otbLogMacro(Debug, << "Predicted read amplification of input " << j << " (blocks of " << inputs[j].BlockSize[0] << "x" << inputs[j].BlockSize[1]
+                           << "): " << amplification);
+      }
+      if (totalNeeded > 0)
+      {
+        m_PredictedReadAmplification = std::accumulate(bestDecodedPixels.begin(), bestDecodedPixels.end(), 0.) / totalNeeded;
+      }
+    }
+
+    // Leave the requested region as it was before the evaluation
+    image->SetRequestedRegion(region);
+  }
+
+  this->m_Splitter               = candidates[selected];
+  this->m_ComputedNumberOfSplits = candidates[selected]->GetNumberOfSplits(region, nbDivisions);
+  this->m_Region                 = region;
+
+  otbLogMacro(Info, << "Block aligned streaming: " << this->m_ComputedNumberOfSplits << " splits (" << candidates[selected]->GetNameOfClass() << ") over "
+                    << inputs.size() << " blocked inputs, predicted read amplification: " << m_PredictedReadAmplification);
+}
+
+} // End namespace otb
+
+#endif
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbRAMMeasuredStrippedStreamingManager_h
+#define otbRAMMeasuredStrippedStreamingManager_h
+
+#include "otbStreamingManager.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class RAMMeasuredStrippedStreamingManager
+ *  \brief This class computes the divisions needed to stream an image
+ *  by strips, and corrects their height from the memory actually
+ *  consumed by the first strips.
+ *
+ * The first strips are computed like in RAMDrivenStrippedStreamingManager,
+ * from the static estimation of the pipeline memory print. This
+ * estimation ignores the internal buffers of the filters, so the writer
+ * notifies the manager each time a strip has been processed (see
+ * NotifySplitProcessed()). After NumberOfProbeSplits strips, the peak
+ * resident memory measured during their processing gives the actual
+ * memory print per pixel, and the remaining rows are re-planned in strips
+ * fitting the available RAM.
+ *
+ * Strip heights are multiples of the TileHintY found in the image
+ * metadata, when it is available and smaller than the strip height.
+ *
+ * The measure covers the whole process: other processing running at the
+ * same time in the process is accounted for. If the resident memory can
+ * not be measured on the platform, the initial plan is kept.
+ *
+ * \sa RAMDrivenStrippedStreamingManager
+ * \sa ImageFileWriter
+ *
+ * \ingroup OTBStreaming
+ */
+template <class TImage>
+class ITK_EXPORT RAMMeasuredStrippedStreamingManager : public StreamingManager<TImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef RAMMeasuredStrippedStreamingManager Self;
+  typedef StreamingManager<TImage>            Superclass;
+  typedef itk::SmartPointer<Self>             Pointer;
+  typedef itk::SmartPointer<const Self>       ConstPointer;
+
+  typedef TImage                               ImageType;
+  typedef typename Superclass::RegionType      RegionType;
+  typedef typename Superclass::MemoryPrintType MemoryPrintType;
+
+  /** Creation through object factory macro */
+  itkNewMacro(Self);
+
+  /** Type macro */
+  itkTypeMacro(RAMMeasuredStrippedStreamingManager, itk::LightObject);
+
+  /** Dimension of input image. */
+  itkStaticConstMacro(ImageDimension, unsigned int, ImageType::ImageDimension);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkSetMacro(AvailableRAMInMB, unsigned int);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkGetConstMacro(AvailableRAMInMB, unsigned int);
+
+  /** The multiplier to apply to the memory print estimation and measure */
+  itkSetMacro(Bias, double);
+
+  /** The multiplier to apply to the memory print estimation and measure */
+  itkGetConstMacro(Bias, double);
+
+  /** The number of strips processed before re-planning (default is 1) */
+  itkSetClampMacro(NumberOfProbeSplits, unsigned int, 1, itk::NumericTraits<unsigned int>::max());
+
+  /** The number of strips processed before re-planning (default is 1) */
+  itkGetConstMacro(NumberOfProbeSplits, unsigned int);
+
+  /** The memory print measured on the probe strips, in bytes (0 until
+   * measured) */
+  itkGetConstMacro(MeasuredMemoryPrint, MemoryPrintType);
+
+  /** Actually computes the stream divisions, according to the specified streaming mode,
+   * eventually using the input parameter to estimate memory consumption */
+  void PrepareStreaming(itk::DataObject* input, const RegionType& region) override;
+
+  RegionType GetSplit(unsigned int i) override;
+
+  /** Measure the peak memory during the processing of the ith strip, and
+   * re-plan the remaining strips after the last probe strip */
+  bool NotifySplitProcessed(unsigned int i) override;
+
+  /** Re-plan the strips after the ith one, given the memory print measured
+   * while processing the strips up to the ith one, in bytes */
+  void ReplanFromMemoryPrint(unsigned int i, MemoryPrintType memoryPrint);
+
+protected:
+  RAMMeasuredStrippedStreamingManager();
+  ~RAMMeasuredStrippedStreamingManager() override;
+
+  /** Split the rows [firstRow, region end) in strips of the given height */
+  void PlanStrips(long firstRow, unsigned long stripHeight);
+
+  /** The number of MegaBytes of RAM available */
+  unsigned int m_AvailableRAMInMB;
+
+  /** The multiplier to apply to the memory print estimation */
+  double m_Bias;
+
+  /** The number of strips processed before re-planning */
+  unsigned int m_NumberOfProbeSplits;
+
+  /** Resident memory when the streaming was prepared */
+  MemoryPrintType m_BaselineMemory;
+
+  /** Peak memory print measured on the probe strips */
+  MemoryPrintType m_MeasuredMemoryPrint;
+
+  /** Strip heights are aligned on this value if not 0 */
+  unsigned long m_TileHintY;
+
+  /** The strips */
+  std::vector<RegionType> m_Strips;
+
+private:
+  RAMMeasuredStrippedStreamingManager(const RAMMeasuredStrippedStreamingManager&) = delete;
+  void operator=(const RAMMeasuredStrippedStreamingManager&) = delete;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbRAMMeasuredStrippedStreamingManager.hxx"
+#endif
+
+#endif
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbRAMMeasuredStrippedStreamingManager_hxx
+#define otbRAMMeasuredStrippedStreamingManager_hxx
+
+#include "otbRAMMeasuredStrippedStreamingManager.h"
+#include "otbMacro.h"
+#include "otbSystem.h"
+#include "itkImageRegionSplitter.h"
+#include "otbMetaDataKey.h"
+
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TImage>
+RAMMeasuredStrippedStreamingManager<TImage>::RAMMeasuredStrippedStreamingManager()
+  : m_AvailableRAMInMB(0), m_Bias(1.0), m_NumberOfProbeSplits(1), m_BaselineMemory(0), m_MeasuredMemoryPrint(0), m_TileHintY(0)
+{
+}
+
+template <class TImage>
+RAMMeasuredStrippedStreamingManager<TImage>::~RAMMeasuredStrippedStreamingManager()
+{
+}
+
+template <class TImage>
+void RAMMeasuredStrippedStreamingManager<TImage>::PrepareStreaming(itk::DataObject* input, const RegionType& region)
+{
+  unsigned long nbDivisions = this->EstimateOptimalNumberOfDivisions(input, region, m_AvailableRAMInMB, m_Bias);
+
+  m_TileHintY     = 0;
+  auto inputImage = dynamic_cast<TImage*>(input);
+  if (inputImage)
+  {
+    const auto& imd = inputImage->GetImageMetadata();
+    if (imd.Has(MDNum::TileHintY))
+    {
+      m_TileHintY = imd[MDNum::TileHintY];
+    }
+  }
+
+  // Only used by clients asking for the splitter, the strips are stored
+  this->m_Splitter = itk::ImageRegionSplitter<itkGetStaticConstMacro(ImageDimension)>::New();
+  this->m_Region   = region;
+
+  const unsigned long rows = region.GetSize(ImageDimension - 1);
+  nbDivisions              = std::max(1UL, std::min(nbDivisions, rows));
+
+  m_Strips.clear();
+  this->PlanStrips(region.GetIndex(ImageDimension - 1), (rows + nbDivisions - 1) / nbDivisions);
+
+  // The peak memory of the probe strips is measured from here. When the
+  // peak can not be reset, it includes the memory used before this
+  // pipeline and the estimated plan is kept.
+  m_MeasuredMemoryPrint = 0;
+  m_BaselineMemory      = 0;
+  if (System::ResetPeakResidentMemory())
+  {
+    m_BaselineMemory = System::GetResidentMemoryInBytes();
+  }
+}
+
+template <class TImage>
+typename RAMMeasuredStrippedStreamingManager<TImage>::RegionType RAMMeasuredStrippedStreamingManager<TImage>::GetSplit(unsigned int i)
+{
+  return m_Strips[i];
+}
+
+template <class TImage>
+bool RAMMeasuredStrippedStreamingManager<TImage>::NotifySplitProcessed(unsigned int i)
+{
+  if (i >= m_NumberOfProbeSplits || i + 1 >= m_Strips.size())
+  {
+    return false;
+  }
+
+  const MemoryPrintType peakMemory = System::GetPeakResidentMemoryInBytes();
+  if (peakMemory == 0 || m_BaselineMemory == 0)
+  {
+    if (i == 0)
+    {
+      otbLogMacro(Warning, << "Peak memory consumption can not be measured on this platform, the estimated streaming plan is kept");
+    }
+    return false;
+  }
+
+  m_MeasuredMemoryPrint = std::max(m_MeasuredMemoryPrint, peakMemory > m_BaselineMemory ? peakMemory - m_BaselineMemory : 0);
+
+  if (i + 1 < m_NumberOfProbeSplits)
+  {
+    return false;
+  }
+
+  this->ReplanFromMemoryPrint(i, m_MeasuredMemoryPrint);
+  return true;
+}
+
+template <class TImage>
+void RAMMeasuredStrippedStreamingManager<TImage>::ReplanFromMemoryPrint(unsigned int i, MemoryPrintType memoryPrint)
+{
+  const unsigned int lastDimension = ImageDimension - 1;
+
+  MemoryPrintType availableRAMInBytes = this->GetActualAvailableRAMInBytes(m_AvailableRAMInMB);
+  if (this->GetNumberOfConcurrentSplits() > 1)
+  {
+    availableRAMInBytes /= this->GetNumberOfConcurrentSplits();
+  }
+
+  // The first strip is the highest of the probe strips
+  const double bytesPerRow = m_Bias * static_cast<double>(memoryPrint) / m_Strips[0].GetSize(lastDimension);
+
+  const long          firstRow      = m_Strips[i].GetIndex(lastDimension) + m_Strips[i].GetSize(lastDimension);
+  const unsigned long remainingRows = this->m_Region.GetIndex(lastDimension) + this->m_Region.GetSize(lastDimension) - firstRow;
+
+  unsigned long stripHeight = remainingRows;
+  if (bytesPerRow > 0)
+  {
+    stripHeight = std::max(1UL, std::min(remainingRows, static_cast<unsigned long>(availableRAMInBytes / bytesPerRow)));
+  }
+
+  m_Strips.resize(i + 1);
+  this->PlanStrips(firstRow, stripHeight);
+
+  otbLogMacro(Info, << "Measured memory for " << m_Strips[0].GetSize(lastDimension) << " rows: "
+                    << memoryPrint * otb::PipelineMemoryPrintCalculator::ByteToMegabyte << " MB (avail.: "
+                    << availableRAMInBytes * otb::PipelineMemoryPrintCalculator::ByteToMegabyte << " MB), remaining " << remainingRows
+                    << " rows re-planned in " << m_Strips.size() - i - 1 << " blocks");
+}
+
+template <class TImage>
+void RAMMeasuredStrippedStreamingManager<TImage>::PlanStrips(long firstRow, unsigned long stripHeight)
+{
+  const unsigned int lastDimension = ImageDimension - 1;
+
+  if (m_TileHintY > 0 && stripHeight > m_TileHintY)
+  {
+    stripHeight = (stripHeight / m_TileHintY) * m_TileHintY;
+  }
+  stripHeight = std::max(1UL, stripHeight);
+
+  const long endRow = this->m_Region.GetIndex(lastDimension) + this->m_Region.GetSize(lastDimension);
+  for (long row = firstRow; row < endRow; row += stripHeight)
+  {
+    RegionType strip = this->m_Region;
+    strip.SetIndex(lastDimension, row);
+    strip.SetSize(lastDimension, std::min(stripHeight, static_cast<unsigned long>(endRow - row)));
+    m_Strips.push_back(strip);
+  }
+
+  this->m_ComputedNumberOfSplits = m_Strips.size();
+}
+
+} // End namespace otb
+
+#endif
@@ -223,6 +223,12 @@ void StreamingImageVirtualWriter<TInputImage>::GenerateData(void)
     inputPtr->SetRequestedRegion(streamRegion);
     inputPtr->PropagateRequestedRegion();
     inputPtr->UpdateOutputData();
+
+    // The streaming manager may re-plan the next pieces from the memory actually used
+    if (m_StreamingManager->NotifySplitProcessed(m_CurrentDivision))
+    {
+      m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
+    }
   }
 
   /**
@@ -91,15 +91,34 @@ public:
    * GetNumberOfSplits() returns. */
   virtual RegionType GetSplit(unsigned int i);
 
+  /** Notify the streaming manager that the ith piece has been processed.
+   * Streaming managers measuring the actual memory consumption may re-plan
+   * the pieces after the ith one: they then return true, and
+   * GetNumberOfSplits() and GetSplit() describe the new partition (the pieces
+   * up to the ith one are left unchanged). The default implementation does
+   * nothing and returns false. */
+  virtual bool NotifySplitProcessed(unsigned int i);
+
   itkSetMacro(DefaultRAM, MemoryPrintType);
   itkGetMacro(DefaultRAM, MemoryPrintType);
 
+  /** Number of splits processed at the same time by the writer. The
+   *  available RAM is shared between them when estimating the number of
+   *  divisions. Default is 1. */
+  itkSetMacro(NumberOfConcurrentSplits, unsigned int);
+  itkGetMacro(NumberOfConcurrentSplits, unsigned int);
+
 protected:
   StreamingManager();
   ~StreamingManager() override;
 
   virtual unsigned int EstimateOptimalNumberOfDivisions(itk::DataObject* input, const RegionType& region, MemoryPrintType availableRAMInMB, double bias = 1.0);
 
+  /** Compute the available RAM in Bytes from an input value in MByte.
+   *  If the input value is 0, it uses the m_DefaultRAM value.
+   *  If m_DefaultRAM is also 0, it uses the configuration settings */
+  MemoryPrintType GetActualAvailableRAMInBytes(MemoryPrintType availableRAMInMB);
+
   /** The number of splits generated by the splitter */
   unsigned int m_ComputedNumberOfSplits;
 
@@ -114,13 +133,11 @@ private:
   StreamingManager(const StreamingManager&) = delete;
   void operator=(const StreamingManager&) = delete;
 
-  /** Compute the available RAM in Bytes from an input value in MByte.
-   *  If the input value is 0, it uses the m_DefaultRAM value.
-   *  If m_DefaultRAM is also 0, it uses the configuration settings */
-  MemoryPrintType GetActualAvailableRAMInBytes(MemoryPrintType availableRAMInMB);
-
   /** Default available RAM in MB */
   MemoryPrintType m_DefaultRAM;
+
+  /** Number of splits processed concurrently */
+  unsigned int m_NumberOfConcurrentSplits;
 };
 
 } // End namespace otb
@@ -29,7 +29,7 @@ namespace otb
 {
 
 template <class TImage>
-StreamingManager<TImage>::StreamingManager() : m_ComputedNumberOfSplits(0), m_DefaultRAM(0)
+StreamingManager<TImage>::StreamingManager() : m_ComputedNumberOfSplits(0), m_DefaultRAM(0), m_NumberOfConcurrentSplits(1)
 {
 }
 
@@ -70,6 +70,13 @@ unsigned int StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::Dat
 {
   MemoryPrintType availableRAMInBytes = GetActualAvailableRAMInBytes(availableRAM);
 
+  // Each concurrent split runs its own pipeline
+  if (m_NumberOfConcurrentSplits > 1)
+  {
+    availableRAMInBytes /= m_NumberOfConcurrentSplits;
+    otbLogMacro(Info, << "Available RAM is shared between " << m_NumberOfConcurrentSplits << " concurrent splits");
+  }
+
   otb::PipelineMemoryPrintCalculator::Pointer memoryPrintCalculator;
   memoryPrintCalculator = otb::PipelineMemoryPrintCalculator::New();
 
@@ -168,6 +175,12 @@ typename StreamingManager<TImage>::RegionType StreamingManager<TImage>::GetSplit
   return region;
 }
 
+template <class TImage>
+bool StreamingManager<TImage>::NotifySplitProcessed(unsigned int itkNotUsed(i))
+{
+  return false;
+}
+
 } // End namespace otb
 
 #endif
@@ -25,8 +25,14 @@
 #include "otbTileDimensionTiledStreamingManager.h"
 #include "otbRAMDrivenTiledStreamingManager.h"
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbRAMMeasuredStrippedStreamingManager.h"
+#include "otbRAMDrivenBlockAlignedStreamingManager.h"
+#include "otbImage.h"
+#include "itkMeanImageFilter.h"
 
+#include <cmath>
 #include <fstream>
+#include <iostream>
 
 const int Dimension = 2;
 typedef otb::VectorImage<unsigned short, Dimension> ImageType;
@@ -35,6 +41,8 @@ typedef otb::RAMDrivenStrippedStreamingManager<ImageType>     RAMDrivenStrippedS
 typedef otb::TileDimensionTiledStreamingManager<ImageType>    TileDimensionTiledStreamingManagerType;
 typedef otb::RAMDrivenTiledStreamingManager<ImageType>        RAMDrivenTiledStreamingManagerType;
 typedef otb::RAMDrivenAdaptativeStreamingManager<ImageType>   RAMDrivenAdaptativeStreamingManagerType;
+typedef otb::RAMMeasuredStrippedStreamingManager<ImageType>   RAMMeasuredStrippedStreamingManagerType;
+typedef otb::RAMDrivenBlockAlignedStreamingManager<ImageType> RAMDrivenBlockAlignedStreamingManagerType;
 
 
 ImageType::Pointer makeImage(ImageType::RegionType region)
@@ -208,3 +216,135 @@ int otbRAMDrivenAdaptativeStreamingManager(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbRAMMeasuredStrippedStreamingManager(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  RAMMeasuredStrippedStreamingManagerType::Pointer streamingManager = RAMMeasuredStrippedStreamingManagerType::New();
+
+  ImageType::RegionType region;
+  region.SetIndex(0, 0);
+  region.SetIndex(1, 0);
+  region.SetSize(0, 10013);
+  region.SetSize(1, 5727);
+
+  streamingManager->SetAvailableRAMInMB(64);
+  streamingManager->PrepareStreaming(makeImage(region), region);
+
+  // Pretend the first strip consumed four times the memory that was available
+  const unsigned int firstHeight = streamingManager->GetSplit(0).GetSize(1);
+  streamingManager->ReplanFromMemoryPrint(0, 4 * 64 * 1024 * 1024);
+
+  const unsigned int nbSplits = streamingManager->GetNumberOfSplits();
+  if (nbSplits < 2)
+  {
+    std::cerr << "Expected several splits after re-planning, got " << nbSplits << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The strips must still cover the region, in order, without overlap
+  long nextRow = region.GetIndex(1);
+  for (unsigned int i = 0; i < nbSplits; ++i)
+  {
+    ImageType::RegionType split = streamingManager->GetSplit(i);
+    if (split.GetIndex(1) != nextRow || split.GetIndex(0) != region.GetIndex(0) || split.GetSize(0) != region.GetSize(0))
+    {
+      std::cerr << "Split " << i << " does not follow the previous one: " << split << std::endl;
+      return EXIT_FAILURE;
+    }
+    nextRow += split.GetSize(1);
+  }
+  if (nextRow != static_cast<long>(region.GetIndex(1) + region.GetSize(1)))
+  {
+    std::cerr << "Splits do not cover the region" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The re-planned strips are smaller than the first one, and aligned on the tile hint
+  const unsigned int newHeight = streamingManager->GetSplit(1).GetSize(1);
+  if (newHeight > firstHeight / 4 + 64 || (newHeight > 64 && newHeight % 64 != 0))
+  {
+    std::cerr << "Unexpected strip height after re-planning: " << newHeight << " (first strip: " << firstHeight << ")" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+template <class TStreamingManager, class TRegion>
+bool checkSplitsCoverRegion(TStreamingManager* streamingManager, const TRegion& region)
+{
+  unsigned long long nbPixels = 0;
+  for (unsigned int i = 0; i < streamingManager->GetNumberOfSplits(); ++i)
+  {
+    TRegion split = streamingManager->GetSplit(i);
+    if (!region.IsInside(split))
+    {
+      std::cerr << "Split " << i << " is outside of the region: " << split << std::endl;
+      return false;
+    }
+    nbPixels += split.GetNumberOfPixels();
+  }
+  if (nbPixels != region.GetNumberOfPixels())
+  {
+    std::cerr << "Splits do not cover the region" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+int otbRAMDrivenBlockAlignedStreamingManager(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  ImageType::RegionType region;
+  region.SetIndex(0, 0);
+  region.SetIndex(1, 0);
+  region.SetSize(0, 10013);
+  region.SetSize(1, 5727);
+
+  // Without halo, splits aligned on the blocks decode each block once
+  RAMDrivenBlockAlignedStreamingManagerType::Pointer streamingManager = RAMDrivenBlockAlignedStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(64);
+  streamingManager->PrepareStreaming(makeImage(region), region);
+
+  if (streamingManager->GetNumberOfSplits() < 2 || !checkSplitsCoverRegion(streamingManager.GetPointer(), region))
+  {
+    return EXIT_FAILURE;
+  }
+  if (streamingManager->GetPredictedInputReadAmplifications().size() != 1 || std::abs(streamingManager->GetPredictedReadAmplification() - 1.) > 1e-9)
+  {
+    std::cerr << "Unexpected read amplification without halo: " << streamingManager->GetPredictedReadAmplification() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The halo of a neighborhood filter makes the splits decode the blocks
+  // along their borders twice
+  typedef otb::Image<unsigned short>                               ScalarImageType;
+  typedef itk::MeanImageFilter<ScalarImageType, ScalarImageType>  MeanFilterType;
+  typedef otb::RAMDrivenBlockAlignedStreamingManager<ScalarImageType> ScalarStreamingManagerType;
+
+  ScalarImageType::Pointer image = ScalarImageType::New();
+  image->SetRegions(region);
+  image->GetImageMetadata().Add(otb::MDNum::TileHintX, 256);
+  image->GetImageMetadata().Add(otb::MDNum::TileHintY, 256);
+
+  MeanFilterType::Pointer meanFilter = MeanFilterType::New();
+  meanFilter->SetInput(image);
+  meanFilter->SetRadius(4);
+  meanFilter->UpdateOutputInformation();
+
+  ScalarStreamingManagerType::Pointer haloStreamingManager = ScalarStreamingManagerType::New();
+  haloStreamingManager->SetAvailableRAMInMB(16);
+  haloStreamingManager->PrepareStreaming(meanFilter->GetOutput(), region);
+
+  if (haloStreamingManager->GetNumberOfSplits() < 2 || !checkSplitsCoverRegion(haloStreamingManager.GetPointer(), region))
+  {
+    return EXIT_FAILURE;
+  }
+  const double amplification = haloStreamingManager->GetPredictedReadAmplification();
+  if (haloStreamingManager->GetPredictedInputReadAmplifications().size() != 1 || amplification <= 1. || amplification > 3.)
+  {
+    std::cerr << "Unexpected read amplification with halo: " << amplification << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
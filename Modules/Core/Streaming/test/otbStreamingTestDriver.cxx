@@ -27,5 +27,7 @@ void RegisterTests()
   REGISTER_TEST(otbTileDimensionTiledStreamingManager);
   REGISTER_TEST(otbRAMDrivenTiledStreamingManager);
   REGISTER_TEST(otbRAMDrivenAdaptativeStreamingManager);
+  REGISTER_TEST(otbRAMMeasuredStrippedStreamingManager);
+  REGISTER_TEST(otbRAMDrivenBlockAlignedStreamingManager);
   REGISTER_TEST(otbPipelineMemoryPrintCalculatorTest);
 }
@@ -23,6 +23,7 @@
 
 #include <sstream>
 #include <stdio.h>
+#include <vector>
 #include "otbTransform.h"
 #include "itkMacro.h"
 
@@ -114,6 +115,9 @@ public:
   /**  Method to transform a point. */
   SecondTransformOutputPointType TransformPoint(const FirstTransformInputPointType&) const override;
 
+  /**  Method to transform count points, through both transforms in turn */
+  void TransformPoints(const FirstTransformInputPointType* inputPoints, SecondTransformOutputPointType* outputPoints, std::size_t count) const override;
+
   /**  Method to transform a vector. */
   //  virtual OutputVectorType TransformVector(const InputVectorType &) const;
 
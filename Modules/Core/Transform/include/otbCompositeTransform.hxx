@@ -55,6 +55,15 @@ CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensi
   return outputPoint;
 }
 
+template <class TFirstTransform, class TSecondTransform, class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(
+    const FirstTransformInputPointType* inputPoints, SecondTransformOutputPointType* outputPoints, std::size_t count) const
+{
+  std::vector<FirstTransformOutputPointType> geoPoints(count);
+  internal::TransformPoints(m_FirstTransform.GetPointer(), inputPoints, geoPoints.data(), count);
+  internal::TransformPoints(m_SecondTransform.GetPointer(), geoPoints.data(), outputPoints, count);
+}
+
 /*template<class TFirstTransform, class TSecondTransform, class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
   typename CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensions, NOutputDimensions>::OutputVectorType
   CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensions, NOutputDimensions>
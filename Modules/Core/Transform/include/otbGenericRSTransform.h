@@ -159,6 +159,8 @@ public:
 
   OutputPointType TransformPoint(const InputPointType& point) const override;
 
+  void TransformPoints(const InputPointType* inputPoints, OutputPointType* outputPoints, std::size_t count) const override;
+
   virtual void InstantiateTransform();
 
   // Get inverse methods
@@ -238,6 +238,41 @@ GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>::TransformP
   return outputPoint;
 }
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(const InputPointType* inputPoints, OutputPointType* outputPoints,
+                                                                                             std::size_t count) const
+{
+  typedef typename TransformType::InputPointType  TransformInputPointType;
+  typedef typename TransformType::OutputPointType TransformOutputPointType;
+
+  // Apply input origin/spacing
+  std::vector<TransformInputPointType> points(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    for (unsigned int dim = 0; dim < NInputDimensions; ++dim)
+    {
+      points[i][dim] = inputPoints[i][dim];
+    }
+    points[i][0] = points[i][0] * m_InputSpacing[0] + m_InputOrigin[0];
+    points[i][1] = points[i][1] * m_InputSpacing[1] + m_InputOrigin[1];
+  }
+
+  // Transform points
+  std::vector<TransformOutputPointType> transformedPoints(count);
+  this->GetTransform()->TransformPoints(points.data(), transformedPoints.data(), count);
+
+  // Apply output origin/spacing
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    for (unsigned int dim = 0; dim < NOutputDimensions; ++dim)
+    {
+      outputPoints[i][dim] = transformedPoints[i][dim];
+    }
+    outputPoints[i][0] = (outputPoints[i][0] - m_OutputOrigin[0]) / m_OutputSpacing[0];
+    outputPoints[i][1] = (outputPoints[i][1] - m_OutputOrigin[1]) / m_OutputSpacing[1];
+  }
+}
+
 template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
 bool GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>::GetInverse(Self* inverseTransform) const
 {
@@ -47,6 +47,10 @@ namespace otb
  * ForceSizeTo(size). The spacing is then computed to get all the
  * pixels of the image in the output image.
  *
+ * When PreloadDEM is on, Compute() also preloads the heights of the
+ * image footprint in the DEMHandler (see DEMHandler::PreloadArea()), so
+ * that the projection of the image does not access the DEM files.
+ *
  * \sa GenericRSTransform
  * \ingroup Projection
  *
@@ -112,6 +116,11 @@ public:
   itkGetMacro(EstimateIsotropicSpacing, bool);
   itkBooleanMacro(EstimateIsotropicSpacing);
 
+  /** Preload the DEM over the image footprint flag */
+  itkSetMacro(PreloadDEM, bool);
+  itkGetMacro(PreloadDEM, bool);
+  itkBooleanMacro(PreloadDEM);
+
   /**
    * Method to Force the use of the spacing selected by the user
    * The output size is computed using this spacing
@@ -180,6 +189,7 @@ private:
   void EstimateOutputSpacing();
   void EstimateOutputSize();
   void EstimateOutputOrigin();
+  void PreloadDEMArea();
 
   typename ImageType::ConstPointer m_Input;
   PointType                        m_OutputOrigin{0.0};
@@ -192,6 +202,7 @@ private:
   bool m_ForceSpacing;
   bool m_ForceSize;
   bool m_EstimateIsotropicSpacing;
+  bool m_PreloadDEM;
 
 }; // end of class ImageToGenericRSOutputParameters
 
@@ -25,6 +25,11 @@
 #include "otbImageToGenericRSOutputParameters.h"
 #include "itkMacro.h"
 #include "itkContinuousIndex.h"
+#include "otbDEMHandler.h"
+#include "otbSpatialReference.h"
+#include "otbMacro.h"
+#include <algorithm>
+#include <cmath>
 
 namespace otb
 {
@@ -36,6 +41,7 @@ ImageToGenericRSOutputParameters<TImage>::ImageToGenericRSOutputParameters()
   m_ForceSpacing             = false;
   m_ForceSize                = false;
   m_EstimateIsotropicSpacing = false;
+  m_PreloadDEM               = false;
 }
 
 /**
@@ -58,6 +64,10 @@ void ImageToGenericRSOutputParameters<TImage>::Compute()
   // Estimate the Output image Extent
   this->EstimateOutputImageExtent();
 
+  // Preload the DEM over the image footprint
+  if (m_PreloadDEM)
+    this->PreloadDEMArea();
+
   // Estimate the Output Spacing
   if (!m_ForceSpacing)
     this->EstimateOutputSpacing();
@@ -152,6 +162,64 @@ void ImageToGenericRSOutputParameters<TImage>::EstimateOutputImageExtent()
 }
 
 
+/**
+ * The footprint of the image is sampled along its edges, and the
+ * WGS84 envelope of these points, enlarged by a margin, is preloaded in
+ * the DEMHandler.
+ */
+template <class TImage>
+void ImageToGenericRSOutputParameters<TImage>::PreloadDEMArea()
+{
+  // Local generic RS Transform to project the image edges to WGS84
+  GenericRSTransformPointerType transform = GenericRSTransformType::New();
+  transform->SetInputImageMetadata(&(m_Input->GetImageMetadata()));
+  transform->SetInputProjectionRef(m_Input->GetProjectionRef());
+  transform->SetOutputProjectionRef(otb::SpatialReference::FromWGS84().ToWkt());
+  transform->InstantiateTransform();
+
+  itk::ContinuousIndex<double, 2> first(m_Input->GetLargestPossibleRegion().GetIndex());
+  first[0] += -0.5;
+  first[1] += -0.5;
+  SizeType size = m_Input->GetLargestPossibleRegion().GetSize();
+
+  // Sensor footprints are not straight: sample each edge
+  const unsigned int nbSamplesPerEdge = 16;
+  double             lonMin = itk::NumericTraits<double>::max(), lonMax = itk::NumericTraits<double>::NonpositiveMin();
+  double             latMin = lonMin, latMax = lonMax;
+  for (unsigned int i = 0; i <= nbSamplesPerEdge; ++i)
+  {
+    const double t = static_cast<double>(i) / nbSamplesPerEdge;
+    const double edgePoints[4][2] = {{t * size[0], 0.}, {t * size[0], 1. * size[1]}, {0., t * size[1]}, {1. * size[0], t * size[1]}};
+    for (const auto& edgePoint : edgePoints)
+    {
+      itk::ContinuousIndex<double, 2> index(first);
+      index[0] += edgePoint[0];
+      index[1] += edgePoint[1];
+
+      PointType physicalPoint;
+      m_Input->TransformContinuousIndexToPhysicalPoint(index, physicalPoint);
+      const PointType geoPoint = transform->TransformPoint(physicalPoint);
+      if (std::isnan(geoPoint[0]) || std::isnan(geoPoint[1]))
+        continue;
+      lonMin = std::min(lonMin, geoPoint[0]);
+      lonMax = std::max(lonMax, geoPoint[0]);
+      latMin = std::min(latMin, geoPoint[1]);
+      latMax = std::max(latMax, geoPoint[1]);
+    }
+  }
+
+  if (lonMin > lonMax || latMin > latMax)
+  {
+    otbLogMacro(Warning, << "Unable to compute the footprint of the image: the DEM is not preloaded");
+    return;
+  }
+
+  // Margin for the localization errors of the footprint
+  const double marginLon = 0.05 * (lonMax - lonMin) + 0.001;
+  const double marginLat = 0.05 * (latMax - latMin) + 0.001;
+  DEMHandler::GetInstance().PreloadArea(lonMin - marginLon, latMin - marginLat, lonMax + marginLon, latMax + marginLat);
+}
+
 /**
  * Method used to estimate the Origin using the extent of the image
  *
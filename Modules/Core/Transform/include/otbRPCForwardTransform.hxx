@@ -51,6 +51,13 @@ RPCForwardTransform<TScalarType, NInputDimensions, NOutputDimensions>::Transform
   return pOut;
 }
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void RPCForwardTransform<TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(const InputPointType* inputPoints, OutputPointType* outputPoints,
+                                                                                     std::size_t count) const
+{
+  this->TransformPointsWithRPC(inputPoints, outputPoints, count, false);
+}
+
 /**
  * PrintSelf method
  */
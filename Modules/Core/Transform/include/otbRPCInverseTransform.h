@@ -62,6 +62,9 @@ public:
   /**  Method to transform a point. */
   OutputPointType TransformPoint(const InputPointType& point) const override;
 
+  /**  Method to transform count points in one call to the RPC transformer. */
+  void TransformPoints(const InputPointType* inputPoints, OutputPointType* outputPoints, std::size_t count) const override;
+
   RPCInverseTransform();
   ~RPCInverseTransform() = default;
 
@@ -53,6 +53,13 @@ RPCInverseTransform<TScalarType, NInputDimensions, NOutputDimensions>::Transform
   return pOut;
 }
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void RPCInverseTransform<TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(const InputPointType* inputPoints, OutputPointType* outputPoints,
+                                                                                     std::size_t count) const
+{
+  this->TransformPointsWithRPC(inputPoints, outputPoints, count, true);
+}
+
 /**
  * PrintSelf method
  */
@@ -81,6 +81,10 @@ protected:
   ~RPCTransformBase() = default;
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
+  /** Transform count points with the RPC model, from image to ground if
+   * inverse is false, from ground to image otherwise */
+  void TransformPointsWithRPC(const InputPointType* inputPoints, OutputPointType* outputPoints, std::size_t count, bool inverse) const;
+
   std::unique_ptr<Projection::RPCParam> m_RPCParam;
   std::unique_ptr<GDALRPCTransformer> m_Transformer;
 
@@ -24,6 +24,10 @@
 #include "otbRPCTransformBase.h"
 #include "otbRPCSolver.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
 namespace otb
 {
 
@@ -55,6 +59,47 @@ bool RPCTransformBase<TScalarType, NInputDimensions, NOutputDimensions>::IsValid
   return m_Transformer != nullptr;
 }
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void RPCTransformBase<TScalarType, NInputDimensions, NOutputDimensions>::TransformPointsWithRPC(const InputPointType* inputPoints, OutputPointType* outputPoints,
+                                                                                                 std::size_t count, bool inverse) const
+{
+  // GDAL transforms whole arrays of coordinates, and the transformer is
+  // locked once per chunk instead of once per point
+  const std::size_t   chunkSize = std::min<std::size_t>(count, 4096);
+  std::vector<double> x(chunkSize), y(chunkSize), z(chunkSize);
+  for (std::size_t first = 0; first < count; first += chunkSize)
+  {
+    const std::size_t nbPoints = std::min(chunkSize, count - first);
+    for (std::size_t i = 0; i < nbPoints; ++i)
+    {
+      x[i] = static_cast<double>(inputPoints[first + i][0]);
+      y[i] = static_cast<double>(inputPoints[first + i][1]);
+      if (NInputDimensions > 2)
+        z[i] = static_cast<double>(inputPoints[first + i][2]);
+      else
+        z[i] = 0.;
+    }
+
+    if (inverse)
+    {
+      if (!this->m_Transformer->InverseTransform(x.data(), y.data(), z.data(), static_cast<int>(nbPoints)))
+        throw std::runtime_error("GDALRPCTransform was not able to process the InverseTransform.");
+    }
+    else if (!this->m_Transformer->ForwardTransform(x.data(), y.data(), z.data(), static_cast<int>(nbPoints)))
+    {
+      throw std::runtime_error("GDALRPCTransform was not able to process the ForwardTransform.");
+    }
+
+    for (std::size_t i = 0; i < nbPoints; ++i)
+    {
+      outputPoints[first + i][0] = static_cast<TScalarType>(x[i]);
+      outputPoints[first + i][1] = static_cast<TScalarType>(y[i]);
+      if (NOutputDimensions > 2)
+        outputPoints[first + i][2] = static_cast<TScalarType>(z[i]);
+    }
+  }
+}
+
 /**
  * PrintSelf method
  */
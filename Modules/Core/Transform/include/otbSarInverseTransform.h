@@ -62,6 +62,9 @@ public:
   /**  Method to transform a point. */
   OutputPointType TransformPoint(const InputPointType& point) const override;
 
+  /**  Method to transform count points, querying the DEM heights of all of them at once. */
+  void TransformPoints(const InputPointType* inputPoints, OutputPointType* outputPoints, std::size_t count) const override;
+
   SarInverseTransform();
   ~SarInverseTransform() = default;
 
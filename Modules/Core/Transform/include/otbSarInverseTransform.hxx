@@ -24,6 +24,8 @@
 #include "otbSarInverseTransform.h"
 #include "otbDEMHandler.h"
 
+#include <vector>
+
 namespace otb
 {
 template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
@@ -57,6 +59,49 @@ SarInverseTransform<TScalarType, NInputDimensions, NOutputDimensions>::Transform
   return pOut;
 }
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void SarInverseTransform<TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(const InputPointType* inputPoints, OutputPointType* outputPoints,
+                                                                                             std::size_t count) const
+{
+  std::vector<double> heights(count);
+  if (NInputDimensions > 2)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+      heights[i] = static_cast<double>(inputPoints[i][2]);
+  }
+  else
+  {
+    std::vector<double> lon(count), lat(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      lon[i] = static_cast<double>(inputPoints[i][0]);
+      lat[i] = static_cast<double>(inputPoints[i][1]);
+    }
+    otb::DEMHandler::GetInstance().GetHeightAboveEllipsoid(count, lon.data(), lat.data(), heights.data());
+  }
+
+  // Neighbouring points have close zero doppler times
+  SarSensorModel::ZeroDopplerLocator locator(*this->m_Transformer);
+
+  SarSensorModel::Point2DType sensorPoint;
+  SarSensorModel::Point3DType worldPoint;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    worldPoint[0] = static_cast<double>(inputPoints[i][0]);
+    worldPoint[1] = static_cast<double>(inputPoints[i][1]);
+    worldPoint[2] = heights[i];
+
+    locator.WorldToLineSample(worldPoint, sensorPoint);
+
+    // from centered to upper left corner pixel convention
+    outputPoints[i][0] = static_cast<TScalarType>(sensorPoint[0]) + 0.5;
+    outputPoints[i][1] = static_cast<TScalarType>(sensorPoint[1]) + 0.5;
+
+    if (NOutputDimensions > 2)
+      outputPoints[i][2] = static_cast<TScalarType>(worldPoint[2]);
+  }
+}
+
 /**
  * PrintSelf method
  */
@@ -251,6 +251,40 @@ public:
    */
   ZeroDopplerInfo ZeroDopplerLookup(Point3DType const& inEcefPoint) const;
 
+  /**
+   * Zero doppler search for sequences of neighbouring ground points.
+   *
+   * The locator remembers the OrbitStateVector samples around the zero
+   * doppler of the last point, and starts the search of the next point
+   * from them instead of scanning the orbit from its first sample. As long
+   * as the doppler of a ground point changes sign only once along the
+   * orbit, results are identical to those of the `SarSensorModel`
+   * functions.
+   *
+   * A locator is cheap to build and keeps a state: use one per thread, or
+   * per batch of points.
+   */
+  class ZeroDopplerLocator
+  {
+  public:
+    explicit ZeroDopplerLocator(SarSensorModel const& model) : m_Model(model)
+    {
+    }
+
+    /** Warm started `SarSensorModel::ZeroDopplerLookup()` */
+    ZeroDopplerInfo ZeroDopplerLookup(Point3DType const& inEcefPoint);
+
+    /** Warm started `SarSensorModel::WorldToLineSample()` */
+    void WorldToLineSample(const Point3DType& inGeoPoint, Point2DType& outLineSample);
+
+  private:
+    SarSensorModel const& m_Model;
+
+    /** Index of the first of the two samples around the last zero doppler,
+     * negative when there is none */
+    std::ptrdiff_t m_Record1 = -1;
+  };
+
 
   /*-------------------------------[ Burst related functions ]-----------------*/
   /** Deburst metadata if possible and return lines to keep in image file */
@@ -384,6 +418,21 @@ private:
       OrbitIterator itrecord1) const;
 
    /**
+   * Azimuth time of the zero doppler between `record1` and the next
+   * OrbitStateVector sample, from the dopplers of these samples.
+   */
+  TimeType InterpolateZeroDopplerTime(OrbitIterator record1, double doppler1, double doppler2) const;
+
+  /**
+   * Zero doppler information at `azimuthTime`, between the
+   * OrbitStateVector samples `record1` and `record2`.
+   */
+  ZeroDopplerInfo ZeroDopplerInfoAt(TimeType azimuthTime, OrbitIterator record1, OrbitIterator record2) const;
+
+  /** Convert azimuth and range times to input image point (col,row) */
+  void AzimuthRangeTimeToLineSample(const TimeType& azimuthTime, double rangeTime, Point2DType& outLineSample) const;
+
+  /**
     * Convert azimuth time to fractional line.
     *
     * \param[in] azimuthTime The azimuth time to convert
@@ -23,6 +23,7 @@
 
 #include "itkWarpImageFilter.h"
 #include "otbStreamingTraits.h"
+#include "otbSeparableRowInterpolator.h"
 
 namespace otb
 {
@@ -40,6 +41,9 @@ namespace otb
  * If the maximum displacement is wrong, this filter is likely to request data outside of the input image buffered region. In this case, pixels
  * outside the region will be set to Zero according to itk::NumericTraits.
  *
+ * Interpolators implementing SeparableRowInterpolator (BCO, windowed sinc)
+ * interpolate the positions of each output line in a single call.
+ *
  * \sa itk::WarpImageFilter
  *
  * \ingroup Streamed
@@ -79,6 +83,9 @@ public:
   typedef typename DisplacementFieldType::Pointer    DisplacementFieldPointerType;
   typedef typename DisplacementFieldType::RegionType DisplacementFieldRegionType;
 
+  /** Interpolators evaluating a line of positions at once */
+  typedef SeparableRowInterpolator<typename Superclass::CoordRepType> RowInterpolatorType;
+
   /** Accessors */
   itkSetMacro(MaximumDisplacement, DisplacementValueType);
   itkGetConstReferenceMacro(MaximumDisplacement, DisplacementValueType);
@@ -113,6 +120,9 @@ protected:
    */
   void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
+  /** Warp the region line by line with a SeparableRowInterpolator */
+  void WarpRows(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId, const RowInterpolatorType& rowInterpolator);
+
 private:
   StreamingWarpImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
@@ -24,11 +24,15 @@
 
 #include "otbStreamingWarpImageFilter.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageScanlineIterator.h"
+#include "itkProgressReporter.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkMetaDataObject.h"
 #include "otbMetaDataKey.h"
 #include "otbNoDataHelper.h"
 
+#include <vector>
+
 namespace otb
 {
 
@@ -287,8 +291,17 @@ template <class TInputImage, class TOutputImage, class TDisplacementField>
 void StreamingWarpImageFilter<TInputImage, TOutputImage, TDisplacementField>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
                                                                                                    itk::ThreadIdType threadId)
 {
-  // the superclass itk::WarpImageFilter is doing the actual warping
-  Superclass::ThreadedGenerateData(outputRegionForThread, threadId);
+  // the superclass itk::WarpImageFilter is doing the actual warping,
+  // unless the interpolator can evaluate whole lines
+  const RowInterpolatorType* rowInterpolator = dynamic_cast<const RowInterpolatorType*>(this->GetInterpolator());
+  if (rowInterpolator != nullptr && rowInterpolator->CanEvaluateRows())
+  {
+    this->WarpRows(outputRegionForThread, threadId, *rowInterpolator);
+  }
+  else
+  {
+    Superclass::ThreadedGenerateData(outputRegionForThread, threadId);
+  }
 
   // second pass on the thread region to mask pixels outside the displacement grid
   const PixelType        paddingValue = this->GetEdgePaddingValue();
@@ -328,6 +341,87 @@ void StreamingWarpImageFilter<TInputImage, TOutputImage, TDisplacementField>::Th
   }
 }
 
+template <class TInputImage, class TOutputImage, class TDisplacementField>
+void StreamingWarpImageFilter<TInputImage, TOutputImage, TDisplacementField>::WarpRows(const OutputImageRegionType& outputRegionForThread,
+                                                                                       itk::ThreadIdType threadId, const RowInterpolatorType& rowInterpolator)
+{
+  typedef itk::DefaultConvertPixelTraits<PixelType>         PixelConvertType;
+  typedef typename PixelConvertType::ComponentType          PixelComponentType;
+  typedef typename RowInterpolatorType::ContinuousIndexType RowContinuousIndexType;
+
+  const InputImageType* inputPtr     = this->GetInput();
+  OutputImageType*      outputPtr    = this->GetOutput();
+  const PixelType       paddingValue = this->GetEdgePaddingValue();
+  const auto*           interpolator = this->GetInterpolator();
+
+  const unsigned int nComponents = inputPtr->GetNumberOfComponentsPerPixel();
+  const unsigned int lineSize    = outputRegionForThread.GetSize()[0];
+
+  // Positions of the line inside the input buffer, and their values
+  std::vector<RowContinuousIndexType> indices(lineSize);
+  std::vector<bool>                   inside(lineSize);
+  std::vector<double>                 values(lineSize * nComponents);
+
+  PixelType outputValue;
+  itk::NumericTraits<PixelType>::SetLength(outputValue, nComponents);
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetSize()[1]);
+
+  itk::ImageScanlineIterator<OutputImageType>                  outIt(outputPtr, outputRegionForThread);
+  IndexType                                                    index;
+  PointType                                                    point;
+  DisplacementValueType                                        displacement;
+  itk::ContinuousIndex<double, InputImageType::ImageDimension> inputIndex;
+
+  while (!outIt.IsAtEnd())
+  {
+    // Same mapping as itk::WarpImageFilter: output point + displacement
+    unsigned int nbInside = 0;
+    index                 = outIt.GetIndex();
+    for (unsigned int x = 0; x < lineSize; ++x, ++index[0])
+    {
+      outputPtr->TransformIndexToPhysicalPoint(index, point);
+      this->EvaluateDisplacementAtPhysicalPoint(point, displacement);
+      for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+      {
+        point[dim] += displacement[dim];
+      }
+      inputPtr->TransformPhysicalPointToContinuousIndex(point, inputIndex);
+
+      inside[x] = interpolator->IsInsideBuffer(inputIndex);
+      if (inside[x])
+      {
+        indices[nbInside][0] = inputIndex[0];
+        indices[nbInside][1] = inputIndex[1];
+        ++nbInside;
+      }
+    }
+
+    rowInterpolator.EvaluateAtContinuousIndices(indices.data(), nbInside, values.data());
+
+    const double* value = values.data();
+    for (unsigned int x = 0; x < lineSize; ++x, ++outIt)
+    {
+      if (inside[x])
+      {
+        for (unsigned int k = 0; k < nComponents; ++k)
+        {
+          PixelConvertType::SetNthComponent(k, outputValue, static_cast<PixelComponentType>(value[k]));
+        }
+        outIt.Set(outputValue);
+        value += nComponents;
+      }
+      else
+      {
+        outIt.Set(paddingValue);
+      }
+    }
+
+    progress.CompletedPixel();
+    outIt.NextLine();
+  }
+}
+
 template <class TInputImage, class TOutputImage, class TDisplacementField>
 void StreamingWarpImageFilter<TInputImage, TOutputImage, TDisplacementField>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
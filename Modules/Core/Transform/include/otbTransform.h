@@ -24,6 +24,8 @@
 #include "itkTransform.h"
 #include "vnl/vnl_vector_fixed.h"
 
+#include <cstddef>
+
 
 namespace otb
 {
@@ -106,6 +108,17 @@ public:
     return OutputPointType();
   }
 
+  /** Method to transform count points. Sensor models override it to
+   * process the points together; by default each point goes through
+   * TransformPoint(). */
+  virtual void TransformPoints(const InputPointType* inputPoints, OutputPointType* outputPoints, std::size_t count) const
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      outputPoints[i] = this->TransformPoint(inputPoints[i]);
+    }
+  }
+
   using Superclass::TransformVector;
   /**  Method to transform a vector. */
   OutputVectorType TransformVector(const InputVectorType&) const override
@@ -255,6 +268,29 @@ private:
   Transform(const Self&) = delete;
   void operator=(const Self&) = delete;
 };
+
+namespace internal
+{
+/** Transform count points with transform, in one batch if it is an
+ * otb::Transform, point by point otherwise */
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void TransformPoints(const itk::Transform<TScalarType, NInputDimensions, NOutputDimensions>* transform,
+                     const itk::Point<TScalarType, NInputDimensions>* inputPoints, itk::Point<TScalarType, NOutputDimensions>* outputPoints,
+                     std::size_t count)
+{
+  typedef Transform<TScalarType, NInputDimensions, NOutputDimensions> OTBTransformType;
+  if (const OTBTransformType* otbTransform = dynamic_cast<const OTBTransformType*>(transform))
+  {
+    otbTransform->TransformPoints(inputPoints, outputPoints, count);
+    return;
+  }
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    outputPoints[i] = transform->TransformPoint(inputPoints[i]);
+  }
+}
+} // end namespace internal
+
 } // end namespace otb
 
 #endif
@@ -165,6 +165,11 @@ void SarSensorModel::WorldToLineSample(const Point3DType& inGeoPoint, Point2DTyp
 
   WorldToAzimuthRangeTime(inGeoPoint, azimuthTime, rangeTime, sensorPos, sensorVel);
 
+  AzimuthRangeTimeToLineSample(azimuthTime, rangeTime, outLineSample);
+}
+
+void SarSensorModel::AzimuthRangeTimeToLineSample(const TimeType& azimuthTime, double rangeTime, Point2DType& outLineSample) const
+{
   // Convert azimuth time to line
   outLineSample[1] = AzimuthTimeToLine(azimuthTime);
 
@@ -421,21 +426,28 @@ SarSensorModel::ZeroDopplerTimeLookupInternal(Point3DType const& inEcefPoint) co
     assert(it != m_SarParam.orbits.cend());
     auto record2 = it;
     auto record1 = --it;
-    // now interpolate time and sensor position
-    const double abs_doppler1 = std::abs(doppler1);
-    const double interpDenom = abs_doppler1+std::abs(doppler2);
-    assert(interpDenom>0&&"Both doppler frequency are null in interpolation weight computation");
-    const double interp = abs_doppler1/interpDenom;
-    const DurationType delta_td = record2->time - record1->time;
-    // Compute interpolated time offset wrt record1
-    // (No need for that many computations (day-frac -> ms -> day frac))
-    const DurationType td     = delta_td * interp;
-
-    // Compute interpolated azimuth time
-    return { record1->time + td + m_AzimuthTimeOffset, record1, record2 };
+    return { InterpolateZeroDopplerTime(record1, doppler1, doppler2), record1, record2 };
   }
 }
 
+SarSensorModel::TimeType
+SarSensorModel::InterpolateZeroDopplerTime(OrbitIterator record1, double doppler1, double doppler2) const
+{
+  auto const record2 = record1 + 1;
+  // now interpolate time and sensor position
+  const double abs_doppler1 = std::abs(doppler1);
+  const double interpDenom = abs_doppler1+std::abs(doppler2);
+  assert(interpDenom>0&&"Both doppler frequency are null in interpolation weight computation");
+  const double interp = abs_doppler1/interpDenom;
+  const DurationType delta_td = record2->time - record1->time;
+  // Compute interpolated time offset wrt record1
+  // (No need for that many computations (day-frac -> ms -> day frac))
+  const DurationType td     = delta_td * interp;
+
+  // Compute interpolated azimuth time
+  return record1->time + td + m_AzimuthTimeOffset;
+}
+
 SarSensorModel::TimeType
 SarSensorModel::ZeroDopplerTimeLookup(Point3DType const& inEcefPoint) const
 {
@@ -450,6 +462,12 @@ SarSensorModel::ZeroDopplerLookup(Point3DType const& inEcefPoint) const
   std::tie(azimuthTime, itRecord1, itRecord2)
     = ZeroDopplerTimeLookupInternal(inEcefPoint);
 
+  return ZeroDopplerInfoAt(azimuthTime, itRecord1, itRecord2);
+}
+
+SarSensorModel::ZeroDopplerInfo
+SarSensorModel::ZeroDopplerInfoAt(TimeType azimuthTime, OrbitIterator itRecord1, OrbitIterator itRecord2) const
+{
   // Interpolate sensor position and velocity
   Point3DType  sensorPos;
   Vector3DType sensorVel;
@@ -465,6 +483,72 @@ SarSensorModel::ZeroDopplerLookup(Point3DType const& inEcefPoint) const
   return res;
 }
 
+SarSensorModel::ZeroDopplerInfo
+SarSensorModel::ZeroDopplerLocator::ZeroDopplerLookup(Point3DType const& inEcefPoint)
+{
+  auto const& orbits = m_Model.m_SarParam.orbits;
+  auto const  nbRecords = static_cast<std::ptrdiff_t>(orbits.size());
+
+  auto const doppler = [&](std::ptrdiff_t i)
+  { return DotProduct(inEcefPoint - orbits[i].position, orbits[i].velocity); };
+
+  if (m_Record1 >= 0 && m_Record1 + 1 < nbRecords)
+  {
+    // Start from the samples around the previous zero doppler
+    std::ptrdiff_t k = m_Record1;
+    double doppler1 = doppler(k);
+    double doppler2 = doppler(k + 1);
+
+    if ((doppler1 < 0) == (doppler2 < 0))
+    {
+      if ((doppler1 < 0) == (doppler(0) < 0))
+      {
+        // The sign changes after k
+        for (++k; k + 1 < nbRecords; ++k)
+        {
+          doppler1 = doppler2;
+          doppler2 = doppler(k + 1);
+          if ((doppler1 < 0) != (doppler2 < 0))
+            break;
+        }
+      }
+      else
+      {
+        // The sign changes before k
+        for (--k; k >= 0; --k)
+        {
+          doppler2 = doppler1;
+          doppler1 = doppler(k);
+          if ((doppler1 < 0) != (doppler2 < 0))
+            break;
+        }
+      }
+    }
+
+    if (k >= 0 && k + 1 < nbRecords)
+    {
+      m_Record1 = k;
+      auto const record1 = orbits.cbegin() + k;
+      return m_Model.ZeroDopplerInfoAt(m_Model.InterpolateZeroDopplerTime(record1, doppler1, doppler2), record1, record1 + 1);
+    }
+  }
+
+  // Full search, which also handles extrapolation
+  TimeType      azimuthTime;
+  OrbitIterator itRecord1, itRecord2;
+  std::tie(azimuthTime, itRecord1, itRecord2) = m_Model.ZeroDopplerTimeLookupInternal(inEcefPoint);
+
+  m_Record1 = itRecord2 == itRecord1 + 1 ? std::distance(orbits.cbegin(), itRecord1) : -1;
+  return m_Model.ZeroDopplerInfoAt(azimuthTime, itRecord1, itRecord2);
+}
+
+void SarSensorModel::ZeroDopplerLocator::WorldToLineSample(const Point3DType& inGeoPoint, Point2DType& outLineSample)
+{
+  auto const ecefPoint = m_Model.WorldToEcef(inGeoPoint);
+  auto const zdi       = ZeroDopplerLookup(ecefPoint);
+  m_Model.AzimuthRangeTimeToLineSample(zdi.azimuthTime, m_Model.CalculateRangeTime(ecefPoint, zdi.sensorPos), outLineSample);
+}
+
 SarSensorModel::OrbitIterator
 SarSensorModel::searchLagrangianNeighbourhood(TimeType azimuthTime) const
 {
@@ -475,28 +559,22 @@ SarSensorModel::searchLagrangianNeighbourhood(TimeType azimuthTime) const
     return m_SarParam.orbits.end();
   }
   else
-  { // TODO: use std::upper_bound
-    // Search for the deg number of records around the azimuth time
-    unsigned int t_min_idx = 0;
-    auto t_min = Abs(azimuthTime - m_SarParam.orbits.front().time);
-    unsigned int count = 0;
-
-    // Unfortunately, we cannot loop from m_FirstLineInOrbit to
-    // m_LastLineInOrbit as there is no guarantee the azimuthTime happens
-    // outside this range => we must search the whole orbit information.
-    // for(auto it = m_FirstLineInOrbit; it!= m_LastLineInOrbit; ++it,++count)
-     for(auto it = m_SarParam.orbits.cbegin();it!= m_SarParam.orbits.cend();++it,++count)
-     {
-        const auto current_time = Abs(azimuthTime-it->time);
-        if(t_min > current_time)
-        {
-        // TODO: break when the distance is growing.
-           t_min_idx = count;
-           t_min = current_time;
-        }
-     }
+  {
+    // Orbit records are sorted by time: the closest one is on either side
+    // of the first record not before the azimuth time. On ties, keep the
+    // earliest one.
+    auto const& orbits = m_SarParam.orbits;
+    auto        it     = std::lower_bound(orbits.cbegin(), orbits.cend(), azimuthTime, cmp_times);
+    if (it == orbits.cend())
+    {
+      --it;
+    }
+    else if (it != orbits.cbegin() && !(Abs(azimuthTime - (it - 1)->time) > Abs(azimuthTime - it->time)))
+    {
+      --it;
+    }
 
-    return m_SarParam.orbits.begin() + t_min_idx;
+    return orbits.begin() + std::distance(orbits.cbegin(), it);
   }
 }
 
@@ -704,6 +782,9 @@ SarSensorModel::Point3DType SarSensorModel::projToSurface(
   // Initialize current estimation
   auto currentEstimation = WorldToEcef(groundGcp);
 
+  // Successive estimations are close to each other
+  ZeroDopplerLocator locator(*this);
+
   // Corresponding image position
   Point2DType currentImPoint;
   currentImPoint[0] = gcp.m_GCPCol;
@@ -739,14 +820,14 @@ SarSensorModel::Point3DType SarSensorModel::projToSurface(
     auto currentEstimationWorld = EcefToWorld(currentEstimation);
 
     auto tmpGpt = EcefToWorld(currentEstimation + dx);
-    WorldToLineSample(tmpGpt, tmpImPt);
+    locator.WorldToLineSample(tmpGpt, tmpImPt);
 
     p_fx[0] = (currentImPoint[0] - tmpImPt[0])/d;
     p_fy[0] = (currentImPoint[1] - tmpImPt[1])/d;
     p_fh[0] = (currentEstimationWorld[2] - tmpGpt[2])/d;
 
     tmpGpt = EcefToWorld(currentEstimation + dy);
-    WorldToLineSample(tmpGpt,tmpImPt);
+    locator.WorldToLineSample(tmpGpt,tmpImPt);
 
 
     p_fx[1] = (currentImPoint[0] - tmpImPt[0])/d;
@@ -754,7 +835,7 @@ SarSensorModel::Point3DType SarSensorModel::projToSurface(
     p_fh[1] = (currentEstimationWorld[2] - tmpGpt[2])/d;
 
     tmpGpt = EcefToWorld(currentEstimation + dz);
-    WorldToLineSample(tmpGpt,tmpImPt);
+    locator.WorldToLineSample(tmpGpt,tmpImPt);
     p_fx[2] = (currentImPoint[0] - tmpImPt[0])/d;
     p_fy[2] = (currentImPoint[1] - tmpImPt[1])/d;
     p_fh[2] = (currentEstimationWorld[2] - tmpGpt[2])/d;
@@ -792,7 +873,7 @@ SarSensorModel::Point3DType SarSensorModel::projToSurface(
     const double atHgt = heightFunction(currentEstimationWorld[0], currentEstimationWorld[1]);
     currentHeightResidual = atHgt - currentEstimationWorld[2];
 
-    WorldToLineSample(currentEstimationWorld, currentImPoint);
+    locator.WorldToLineSample(currentEstimationWorld, currentImPoint);
 
     if (currentImSquareResidual <= imgResidual && currentHeightResidual <= heightResidual)
     {
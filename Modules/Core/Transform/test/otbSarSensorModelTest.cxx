@@ -95,6 +95,9 @@ BOOST_AUTO_TEST_CASE(SARSensorModel_auto_validate_inverse_transform )
 
   otb::SarSensorModel model(imd);
 
+  // The warm started locator must give the same result as the full search
+  otb::SarSensorModel::ZeroDopplerLocator locator(model);
+
   for (const auto & gcp : imd.GetGCPParam().GCPs)
   {
     itk::Point<double, 3> geoPoint;
@@ -112,6 +115,12 @@ BOOST_AUTO_TEST_CASE(SARSensorModel_auto_validate_inverse_transform )
 
     BOOST_TEST(std::abs(lineSample[0] - lineSampleBaseline[0]) < lineTol);
     BOOST_TEST(std::abs(lineSample[1] - lineSampleBaseline[1]) < sampleTol);
+
+    itk::Point<double, 2> lineSampleLocator;
+    locator.WorldToLineSample(geoPoint, lineSampleLocator);
+
+    BOOST_TEST(std::abs(lineSampleLocator[0] - lineSample[0]) < 1e-6);
+    BOOST_TEST(std::abs(lineSampleLocator[1] - lineSample[1]) < 1e-6);
   }
 }
 
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "itkTimeProbe.h"
+#include "otbGeomMetadataSupplier.h"
+#include "otbImageMetadataInterfaceFactory.h"
+#include "otbRPCForwardTransform.h"
+#include "otbRPCInverseTransform.h"
+
+namespace
+{
+// Transform the points one by one and in one batch, compare the results
+// and report both timings
+template <class TTransform>
+bool CompareBatch(const TTransform* transform, const std::vector<typename TTransform::InputPointType>& points,
+                  std::vector<typename TTransform::OutputPointType>& batchPoints, double tolerance, const char* name)
+{
+  std::vector<typename TTransform::OutputPointType> scalarPoints(points.size());
+  batchPoints.resize(points.size());
+
+  itk::TimeProbe scalarProbe;
+  scalarProbe.Start();
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    scalarPoints[i] = transform->TransformPoint(points[i]);
+  }
+  scalarProbe.Stop();
+
+  itk::TimeProbe batchProbe;
+  batchProbe.Start();
+  transform->TransformPoints(points.data(), batchPoints.data(), points.size());
+  batchProbe.Stop();
+
+  std::cout << name << ": " << points.size() << " points, TransformPoint " << scalarProbe.GetTotal() << " s, TransformPoints " << batchProbe.GetTotal()
+            << " s" << std::endl;
+
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    if (scalarPoints[i].EuclideanDistanceTo(batchPoints[i]) > tolerance)
+    {
+      std::cerr << name << ": " << points[i] << " transformed to " << batchPoints[i] << " instead of " << scalarPoints[i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // end anonymous namespace
+
+int otbSensorTransformBatchTest(int argc, char* argv[])
+{
+  if (argc != 5)
+  {
+    std::cerr << "Usage: " << argv[0] << " <geom file> <points per side> <ground tolerance> <image tolerance>" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  using ForwardTransformType = otb::RPCForwardTransform<double, 2, 2>;
+  using InverseTransformType = otb::RPCInverseTransform<double, 2, 2>;
+
+  const std::string  geomFile(argv[1]);
+  const unsigned int nbPointsPerSide = std::stoi(argv[2]);
+  const double       geoTol          = std::stod(argv[3]);
+  const double       imgTol          = std::stod(argv[4]);
+
+  otb::ImageMetadata        imd;
+  otb::GeomMetadataSupplier geomSupplier(geomFile);
+  for (int loop = 0; loop < geomSupplier.GetNbBands(); ++loop)
+    imd.Bands.emplace_back();
+  otb::ImageMetadataInterfaceFactory::CreateIMI(imd, geomSupplier);
+  geomSupplier.FetchRPC(imd);
+
+  auto forwardTransform = ForwardTransformType::New();
+  auto inverseTransform = InverseTransformType::New();
+  if (!forwardTransform->SetMetadata(imd) || !inverseTransform->SetMetadata(imd))
+  {
+    std::cerr << "No RPC model in " << geomFile << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Regular grid over the image
+  const auto& rpc = boost::any_cast<const otb::Projection::RPCParam&>(imd[otb::MDGeom::RPC]);
+  std::vector<ForwardTransformType::InputPointType> imagePoints;
+  for (unsigned int j = 0; j < nbPointsPerSide; ++j)
+  {
+    for (unsigned int i = 0; i < nbPointsPerSide; ++i)
+    {
+      ForwardTransformType::InputPointType point;
+      point[0] = rpc.SampleOffset + rpc.SampleScale * (2. * i / (nbPointsPerSide - 1) - 1.);
+      point[1] = rpc.LineOffset + rpc.LineScale * (2. * j / (nbPointsPerSide - 1) - 1.);
+      imagePoints.push_back(point);
+    }
+  }
+
+  std::vector<ForwardTransformType::OutputPointType> groundPoints;
+  std::vector<InverseTransformType::OutputPointType> backPoints;
+  const bool success = CompareBatch(forwardTransform.GetPointer(), imagePoints, groundPoints, geoTol, "RPCForwardTransform") &&
+                       CompareBatch(inverseTransform.GetPointer(), groundPoints, backPoints, imgTol, "RPCInverseTransform");
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
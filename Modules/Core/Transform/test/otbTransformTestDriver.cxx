@@ -36,5 +36,6 @@ void RegisterTests()
   REGISTER_TEST(otbSarTransformTest);
   REGISTER_TEST(otbRPCSolverTest);
   REGISTER_TEST(otbLeastSquareAffineTransformEstimator);
+  REGISTER_TEST(otbSensorTransformBatchTest);
   // REGISTER_TEST(otbSpot5TransformTest);
 }
@@ -524,6 +524,8 @@ private:
     else
     {
       VectorStatsFilterType::Pointer statFilter(VectorStatsFilterType::New());
+      statFilter->SetEnableFirstOrderStats(false);
+      statFilter->SetEnableSecondOrderStats(false);
       statFilter->SetIgnoreInfiniteValues(true);
       if (IsParameterEnabled("nodata"))
       {
@@ -29,6 +29,7 @@
 
 #include "otbStreamingStatisticsVectorImageFilter.h"
 #include "otbParserX.h"
+#include "otbBandMathXProgram.h"
 
 #include <vector>
 #include <string>
@@ -53,6 +54,12 @@ namespace otb
  * If the jth input image is multidimensional, then the variable imj represents a vector whose components are related to its bands.
  * In order to access the kth band, the variable observes the following pattern : imjbk.
  *
+ * The expressions giving a scalar from band values, pixel indices and
+ * constants with the usual operators and functions are compiled to a
+ * BandMathXProgram and evaluated on whole lines. The other ones
+ * (vectors, matrices, neighborhoods, OTB specific functions) are evaluated
+ * pixel by pixel by muParserX.
+ *
  * \sa Parser
  *
  * \ingroup Streamed
@@ -136,6 +143,19 @@ public:
     return !m_StatsVarDetected.empty();
   }
 
+  /** Evaluate the expressions supported by BandMathXProgram with a compiled
+   * program instead of muParserX (default is true) */
+  itkSetMacro(CompileExpressions, bool);
+  itkGetConstMacro(CompileExpressions, bool);
+  itkBooleanMacro(CompileExpressions);
+
+  /** Return true if the nth expression is evaluated by a compiled program.
+   * Only valid after UpdateOutputInformation(). */
+  bool IsExpressionCompiled(unsigned int IDExpression) const
+  {
+    return IDExpression < m_Programs.size() && m_Programs[IDExpression].IsCompiled();
+  }
+
 protected:
   BandMathXImageFilter();
   ~BandMathXImageFilter() override;
@@ -166,6 +186,10 @@ private:
   void PrepareParsers();
   void PrepareParsersGlobStats();
   void OutputsDimensions();
+  void CompileExpressions();
+  /** Evaluate the compiled expressions, reporting progressWeight of the
+   *  progress of the thread */
+  void CompiledThreadedGenerateData(const ImageRegionType& outputRegionForThread, itk::ThreadIdType threadId, float progressWeight);
 
   std::vector<std::string>                      m_Expression;
   std::vector<std::vector<ParserType::Pointer>> m_VParser;
@@ -190,6 +214,11 @@ private:
   itk::Array<long> m_ThreadOverflow;
 
   bool m_ManyExpressions;
+
+  bool                          m_CompileExpressions;
+  std::vector<BandMathXProgram> m_Programs;         // one per expression, not compiled if evaluated by muParserX
+  std::vector<unsigned int>     m_ProgramVariables; // index in m_VVarName of each variable of the programs
+  unsigned int                  m_NumberOfCompiledExpressions;
 };
 
 } // end namespace otb
@@ -32,7 +32,9 @@
 #include "itkNumericTraits.h"
 #include "itkProgressReporter.h"
 #include "otbMacro.h"
+#include "otbMath.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -68,6 +70,9 @@ BandMathXImageFilter<TImage>::BandMathXImageFilter()
   m_SizeNeighbourhood = 10;
 
   m_ManyExpressions = true;
+
+  m_CompileExpressions          = true;
+  m_NumberOfCompiledExpressions = 0;
 }
 
 /** Destructor */
@@ -87,6 +92,8 @@ BandMathXImageFilter<TImage>::~BandMathXImageFilter()
   m_VFinalAllowedVarName.clear();
   m_VNotAllowedVarName.clear();
   m_outputsDimensions.clear();
+  m_Programs.clear();
+  m_ProgramVariables.clear();
 }
 
 
@@ -101,6 +108,8 @@ void BandMathXImageFilter<TImage>::PrintSelf(std::ostream& os, itk::Indent inden
   os << indent << "Computed values follow:" << std::endl;
   os << indent << "UnderflowCount: " << m_UnderflowCount << std::endl;
   os << indent << "OverflowCount: " << m_OverflowCount << std::endl;
+  os << indent << "CompileExpressions: " << m_CompileExpressions << std::endl;
+  os << indent << "Compiled expressions: " << m_NumberOfCompiledExpressions << std::endl;
   os << indent << "itk::NumericTraits<typename PixelValueType>::NonpositiveMin()  :  " << itk::NumericTraits<PixelValueType>::NonpositiveMin() << std::endl;
   os << indent << "itk::NumericTraits<typename PixelValueType>::max()  :             " << itk::NumericTraits<PixelValueType>::max() << std::endl;
 }
@@ -856,6 +865,63 @@ void BandMathXImageFilter<TImage>::OutputsDimensions()
   }
 }
 
+template <typename TImage>
+void BandMathXImageFilter<TImage>::CompileExpressions()
+{
+  m_Programs.assign(m_Expression.size(), BandMathXProgram());
+  m_ProgramVariables.clear();
+  m_NumberOfCompiledExpressions = 0;
+
+  if (!m_CompileExpressions)
+    return;
+
+  // Indices and pixel values change at each pixel, the other scalar variables
+  // are constant over the image. Vectors, neighborhoods and matrices are left
+  // to muParserX.
+  std::vector<std::string>          variables;
+  BandMathXProgram::ConstantMapType constants;
+
+  // Constants of muParserX (pi, e) and the ones defined by ParserX
+  constants["pi"]     = CONST_PI;
+  constants["e"]      = CONST_E;
+  constants["log2e"]  = CONST_LOG2E;
+  constants["log10e"] = CONST_LOG10E;
+  constants["ln2"]    = CONST_LN2;
+  constants["ln10"]   = CONST_LN10;
+  constants["euler"]  = CONST_EULER;
+
+  for (unsigned int j = 0; j < m_VVarName.size(); ++j)
+  {
+    const adhocStruct& var = m_AImage[0][j];
+    switch (var.type)
+    {
+    case 0: // idxX
+    case 1: // idxY
+    case 5: // pixel
+      variables.push_back(var.name);
+      m_ProgramVariables.push_back(j);
+      break;
+
+    case 2: // imiPhyX
+    case 3: // imiPhyY
+    case 7: // user defined variables
+    case 8: // global stats
+      if ((var.value.GetType() == 'i') || (var.value.GetType() == 'f'))
+        constants[var.name] = var.value.GetFloat();
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  for (unsigned int IDExpression = 0; IDExpression < m_Expression.size(); ++IDExpression)
+    if ((m_outputsDimensions[IDExpression] == 1) && m_Programs[IDExpression].Compile(m_Expression[IDExpression], variables, constants))
+      m_NumberOfCompiledExpressions++;
+
+  otbDebugMacro(<< m_NumberOfCompiledExpressions << " of " << m_Expression.size() << " expressions compiled");
+}
+
 template <typename TImage>
 void BandMathXImageFilter<TImage>::CheckImageDimensions(void)
 {
@@ -888,6 +954,7 @@ void BandMathXImageFilter<TImage>::GenerateOutputInformation(void)
   if (GlobalStatsDetected())
     PrepareParsersGlobStats();
   OutputsDimensions();
+  CompileExpressions();
 
 
   typedef itk::ImageBase<TImage::ImageDimension> ImageBaseType;
@@ -1007,6 +1074,14 @@ template <typename TImage>
 void BandMathXImageFilter<TImage>::ThreadedGenerateData(const ImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
 {
 
+  // Compiled expressions are evaluated on whole lines, before the others.
+  // Each pass reports its share of the expressions in the progress
+  const float compiledWeight = static_cast<float>(m_NumberOfCompiledExpressions) / m_Expression.size();
+  if (m_NumberOfCompiledExpressions > 0)
+    CompiledThreadedGenerateData(outputRegionForThread, threadId, compiledWeight);
+  if (m_NumberOfCompiledExpressions == m_Expression.size())
+    return;
+
   ValueType    value;
   unsigned int nbInputImages = this->GetNumberOfInputs();
 
@@ -1044,8 +1119,8 @@ void BandMathXImageFilter<TImage>::ThreadedGenerateData(const ImageRegionType& o
   // Index only iterator
   IndexIteratorType indexIterator(this->GetNthInput(0), outputRegionForThread);
 
-  // Support progress methods/callbacks
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+  // Support progress methods/callbacks, after the compiled expressions
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels(), 100, compiledWeight, 1.0f - compiledWeight);
 
   // iterator on variables
   typename std::vector<adhocStruct>::iterator iterVarStart = m_AImage[threadId].begin();
@@ -1152,6 +1227,9 @@ void BandMathXImageFilter<TImage>::ThreadedGenerateData(const ImageRegionType& o
       //----------------- ----------- -----------------//
       for (unsigned int IDExpression = 0; IDExpression < m_Expression.size(); ++IDExpression)
       {
+        if (m_Programs[IDExpression].IsCompiled())
+          continue;
+
         value = m_VParser[threadId][IDExpression]->EvalRef();
 
         switch (value.GetType())
@@ -1229,6 +1307,120 @@ void BandMathXImageFilter<TImage>::ThreadedGenerateData(const ImageRegionType& o
   }
 }
 
+template <typename TImage>
+void BandMathXImageFilter<TImage>::CompiledThreadedGenerateData(const ImageRegionType& outputRegionForThread, itk::ThreadIdType threadId, float progressWeight)
+{
+  typedef itk::ImageScanlineConstIterator<TImage> ImageScanlineConstIteratorType;
+  typedef itk::ImageScanlineIterator<TImage>      ImageScanlineIteratorType;
+
+  unsigned int      nbInputImages = this->GetNumberOfInputs();
+  unsigned int      nbVar         = m_ProgramVariables.size();
+  const std::size_t lineLength    = outputRegionForThread.GetSize(0);
+
+  // Values of the variables along the current line
+  std::vector<std::vector<double>> variables(nbVar, std::vector<double>(lineLength));
+  std::vector<const double*>       variablePointers(nbVar);
+  for (unsigned int v = 0; v < nbVar; ++v)
+    variablePointers[v] = variables[v].data();
+
+  std::vector<double>             result(lineLength);
+  BandMathXProgram::WorkspaceType workspace;
+
+  // For each input image, the bands to read and their variable
+  std::vector<std::vector<std::pair<unsigned int, int>>> inputBands(nbInputImages);
+  for (unsigned int v = 0; v < nbVar; ++v)
+  {
+    const adhocStruct& var = m_VVarName[m_ProgramVariables[v]];
+    if (var.type == 5) // info[0] : Input image #ID, info[1] : Band #ID
+      inputBands[var.info[0]].push_back(std::make_pair(v, var.info[1]));
+  }
+
+  std::vector<ImageScanlineConstIteratorType> Vit(nbInputImages);
+  for (unsigned int j = 0; j < nbInputImages; ++j)
+    if (!inputBands[j].empty())
+    {
+      Vit[j] = ImageScanlineConstIteratorType(this->GetNthInput(j), outputRegionForThread);
+      Vit[j].GoToBegin();
+    }
+
+  std::vector<ImageScanlineIteratorType> VoutIt(m_Expression.size());
+  unsigned int                           firstCompiled = m_Expression.size();
+  for (unsigned int j = 0; j < m_Expression.size(); ++j)
+    if (m_Programs[j].IsCompiled())
+    {
+      VoutIt[j] = ImageScanlineIteratorType(this->GetOutput(j), outputRegionForThread);
+      VoutIt[j].GoToBegin();
+      firstCompiled = std::min(firstCompiled, j);
+    }
+
+  // Support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels(), 100, 0.0f, progressWeight);
+
+  PixelType outputPixel(1);
+
+  while (!VoutIt[firstCompiled].IsAtEnd()) // For each line
+  {
+    const IndexType lineIndex = VoutIt[firstCompiled].GetIndex();
+
+    //----------------- Variable affectations -----------------//
+    for (unsigned int v = 0; v < nbVar; ++v)
+    {
+      const adhocStruct& var = m_VVarName[m_ProgramVariables[v]];
+      if (var.type == 0) // idxX
+        for (std::size_t x = 0; x < lineLength; ++x)
+          variables[v][x] = static_cast<double>(lineIndex[0]) + x;
+      else if (var.type == 1) // idxY
+        std::fill(variables[v].begin(), variables[v].end(), static_cast<double>(lineIndex[1]));
+    }
+
+    for (unsigned int j = 0; j < nbInputImages; ++j)
+    {
+      if (inputBands[j].empty())
+        continue;
+
+      for (std::size_t x = 0; !Vit[j].IsAtEndOfLine(); ++Vit[j], ++x)
+      {
+        const PixelType pixel = Vit[j].Get();
+        for (unsigned int b = 0; b < inputBands[j].size(); ++b)
+          variables[inputBands[j][b].first][x] = pixel[inputBands[j][b].second];
+      }
+      Vit[j].NextLine();
+    }
+
+    //----------------- Evaluations -----------------//
+    for (unsigned int IDExpression = 0; IDExpression < m_Expression.size(); ++IDExpression)
+    {
+      if (!m_Programs[IDExpression].IsCompiled())
+        continue;
+
+      m_Programs[IDExpression].Evaluate(variablePointers.data(), lineLength, workspace, result.data());
+
+      //----------------- Pixel affectations -----------------//
+      ImageScanlineIteratorType& outIt = VoutIt[IDExpression];
+      for (std::size_t x = 0; !outIt.IsAtEndOfLine(); ++outIt, ++x)
+      {
+        double value = result[x];
+        if (value < double(itk::NumericTraits<PixelValueType>::NonpositiveMin()))
+        {
+          value = itk::NumericTraits<PixelValueType>::NonpositiveMin();
+          m_ThreadUnderflow[threadId]++;
+        }
+        else if (value > double(itk::NumericTraits<PixelValueType>::max()))
+        {
+          value = itk::NumericTraits<PixelValueType>::max();
+          m_ThreadOverflow[threadId]++;
+        }
+        outputPixel[0] = value;
+        outIt.Set(outputPixel);
+      }
+      outIt.NextLine();
+    }
+
+    for (std::size_t x = 0; x < lineLength; ++x)
+      progress.CompletedPixel();
+  }
+}
+
 } // end namespace otb
 
 #endif
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbBandMathXProgram_h
+#define otbBandMathXProgram_h
+
+#include "OTBMathParserXExport.h"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+/** \class BandMathXProgram
+ * \brief Scalar BandMathX expression compiled to a bytecode evaluated over
+ * arrays of pixels.
+ *
+ * The expression is parsed once, with the muParserX syntax and operator
+ * priorities, into a list of instructions. Each instruction applies one
+ * operator or function to whole arrays of values, in a loop the compiler
+ * can vectorize, so that the cost of the interpretation is paid once per
+ * array instead of once per pixel. Sub-expressions that only involve
+ * constants are computed at compilation.
+ *
+ * The supported subset is:
+ *  - numbers, per pixel variables, and named constants;
+ *  - the operators + - * / ^ == != < <= > >= && || and ?: ;
+ *  - the functions sin, cos, tan, asin, acos, atan, sinh, cosh, tanh, asinh,
+ *    acosh, atanh, ln, log2, log10, exp, sqrt, abs, min, max, sum and ndvi.
+ *
+ * Compile() returns false for any other expression (vectors, matrices,
+ * other functions or operators), which must then be evaluated by muParserX.
+ *
+ * Comparisons and logical operators give 1 or 0, and any non zero value
+ * is true. Both branches of ?: are evaluated.
+ *
+ * \sa BandMathXImageFilter
+ *
+ * \ingroup OTBMathParserX
+ */
+class OTBMathParserX_EXPORT BandMathXProgram
+{
+public:
+  typedef std::map<std::string, double> ConstantMapType;
+  typedef std::vector<double>           WorkspaceType;
+
+  BandMathXProgram();
+
+  /** Compile expression. variables are the names of the per pixel
+   *  variables, in the order of the arrays given to Evaluate(), and
+   *  constants the names of the values fixed for the whole image. Returns
+   *  false, and leaves the program empty, if the expression is not in the
+   *  supported subset. */
+  bool Compile(const std::string& expression, const std::vector<std::string>& variables, const ConstantMapType& constants);
+
+  bool IsCompiled() const
+  {
+    return m_Compiled;
+  }
+
+  /** Number of instructions of the program */
+  std::size_t GetNumberOfInstructions() const
+  {
+    return m_Instructions.size();
+  }
+
+  /** Evaluate the expression on n pixels: variables[i] points to the n
+   *  values of the ith variable, and output, which must not overlap them,
+   *  receives the n results. workspace holds the intermediate arrays; it
+   *  can be reused between calls but not shared between threads. */
+  void Evaluate(const double* const* variables, std::size_t n, WorkspaceType& workspace, double* output) const;
+
+private:
+  class Compiler;
+
+  enum OpCodeType
+  {
+    OpConstant,
+    OpNegate,
+    OpAdd,
+    OpSubtract,
+    OpMultiply,
+    OpDivide,
+    OpPower,
+    OpEqual,
+    OpNotEqual,
+    OpLess,
+    OpLessEqual,
+    OpGreater,
+    OpGreaterEqual,
+    OpAnd,
+    OpOr,
+    OpSelect,
+    OpMinimum,
+    OpMaximum,
+    OpNDVI,
+    OpSin,
+    OpCos,
+    OpTan,
+    OpAsin,
+    OpAcos,
+    OpAtan,
+    OpSinh,
+    OpCosh,
+    OpTanh,
+    OpAsinh,
+    OpAcosh,
+    OpAtanh,
+    OpLn,
+    OpLog2,
+    OpLog10,
+    OpExp,
+    OpSqrt,
+    OpAbs
+  };
+
+  /** Registers below the number of variables are the input arrays, the
+   *  following ones are intermediate arrays of the workspace */
+  struct Instruction
+  {
+    OpCodeType   opCode;
+    unsigned int destination;
+    unsigned int numberOfArguments;
+    unsigned int arguments[3];
+    double       constant;
+  };
+
+  /** Apply one instruction to n values */
+  static void Execute(const Instruction& instruction, const double* const* arguments, double* output, std::size_t n);
+
+  bool                     m_Compiled;
+  unsigned int             m_NumberOfVariables;
+  unsigned int             m_NumberOfTemporaries;
+  unsigned int             m_Result;
+  std::vector<Instruction> m_Instructions;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,696 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbBandMathXProgram.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace otb
+{
+
+namespace
+{
+
+enum TokenKindType
+{
+  TokenEnd,
+  TokenNumber,
+  TokenName,
+  TokenOperator
+};
+
+struct Token
+{
+  TokenKindType kind;
+  std::string   text;
+  double        value;
+};
+
+/** Split expression into tokens. Returns false on any character that is
+ *  not part of the supported subset. */
+bool Tokenize(const std::string& expression, std::vector<Token>& tokens)
+{
+  // Two characters operators first
+  static const char* const operators[] = {"&&", "||", "==", "!=", "<=", ">=", "<", ">", "+", "-", "*", "/", "^", "?", ":", "(", ")", ","};
+
+  tokens.clear();
+  std::size_t pos = 0;
+  while (pos < expression.size())
+  {
+    const unsigned char c = expression[pos];
+    if (std::isspace(c))
+    {
+      ++pos;
+      continue;
+    }
+
+    Token token;
+    token.value = 0.;
+    if (std::isdigit(c) || (c == '.' && pos + 1 < expression.size() && std::isdigit(static_cast<unsigned char>(expression[pos + 1]))))
+    {
+      const char* begin = expression.c_str() + pos;
+      char*       end   = nullptr;
+      token.kind        = TokenNumber;
+      token.value       = std::strtod(begin, &end);
+      token.text        = expression.substr(pos, end - begin);
+      pos += token.text.size();
+
+      // Suffixes such as the imaginary unit are not supported
+      if (pos < expression.size() && (std::isalnum(static_cast<unsigned char>(expression[pos])) || expression[pos] == '_' || expression[pos] == '.'))
+      {
+        return false;
+      }
+    }
+    else if (std::isalpha(c) || c == '_')
+    {
+      const std::size_t begin = pos;
+      while (pos < expression.size() && (std::isalnum(static_cast<unsigned char>(expression[pos])) || expression[pos] == '_'))
+      {
+        ++pos;
+      }
+      token.kind = TokenName;
+      token.text = expression.substr(begin, pos - begin);
+    }
+    else
+    {
+      token.kind = TokenOperator;
+      for (const char* op : operators)
+      {
+        if (expression.compare(pos, std::strlen(op), op) == 0)
+        {
+          token.text = op;
+          break;
+        }
+      }
+      if (token.text.empty())
+      {
+        return false;
+      }
+      pos += token.text.size();
+    }
+    tokens.push_back(token);
+  }
+
+  Token end;
+  end.kind  = TokenEnd;
+  end.value = 0.;
+  tokens.push_back(end);
+  return true;
+}
+
+template <class TFunction>
+void Transform(const double* a, double* output, std::size_t n, TFunction f)
+{
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    output[i] = f(a[i]);
+  }
+}
+
+template <class TFunction>
+void Transform(const double* a, const double* b, double* output, std::size_t n, TFunction f)
+{
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    output[i] = f(a[i], b[i]);
+  }
+}
+
+} // end anonymous namespace
+
+/** Recursive descent parser emitting the instructions of a program */
+class BandMathXProgram::Compiler
+{
+public:
+  Compiler(BandMathXProgram& program, const std::vector<Token>& tokens, const std::vector<std::string>& variables, const ConstantMapType& constants)
+    : m_Program(program), m_Tokens(tokens), m_Position(0), m_Variables(variables), m_Constants(constants)
+  {
+  }
+
+  bool Compile()
+  {
+    Operand result;
+    if (!ParseTernary(result) || m_Tokens[m_Position].kind != TokenEnd)
+    {
+      return false;
+    }
+
+    if (result.constant)
+    {
+      Instruction instruction;
+      instruction.opCode            = OpConstant;
+      instruction.destination       = Allocate();
+      instruction.numberOfArguments = 0;
+      instruction.constant          = result.value;
+      m_Program.m_Instructions.push_back(instruction);
+      result.constant = false;
+      result.reg      = instruction.destination;
+    }
+    m_Program.m_Result = result.reg;
+    return true;
+  }
+
+private:
+  /** Either a value known at compilation or a register */
+  struct Operand
+  {
+    bool         constant;
+    double       value;
+    unsigned int reg;
+  };
+
+  static Operand Constant(double value)
+  {
+    Operand operand;
+    operand.constant = true;
+    operand.value    = value;
+    operand.reg      = 0;
+    return operand;
+  }
+
+  static Operand Register(unsigned int reg)
+  {
+    Operand operand;
+    operand.constant = false;
+    operand.value    = 0.;
+    operand.reg      = reg;
+    return operand;
+  }
+
+  bool Accept(const char* op)
+  {
+    const Token& token = m_Tokens[m_Position];
+    if (token.kind == TokenOperator && token.text == op)
+    {
+      ++m_Position;
+      return true;
+    }
+    return false;
+  }
+
+  unsigned int Allocate()
+  {
+    if (!m_Free.empty())
+    {
+      const unsigned int reg = m_Free.back();
+      m_Free.pop_back();
+      return reg;
+    }
+    return m_Program.m_NumberOfVariables + m_Program.m_NumberOfTemporaries++;
+  }
+
+  void Release(const Operand& operand)
+  {
+    // Each intermediate array is read once: it can be reused right away
+    if (!operand.constant && operand.reg >= m_Program.m_NumberOfVariables)
+    {
+      m_Free.push_back(operand.reg);
+    }
+  }
+
+  /** Add an instruction, or compute its value if all its arguments are
+   *  constant */
+  Operand Emit(OpCodeType opCode, std::vector<Operand> arguments)
+  {
+    Instruction instruction;
+    instruction.opCode            = opCode;
+    instruction.numberOfArguments = arguments.size();
+    instruction.constant          = 0.;
+
+    if (std::all_of(arguments.begin(), arguments.end(), [](const Operand& operand) { return operand.constant; }))
+    {
+      double        values[3];
+      const double* pointers[3] = {nullptr, nullptr, nullptr};
+      for (unsigned int k = 0; k < arguments.size(); ++k)
+      {
+        values[k]   = arguments[k].value;
+        pointers[k] = &values[k];
+      }
+      double result;
+      Execute(instruction, pointers, &result, 1);
+      return Constant(result);
+    }
+
+    for (Operand& argument : arguments)
+    {
+      if (argument.constant)
+      {
+        Instruction load;
+        load.opCode            = OpConstant;
+        load.destination       = Allocate();
+        load.numberOfArguments = 0;
+        load.constant          = argument.value;
+        m_Program.m_Instructions.push_back(load);
+        argument = Register(load.destination);
+      }
+    }
+    for (unsigned int k = 0; k < arguments.size(); ++k)
+    {
+      instruction.arguments[k] = arguments[k].reg;
+      Release(arguments[k]);
+    }
+    instruction.destination = Allocate();
+    m_Program.m_Instructions.push_back(instruction);
+    return Register(instruction.destination);
+  }
+
+  /** condition ? a : b, right associative */
+  bool ParseTernary(Operand& result)
+  {
+    Operand condition;
+    if (!ParseBinary(0, condition))
+    {
+      return false;
+    }
+    if (!Accept("?"))
+    {
+      result = condition;
+      return true;
+    }
+
+    Operand a, b;
+    if (!ParseTernary(a) || !Accept(":") || !ParseTernary(b))
+    {
+      return false;
+    }
+    if (condition.constant)
+    {
+      Release(condition.value != 0. ? b : a);
+      result = condition.value != 0. ? a : b;
+      return true;
+    }
+    result = Emit(OpSelect, {condition, a, b});
+    return true;
+  }
+
+  /** Left associative binary operators, by increasing priority */
+  bool ParseBinary(unsigned int level, Operand& result)
+  {
+    struct BinaryOperator
+    {
+      unsigned int level;
+      const char*  symbol;
+      OpCodeType   opCode;
+    };
+    static const BinaryOperator binaryOperators[] = {{0, "||", OpOr},          {1, "&&", OpAnd},         {2, "==", OpEqual},   {2, "!=", OpNotEqual},
+                                                     {3, "<", OpLess},         {3, "<=", OpLessEqual},   {3, ">", OpGreater},  {3, ">=", OpGreaterEqual},
+                                                     {4, "+", OpAdd},          {4, "-", OpSubtract},     {5, "*", OpMultiply}, {5, "/", OpDivide}};
+    static const unsigned int numberOfLevels = 6;
+
+    if (level == numberOfLevels)
+    {
+      return ParseUnary(result);
+    }
+    if (!ParseBinary(level + 1, result))
+    {
+      return false;
+    }
+
+    bool found = true;
+    while (found)
+    {
+      found = false;
+      for (const BinaryOperator& op : binaryOperators)
+      {
+        if (op.level == level && Accept(op.symbol))
+        {
+          Operand right;
+          if (!ParseBinary(level + 1, right))
+          {
+            return false;
+          }
+          result = Emit(op.opCode, {result, right});
+          found  = true;
+          break;
+        }
+      }
+    }
+    return true;
+  }
+
+  /** Signs bind less than ^, as in muParserX: -2^2 is -4 */
+  bool ParseUnary(Operand& result)
+  {
+    if (Accept("-"))
+    {
+      Operand operand;
+      if (!ParseUnary(operand))
+      {
+        return false;
+      }
+      result = Emit(OpNegate, {operand});
+      return true;
+    }
+    if (Accept("+"))
+    {
+      return ParseUnary(result);
+    }
+    return ParsePower(result);
+  }
+
+  /** a ^ b, right associative, b may be signed */
+  bool ParsePower(Operand& result)
+  {
+    if (!ParsePrimary(result))
+    {
+      return false;
+    }
+    if (Accept("^"))
+    {
+      Operand exponent;
+      if (!ParseUnary(exponent))
+      {
+        return false;
+      }
+      result = Emit(OpPower, {result, exponent});
+    }
+    return true;
+  }
+
+  bool ParsePrimary(Operand& result)
+  {
+    const Token token = m_Tokens[m_Position];
+    if (token.kind == TokenNumber)
+    {
+      ++m_Position;
+      result = Constant(token.value);
+      return true;
+    }
+    if (Accept("("))
+    {
+      return ParseTernary(result) && Accept(")");
+    }
+    if (token.kind != TokenName)
+    {
+      return false;
+    }
+
+    ++m_Position;
+    if (Accept("("))
+    {
+      return ParseCall(token.text, result);
+    }
+
+    const auto variable = std::find(m_Variables.begin(), m_Variables.end(), token.text);
+    if (variable != m_Variables.end())
+    {
+      result = Register(static_cast<unsigned int>(variable - m_Variables.begin()));
+      return true;
+    }
+    const auto constant = m_Constants.find(token.text);
+    if (constant != m_Constants.end())
+    {
+      result = Constant(constant->second);
+      return true;
+    }
+    return false;
+  }
+
+  /** Function call, the opening parenthesis being already read */
+  bool ParseCall(const std::string& name, Operand& result)
+  {
+    std::vector<Operand> arguments;
+    if (!Accept(")"))
+    {
+      do
+      {
+        Operand argument;
+        if (!ParseTernary(argument))
+        {
+          return false;
+        }
+        arguments.push_back(argument);
+      } while (Accept(","));
+      if (!Accept(")"))
+      {
+        return false;
+      }
+    }
+
+    struct Function
+    {
+      const char* name;
+      OpCodeType  opCode;
+    };
+    static const Function unaryFunctions[] = {{"sin", OpSin},     {"cos", OpCos},     {"tan", OpTan},     {"asin", OpAsin},   {"acos", OpAcos},
+                                              {"atan", OpAtan},   {"sinh", OpSinh},   {"cosh", OpCosh},   {"tanh", OpTanh},   {"asinh", OpAsinh},
+                                              {"acosh", OpAcosh}, {"atanh", OpAtanh}, {"ln", OpLn},       {"log2", OpLog2},   {"log10", OpLog10},
+                                              {"exp", OpExp},     {"sqrt", OpSqrt},   {"abs", OpAbs}};
+    for (const Function& function : unaryFunctions)
+    {
+      if (name == function.name)
+      {
+        if (arguments.size() != 1)
+        {
+          return false;
+        }
+        result = Emit(function.opCode, arguments);
+        return true;
+      }
+    }
+
+    if (name == "ndvi")
+    {
+      if (arguments.size() != 2)
+      {
+        return false;
+      }
+      result = Emit(OpNDVI, arguments);
+      return true;
+    }
+
+    // Variadic functions are chains of binary operations
+    OpCodeType opCode;
+    if (name == "min")
+    {
+      opCode = OpMinimum;
+    }
+    else if (name == "max")
+    {
+      opCode = OpMaximum;
+    }
+    else if (name == "sum")
+    {
+      opCode = OpAdd;
+    }
+    else
+    {
+      return false;
+    }
+    if (arguments.empty())
+    {
+      return false;
+    }
+    result = arguments[0];
+    for (std::size_t k = 1; k < arguments.size(); ++k)
+    {
+      result = Emit(opCode, {result, arguments[k]});
+    }
+    return true;
+  }
+
+  BandMathXProgram&               m_Program;
+  const std::vector<Token>&       m_Tokens;
+  std::size_t                     m_Position;
+  const std::vector<std::string>& m_Variables;
+  const ConstantMapType&          m_Constants;
+  std::vector<unsigned int>       m_Free;
+};
+
+BandMathXProgram::BandMathXProgram() : m_Compiled(false), m_NumberOfVariables(0), m_NumberOfTemporaries(0), m_Result(0)
+{
+}
+
+bool BandMathXProgram::Compile(const std::string& expression, const std::vector<std::string>& variables, const ConstantMapType& constants)
+{
+  m_Instructions.clear();
+  m_NumberOfVariables   = variables.size();
+  m_NumberOfTemporaries = 0;
+  m_Result              = 0;
+
+  std::vector<Token> tokens;
+  m_Compiled = Tokenize(expression, tokens) && Compiler(*this, tokens, variables, constants).Compile();
+  if (!m_Compiled)
+  {
+    m_Instructions.clear();
+    m_NumberOfTemporaries = 0;
+  }
+  return m_Compiled;
+}
+
+void BandMathXProgram::Evaluate(const double* const* variables, std::size_t n, WorkspaceType& workspace, double* output) const
+{
+  if (m_Result < m_NumberOfVariables)
+  {
+    std::copy(variables[m_Result], variables[m_Result] + n, output);
+    return;
+  }
+
+  // The result register is stored directly in output
+  workspace.resize(m_NumberOfTemporaries * n);
+  auto address = [&](unsigned int reg) -> double* {
+    return reg == m_Result ? output : workspace.data() + (reg - m_NumberOfVariables) * n;
+  };
+
+  const double* arguments[3] = {nullptr, nullptr, nullptr};
+  for (const Instruction& instruction : m_Instructions)
+  {
+    for (unsigned int k = 0; k < instruction.numberOfArguments; ++k)
+    {
+      const unsigned int reg = instruction.arguments[k];
+      arguments[k]           = reg < m_NumberOfVariables ? variables[reg] : address(reg);
+    }
+    Execute(instruction, arguments, address(instruction.destination), n);
+  }
+}
+
+void BandMathXProgram::Execute(const Instruction& instruction, const double* const* arguments, double* output, std::size_t n)
+{
+  const double* a = arguments[0];
+  const double* b = arguments[1];
+
+  switch (instruction.opCode)
+  {
+  case OpConstant:
+    std::fill(output, output + n, instruction.constant);
+    break;
+  case OpNegate:
+    Transform(a, output, n, [](double x) { return -x; });
+    break;
+  case OpAdd:
+    Transform(a, b, output, n, [](double x, double y) { return x + y; });
+    break;
+  case OpSubtract:
+    Transform(a, b, output, n, [](double x, double y) { return x - y; });
+    break;
+  case OpMultiply:
+    Transform(a, b, output, n, [](double x, double y) { return x * y; });
+    break;
+  case OpDivide:
+    Transform(a, b, output, n, [](double x, double y) { return x / y; });
+    break;
+  case OpPower:
+    Transform(a, b, output, n, [](double x, double y) { return std::pow(x, y); });
+    break;
+  case OpEqual:
+    Transform(a, b, output, n, [](double x, double y) { return x == y ? 1. : 0.; });
+    break;
+  case OpNotEqual:
+    Transform(a, b, output, n, [](double x, double y) { return x != y ? 1. : 0.; });
+    break;
+  case OpLess:
+    Transform(a, b, output, n, [](double x, double y) { return x < y ? 1. : 0.; });
+    break;
+  case OpLessEqual:
+    Transform(a, b, output, n, [](double x, double y) { return x <= y ? 1. : 0.; });
+    break;
+  case OpGreater:
+    Transform(a, b, output, n, [](double x, double y) { return x > y ? 1. : 0.; });
+    break;
+  case OpGreaterEqual:
+    Transform(a, b, output, n, [](double x, double y) { return x >= y ? 1. : 0.; });
+    break;
+  case OpAnd:
+    Transform(a, b, output, n, [](double x, double y) { return x != 0. && y != 0. ? 1. : 0.; });
+    break;
+  case OpOr:
+    Transform(a, b, output, n, [](double x, double y) { return x != 0. || y != 0. ? 1. : 0.; });
+    break;
+  case OpSelect:
+  {
+    const double* c = arguments[2];
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      output[i] = a[i] != 0. ? b[i] : c[i];
+    }
+    break;
+  }
+  case OpMinimum:
+    Transform(a, b, output, n, [](double x, double y) { return std::min(x, y); });
+    break;
+  case OpMaximum:
+    Transform(a, b, output, n, [](double x, double y) { return std::max(x, y); });
+    break;
+  case OpNDVI:
+    // Same as the ndvi function of muParserX (see ParserXPlugins)
+    Transform(a, b, output, n, [](double r, double nir) { return std::abs(r + nir) < 1E-6 ? 0. : (nir - r) / (nir + r); });
+    break;
+  case OpSin:
+    Transform(a, output, n, [](double x) { return std::sin(x); });
+    break;
+  case OpCos:
+    Transform(a, output, n, [](double x) { return std::cos(x); });
+    break;
+  case OpTan:
+    Transform(a, output, n, [](double x) { return std::tan(x); });
+    break;
+  case OpAsin:
+    Transform(a, output, n, [](double x) { return std::asin(x); });
+    break;
+  case OpAcos:
+    Transform(a, output, n, [](double x) { return std::acos(x); });
+    break;
+  case OpAtan:
+    Transform(a, output, n, [](double x) { return std::atan(x); });
+    break;
+  case OpSinh:
+    Transform(a, output, n, [](double x) { return std::sinh(x); });
+    break;
+  case OpCosh:
+    Transform(a, output, n, [](double x) { return std::cosh(x); });
+    break;
+  case OpTanh:
+    Transform(a, output, n, [](double x) { return std::tanh(x); });
+    break;
+  case OpAsinh:
+    Transform(a, output, n, [](double x) { return std::asinh(x); });
+    break;
+  case OpAcosh:
+    Transform(a, output, n, [](double x) { return std::acosh(x); });
+    break;
+  case OpAtanh:
+    Transform(a, output, n, [](double x) { return std::atanh(x); });
+    break;
+  case OpLn:
+    Transform(a, output, n, [](double x) { return std::log(x); });
+    break;
+  case OpLog2:
+    Transform(a, output, n, [](double x) { return std::log2(x); });
+    break;
+  case OpLog10:
+    Transform(a, output, n, [](double x) { return std::log10(x); });
+    break;
+  case OpExp:
+    Transform(a, output, n, [](double x) { return std::exp(x); });
+    break;
+  case OpSqrt:
+    Transform(a, output, n, [](double x) { return std::sqrt(x); });
+    break;
+  case OpAbs:
+    Transform(a, output, n, [](double x) { return std::abs(x); });
+    break;
+  }
+}
+
+} // end namespace otb
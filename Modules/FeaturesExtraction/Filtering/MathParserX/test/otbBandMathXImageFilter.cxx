@@ -684,3 +684,88 @@ int otbBandMathXImageFilterBandsFailures(int itkNotUsed(argc), char* itkNotUsed(
   }
   return EXIT_SUCCESS;
 }
+
+int otbBandMathXImageFilterCompiled(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::VectorImage<double, 2> ImageType;
+  typedef otb::BandMathXImageFilter<ImageType> FilterType;
+
+  const unsigned int N = 100, D1 = 3, D2 = 1;
+
+  ImageType::SizeType size;
+  size.Fill(N);
+  ImageType::IndexType index;
+  index.Fill(0);
+  ImageType::RegionType region;
+  region.SetSize(size);
+  region.SetIndex(index);
+
+  ImageType::Pointer image1 = createTestImage<ImageType>(region, D1);
+  ImageType::Pointer image2 = createTestImage<ImageType>(region, D2);
+
+  typedef itk::ImageRegionIteratorWithIndex<ImageType> IteratorType;
+  IteratorType                                         it1(image1, region);
+  IteratorType                                         it2(image2, region);
+
+  for (it1.GoToBegin(), it2.GoToBegin(); !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    ImageType::IndexType i1 = it1.GetIndex();
+
+    it1.Get()[0] = i1[0] + i1[1] - 50;
+    it1.Get()[1] = i1[0] * i1[1] - 50;
+    it1.Get()[2] = i1[0] / (i1[1] + 1) + 5;
+    it2.Get()[0] = (i1[0] - i1[1]) % 7;
+  }
+
+  // The first five expressions are in the subset supported by
+  // BandMathXProgram, the last one is evaluated by muParserX
+  std::vector<std::string> expressions = {"ndvi(im1b1, im1b2) + 0.5 * abs(im1b3 - K)",
+                                          "im1b1 > 10 && im2b1 != 0 ? sqrt(abs(im1b2)) : -im1b3^2",
+                                          "exp(-idxX / 50) * cos(pi * idxY * im1PhyX / 100) + min(im1b1, im1b2, im1b3)",
+                                          "im1b1 / im2b1",
+                                          "2 * K",
+                                          "vmax(im1)"};
+
+  FilterType::Pointer compiledFilter = FilterType::New();
+  FilterType::Pointer parserFilter   = FilterType::New();
+  parserFilter->CompileExpressionsOff();
+
+  for (FilterType* filter : {compiledFilter.GetPointer(), parserFilter.GetPointer()})
+  {
+    filter->SetNthInput(0, image1);
+    filter->SetNthInput(1, image2);
+    filter->SetConstant("K", 2.5);
+    for (const std::string& expression : expressions)
+      filter->SetExpression(expression);
+    filter->Update();
+  }
+
+  for (unsigned int e = 0; e < expressions.size(); ++e)
+  {
+    const bool expectedCompiled = (e + 1 < expressions.size());
+    if (compiledFilter->IsExpressionCompiled(e) != expectedCompiled || parserFilter->IsExpressionCompiled(e))
+    {
+      std::cout << "Expression " << expressions[e] << (expectedCompiled ? " should" : " should not") << " be compiled -> TEST FAILED" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    IteratorType itCompiled(compiledFilter->GetOutput(e), region);
+    IteratorType itParser(parserFilter->GetOutput(e), region);
+    for (itCompiled.GoToBegin(), itParser.GoToBegin(); !itCompiled.IsAtEnd(); ++itCompiled, ++itParser)
+    {
+      const double compiled = itCompiled.Get()[0];
+      const double parsed   = itParser.Get()[0];
+      if (std::isnan(compiled) && std::isnan(parsed))
+        continue;
+
+      if (std::abs(compiled - parsed) > 1E-12 * std::max(1., std::abs(parsed)))
+      {
+        std::cout << "Expression " << expressions[e] << " at " << itCompiled.GetIndex() << " : compiled = " << compiled << ", muParserX = " << parsed
+                  << " -> TEST FAILED" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
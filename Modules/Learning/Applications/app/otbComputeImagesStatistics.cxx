@@ -23,6 +23,8 @@
 
 #include "otbStatisticsXMLFileWriter.h"
 #include "otbStreamingStatisticsVectorImageFilter.h"
+#include "otbImageFileReader.h"
+#include "otbExtendedFilenameHelper.h"
 #include <sstream>
 
 namespace otb
@@ -56,7 +58,10 @@ private:
         "for each band of a set of images and optionally saves the results in an XML file."
         " The output XML is intended to be used as an input "
         "for the TrainImagesClassifier application to normalize samples before learning. "
-        "You can also normalize the image with the XML file in the ImageClassifier application.");
+        "You can also normalize the image with the XML file in the ImageClassifier application.\n"
+        "The statistics can be estimated on a subset of the pixels with the samples parameter: "
+        "the coarsest overview of each image having enough pixels is read, and its pixels are "
+        "subsampled with a regular stride. The 95% confidence interval of the means is then logged.");
 
     SetDocLimitations(
         "Each image of the set must contain the same bands as the others"
@@ -74,6 +79,14 @@ private:
     SetParameterDescription("bv", "Background value to ignore in computation of statistics.");
     MandatoryOff("bv");
 
+    AddParameter(ParameterType_Int, "samples", "Number of samples");
+    SetParameterDescription("samples",
+                            "Estimate the statistics of each image on at least this number of pixels, "
+                            "instead of all its pixels. The coarsest overview with enough pixels is read "
+                            "when the image file has overviews.");
+    SetMinimumParameterIntValue("samples", 1);
+    MandatoryOff("samples");
+
     AddParameter(ParameterType_Group, "out", "Optional outputs");
 
     AddParameter(ParameterType_OutputFilename, "out.xml", "Output XML file");
@@ -153,10 +166,18 @@ private:
     MatrixValueType nbSamples(nbBands, static_cast<unsigned int>(nbImages));
     nbSamples.Fill(itk::NumericTraits<MatrixValueType::ValueType>::Zero);
 
+    // Estimation on a subset of the pixels
+    const unsigned long      numberOfSamples = HasValue("samples") ? GetParameterInt("samples") : 0;
+    std::vector<std::string> fileNames       = GetParameterStringList("il");
+
     // Iterate over all input images
     for (unsigned int imageId = 0; imageId < nbImages; ++imageId)
     {
       FloatVectorImageType* image = imageList->GetNthElement(imageId);
+      if (numberOfSamples > 0 && imageId < fileNames.size() && !fileNames[imageId].empty())
+      {
+        image = ReadOverview(fileNames[imageId], numberOfSamples, image);
+      }
       if (nbBands != image->GetNumberOfComponentsPerPixel())
       {
         itkExceptionMacro(<< "The image #" << imageId + 1 << " has " << image->GetNumberOfComponentsPerPixel() << " bands, while the image #1 has " << nbBands);
@@ -175,8 +196,15 @@ private:
         statsEstimator->SetIgnoreUserDefinedValue(true);
         statsEstimator->SetUserIgnoredValue(GetParameterFloat("bv"));
       }
+      statsEstimator->SetNumberOfSamples(numberOfSamples);
       statsEstimator->Update();
 
+      if (numberOfSamples > 0)
+      {
+        otbAppLogINFO("Image #" << imageId + 1 << ": statistics estimated with a sampling stride of " << statsEstimator->GetSamplingStride()
+                                << ", 95% confidence radius of the means: " << statsEstimator->GetMeanConfidenceRadius(0.95));
+      }
+
       MeasurementType nbRelevantPixels = statsEstimator->GetNbRelevantPixels();
       MeasurementType meanPerBand      = statsEstimator->GetMean();
       MeasurementType minPerBand       = statsEstimator->GetMinimum();
@@ -260,6 +288,17 @@ private:
       stddev[i] = std::sqrt(totalVariancePerBand[i]);
     }
 
+    if (numberOfSamples > 0)
+    {
+      // Normal approximation of the error on the mean of the samples
+      MeasurementType meanConfidenceRadius(nbBands);
+      for (unsigned int i = 0; i < nbBands; ++i)
+      {
+        meanConfidenceRadius[i] = totalSamplesPerBand[i] > 0 ? 1.96 * stddev[i] / std::sqrt(totalSamplesPerBand[i]) : 0.;
+      }
+      otbAppLogINFO("95% confidence radius of the estimated means: " << meanConfidenceRadius);
+    }
+
     // Display the pixel value
     std::ostringstream oss_mean, oss_min, oss_max, oss_std;
     oss_mean << totalMeanPerBand;
@@ -290,7 +329,47 @@ private:
     }
   }
 
+  // Read the coarsest overview of fileName having at least numberOfSamples
+  // pixels, or return image if there is none. The resol option of fileName,
+  // if any, is replaced by the one of the overview.
+  FloatVectorImageType* ReadOverview(const std::string& fileName, unsigned long numberOfSamples, FloatVectorImageType* image)
+  {
+    typedef otb::ImageFileReader<FloatVectorImageType> ReaderType;
+
+    ExtendedFilenameHelper::Pointer helper = ExtendedFilenameHelper::New();
+    helper->SetExtendedFileName(fileName);
+    std::ostringstream options;
+    for (const auto& option : helper->GetOptionMap())
+    {
+      if (option.first != "resol")
+      {
+        options << "&" << option.first << "=" << option.second;
+      }
+    }
+    const std::string fullResolutionFileName = helper->GetSimpleFileName() + (options.str().empty() ? "" : "?" + options.str());
+
+    ReaderType::Pointer reader = ReaderType::New();
+    reader->SetFileName(fullResolutionFileName);
+    const unsigned int resolutionFactor = reader->GetOverviewResolutionFactor(numberOfSamples);
+    if (resolutionFactor == 0)
+    {
+      return image;
+    }
+
+    std::ostringstream overviewFileName;
+    overviewFileName << helper->GetSimpleFileName() << "?" << options.str() << "&resol=" << resolutionFactor;
+    otbAppLogINFO("Reading " << overviewFileName.str());
+
+    ReaderType::Pointer overviewReader = ReaderType::New();
+    overviewReader->SetFileName(overviewFileName.str());
+    overviewReader->UpdateOutputInformation();
+    m_Readers.push_back(overviewReader.GetPointer());
+    return overviewReader->GetOutput();
+  }
+
   itk::LightObject::Pointer m_FilterRef;
+
+  std::vector<itk::LightObject::Pointer> m_Readers;
 };
 }
 }
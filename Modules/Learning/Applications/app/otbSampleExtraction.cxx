@@ -78,6 +78,16 @@ private:
                             "values (OGR format). If not given, the input vector data file is updated");
     MandatoryOff("out");
 
+    AddParameter(ParameterType_OutputFilename, "outstore", "Output sample store");
+    SetParameterDescription("outstore",
+                            "Binary file storing the sample values by columns, "
+                            "with the class field as label (its values shall be numbers). "
+                            "It can be given as input vector data to TrainVectorClassifier "
+                            "and TrainVectorRegression, and is much faster to read than an "
+                            "OGR file. If it is given without the out parameter, the input "
+                            "vector data file is not updated.");
+    MandatoryOff("outstore");
+
     AddParameter(ParameterType_Choice, "outfield", "Output field names");
     SetParameterDescription("outfield", "Choice between naming method for output fields");
 
@@ -159,11 +169,17 @@ private:
   {
     ogr::DataSource::Pointer vectors;
     ogr::DataSource::Pointer output;
+    const bool               useStore = IsParameterEnabled("outstore") && HasValue("outstore");
     if (IsParameterEnabled("out") && HasValue("out"))
     {
       vectors = ogr::DataSource::New(this->GetParameterString("vec"));
       output  = ogr::DataSource::New(this->GetParameterString("out"), ogr::DataSource::Modes::Overwrite);
     }
+    else if (useStore)
+    {
+      // Only the sample store is written
+      vectors = ogr::DataSource::New(this->GetParameterString("vec"));
+    }
     else
     {
       // Update mode
@@ -202,7 +218,14 @@ private:
     filter->SetInput(this->GetParameterImage("in"));
     filter->SetLayerIndex(this->GetParameterInt("layer"));
     filter->SetSamplePositions(vectors);
-    filter->SetOutputSamples(output);
+    if (output.IsNotNull())
+    {
+      filter->SetOutputSamples(output);
+    }
+    if (useStore)
+    {
+      filter->SetSampleStoreFileName(this->GetParameterString("outstore"));
+    }
     filter->SetClassFieldName(fieldName);
     filter->SetOutputFieldPrefix(namePrefix);
     filter->SetOutputFieldNames(nameList);
@@ -211,7 +234,10 @@ private:
 
     AddProcess(filter->GetStreamer(), "Extracting sample values...");
     filter->Update();
-    output->SyncToDisk();
+    if (output.IsNotNull())
+    {
+      output->SyncToDisk();
+    }
   }
 };
 
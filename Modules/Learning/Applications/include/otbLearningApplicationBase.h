@@ -32,6 +32,7 @@
 
 // Estimator
 #include "otbMachineLearningModelFactory.h"
+#include <functional>
 #include <string>
 
 namespace otb
@@ -127,6 +128,20 @@ protected:
    * uses specific train methods depending on the chosen model.*/
   void Train(typename ListSampleType::Pointer trainingListSample, typename TargetListSampleType::Pointer trainingLabeledListSample, std::string modelPath);
 
+  /** Reader of the training chunks: fills the lists with the next chunk
+   *  and returns false when there is no chunk left */
+  typedef std::function<bool(ListSampleType*, TargetListSampleType*)> ChunkReaderType;
+
+  /** Generic method to train and save the machine learning model by chunks,
+   * for the models supporting MachineLearningModel::PartialFit(). The lists
+   * hold the first chunk, which must contain every class, nextChunk reads
+   * the next ones into these lists.*/
+  void TrainByChunks(typename ListSampleType::Pointer firstChunkListSample, typename TargetListSampleType::Pointer firstChunkLabeledListSample,
+                     const ChunkReaderType& nextChunk, unsigned int numberOfChunks, std::string modelPath);
+
+  /** Can the chosen model be trained by chunks ? */
+  bool IsPartialFitSupported();
+
   /** Generic method to load a model file and use it to classify a sample list*/
   typename TargetListSampleType::Pointer Classify(typename ListSampleType::Pointer validationListSample, std::string modelPath);
 
@@ -148,6 +163,18 @@ private:
   void                     InitUnsupervisedClassifierParams();
   std::vector<std::string> m_UnsupervisedClassifier;
 
+  /** Called before the training on each chunk, with the chunk index, to
+   *  change the parameters of the model between chunks */
+  typedef std::function<void(unsigned int)> ChunkSetupType;
+
+  /** Train a model created by a specific train method: with Train(), or
+   * with PartialFit() on each chunk during TrainByChunks() */
+  void FitModel(ModelType* model, const ChunkSetupType& setupChunk = ChunkSetupType());
+
+  /** Chunks of TrainByChunks(), m_NextChunk is empty outside of it */
+  ChunkReaderType m_NextChunk;
+  unsigned int    m_NumberOfChunks;
+
 //@{
 #ifdef OTB_USE_LIBSVM
   void InitLibSVMParams();
@@ -31,7 +31,7 @@ namespace Wrapper
 {
 
 template <class TInputValue, class TOutputValue>
-LearningApplicationBase<TInputValue, TOutputValue>::LearningApplicationBase() : m_RegressionFlag(false)
+LearningApplicationBase<TInputValue, TOutputValue>::LearningApplicationBase() : m_RegressionFlag(false), m_NumberOfChunks(1)
 
 {
 }
@@ -248,6 +248,65 @@ void LearningApplicationBase<TInputValue, TOutputValue>::Train(typename ListSamp
   dummyFilter->UpdateProgress(1.0f);
   dummyFilter->InvokeEvent(itk::EndEvent());
 }
+
+template <class TInputValue, class TOutputValue>
+bool LearningApplicationBase<TInputValue, TOutputValue>::IsPartialFitSupported()
+{
+  const std::string modelName = GetParameterString("classifier");
+  return modelName == "ann" || modelName == "sharkrf" || modelName == "sharkkm";
+}
+
+template <class TInputValue, class TOutputValue>
+void LearningApplicationBase<TInputValue, TOutputValue>::TrainByChunks(typename ListSampleType::Pointer       firstChunkListSample,
+                                                                       typename TargetListSampleType::Pointer firstChunkLabeledListSample,
+                                                                       const ChunkReaderType& nextChunk, unsigned int numberOfChunks, std::string modelPath)
+{
+  if (!IsPartialFitSupported())
+  {
+    otbAppLogFATAL(<< "The model " << GetParameterString("classifier") << " cannot be trained by chunks.");
+  }
+
+  // The specific train methods call FitModel(), which reads the chunks
+  m_NextChunk      = nextChunk;
+  m_NumberOfChunks = numberOfChunks;
+  try
+  {
+    Train(firstChunkListSample, firstChunkLabeledListSample, modelPath);
+  }
+  catch (...)
+  {
+    m_NextChunk      = ChunkReaderType();
+    m_NumberOfChunks = 1;
+    throw;
+  }
+  m_NextChunk      = ChunkReaderType();
+  m_NumberOfChunks = 1;
+}
+
+template <class TInputValue, class TOutputValue>
+void LearningApplicationBase<TInputValue, TOutputValue>::FitModel(ModelType* model, const ChunkSetupType& setupChunk)
+{
+  if (!m_NextChunk)
+  {
+    model->Train();
+    return;
+  }
+
+  // The lists of the model hold the first chunk, and receive the next ones
+  typename ListSampleType::Pointer       samples = model->GetInputListSample();
+  typename TargetListSampleType::Pointer labels  = model->GetTargetListSample();
+  model->ResetPartialFit();
+  unsigned int chunk = 0;
+  do
+  {
+    if (setupChunk)
+    {
+      setupChunk(chunk);
+    }
+    otbAppLogINFO("Training on chunk " << ++chunk << "/" << m_NumberOfChunks << " (" << samples->Size() << " samples)");
+    model->PartialFit();
+  } while (m_NextChunk(samples, labels));
+}
 }
 }
 
@@ -145,6 +145,7 @@ void TrainImagesBase::ShareClassificationParams()
   ShareParameter("rand", "training.rand");
 
   ShareParameter("io.confmatout", "training.io.confmatout");
+  ShareParameter("sample.chunk", "training.chunk");
 }
 
 void TrainImagesBase::ConnectClassificationParams()
@@ -231,7 +231,7 @@ void LearningApplicationBase<TInputValue, TOutputValue>::TrainNeuralNetwork(type
   }
   classifier->SetEpsilon(GetParameterFloat("classifier.ann.eps"));
   classifier->SetMaxIter(GetParameterInt("classifier.ann.iter"));
-  classifier->Train();
+  this->FitModel(classifier.GetPointer());
   classifier->Save(modelPath);
 }
 
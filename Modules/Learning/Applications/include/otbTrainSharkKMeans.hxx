@@ -119,7 +119,7 @@ void LearningApplicationBase<TInputValue, TOutputValue>::TrainSharkKMeans(typena
   }
 
   classifier->SetMaximumNumberOfIterations(nbMaxIter);
-  classifier->Train();
+  this->FitModel(classifier.GetPointer());
   classifier->Save(modelPath);
 
   if (HasValue("classifier.sharkkm.outcentroids"))
@@ -24,6 +24,8 @@
 #include "otbLearningApplicationBase.h"
 #include "otbSharkRandomForestsMachineLearningModel.h"
 
+#include <algorithm>
+
 namespace otb
 {
 namespace Wrapper
@@ -43,7 +45,9 @@ void LearningApplicationBase<TInputValue, TOutputValue>::InitSharkRandomForestsP
   SetParameterDescription("classifier.sharkrf.nbtrees",
                           "The maximum number of trees in the forest. Typically, the more trees you have, the better the accuracy. "
                           "However, the improvement in accuracy generally diminishes and reaches an asymptote for a certain number of trees. "
-                          "Also to keep in mind, increasing the number of trees increases the prediction time linearly.");
+                          "Also to keep in mind, increasing the number of trees increases the prediction time linearly. "
+                          "When training by chunks, the trees are shared between the chunks and each chunk grows at least one tree, "
+                          "so the forest has at least as many trees as chunks.");
 
 
   // NodeSize
@@ -85,7 +89,18 @@ void LearningApplicationBase<TInputValue, TOutputValue>::TrainSharkRandomForests
   classifier->SetNumberOfTrees(GetParameterInt("classifier.sharkrf.nbtrees"));
   classifier->SetMTry(GetParameterInt("classifier.sharkrf.mtry"));
 
-  classifier->Train();
+  // By chunks, the trees are shared between the chunks, each chunk growing
+  // at least one tree
+  const unsigned int nbTrees        = GetParameterInt("classifier.sharkrf.nbtrees");
+  const unsigned int numberOfChunks = m_NumberOfChunks;
+  if (numberOfChunks > nbTrees)
+  {
+    otbAppLogWARNING("The forest is trained on " << numberOfChunks << " chunks with one tree each, it has " << numberOfChunks << " trees instead of "
+                                                 << nbTrees << ".");
+  }
+  this->FitModel(classifier.GetPointer(), [classifier, nbTrees, numberOfChunks](unsigned int chunk) {
+    classifier->SetNumberOfTrees(std::max(1u, nbTrees / numberOfChunks + (chunk < nbTrees % numberOfChunks ? 1 : 0)));
+  });
   classifier->Save(modelPath);
 }
 
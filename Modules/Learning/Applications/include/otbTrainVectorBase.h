@@ -27,6 +27,7 @@
 #include "otbOGRDataSourceWrapper.h"
 #include "otbOGRFeatureWrapper.h"
 #include "otbStatisticsXMLFileWriter.h"
+#include "otbSampleStore.h"
 
 #include "itkVariableLengthVector.h"
 #include "otbStatisticsXMLFileReader.h"
@@ -35,6 +36,7 @@
 #include "otbShiftScaleSampleListFilter.h"
 
 #include <algorithm>
+#include <functional>
 #include <locale>
 #include <string>
 
@@ -67,6 +69,9 @@ public:
 
   typedef otb::Statistics::ShiftScaleSampleListFilter<ListSampleType, ListSampleType> ShiftScaleFilterType;
 
+  /** Function receiving each sample read, with its label */
+  typedef std::function<void(const MeasurementType&, ValueType)> SampleCallbackType;
+
 protected:
   /** Class used to store statistics Measurement (mean/stddev) */
   class ShiftScaleParameters
@@ -163,6 +168,35 @@ protected:
    */
   SamplesWithLabel ExtractSamplesWithLabel(std::string parameterName, std::string parameterLayer, const ShiftScaleParameters& measurement);
 
+  /** Read the samples of the input files, without normalization
+   *
+   * \param parameterName the name of the input file option in the input application parameters
+   * \param parameterLayer the name of the layer option in the input application parameters
+   * \param addSample function called with the selected features and the label of each sample
+   * \param readFeatures if false, only the labels are read
+   */
+  void ReadSamples(std::string parameterName, std::string parameterLayer, const SampleCallbackType& addSample, bool readFeatures = true);
+
+  /** Read the samples of a sample store (see SampleExtraction)
+   *
+   * \param fileName the sample store file
+   * \param addSample function called with the selected features and the label of each sample
+   * \param readFeatures if false, only the labels are read
+   */
+  void ReadSampleStore(const std::string& fileName, const SampleCallbackType& addSample, bool readFeatures = true);
+
+  /** Train the model by chunks of the training samples (see the chunk
+   * parameter): the normalized samples are dealt to temporary sample
+   * stores, one per chunk, then the model is updated with each chunk.
+   * At most 64 stores are written at the same time, with one pass over
+   * the samples for each group of stores. The training lists hold the
+   * last chunk afterwards.
+   *
+   * \param measurement statics measurement (mean/stddev)
+   * \param chunkSize the number of samples per chunk
+   */
+  void ExtractAndTrainByChunks(const ShiftScaleParameters& measurement, unsigned int chunkSize);
+
 
   /**
    * Retrieve statistics mean and standard deviation if input statistics are provided.
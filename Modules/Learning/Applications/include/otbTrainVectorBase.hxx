@@ -21,6 +21,11 @@
 #define otbTrainVectorBase_hxx
 
 #include "otbTrainVectorBase.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <map>
+#include <memory>
 
 namespace otb
 {
@@ -35,7 +40,9 @@ void TrainVectorBase<TInputValue, TOutputValue>::DoInit()
   this->SetParameterDescription("io", "This group of parameters allows setting input and output data.");
 
   this->AddParameter(ParameterType_InputVectorDataList, "io.vd", "Input Vector Data");
-  this->SetParameterDescription("io.vd", "Input geometries used for training (note: all geometries from the layer will be used)");
+  this->SetParameterDescription("io.vd",
+                                "Input geometries used for training (note: all geometries from the layer will be used), "
+                                "or sample stores written by SampleExtraction");
 
   this->AddParameter(ParameterType_InputFilename, "io.stats", "Input XML image statistics file");
   this->MandatoryOff("io.stats");
@@ -79,6 +86,17 @@ void TrainVectorBase<TInputValue, TOutputValue>::DoInit()
   this->SetTypeFilter("cfield", { OFTString, OFTInteger, OFTInteger64, OFTReal });
   this->SetListViewSingleSelectionMode("cfield", true);
 
+  this->AddParameter(ParameterType_Int, "chunk", "Number of samples per training chunk");
+  this->SetParameterDescription("chunk",
+                                "Train the model by chunks of about this number of samples, so that the whole "
+                                "training set is never in memory. The samples of each class are dealt to the chunks in turn, "
+                                "so that every chunk has every class, the samples of a class smaller than the number of chunks "
+                                "being repeated. Only the ann, sharkrf and sharkkm models "
+                                "can be trained by chunks. 0 loads all the samples at once.");
+  this->MandatoryOff("chunk");
+  this->SetDefaultParameterInt("chunk", 0);
+  this->SetMinimumParameterIntValue("chunk", 0);
+
   this->AddParameter(ParameterType_Bool, "v", "Verbose mode");
   this->SetParameterDescription("v", "Verbose mode, display the contingency table result.");
   this->SetParameterInt("v", 1);
@@ -104,6 +122,29 @@ void TrainVectorBase<TInputValue, TOutputValue>::DoUpdateParameters()
   if (this->HasValue("io.vd"))
   {
     std::vector<std::string> vectorFileList = this->GetParameterStringList("io.vd");
+
+    // A sample store gives its feature names and its label name
+    if (SampleStoreReader::CanReadFile(vectorFileList[0]))
+    {
+      SampleStoreReader reader;
+      reader.Open(vectorFileList[0]);
+
+      this->ClearChoices("feat");
+      this->ClearChoices("cfield");
+      auto addChoice = [this](const std::string& parameter, const std::string& item) {
+        std::string           key = item;
+        std::string::iterator end = std::remove_if(key.begin(), key.end(), [](char c) { return !std::isalnum(c); });
+        std::transform(key.begin(), end, key.begin(), tolower);
+        this->AddChoice(parameter + "." + key.substr(0, static_cast<unsigned long>(end - key.begin())), item);
+      };
+      for (const auto& name : reader.GetFeatureNames())
+      {
+        addChoice("feat", name);
+      }
+      addChoice("cfield", reader.GetLabelName());
+      return;
+    }
+
     ogr::DataSource::Pointer ogrDS          = ogr::DataSource::New(vectorFileList[0], ogr::DataSource::Modes::Read);
     ogr::Layer               layer          = ogrDS->GetLayer(static_cast<size_t>(this->GetParameterInt("layer")));
     ogr::Feature             feature        = layer.ogr().GetNextFeature();
@@ -148,9 +189,18 @@ void TrainVectorBase<TInputValue, TOutputValue>::DoExecute()
   }
 
   ShiftScaleParameters measurement = GetStatistics(m_FeaturesInfo.m_NbFeatures);
-  ExtractAllSamples(measurement);
+  if (this->GetParameterInt("chunk") > 0)
+  {
+    ExtractAndTrainByChunks(measurement, static_cast<unsigned int>(this->GetParameterInt("chunk")));
+    // Without validation set, the performance is estimated on the last chunk
+    m_ClassificationSamplesWithLabel = ExtractClassificationSamplesWithLabel(measurement);
+  }
+  else
+  {
+    ExtractAllSamples(measurement);
 
-  this->Train(m_TrainingSamplesWithLabel.listSample, m_TrainingSamplesWithLabel.labeledListSample, this->GetParameterString("io.out"));
+    this->Train(m_TrainingSamplesWithLabel.listSample, m_TrainingSamplesWithLabel.labeledListSample, this->GetParameterString("io.out"));
+  }
 
   m_PredictedList = this->Classify(m_ClassificationSamplesWithLabel.listSample, this->GetParameterString("io.out"));
 }
@@ -232,104 +282,323 @@ TrainVectorBase<TInputValue, TOutputValue>::ExtractSamplesWithLabel(std::string
     typename TargetListSampleType::Pointer target = TargetListSampleType::New();
     input->SetMeasurementVectorSize(m_FeaturesInfo.m_NbFeatures);
 
-    std::vector<std::string> fileList = this->GetParameterStringList(parameterName);
-    for (unsigned int k = 0; k < fileList.size(); k++)
+    ReadSamples(parameterName, parameterLayer, [&input, &target](const MeasurementType& mv, ValueType label) {
+      input->PushBack(mv);
+      target->PushBack(label);
+    });
+
+    typename ShiftScaleFilterType::Pointer shiftScaleFilter = ShiftScaleFilterType::New();
+    shiftScaleFilter->SetInput(input);
+    shiftScaleFilter->SetShifts(measurement.meanMeasurementVector);
+    shiftScaleFilter->SetScales(measurement.stddevMeasurementVector);
+    shiftScaleFilter->Update();
+
+    samplesWithLabel.listSample        = shiftScaleFilter->GetOutput();
+    samplesWithLabel.labeledListSample = target;
+    samplesWithLabel.listSample->DisconnectPipeline();
+  }
+
+  return samplesWithLabel;
+}
+
+template <class TInputValue, class TOutputValue>
+void TrainVectorBase<TInputValue, TOutputValue>::ReadSamples(std::string parameterName, std::string parameterLayer, const SampleCallbackType& addSample,
+                                                             bool readFeatures)
+{
+  std::vector<std::string> fileList = this->GetParameterStringList(parameterName);
+  for (unsigned int k = 0; k < fileList.size(); k++)
+  {
+    if (SampleStoreReader::CanReadFile(fileList[k]))
+    {
+      otbAppLogINFO("Reading sample store " << k + 1 << "/" << fileList.size());
+      ReadSampleStore(fileList[k], addSample, readFeatures);
+      continue;
+    }
+
+    otbAppLogINFO("Reading vector file " << k + 1 << "/" << fileList.size());
+    ogr::DataSource::Pointer source  = ogr::DataSource::New(fileList[k], ogr::DataSource::Modes::Read);
+    ogr::Layer               layer   = source->GetLayer(static_cast<size_t>(this->GetParameterInt(parameterLayer)));
+    ogr::Feature             feature = layer.ogr().GetNextFeature();
+    bool                     goesOn  = feature.addr() != 0;
+    if (!goesOn)
     {
-      otbAppLogINFO("Reading vector file " << k + 1 << "/" << fileList.size());
-      ogr::DataSource::Pointer source  = ogr::DataSource::New(fileList[k], ogr::DataSource::Modes::Read);
-      ogr::Layer               layer   = source->GetLayer(static_cast<size_t>(this->GetParameterInt(parameterLayer)));
-      ogr::Feature             feature = layer.ogr().GetNextFeature();
-      bool                     goesOn  = feature.addr() != 0;
-      if (!goesOn)
+      otbAppLogWARNING("The layer " << this->GetParameterInt(parameterLayer) << " of " << fileList[k] << " is empty, input is skipped.");
+      continue;
+    }
+
+    // Check all needed fields are present :
+    //   - check class field if we use supervised classification or if class field name is not empty
+    int cFieldIndex = feature.ogr().GetFieldIndex(m_FeaturesInfo.m_SelectedCFieldName.c_str());
+    if (cFieldIndex < 0 && !m_FeaturesInfo.m_SelectedCFieldName.empty())
+    {
+      otbAppLogFATAL("The field name for class label (" << m_FeaturesInfo.m_SelectedCFieldName << ") has not been found in the vector file " << fileList[k]);
+    }
+
+    //   - check feature fields
+    std::vector<int> featureFieldIndex(m_FeaturesInfo.m_NbFeatures, -1);
+    for (unsigned int i = 0; i < m_FeaturesInfo.m_NbFeatures; i++)
+    {
+      featureFieldIndex[i] = feature.ogr().GetFieldIndex(m_FeaturesInfo.m_SelectedNames[i].c_str());
+      if (featureFieldIndex[i] < 0)
+        otbAppLogFATAL("The field name for feature " << m_FeaturesInfo.m_SelectedNames[i] << " has not been found in the vector file " << fileList[k]);
+    }
+
+
+    MeasurementType mv;
+    mv.SetSize(m_FeaturesInfo.m_NbFeatures);
+    mv.Fill(0.);
+    while (goesOn)
+    {
+      // Retrieve all the features for each field in the ogr layer.
+      for (unsigned int idx = 0; readFeatures && idx < m_FeaturesInfo.m_NbFeatures; ++idx)
       {
-        otbAppLogWARNING("The layer " << this->GetParameterInt(parameterLayer) << " of " << fileList[k] << " is empty, input is skipped.");
-        continue;
+        switch (feature[featureFieldIndex[idx]].GetType())
+        {
+        case OFTInteger:
+          mv[idx] = static_cast<ValueType>(feature[featureFieldIndex[idx]].GetValue<int>());
+          break;
+        case OFTInteger64:
+          mv[idx] = static_cast<ValueType>(feature[featureFieldIndex[idx]].GetValue<int>());
+          break;
+        case OFTReal:
+          mv[idx] = static_cast<ValueType>(feature[featureFieldIndex[idx]].GetValue<double>());
+          break;
+        default:
+          itkExceptionMacro(<< "incorrect field type: " << feature[featureFieldIndex[idx]].GetType() << ".");
+        }
       }
 
-      // Check all needed fields are present :
-      //   - check class field if we use supervised classification or if class field name is not empty
-      int cFieldIndex = feature.ogr().GetFieldIndex(m_FeaturesInfo.m_SelectedCFieldName.c_str());
-      if (cFieldIndex < 0 && !m_FeaturesInfo.m_SelectedCFieldName.empty())
+      ValueType label = 0.;
+      if (cFieldIndex >= 0 && ogr::Field(feature, cFieldIndex).HasBeenSet())
       {
-        otbAppLogFATAL("The field name for class label (" << m_FeaturesInfo.m_SelectedCFieldName << ") has not been found in the vector file " << fileList[k]);
+        switch (feature[cFieldIndex].GetType())
+        {
+        case OFTInteger:
+          label = static_cast<ValueType>(feature[cFieldIndex].GetValue<int>());
+          break;
+        case OFTInteger64:
+          label = static_cast<ValueType>(feature[cFieldIndex].GetValue<int>());
+          break;
+        case OFTReal:
+          label = static_cast<ValueType>(feature[cFieldIndex].GetValue<double>());
+          break;
+        case OFTString:
+          label = static_cast<ValueType>(std::stod(feature[cFieldIndex].GetValue<std::string>()));
+          break;
+        default:
+          itkExceptionMacro(<< "incorrect field type: " << feature[featureFieldIndex[cFieldIndex]].GetType() << ".");
+        }
       }
+      addSample(mv, label);
+
+      feature = layer.ogr().GetNextFeature();
+      goesOn  = feature.addr() != 0;
+    }
+  }
+}
 
-      //   - check feature fields
-      std::vector<int> featureFieldIndex(m_FeaturesInfo.m_NbFeatures, -1);
-      for (unsigned int i = 0; i < m_FeaturesInfo.m_NbFeatures; i++)
+template <class TInputValue, class TOutputValue>
+void TrainVectorBase<TInputValue, TOutputValue>::ReadSampleStore(const std::string& fileName, const SampleCallbackType& addSample, bool readFeatures)
+{
+  SampleStoreReader reader;
+  reader.Open(fileName);
+  if (reader.GetNumberOfSamples() == 0)
+  {
+    otbAppLogWARNING("The sample store " << fileName << " is empty, input is skipped.");
+    return;
+  }
+
+  // Check all needed columns are present
+  const bool hasLabel = !m_FeaturesInfo.m_SelectedCFieldName.empty();
+  if (hasLabel && reader.GetLabelName() != m_FeaturesInfo.m_SelectedCFieldName)
+  {
+    otbAppLogFATAL("The field name for class label (" << m_FeaturesInfo.m_SelectedCFieldName << ") is not the label of the sample store " << fileName
+                                                      << " (" << reader.GetLabelName() << ")");
+  }
+  std::vector<unsigned int> columns(m_FeaturesInfo.m_NbFeatures);
+  for (unsigned int i = 0; i < m_FeaturesInfo.m_NbFeatures; i++)
+  {
+    const int column = reader.GetFeatureIndex(m_FeaturesInfo.m_SelectedNames[i]);
+    if (column < 0)
+      otbAppLogFATAL("The field name for feature " << m_FeaturesInfo.m_SelectedNames[i] << " has not been found in the sample store " << fileName);
+    columns[i] = static_cast<unsigned int>(column);
+  }
+  if (!readFeatures)
+  {
+    columns.clear();
+  }
+
+  // Read the selected columns chunk by chunk
+  std::vector<float>  features(static_cast<std::size_t>(reader.GetChunkSize()) * columns.size());
+  std::vector<double> labels(reader.GetChunkSize());
+  MeasurementType     mv;
+  mv.SetSize(m_FeaturesInfo.m_NbFeatures);
+  mv.Fill(0.);
+  for (std::uint64_t chunk = 0; chunk < reader.GetNumberOfChunks(); ++chunk)
+  {
+    const std::size_t count = reader.ReadChunk(chunk, columns, features.data(), labels.data());
+    for (std::size_t k = 0; k < count; ++k)
+    {
+      for (unsigned int idx = 0; idx < columns.size(); ++idx)
       {
-        featureFieldIndex[i] = feature.ogr().GetFieldIndex(m_FeaturesInfo.m_SelectedNames[i].c_str());
-        if (featureFieldIndex[i] < 0)
-          otbAppLogFATAL("The field name for feature " << m_FeaturesInfo.m_SelectedNames[i] << " has not been found in the vector file " << fileList[k]);
+        mv[idx] = static_cast<ValueType>(features[k * columns.size() + idx]);
       }
+      addSample(mv, hasLabel ? static_cast<ValueType>(labels[k]) : 0.);
+    }
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+void TrainVectorBase<TInputValue, TOutputValue>::ExtractAndTrainByChunks(const ShiftScaleParameters& measurement, unsigned int chunkSize)
+{
+  // The samples of each class are dealt to the chunks in turn, so that a
+  // class with at least as many samples as chunks is in every chunk
+  const bool byClass = !this->m_RegressionFlag && this->GetClassifierCategory() == Superclass::Supervised;
+
+  if (!this->IsPartialFitSupported())
+  {
+    otbAppLogFATAL(<< "The model " << this->GetParameterString("classifier") << " cannot be trained by chunks.");
+  }
 
+  // First pass: count the samples of each class
+  std::map<ValueType, std::uint64_t> classSizes;
+  std::uint64_t                      numberOfSamples = 0;
+  ReadSamples("io.vd", "layer",
+              [&](const MeasurementType&, ValueType label) {
+                ++numberOfSamples;
+                ++classSizes[byClass ? label : 0.];
+              },
+              false);
+  if (numberOfSamples == 0)
+  {
+    otbAppLogFATAL(<< "No training sample found.");
+  }
+
+  // A class with fewer samples than chunks has its samples repeated, so
+  // that it is still in every chunk
+  const std::uint64_t numberOfChunks = (numberOfSamples + chunkSize - 1) / chunkSize;
+  for (const auto& classSize : classSizes)
+  {
+    if (classSize.second < numberOfChunks)
+    {
+      otbAppLogWARNING("Class " << classSize.first << " has only " << classSize.second << " samples for " << numberOfChunks
+                                << " chunks, its samples are repeated in the chunks.");
+    }
+  }
+
+  // The chunks are written by groups of stores open at the same time, with
+  // one pass over the samples per group
+  const std::uint64_t maxOpenStores  = 64;
+  const unsigned int  storeChunkSize = 256;
+  const std::uint64_t numberOfPasses = (numberOfChunks + maxOpenStores - 1) / maxOpenStores;
+  otbAppLogINFO("Splitting " << numberOfSamples << " training samples in " << numberOfChunks << " chunks, in " << numberOfPasses
+                             << " passes over the samples");
+
+  // Next passes: write the normalized samples of each chunk to a temporary
+  // sample store
+  MeasurementType invertedScales = measurement.stddevMeasurementVector;
+  for (unsigned int idx = 0; idx < invertedScales.Size(); ++idx)
+  {
+    invertedScales[idx] = measurement.stddevMeasurementVector[idx] - 1e-10 < 0. ? 0. : 1. / measurement.stddevMeasurementVector[idx];
+  }
+
+  std::vector<std::string> chunkFileNames(numberOfChunks);
+  for (std::uint64_t chunk = 0; chunk < numberOfChunks; ++chunk)
+  {
+    std::ostringstream oss;
+    oss << this->GetParameterString("io.out") << "_chunk" << chunk << ".otbs";
+    chunkFileNames[chunk] = oss.str();
+  }
+  auto removeChunkFiles = [&chunkFileNames](std::uint64_t first) {
+    for (std::uint64_t chunk = first; chunk < chunkFileNames.size(); ++chunk)
+    {
+      itksys::SystemTools::RemoveFile(chunkFileNames[chunk]);
+    }
+  };
 
-      while (goesOn)
+  try
+  {
+    std::vector<float> features(m_FeaturesInfo.m_NbFeatures);
+    for (std::uint64_t firstChunk = 0; firstChunk < numberOfChunks; firstChunk += maxOpenStores)
+    {
+      const std::uint64_t                             lastChunk = std::min(numberOfChunks, firstChunk + maxOpenStores);
+      std::vector<std::unique_ptr<SampleStoreWriter>> writers(lastChunk - firstChunk);
+      for (std::uint64_t chunk = firstChunk; chunk < lastChunk; ++chunk)
       {
-        // Retrieve all the features for each field in the ogr layer.
-        MeasurementType mv;
-        mv.SetSize(m_FeaturesInfo.m_NbFeatures);
-        for (unsigned int idx = 0; idx < m_FeaturesInfo.m_NbFeatures; ++idx)
+        writers[chunk - firstChunk].reset(new SampleStoreWriter);
+        writers[chunk - firstChunk]->Open(chunkFileNames[chunk], m_FeaturesInfo.m_SelectedNames, m_FeaturesInfo.m_SelectedCFieldName, storeChunkSize);
+      }
+
+      // The samples of each class are dealt to the chunks in turn, the
+      // same way at each pass
+      std::map<ValueType, std::uint64_t> dealt;
+      ReadSamples("io.vd", "layer", [&](const MeasurementType& mv, ValueType label) {
+        const ValueType     key       = byClass ? label : 0.;
+        const std::uint64_t index     = dealt[key]++;
+        const std::uint64_t classSize = classSizes[key];
+        const std::uint64_t step      = std::min(classSize, numberOfChunks);
+        bool                converted = false;
+        for (std::uint64_t chunk = index % numberOfChunks; chunk < lastChunk; chunk += step)
         {
-          switch (feature[featureFieldIndex[idx]].GetType())
+          if (chunk < firstChunk)
           {
-          case OFTInteger:
-            mv[idx] = static_cast<ValueType>(feature[featureFieldIndex[idx]].GetValue<int>());
-            break;
-          case OFTInteger64:
-            mv[idx] = static_cast<ValueType>(feature[featureFieldIndex[idx]].GetValue<int>());
-            break;
-          case OFTReal:
-            mv[idx] = static_cast<ValueType>(feature[featureFieldIndex[idx]].GetValue<double>());
-            break;
-          default:
-            itkExceptionMacro(<< "incorrect field type: " << feature[featureFieldIndex[idx]].GetType() << ".");
+            continue;
           }
-        }
-
-        input->PushBack(mv);
-
-        if (cFieldIndex >= 0 && ogr::Field(feature, cFieldIndex).HasBeenSet())
-        {
-          switch (feature[cFieldIndex].GetType())
+          if (!converted)
           {
-          case OFTInteger:
-            target->PushBack(static_cast<ValueType>(feature[cFieldIndex].GetValue<int>()));
-            break;
-          case OFTInteger64:
-            target->PushBack(static_cast<ValueType>(feature[cFieldIndex].GetValue<int>()));
-            break;
-          case OFTReal:
-            target->PushBack(static_cast<ValueType>(feature[cFieldIndex].GetValue<double>()));
-            break;
-          case OFTString:
-            target->PushBack(static_cast<ValueType>(std::stod(feature[cFieldIndex].GetValue<std::string>())));
-            break;
-          default:
-            itkExceptionMacro(<< "incorrect field type: " << feature[featureFieldIndex[cFieldIndex]].GetType() << ".");
+            for (unsigned int idx = 0; idx < m_FeaturesInfo.m_NbFeatures; ++idx)
+            {
+              features[idx] = static_cast<float>((mv[idx] - measurement.meanMeasurementVector[idx]) * invertedScales[idx]);
+            }
+            converted = true;
           }
+          writers[chunk - firstChunk]->Append(features.data(), label);
         }
-        else
-          target->PushBack(0.);
+      });
 
-        feature = layer.ogr().GetNextFeature();
-        goesOn  = feature.addr() != 0;
+      for (auto& writer : writers)
+      {
+        writer->Close();
       }
     }
-
-
-    typename ShiftScaleFilterType::Pointer shiftScaleFilter = ShiftScaleFilterType::New();
-    shiftScaleFilter->SetInput(input);
-    shiftScaleFilter->SetShifts(measurement.meanMeasurementVector);
-    shiftScaleFilter->SetScales(measurement.stddevMeasurementVector);
-    shiftScaleFilter->Update();
-
-    samplesWithLabel.listSample        = shiftScaleFilter->GetOutput();
-    samplesWithLabel.labeledListSample = target;
-    samplesWithLabel.listSample->DisconnectPipeline();
+  }
+  catch (...)
+  {
+    removeChunkFiles(0);
+    throw;
   }
 
-  return samplesWithLabel;
+  // Train on the chunks, each one read from its store and removed
+  std::uint64_t nextChunk = 0;
+  auto          readChunk = [&](ListSampleType* input, TargetListSampleType* target) {
+    if (nextChunk == numberOfChunks)
+    {
+      return false;
+    }
+    input->Clear();
+    target->Clear();
+    ReadSampleStore(chunkFileNames[nextChunk], [input, target](const MeasurementType& mv, ValueType label) {
+      input->PushBack(mv);
+      target->PushBack(label);
+    });
+    itksys::SystemTools::RemoveFile(chunkFileNames[nextChunk]);
+    ++nextChunk;
+    return true;
+  };
+
+  try
+  {
+    m_TrainingSamplesWithLabel = SamplesWithLabel();
+    m_TrainingSamplesWithLabel.listSample->SetMeasurementVectorSize(m_FeaturesInfo.m_NbFeatures);
+    readChunk(m_TrainingSamplesWithLabel.listSample, m_TrainingSamplesWithLabel.labeledListSample);
+    this->TrainByChunks(m_TrainingSamplesWithLabel.listSample, m_TrainingSamplesWithLabel.labeledListSample, readChunk,
+                        static_cast<unsigned int>(numberOfChunks), this->GetParameterString("io.out"));
+  }
+  catch (...)
+  {
+    removeChunkFiles(nextChunk);
+    throw;
+  }
 }
 }
 }
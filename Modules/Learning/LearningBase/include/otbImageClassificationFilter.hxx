@@ -25,6 +25,8 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 
+#include <vector>
+
 namespace otb
 {
 /**
@@ -237,17 +239,13 @@ void ImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::BatchThre
     maskIt.GoToBegin();
   }
 
-  typedef typename ModelType::InputSampleType          InputSampleType;
-  typedef typename ModelType::InputListSampleType      InputListSampleType;
-  typedef typename ModelType::TargetValueType          TargetValueType;
-  typedef typename ModelType::TargetListSampleType     TargetListSampleType;
-  typedef typename ModelType::ConfidenceListSampleType ConfidenceListSampleType;
-  typedef typename ModelType::ProbaListSampleType      ProbaListSampleType;
-  typename InputListSampleType::Pointer                samples      = InputListSampleType::New();
-  unsigned int                                         num_features = inputPtr->GetNumberOfComponentsPerPixel();
-  samples->SetMeasurementVectorSize(num_features);
-  InputSampleType sample(num_features);
-  // Fill the samples
+  typedef typename ModelType::TargetValueType     TargetValueType;
+  typedef typename ModelType::ConfidenceValueType ConfidenceValueType;
+
+  // Copy the valid pixels in a contiguous block, one pixel per row
+  const unsigned int     numberOfFeatures = inputPtr->GetNumberOfComponentsPerPixel();
+  std::vector<ValueType> features;
+  features.reserve(outputRegionForThread.GetNumberOfPixels() * numberOfFeatures);
   bool validPoint = true;
   for (inIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt)
   {
@@ -259,25 +257,22 @@ void ImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::BatchThre
     }
     if (validPoint)
     {
-      typename InputImageType::PixelType pix = inIt.Get();
-      for (size_t feat = 0; feat < num_features; ++feat)
+      const typename InputImageType::PixelType pix = inIt.Get();
+      for (unsigned int feat = 0; feat < numberOfFeatures; ++feat)
       {
-        sample[feat] = pix[feat];
+        features.push_back(pix[feat]);
       }
-      samples->PushBack(sample);
     }
   }
-  // Make the batch prediction
-  typename TargetListSampleType::Pointer     labels;
-  typename ConfidenceListSampleType::Pointer confidences;
-  typename ProbaListSampleType::Pointer      probas;
-  if (computeConfidenceMap)
-    confidences = ConfidenceListSampleType::New();
 
-  if (computeProbaMap)
-    probas = ProbaListSampleType::New();
+  // Make the batch prediction
+  const unsigned int               numberOfSamples = numberOfFeatures > 0 ? features.size() / numberOfFeatures : 0;
+  std::vector<TargetValueType>     labels(numberOfSamples);
+  std::vector<ConfidenceValueType> confidences(computeConfidenceMap ? numberOfSamples : 0);
+  std::vector<double>              probas(computeProbaMap ? numberOfSamples * m_NumberOfClasses : 0);
   // This call is threadsafe
-  labels = m_Model->PredictBatch(samples, confidences, probas);
+  m_Model->PredictBlock(features.data(), numberOfSamples, numberOfFeatures, labels.data(), computeConfidenceMap ? confidences.data() : nullptr,
+                        computeProbaMap ? probas.data() : nullptr, m_NumberOfClasses);
 
   // Set the output values
   ConfidenceMapIteratorType confidenceIt;
@@ -293,43 +288,38 @@ void ImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::BatchThre
     probaIt = ProbaMapIteratorType(probaPtr, outputRegionForThread);
     probaIt.GoToBegin();
   }
-  typename TargetListSampleType::ConstIterator labIt = labels->Begin();
-  maskIt.GoToBegin();
+  if (inputMaskPtr)
+  {
+    maskIt.GoToBegin();
+  }
+  unsigned int    id = 0;
+  ProbaSampleType probaValues{m_NumberOfClasses};
   for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
   {
-    double          confidenceIndex = 0.0;
-    TargetValueType labelValue(m_DefaultLabel);
-    ProbaSampleType probaValues{m_NumberOfClasses};
+    double    confidenceIndex = 0.0;
+    LabelType labelValue(m_DefaultLabel);
+    probaValues.Fill(0.);
     if (inputMaskPtr)
     {
       validPoint = maskIt.Get() > 0;
       ++maskIt;
     }
-    if (validPoint && labIt != labels->End())
+    if (validPoint && id < numberOfSamples)
     {
-      labelValue = labIt.GetMeasurementVector()[0];
+      labelValue = labels[id];
 
       if (computeConfidenceMap)
       {
-        confidenceIndex = confidences->GetMeasurementVector(labIt.GetInstanceIdentifier())[0];
+        confidenceIndex = confidences[id];
       }
       if (computeProbaMap)
       {
-        // The probas may have different size than the m_NumberOfClasses set by the user
-        auto tempProbaValues = probas->GetMeasurementVector(labIt.GetInstanceIdentifier());
         for (unsigned int i = 0; i < m_NumberOfClasses; ++i)
         {
-          if (i < tempProbaValues.Size())
-            probaValues[i] = tempProbaValues[i];
-          else
-            probaValues[i] = 0;
+          probaValues[i] = probas[id * m_NumberOfClasses + i];
         }
       }
-      ++labIt;
-    }
-    else
-    {
-      labelValue = m_DefaultLabel;
+      ++id;
     }
 
     outIt.Set(labelValue);
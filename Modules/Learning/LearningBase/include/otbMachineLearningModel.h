@@ -38,12 +38,17 @@ namespace otb
  * The main generic virtual methods specifically implemented in each classifier
  * derived from the MachineLearningModel class are two learning-related methods:
  * Train() and Save(), and three classification-related methods: Load(),
- * DoPredict() and optionally DoPredictBatch().
+ * DoPredict() and optionally DoPredictBatch() and DoPredictBlock().
  *
  * Thus, each classifier derived from the MachineLearningModel class
  * computes its corresponding model with Train() and exports it with
  * the help of the Save() method.
  *
+ * The models for which HasPartialFit() is true can also be trained
+ * incrementally: each call to PartialFit() updates the model with the
+ * current input and target lists, seen as one more chunk of the training
+ * set, so that the whole training set never has to be in memory.
+ *
  * It is also possible to classify any input sample composed of several
  * features (or any number of bands in the case of a pixel extracted
  * from a multi-band image) with the help of the Predict() method which
@@ -109,6 +114,18 @@ public:
   /** Train the machine learning model */
   virtual void Train() = 0;
 
+  /** Update the model with the samples of the input and target lists,
+   *  as one more chunk of the training set. The first call after
+   *  construction or ResetPartialFit() starts a new model. In
+   *  classification mode, the first chunk must contain every class. */
+  void PartialFit();
+
+  /** Start a new model at the next call to PartialFit() */
+  void ResetPartialFit();
+
+  /** Number of chunks the model was updated with by PartialFit() */
+  itkGetConstMacro(NumberOfPartialFits, unsigned int);
+
   /** Predict a single sample
     * \param input The sample
     * \param quality A pointer to the quality variable were to store
@@ -134,6 +151,20 @@ public:
   typename TargetListSampleType::Pointer PredictBatch(const InputListSampleType* input, ConfidenceListSampleType* quality = nullptr,
                                                       ProbaListSampleType* proba = nullptr) const;
 
+  /** Predict a block of samples stored contiguously, one sample per row:
+    * feature f of sample i is input[i * numberOfFeatures + f]
+    * \param targets Array receiving one label per sample
+    * \param quality Array receiving one confidence value per sample, or NULL
+    * \param proba Array receiving probaSize probabilities per sample, or
+    * NULL. The probabilities the model does not give are set to 0.
+    *
+    * No object is built per sample, and the models that can read the
+    * block directly do so. Like PredictBatch(), this method will be
+    * multi-threaded if OTB is built with OpenMP.
+     */
+  void PredictBlock(const InputValueType* input, unsigned int numberOfSamples, unsigned int numberOfFeatures, TargetValueType* targets,
+                    ConfidenceValueType* quality = nullptr, double* proba = nullptr, unsigned int probaSize = 0) const;
+
   /**\name Classification model file manipulation */
   //@{
   /** Save the model to file */
@@ -162,6 +193,11 @@ public:
   {
     return m_ProbaIndex;
   }
+  /** Query capacity to be trained incrementally with PartialFit() */
+  bool HasPartialFit() const
+  {
+    return m_IsPartialFitSupported;
+  }
 
   /**\name Input list of samples accessors */
   //@{
@@ -224,6 +260,14 @@ protected:
   /** Is DoPredictBatch multi-threaded ? */
   bool m_IsDoPredictBatchMultiThreaded;
 
+  /** flag that tells if the model implements DoPartialFit, child
+   *  classes should modify it in their constructor */
+  bool m_IsPartialFitSupported;
+
+  /** Number of calls to DoPartialFit since the last reset, 0 when the
+   *  next call starts a new model */
+  unsigned int m_NumberOfPartialFits;
+
   /** Output Dimension of the model, used by Dimensionality Reduction models*/
   unsigned int m_Dimension;
 
@@ -246,6 +290,21 @@ private:
   virtual void DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType* target,
                               ConfidenceListSampleType* quality = nullptr, ProbaListSampleType* proba = nullptr) const;
 
+  /**  Actual implementation of PredictBlock
+    *  Default implementation will call DoPredict on each row of the
+    *  block, without copying it.
+    *
+    * Override me if internal implementation can read the block directly.
+    */
+  virtual void DoPredictBlock(const InputValueType* input, unsigned int numberOfSamples, unsigned int numberOfFeatures, TargetValueType* targets,
+                              ConfidenceValueType* quality, double* proba, unsigned int probaSize) const;
+
+  /** Actual implementation of PartialFit
+   *  Default implementation throws, override me (and set
+   *  m_IsPartialFitSupported) if the model can be trained by chunks.
+   */
+  virtual void DoPartialFit();
+
   /** Actual implementation of single sample prediction
    *  \param input sample to predict
    *  \param quality Pointer to a variable to store confidence value,
@@ -39,6 +39,8 @@ MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::MachineLearni
     m_ConfidenceIndex(false),
     m_ProbaIndex(false),
     m_IsDoPredictBatchMultiThreaded(false),
+    m_IsPartialFitSupported(false),
+    m_NumberOfPartialFits(0),
     m_Dimension(0)
 {
 }
@@ -57,6 +59,38 @@ void MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::SetRegre
   }
 }
 
+template <class TInputValue, class TOutputValue, class TConfidenceValue>
+void MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::PartialFit()
+{
+  if (!m_IsPartialFitSupported)
+  {
+    itkExceptionMacro(<< "Incremental training not implemented for " << this->GetNameOfClass() << ".");
+  }
+  if (m_InputListSample.IsNull() || m_TargetListSample.IsNull() || m_InputListSample->Size() != m_TargetListSample->Size())
+  {
+    itkExceptionMacro(<< "Input and target lists of the chunk are missing or do not have the same size.");
+  }
+  if (m_InputListSample->Size() == 0)
+  {
+    return;
+  }
+  this->DoPartialFit();
+  ++m_NumberOfPartialFits;
+  this->Modified();
+}
+
+template <class TInputValue, class TOutputValue, class TConfidenceValue>
+void MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::ResetPartialFit()
+{
+  m_NumberOfPartialFits = 0;
+}
+
+template <class TInputValue, class TOutputValue, class TConfidenceValue>
+void MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::DoPartialFit()
+{
+  itkExceptionMacro(<< "Incremental training not implemented.");
+}
+
 template <class TInputValue, class TOutputValue, class TConfidenceValue>
 typename MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::TargetSampleType
 MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::Predict(const InputSampleType& input, ConfidenceValueType* quality,
@@ -177,6 +211,87 @@ void MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::DoPredic
   }
 }
 
+template <class TInputValue, class TOutputValue, class TConfidenceValue>
+void MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::PredictBlock(const InputValueType* input, unsigned int numberOfSamples,
+                                                                                     unsigned int numberOfFeatures, TargetValueType* targets,
+                                                                                     ConfidenceValueType* quality, double* proba, unsigned int probaSize) const
+{
+  assert(numberOfSamples == 0 || (input != nullptr && targets != nullptr));
+  assert(proba == nullptr || probaSize > 0);
+
+  if (numberOfSamples == 0)
+  {
+    return;
+  }
+  if (m_IsDoPredictBatchMultiThreaded)
+  {
+    // Simply calls DoPredictBlock
+    this->DoPredictBlock(input, numberOfSamples, numberOfFeatures, targets, quality, proba, probaSize);
+    return;
+  }
+#ifdef _OPENMP
+  // OpenMP threading here, with the same split as PredictBatch: each
+  // thread predicts a range of rows
+  unsigned int nb_threads(0), threadId(0), nb_batches(0);
+
+#pragma omp parallel shared(nb_threads, nb_batches) private(threadId)
+  {
+    // Get number of threads configured with ITK
+    omp_set_num_threads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
+    nb_threads = omp_get_num_threads();
+    threadId   = omp_get_thread_num();
+    nb_batches = std::min(nb_threads, numberOfSamples);
+    // Ensure that we do not spawn unnecessary threads
+    if (threadId < nb_batches)
+    {
+      unsigned int batch_size  = numberOfSamples / nb_batches;
+      unsigned int batch_start = threadId * batch_size;
+      if (threadId == nb_threads - 1)
+      {
+        batch_size += numberOfSamples % nb_batches;
+      }
+
+      this->DoPredictBlock(input + static_cast<std::size_t>(batch_start) * numberOfFeatures, batch_size, numberOfFeatures, targets + batch_start,
+                           quality != nullptr ? quality + batch_start : nullptr,
+                           proba != nullptr ? proba + static_cast<std::size_t>(batch_start) * probaSize : nullptr, probaSize);
+    }
+  }
+#else
+  this->DoPredictBlock(input, numberOfSamples, numberOfFeatures, targets, quality, proba, probaSize);
+#endif
+}
+
+template <class TInputValue, class TOutputValue, class TConfidenceValue>
+void MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::DoPredictBlock(const InputValueType* input, unsigned int numberOfSamples,
+                                                                                       unsigned int numberOfFeatures, TargetValueType* targets,
+                                                                                       ConfidenceValueType* quality, double* proba,
+                                                                                       unsigned int probaSize) const
+{
+  // The sample points to the current row of the block, it does not own it
+  InputSampleType sample;
+  ProbaSampleType probaSample;
+  for (unsigned int id = 0; id < numberOfSamples; ++id)
+  {
+    sample.SetData(const_cast<InputValueType*>(input + static_cast<std::size_t>(id) * numberOfFeatures), numberOfFeatures, false);
+
+    ConfidenceValueType    confidence = 0;
+    const TargetSampleType target     = this->DoPredict(sample, quality != nullptr ? &confidence : nullptr, proba != nullptr ? &probaSample : nullptr);
+    targets[id]                       = target[0];
+    if (quality != nullptr)
+    {
+      quality[id] = confidence;
+    }
+    if (proba != nullptr)
+    {
+      double* probaRow = proba + static_cast<std::size_t>(id) * probaSize;
+      for (unsigned int i = 0; i < probaSize; ++i)
+      {
+        probaRow[i] = i < probaSample.Size() ? probaSample[i] : 0.;
+      }
+    }
+  }
+}
+
 template <class TInputValue, class TOutputValue, class TConfidenceValue>
 void MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbEnvelopeRTree_h
+#define otbEnvelopeRTree_h
+
+#include "OTBSamplingExport.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace otb
+{
+
+/** \class EnvelopeRTree
+ * \brief Static R-tree of rectangles, to find the ones intersecting a
+ * query rectangle.
+ *
+ * The tree is packed with the Sort-Tile-Recursive algorithm (Leutenegger,
+ * Lopez and Edgington, 1997): the rectangles are sorted by the x of their
+ * center into vertical slices, then by y within each slice, and grouped
+ * by nodeCapacity into leaves. Each upper level groups nodeCapacity
+ * consecutive nodes of the level below. The tree is built once and cannot
+ * be modified.
+ *
+ * \sa PersistentSamplingFilterBase
+ *
+ * \ingroup OTBSampling
+ */
+class OTBSampling_EXPORT EnvelopeRTree
+{
+public:
+  /** Rectangle, bounds included */
+  struct Envelope
+  {
+    double MinX;
+    double MinY;
+    double MaxX;
+    double MaxY;
+  };
+
+  explicit EnvelopeRTree(unsigned int nodeCapacity = 16);
+
+  /** Build the tree over envelopes, which are identified in queries by
+   *  their position in this vector */
+  void Build(const std::vector<Envelope>& envelopes);
+
+  void Clear();
+
+  std::size_t GetNumberOfEnvelopes() const
+  {
+    return m_Items.size();
+  }
+
+  /** Positions of the envelopes intersecting box, in increasing order */
+  void Query(const Envelope& box, std::vector<std::size_t>& result) const;
+
+private:
+  struct Node
+  {
+    Envelope    envelope;
+    std::size_t first;
+    std::size_t count;
+  };
+
+  unsigned int m_NodeCapacity;
+
+  /** Positions of the envelopes, in the order of the leaves */
+  std::vector<std::size_t> m_Items;
+  std::vector<Envelope>    m_ItemEnvelopes;
+
+  /** Levels of nodes, from the leaves to the root. A node of level 0
+   *  covers a range of m_Items, a node of level l a range of level l-1. */
+  std::vector<std::vector<Node>> m_Levels;
+};
+
+} // end namespace otb
+
+#endif
@@ -25,6 +25,8 @@
 #include "otbPersistentFilterStreamingDecorator.h"
 #include "otbOGRDataSourceWrapper.h"
 #include "otbImage.h"
+#include "otbSampleStore.h"
+#include <memory>
 #include <string>
 
 namespace otb
@@ -35,6 +37,10 @@ namespace otb
  *
  * \brief Persistent filter to extract sample values from an image
  *
+ * The values are written as fields of the output samples, and/or in a
+ * sample store (see SampleStoreWriter) with the class field as label.
+ * When there are no output samples, only the sample store is written.
+ *
  * \ingroup OTBSampling
  */
 template <class TInputImage>
@@ -73,13 +79,17 @@ public:
   /** Get the output samples OGR container */
   ogr::DataSource* GetOutputSamples();
 
-  void Synthetize(void) override
-  {
-  }
+  /** Close the sample store */
+  void Synthetize(void) override;
 
   /** Reset method called before starting the streaming*/
   void Reset(void) override;
 
+  /** Set/Get the file name of the sample store (empty for none). The
+   *  labels come from the class field, converted to numbers. */
+  itkSetMacro(SampleStoreFileName, std::string);
+  itkGetMacro(SampleStoreFileName, std::string);
+
   itkSetMacro(SampleFieldPrefix, std::string);
   itkGetMacro(SampleFieldPrefix, std::string);
 
@@ -101,8 +111,14 @@ protected:
 
   void GenerateInputRequestedRegion() override;
 
+  /** Prepare the sample store buffers of each thread */
+  void BeforeThreadedGenerateData() override;
+
   /** process only points */
-  void ThreadedGenerateVectorData(const ogr::Layer& layerForThread, itk::ThreadIdType threadid) override;
+  void ProcessFeature(const ogr::Feature& feature, itk::ThreadIdType threadid) override;
+
+  /** Also append the samples of each thread to the sample store */
+  void GatherOutputVectors(void) override;
 
 private:
   PersistentImageSampleExtractorFilter(const Self&) = delete;
@@ -117,6 +133,14 @@ private:
 
   /** List of field names for each component */
   std::vector<std::string> m_SampleFieldNames;
+
+  std::string                        m_SampleStoreFileName;
+  std::unique_ptr<SampleStoreWriter> m_SampleStore;
+
+  /** Values and labels of the samples found by each thread, for the
+   *  sample store */
+  std::vector<std::vector<float>>  m_StoreValues;
+  std::vector<std::vector<double>> m_StoreLabels;
 };
 
 /**
@@ -175,6 +199,9 @@ public:
   void SetClassFieldName(const std::string& name);
   std::string GetClassFieldName(void);
 
+  void SetSampleStoreFileName(const std::string& name);
+  std::string GetSampleStoreFileName(void);
+
 protected:
   /** Constructor */
   ImageSampleExtractorFilter()
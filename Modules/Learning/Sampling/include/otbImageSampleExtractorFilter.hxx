@@ -83,7 +83,73 @@ void PersistentImageSampleExtractorFilter<TInputImage>::Reset(void)
   // initialize output DataSource
   ogr::DataSource* inputDS = const_cast<ogr::DataSource*>(this->GetOGRData());
   ogr::DataSource* output  = this->GetOutputSamples();
-  this->InitializeOutputDataSource(inputDS, output);
+  if (output)
+  {
+    this->InitializeOutputDataSource(inputDS, output);
+  }
+  else if (m_SampleStoreFileName.empty())
+  {
+    itkExceptionMacro(<< "No output samples and no sample store given");
+  }
+
+  m_SampleStore.reset();
+  if (!m_SampleStoreFileName.empty())
+  {
+    // The labels of a sample store are numbers
+    ogr::Layer         inLayer    = inputDS->GetLayer(this->GetLayerIndex());
+    OGRFeatureDefn&    layerDefn  = inLayer.GetLayerDefn();
+    const int          fieldIndex = layerDefn.GetFieldIndex(this->GetFieldName().c_str());
+    const OGRFieldType fieldType  = fieldIndex < 0 ? OFTString : layerDefn.GetFieldDefn(fieldIndex)->GetType();
+    if (fieldType != OFTInteger && fieldType != OFTInteger64 && fieldType != OFTReal)
+    {
+      itkExceptionMacro(<< "Class field " << this->GetFieldName() << " is not an integer or real field, it can not be written to the sample store "
+                        << m_SampleStoreFileName);
+    }
+
+    m_SampleStore.reset(new SampleStoreWriter);
+    m_SampleStore->Open(m_SampleStoreFileName, m_SampleFieldNames, this->GetFieldName());
+  }
+}
+
+template <class TInputImage>
+void PersistentImageSampleExtractorFilter<TInputImage>::Synthetize(void)
+{
+  if (m_SampleStore)
+  {
+    otbMsgDevMacro(<< "Wrote " << m_SampleStore->GetNumberOfSamples() << " samples in " << m_SampleStoreFileName);
+    m_SampleStore->Close();
+    m_SampleStore.reset();
+  }
+}
+
+template <class TInputImage>
+void PersistentImageSampleExtractorFilter<TInputImage>::BeforeThreadedGenerateData()
+{
+  const unsigned int numberOfThreads = m_SampleStore ? this->GetNumberOfThreads() : 0;
+  m_StoreValues.assign(numberOfThreads, std::vector<float>());
+  m_StoreLabels.assign(numberOfThreads, std::vector<double>());
+}
+
+template <class TInputImage>
+void PersistentImageSampleExtractorFilter<TInputImage>::GatherOutputVectors(void)
+{
+  Superclass::GatherOutputVectors();
+
+  // Threads have contiguous ranges of features, appending their samples
+  // in order keeps the order of the input layer
+  if (m_SampleStore)
+  {
+    const std::size_t nbBand = m_SampleFieldNames.size();
+    for (unsigned int thread = 0; thread < m_StoreLabels.size(); ++thread)
+    {
+      for (std::size_t k = 0; k < m_StoreLabels[thread].size(); ++k)
+      {
+        m_SampleStore->Append(m_StoreValues[thread].data() + k * nbBand, m_StoreLabels[thread][k]);
+      }
+    }
+  }
+  m_StoreValues.clear();
+  m_StoreLabels.clear();
 }
 
 template <class TInputImage>
@@ -150,46 +216,44 @@ void PersistentImageSampleExtractorFilter<TInputImage>::GenerateInputRequestedRe
 
 
 template <class TInputImage>
-void PersistentImageSampleExtractorFilter<TInputImage>::ThreadedGenerateVectorData(const ogr::Layer& layerForThread, itk::ThreadIdType threadid)
+void PersistentImageSampleExtractorFilter<TInputImage>::ProcessFeature(const ogr::Feature& feature, itk::ThreadIdType threadid)
 {
   // Retrieve inputs
   TInputImage* inputImage = const_cast<TInputImage*>(this->GetInput());
   unsigned int nbBand     = inputImage->GetNumberOfComponentsPerPixel();
 
-  ogr::Layer outputLayer = this->GetInMemoryOutput(threadid);
-
-  itk::ProgressReporter progress(this, threadid, layerForThread.GetFeatureCount(true));
+  const bool writeFields = this->GetOutputSamples() != nullptr;
+  const bool writeStore  = threadid < m_StoreLabels.size();
 
-  // Loop across the features in the layer (filtered by requested region in BeforeTGD already)
-  OGRGeometry* geom;
-  PointType    imgPoint;
-  IndexType    imgIndex;
-  PixelType    imgPixel;
-  double       imgComp;
+  // Features are filtered by requested region in DispatchInputVectors already
+  PointType imgPoint;
+  IndexType imgIndex;
+  PixelType imgPixel;
+  double    imgComp;
 
-  ogr::Layer::const_iterator featIt = layerForThread.begin();
-  for (; featIt != layerForThread.end(); ++featIt)
+  OGRGeometry* geom = feature.ogr().GetGeometryRef();
+  switch (geom->getGeometryType())
   {
-    geom = featIt->ogr().GetGeometryRef();
-    switch (geom->getGeometryType())
-    {
-    case wkbPoint:
-    case wkbPoint25D:
+  case wkbPoint:
+  case wkbPoint25D:
+  {
+    OGRPoint* castPoint = dynamic_cast<OGRPoint*>(geom);
+    if (castPoint == NULL)
     {
-      OGRPoint* castPoint = dynamic_cast<OGRPoint*>(geom);
-      if (castPoint == NULL)
-      {
-        // Wrong Type !
-        break;
-      }
-      imgPoint[0] = castPoint->getX();
-      imgPoint[1] = castPoint->getY();
-      inputImage->TransformPhysicalPointToIndex(imgPoint, imgIndex);
-      imgPixel = inputImage->GetPixel(imgIndex);
+      // Wrong Type !
+      break;
+    }
+    imgPoint[0] = castPoint->getX();
+    imgPoint[1] = castPoint->getY();
+    inputImage->TransformPhysicalPointToIndex(imgPoint, imgIndex);
+    imgPixel = inputImage->GetPixel(imgIndex);
 
+    if (writeFields)
+    {
+      ogr::Layer   outputLayer = this->GetInMemoryOutput(threadid);
       ogr::Feature dstFeature(outputLayer.GetLayerDefn());
-      dstFeature.SetFrom(*featIt, TRUE);
-      dstFeature.SetFID(featIt->GetFID());
+      dstFeature.SetFrom(feature, TRUE);
+      dstFeature.SetFID(feature.GetFID());
       for (unsigned int i = 0; i < nbBand; ++i)
       {
         imgComp = static_cast<double>(itk::DefaultConvertPixelTraits<PixelType>::GetNthComponent(i, imgPixel));
@@ -197,15 +261,22 @@ void PersistentImageSampleExtractorFilter<TInputImage>::ThreadedGenerateVectorDa
         dstFeature[m_SampleFieldNames[i]].SetValue(imgComp);
       }
       outputLayer.CreateFeature(dstFeature);
-      break;
     }
-    default:
+    if (writeStore)
     {
-      otbWarningMacro("Geometry not handled: " << geom->getGeometryName());
-      break;
-    }
+      for (unsigned int i = 0; i < nbBand; ++i)
+      {
+        m_StoreValues[threadid].push_back(static_cast<float>(itk::DefaultConvertPixelTraits<PixelType>::GetNthComponent(i, imgPixel)));
+      }
+      m_StoreLabels[threadid].push_back(feature.ogr().GetFieldAsDouble(this->GetFieldIndex()));
     }
-    progress.CompletedPixel();
+    break;
+  }
+  default:
+  {
+    otbWarningMacro("Geometry not handled: " << geom->getGeometryName());
+    break;
+  }
   }
 }
 
@@ -307,6 +378,18 @@ std::string ImageSampleExtractorFilter<TInputImage>::GetClassFieldName(void)
   return this->GetFilter()->GetFieldName();
 }
 
+template <class TInputImage>
+void ImageSampleExtractorFilter<TInputImage>::SetSampleStoreFileName(const std::string& name)
+{
+  this->GetFilter()->SetSampleStoreFileName(name);
+}
+
+template <class TInputImage>
+std::string ImageSampleExtractorFilter<TInputImage>::GetSampleStoreFileName(void)
+{
+  return this->GetFilter()->GetSampleStoreFileName();
+}
+
 } // end of namespace otb
 
 #endif
@@ -177,34 +177,13 @@ void PersistentOGRDataToSamplePositionFilter<TInputImage, TMaskImage, TSampler>:
 template <class TInputImage, class TMaskImage, class TSampler>
 void PersistentOGRDataToSamplePositionFilter<TInputImage, TMaskImage, TSampler>::DispatchInputVectors()
 {
-  TInputImage*     outputImage = this->GetOutput();
-  ogr::DataSource* vectors     = const_cast<ogr::DataSource*>(this->GetOGRData());
-  ogr::Layer       inLayer     = vectors->GetLayer(this->GetLayerIndex());
-
-  const RegionType&            requestedRegion = outputImage->GetRequestedRegion();
-  itk::ContinuousIndex<double> startIndex(requestedRegion.GetIndex());
-  itk::ContinuousIndex<double> endIndex(requestedRegion.GetUpperIndex());
-  startIndex[0] += -0.5;
-  startIndex[1] += -0.5;
-  endIndex[0] += 0.5;
-  endIndex[1] += 0.5;
-  itk::Point<double, 2> startPoint;
-  itk::Point<double, 2> endPoint;
-  outputImage->TransformContinuousIndexToPhysicalPoint(startIndex, startPoint);
-  outputImage->TransformContinuousIndexToPhysicalPoint(endIndex, endPoint);
-
-  // create geometric extent
-  OGRPolygon    tmpPolygon;
-  OGRLinearRing ring;
-  ring.addPoint(startPoint[0], startPoint[1], 0.0);
-  ring.addPoint(startPoint[0], endPoint[1], 0.0);
-  ring.addPoint(endPoint[0], endPoint[1], 0.0);
-  ring.addPoint(endPoint[0], startPoint[1], 0.0);
-  ring.addPoint(startPoint[0], startPoint[1], 0.0);
-  tmpPolygon.addRing(&ring);
-
-  inLayer.SetSpatialFilter(&tmpPolygon);
+  ogr::DataSource* vectors = const_cast<ogr::DataSource*>(this->GetOGRData());
+  ogr::Layer       inLayer = vectors->GetLayer(this->GetLayerIndex());
 
+  std::vector<ogr::Feature> features;
+  this->GetFeaturesInRequestedRegion(features);
+
+  // The samplers of a class are used by a single thread
   unsigned int            numberOfThreads = this->GetNumberOfThreads();
   std::vector<ogr::Layer> tmpLayers;
   for (unsigned int i = 0; i < numberOfThreads; i++)
@@ -212,19 +191,16 @@ void PersistentOGRDataToSamplePositionFilter<TInputImage, TMaskImage, TSampler>:
     tmpLayers.push_back(this->GetInMemoryInput(i));
   }
 
-  OGRFeatureDefn&            layerDefn = inLayer.GetLayerDefn();
-  ogr::Layer::const_iterator featIt    = inLayer.begin();
-  std::string                className;
-  for (; featIt != inLayer.end(); ++featIt)
+  OGRFeatureDefn& layerDefn = inLayer.GetLayerDefn();
+  std::string     className;
+  for (const auto& feature : features)
   {
     ogr::Feature dstFeature(layerDefn);
-    dstFeature.SetFrom(*featIt, TRUE);
-    dstFeature.SetFID(featIt->GetFID());
-    className = featIt->ogr().GetFieldAsString(this->GetFieldIndex());
+    dstFeature.SetFrom(feature, TRUE);
+    dstFeature.SetFID(feature.GetFID());
+    className = feature.ogr().GetFieldAsString(this->GetFieldIndex());
     tmpLayers[m_ClassPartition[className]].CreateFeature(dstFeature);
   }
-
-  inLayer.SetSpatialFilter(nullptr);
 }
 
 template <class TInputImage, class TMaskImage, class TSampler>
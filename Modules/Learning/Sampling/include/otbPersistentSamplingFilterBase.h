@@ -24,13 +24,26 @@
 #include "otbPersistentImageFilter.h"
 #include "otbOGRDataSourceWrapper.h"
 #include "otbImage.h"
+#include "otbEnvelopeRTree.h"
 #include <string>
+#include <vector>
 
 namespace otb
 {
 /** \class PersistentSamplingFilterBase
  *  \brief Base class for persistent filter doing sampling tasks
  *
+ *  The features intersecting each requested region are found with an
+ *  R-tree of the feature envelopes, built once for the input layer (see
+ *  UseSpatialIndex). They are then shared between the threads in
+ *  contiguous ranges of similar cost, estimated by the number of pixels
+ *  they cover, so that the outputs keep the order of the input layer.
+ *
+ *  When the image has no rotation, the pixels inside a polygon are found
+ *  row by row: the edges of the polygon crossing a row are selected once,
+ *  then each pixel of the row is tested against them with the same rule
+ *  as OGRLinearRing::isPointInRing().
+ *
  *  \note This class contains pure virtual method, and can not be instantiated.
  *
  * \sa PersistentOGRDataToClassStatisticsFilter
@@ -93,6 +106,13 @@ public:
   itkSetMacro(OutLayerName, std::string);
   itkGetMacro(OutLayerName, std::string);
 
+  /** Set/Get macro to find the features of each requested region with
+   *  an R-tree of the feature envelopes (default). It needs a layer
+   *  supporting random reads, otherwise the OGR spatial filter is used. */
+  itkSetMacro(UseSpatialIndex, bool);
+  itkGetMacro(UseSpatialIndex, bool);
+  itkBooleanMacro(UseSpatialIndex);
+
 protected:
   /** Constructor */
   PersistentSamplingFilterBase();
@@ -115,9 +135,14 @@ protected:
   /** Allocate in-memory layers for input and outputs */
   void AllocateOutputs(void) override;
 
-  /** Start of main processing loop */
+  /** Start of main processing loop, on the features of an in-memory
+   *  input layer (only used when DispatchInputVectors() fills them) */
   virtual void ThreadedGenerateVectorData(const ogr::Layer& layerForThread, itk::ThreadIdType threadid);
 
+  /** Process a feature: crop its bounding region to the requested region,
+   *  then call PrepareFeature() and ExploreGeometry() */
+  virtual void ProcessFeature(const ogr::Feature& feature, itk::ThreadIdType threadid);
+
   /** Process a geometry, recursive method when the geometry is a collection */
   void ExploreGeometry(const ogr::Feature& feature, OGRGeometry* geom, RegionType& region, itk::ThreadIdType& threadid);
 
@@ -142,10 +167,16 @@ protected:
 
   /** Get the region bounding a set of features */
   RegionType FeatureBoundingRegion(const TInputImage* image, otb::ogr::Layer::const_iterator& featIt) const;
+  RegionType FeatureBoundingRegion(const TInputImage* image, const ogr::Feature& feature) const;
+
+  /** Get the features of the input layer intersecting the requested
+   *  region, in the order of the layer */
+  void GetFeaturesInRequestedRegion(std::vector<ogr::Feature>& features);
 
-  /** Method to split the input OGRDataSource between several containers
-   *  for each thread. Default is to put the same number of features for
-   *  each thread.*/
+  /** Method to split the input features between the threads. Default is
+   *  to give each thread a contiguous range of features of the requested
+   *  region, with the same number of pixels to process. Overloads may fill
+   *  the in-memory input layers instead (see GetInMemoryInput()).*/
   virtual void DispatchInputVectors(void);
 
   /** Gather the content of in-memory output layer into the filter outputs */
@@ -216,6 +247,31 @@ private:
 
   /** In-memory containers storing position during iteration loop*/
   std::vector<std::vector<OGRDataPointer>> m_InMemoryOutputs;
+
+  /** Process the range of m_RegionFeatures given to a thread */
+  void ThreadedGenerateFeatureData(itk::ThreadIdType threadid, itk::ThreadIdType threadCount);
+
+  /** Build the spatial index if the input layer changed since last time.
+   *  Returns false if the index can not be used. */
+  bool UpdateSpatialIndex(ogr::Layer& layer);
+
+  /** Features of the requested region, and bounds of the range given to
+   *  each thread (empty when the in-memory input layers are used) */
+  std::vector<ogr::Feature> m_RegionFeatures;
+  std::vector<std::size_t>  m_FeatureRanges;
+
+  bool m_UseSpatialIndex;
+
+  /** R-tree of the feature envelopes, with the FID of each envelope */
+  EnvelopeRTree                        m_SpatialIndex;
+  std::vector<EnvelopeRTree::Envelope> m_IndexedEnvelopes;
+  std::vector<long>                    m_IndexedFIDs;
+  bool                                 m_SpatialIndexValid;
+
+  /** Data source and layer indexed, and time of the index */
+  const ogr::DataSource* m_IndexedData;
+  int                    m_IndexedLayer;
+  itk::TimeStamp         m_IndexTime;
 };
 } // End namespace otb
 
@@ -28,6 +28,7 @@
 #include "otbMacro.h"
 #include "otbStopwatch.h"
 #include "itkProgressReporter.h"
+#include <algorithm>
 
 namespace otb
 {
@@ -41,7 +42,11 @@ PersistentSamplingFilterBase<TInputImage, TMaskImage>::PersistentSamplingFilterB
     m_OGRLayerCreationOptions(),
     m_AdditionalFields(),
     m_InMemoryInputs(),
-    m_InMemoryOutputs()
+    m_InMemoryOutputs(),
+    m_UseSpatialIndex(true),
+    m_SpatialIndexValid(false),
+    m_IndexedData(nullptr),
+    m_IndexedLayer(-1)
 {
   this->SetNthOutput(0, TInputImage::New());
 }
@@ -151,7 +156,9 @@ void PersistentSamplingFilterBase<TInputImage, TMaskImage>::GenerateData(void)
   this->AllocateOutputs();
   this->BeforeThreadedGenerateData();
 
-  // Split the data into in-memory layers
+  // Split the features between threads
+  this->m_RegionFeatures.clear();
+  this->m_FeatureRanges.clear();
   this->DispatchInputVectors();
 
   // struct to store filter pointer
@@ -169,6 +176,8 @@ void PersistentSamplingFilterBase<TInputImage, TMaskImage>::GenerateData(void)
 
   // gather the data from in-memory output layers
   this->GatherOutputVectors();
+  this->m_RegionFeatures.clear();
+  this->m_FeatureRanges.clear();
 
   this->AfterThreadedGenerateData();
 }
@@ -320,30 +329,49 @@ void PersistentSamplingFilterBase<TInputImage, TMaskImage>::FillOneOutput(unsign
 template <class TInputImage, class TMaskImage>
 void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ThreadedGenerateVectorData(const ogr::Layer& layerForThread, itk::ThreadIdType threadid)
 {
-  // Retrieve inputs
-  TInputImage* inputImage      = const_cast<TInputImage*>(this->GetInput());
-  TInputImage* outputImage     = this->GetOutput();
-  RegionType   requestedRegion = outputImage->GetRequestedRegion();
-
   itk::ProgressReporter progress(this, threadid, layerForThread.GetFeatureCount(true));
 
-  // Loop across the features in the layer (filtered by requested region in BeforeTGD already)
+  // Loop across the features in the layer (filtered by requested region in DispatchInputVectors already)
   ogr::Layer::const_iterator featIt = layerForThread.begin();
   for (; featIt != layerForThread.end(); ++featIt)
   {
-    // Compute the intersection of thread region and polygon bounding region, called "considered region"
-    // This need not be done in ThreadedGenerateData and could be pre-processed and cached before filter execution if needed
-    RegionType consideredRegion = FeatureBoundingRegion(inputImage, featIt);
-    bool       regionNotEmpty   = consideredRegion.Crop(requestedRegion);
-    if (regionNotEmpty)
-    {
-      this->PrepareFeature(*featIt, threadid);
-      this->ExploreGeometry(*featIt, featIt->ogr().GetGeometryRef(), consideredRegion, threadid);
-    }
+    this->ProcessFeature(*featIt, threadid);
     progress.CompletedPixel();
   }
 }
 
+template <class TInputImage, class TMaskImage>
+void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ThreadedGenerateFeatureData(itk::ThreadIdType threadid, itk::ThreadIdType threadCount)
+{
+  // The last thread takes the remaining ranges if fewer threads are run
+  const std::size_t begin = m_FeatureRanges[threadid];
+  const std::size_t end   = (threadid + 1 == threadCount) ? m_FeatureRanges.back() : m_FeatureRanges[threadid + 1];
+
+  itk::ProgressReporter progress(this, threadid, end - begin);
+
+  for (std::size_t i = begin; i < end; ++i)
+  {
+    this->ProcessFeature(m_RegionFeatures[i], threadid);
+    progress.CompletedPixel();
+  }
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessFeature(const ogr::Feature& feature, itk::ThreadIdType threadid)
+{
+  const TInputImage* inputImage      = this->GetInput();
+  RegionType         requestedRegion = this->GetOutput()->GetRequestedRegion();
+
+  // Compute the intersection of thread region and polygon bounding region, called "considered region"
+  RegionType consideredRegion = FeatureBoundingRegion(inputImage, feature);
+  bool       regionNotEmpty   = consideredRegion.Crop(requestedRegion);
+  if (regionNotEmpty)
+  {
+    this->PrepareFeature(feature, threadid);
+    this->ExploreGeometry(feature, feature.ogr().GetGeometryRef(), consideredRegion, threadid);
+  }
+}
+
 template <class TInputImage, class TMaskImage>
 void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ExploreGeometry(const ogr::Feature& feature, OGRGeometry* geom, RegionType& region,
                                                                             itk::ThreadIdType& threadid)
@@ -491,6 +519,110 @@ void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessPolygon(const
   typename TInputImage::PointType imgPoint;
   OGRPoint                        tmpPoint;
 
+  typename TInputImage::DirectionType identity;
+  identity.SetIdentity();
+  if (img->GetDirection() == identity && polygon->getExteriorRing() != nullptr)
+  {
+    // Without rotation, all the pixels of a row have the same y: the edges
+    // of each ring crossing the row are selected once, then each pixel is
+    // tested against them only. The edge selection and the crossing test
+    // are the ones of OGRLinearRing::isPointInRing(), with the same
+    // arithmetic, so that the same pixels are found.
+    std::vector<const OGRLinearRing*> rings(1, polygon->getExteriorRing());
+    for (int k = 0; k < polygon->getNumInteriorRings(); k++)
+    {
+      rings.push_back(polygon->getInteriorRing(k));
+    }
+    std::vector<OGREnvelope> envelopes(rings.size());
+    for (unsigned int k = 0; k < rings.size(); k++)
+    {
+      rings[k]->getEnvelope(&envelopes[k]);
+    }
+
+    // Edges of each ring crossing the current row, stored as (x1, y1, x2, y2)
+    // with y relative to the row
+    std::vector<std::vector<double>> edges(rings.size());
+    auto isInRing = [&envelopes, &edges](unsigned int k, double x, double y) {
+      const OGREnvelope& env = envelopes[k];
+      if (!(x >= env.MinX && x <= env.MaxX && y >= env.MinY && y <= env.MaxY))
+      {
+        return false;
+      }
+      const std::vector<double>& rowEdges = edges[k];
+      bool                       inside   = false;
+      for (std::size_t i = 0; i < rowEdges.size(); i += 4)
+      {
+        const double x1 = rowEdges[i] - x;
+        const double y1 = rowEdges[i + 1];
+        const double x2 = rowEdges[i + 2] - x;
+        const double y2 = rowEdges[i + 3];
+        if (0.0 < (x1 * y2 - x2 * y1) / (y2 - y1))
+        {
+          inside = !inside;
+        }
+      }
+      return inside;
+    };
+
+    const typename TInputImage::IndexType start = region.GetIndex();
+    const typename TInputImage::SizeType  size  = region.GetSize();
+    for (unsigned long row = 0; row < size[1]; ++row)
+    {
+      imgIndex[0] = start[0];
+      imgIndex[1] = start[1] + row;
+      img->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
+      const double y = imgPoint[1];
+      for (unsigned int k = 0; k < rings.size(); k++)
+      {
+        edges[k].clear();
+        // As in OGRLinearRing::isPointInRing(), a ring of less than 4
+        // points contains no point
+        const int nbPoints = rings[k]->getNumPoints();
+        if (nbPoints < 4 || y < envelopes[k].MinY || y > envelopes[k].MaxY)
+        {
+          continue;
+        }
+        double prevX = rings[k]->getX(0);
+        double prevY = rings[k]->getY(0) - y;
+        for (int i = 1; i < nbPoints; i++)
+        {
+          const double curX = rings[k]->getX(i);
+          const double curY = rings[k]->getY(i) - y;
+          if ((curY > 0 && prevY <= 0) || (prevY > 0 && curY <= 0))
+          {
+            edges[k].insert(edges[k].end(), {curX, curY, prevX, prevY});
+          }
+          prevX = curX;
+          prevY = curY;
+        }
+      }
+      if (edges[0].empty())
+      {
+        continue;
+      }
+
+      for (unsigned long col = 0; col < size[0]; ++col)
+      {
+        imgIndex[0] = start[0] + col;
+        if (mask && !mask->GetPixel(imgIndex))
+        {
+          continue;
+        }
+        img->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
+        bool isInside = isInRing(0, imgPoint[0], imgPoint[1]);
+        for (unsigned int k = 1; isInside && k < rings.size(); k++)
+        {
+          isInside = !isInRing(k, imgPoint[0], imgPoint[1]);
+        }
+        if (isInside)
+        {
+          this->ProcessSample(feature, imgIndex, imgPoint, threadid);
+        }
+      }
+    }
+    return;
+  }
+
   if (mask)
   {
     // For pixels in consideredRegion and not masked
@@ -578,10 +710,17 @@ inline bool PersistentSamplingFilterBase<TInputImage, TMaskImage>::IsSampleOnLin
 template <class TInputImage, class TMaskImage>
 typename PersistentSamplingFilterBase<TInputImage, TMaskImage>::RegionType
 PersistentSamplingFilterBase<TInputImage, TMaskImage>::FeatureBoundingRegion(const TInputImage* image, otb::ogr::Layer::const_iterator& featIt) const
+{
+  return this->FeatureBoundingRegion(image, *featIt);
+}
+
+template <class TInputImage, class TMaskImage>
+typename PersistentSamplingFilterBase<TInputImage, TMaskImage>::RegionType
+PersistentSamplingFilterBase<TInputImage, TMaskImage>::FeatureBoundingRegion(const TInputImage* image, const ogr::Feature& feature) const
 {
   // otb::ogr wrapper is incomplete and leaky abstraction is inevitable here
   OGREnvelope envelope;
-  featIt->GetGeometry()->getEnvelope(&envelope);
+  feature.GetGeometry()->getEnvelope(&envelope);
   itk::Point<double, 2> lowerPoint, upperPoint;
   lowerPoint[0] = envelope.MinX;
   lowerPoint[1] = envelope.MinY;
@@ -617,6 +756,39 @@ PersistentSamplingFilterBase<TInputImage, TMaskImage>::FeatureBoundingRegion(con
 
 template <class TInputImage, class TMaskImage>
 void PersistentSamplingFilterBase<TInputImage, TMaskImage>::DispatchInputVectors()
+{
+  this->GetFeaturesInRequestedRegion(m_RegionFeatures);
+
+  // Estimate the cost of each feature by the number of pixels to test
+  const TInputImage*  inputImage      = this->GetInput();
+  const RegionType&   requestedRegion = this->GetOutput()->GetRequestedRegion();
+  std::vector<double> cumulatedCost;
+  cumulatedCost.reserve(m_RegionFeatures.size());
+  double totalCost = 0.0;
+  for (const auto& feature : m_RegionFeatures)
+  {
+    RegionType consideredRegion = FeatureBoundingRegion(inputImage, feature);
+    totalCost += 1.0;
+    if (consideredRegion.Crop(requestedRegion))
+    {
+      totalCost += consideredRegion.GetNumberOfPixels();
+    }
+    cumulatedCost.push_back(totalCost);
+  }
+
+  // Contiguous ranges of features with the same cost for each thread
+  unsigned int numberOfThreads = this->GetNumberOfThreads();
+  m_FeatureRanges.assign(numberOfThreads + 1, m_RegionFeatures.size());
+  m_FeatureRanges[0] = 0;
+  for (unsigned int i = 1; i < numberOfThreads; i++)
+  {
+    const double threshold = totalCost * i / numberOfThreads;
+    m_FeatureRanges[i]     = std::upper_bound(cumulatedCost.begin(), cumulatedCost.end(), threshold) - cumulatedCost.begin();
+  }
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentSamplingFilterBase<TInputImage, TMaskImage>::GetFeaturesInRequestedRegion(std::vector<ogr::Feature>& features)
 {
   TInputImage*     outputImage = this->GetOutput();
   ogr::DataSource* vectors     = const_cast<ogr::DataSource*>(this->GetOGRData());
@@ -644,38 +816,102 @@ void PersistentSamplingFilterBase<TInputImage, TMaskImage>::DispatchInputVectors
   ring.addPoint(startPoint[0], startPoint[1], 0.0);
   tmpPolygon.addRing(&ring);
 
-  inLayer.SetSpatialFilter(&tmpPolygon);
+  features.clear();
+  if (m_UseSpatialIndex && this->UpdateSpatialIndex(inLayer))
+  {
+    EnvelopeRTree::Envelope box;
+    box.MinX = std::min(startPoint[0], endPoint[0]);
+    box.MinY = std::min(startPoint[1], endPoint[1]);
+    box.MaxX = std::max(startPoint[0], endPoint[0]);
+    box.MaxY = std::max(startPoint[1], endPoint[1]);
+
+    std::vector<std::size_t> candidates;
+    m_SpatialIndex.Query(box, candidates);
+    for (std::size_t candidate : candidates)
+    {
+      OGRFeature* ogrFeature = inLayer.ogr().GetFeature(m_IndexedFIDs[candidate]);
+      if (ogrFeature == nullptr)
+      {
+        continue;
+      }
+      ogr::Feature feature(ogrFeature);
+      // Features with an envelope inside the extent intersect it, the
+      // others need the same exact test as the OGR spatial filter
+      const EnvelopeRTree::Envelope& envelope = m_IndexedEnvelopes[candidate];
+      const bool inside = envelope.MinX >= box.MinX && envelope.MaxX <= box.MaxX && envelope.MinY >= box.MinY && envelope.MaxY <= box.MaxY;
+      if (inside || feature.GetGeometry()->Intersects(&tmpPolygon))
+      {
+        features.push_back(feature);
+      }
+    }
+  }
+  else
+  {
+    inLayer.SetSpatialFilter(&tmpPolygon);
+    ogr::Layer::const_iterator featIt = inLayer.begin();
+    for (; featIt != inLayer.end(); ++featIt)
+    {
+      features.push_back(*featIt);
+    }
+    inLayer.SetSpatialFilter(nullptr);
+  }
+}
 
-  unsigned int            numberOfThreads = this->GetNumberOfThreads();
-  std::vector<ogr::Layer> tmpLayers;
-  tmpLayers.reserve(numberOfThreads);
-  for (unsigned int i = 0; i < numberOfThreads; i++)
+template <class TInputImage, class TMaskImage>
+bool PersistentSamplingFilterBase<TInputImage, TMaskImage>::UpdateSpatialIndex(ogr::Layer& layer)
+{
+  const ogr::DataSource* vectors = this->GetOGRData();
+  if (m_IndexedData == vectors && m_IndexedLayer == m_LayerIndex && vectors->GetMTime() < m_IndexTime.GetMTime())
   {
-    tmpLayers.push_back(this->GetInMemoryInput(i));
+    return m_SpatialIndexValid;
   }
 
-  const unsigned int nbFeatThread = std::ceil(inLayer.GetFeatureCount(true) / (float)numberOfThreads);
-  // assert(nbFeatThread > 0);
+  otb::Stopwatch chrono = otb::Stopwatch::StartNew();
+  m_IndexedData         = vectors;
+  m_IndexedLayer        = m_LayerIndex;
+  m_IndexTime.Modified();
+  m_SpatialIndex.Clear();
+  m_IndexedEnvelopes.clear();
+  m_IndexedFIDs.clear();
+
+  // Features are read back by FID, which needs random reads
+  m_SpatialIndexValid = layer.ogr().TestCapability(OLCRandomRead);
+  if (!m_SpatialIndexValid)
+  {
+    otbMsgDevMacro(<< "Layer " << layer.GetName() << " has no random read, using the OGR spatial filter");
+    return false;
+  }
 
-  OGRFeatureDefn&            layerDefn = inLayer.GetLayerDefn();
-  ogr::Layer::const_iterator featIt    = inLayer.begin();
-  unsigned int               counter   = 0;
-  unsigned int               cptFeat   = 0;
-  for (; featIt != inLayer.end(); ++featIt)
+  layer.SetSpatialFilter(nullptr);
+  ogr::Layer::const_iterator featIt = layer.begin();
+  for (; featIt != layer.end(); ++featIt)
   {
-    ogr::Feature dstFeature(layerDefn);
-    dstFeature.SetFrom(*featIt, TRUE);
-    dstFeature.SetFID(featIt->GetFID());
-    tmpLayers[counter].CreateFeature(dstFeature);
-    cptFeat++;
-    if (cptFeat > nbFeatThread && (counter + 1) < numberOfThreads)
+    const OGRGeometry* geom = featIt->GetGeometry();
+    if (geom == nullptr || geom->IsEmpty())
     {
-      counter++;
-      cptFeat = 0;
+      continue;
     }
+    if (featIt->GetFID() == OGRNullFID)
+    {
+      m_SpatialIndexValid = false;
+      break;
+    }
+    OGREnvelope envelope;
+    geom->getEnvelope(&envelope);
+    m_IndexedEnvelopes.push_back({envelope.MinX, envelope.MinY, envelope.MaxX, envelope.MaxY});
+    m_IndexedFIDs.push_back(featIt->GetFID());
   }
 
-  inLayer.SetSpatialFilter(nullptr);
+  if (!m_SpatialIndexValid)
+  {
+    m_IndexedEnvelopes.clear();
+    m_IndexedFIDs.clear();
+    return false;
+  }
+  m_SpatialIndex.Build(m_IndexedEnvelopes);
+  chrono.Stop();
+  otbMsgDevMacro(<< "Spatial index of " << m_IndexedFIDs.size() << " features built in " << chrono.GetElapsedMilliseconds() << " ms");
+  return true;
 }
 
 template <class TInputImage, class TMaskImage>
@@ -785,11 +1021,17 @@ ITK_THREAD_RETURN_TYPE PersistentSamplingFilterBase<TInputImage, TMaskImage>::Ve
   int threadId    = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
   int threadCount = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->NumberOfThreads;
 
-  ogr::Layer layer = str->Filter->GetInMemoryInput(threadId);
-
   if (threadId < threadCount)
   {
-    str->Filter->ThreadedGenerateVectorData(layer, threadId);
+    if (str->Filter->m_FeatureRanges.empty())
+    {
+      ogr::Layer layer = str->Filter->GetInMemoryInput(threadId);
+      str->Filter->ThreadedGenerateVectorData(layer, threadId);
+    }
+    else
+    {
+      str->Filter->ThreadedGenerateFeatureData(threadId, threadCount);
+    }
   }
 
   return ITK_THREAD_RETURN_VALUE;
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbEnvelopeRTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace otb
+{
+
+namespace
+{
+inline bool Intersects(const EnvelopeRTree::Envelope& a, const EnvelopeRTree::Envelope& b)
+{
+  return a.MinX <= b.MaxX && b.MinX <= a.MaxX && a.MinY <= b.MaxY && b.MinY <= a.MaxY;
+}
+
+inline void Expand(EnvelopeRTree::Envelope& a, const EnvelopeRTree::Envelope& b)
+{
+  a.MinX = std::min(a.MinX, b.MinX);
+  a.MinY = std::min(a.MinY, b.MinY);
+  a.MaxX = std::max(a.MaxX, b.MaxX);
+  a.MaxY = std::max(a.MaxY, b.MaxY);
+}
+}
+
+EnvelopeRTree::EnvelopeRTree(unsigned int nodeCapacity) : m_NodeCapacity(std::max(2u, nodeCapacity))
+{
+}
+
+void EnvelopeRTree::Clear()
+{
+  m_Items.clear();
+  m_ItemEnvelopes.clear();
+  m_Levels.clear();
+}
+
+void EnvelopeRTree::Build(const std::vector<Envelope>& envelopes)
+{
+  this->Clear();
+  const std::size_t n = envelopes.size();
+  if (n == 0)
+  {
+    return;
+  }
+
+  // Sort-Tile-Recursive packing of the leaves
+  m_Items.resize(n);
+  std::iota(m_Items.begin(), m_Items.end(), 0);
+  auto centerX = [&envelopes](std::size_t i) { return envelopes[i].MinX + envelopes[i].MaxX; };
+  auto centerY = [&envelopes](std::size_t i) { return envelopes[i].MinY + envelopes[i].MaxY; };
+  std::sort(m_Items.begin(), m_Items.end(), [&](std::size_t a, std::size_t b) { return centerX(a) < centerX(b); });
+
+  const std::size_t numberOfLeaves = (n + m_NodeCapacity - 1) / m_NodeCapacity;
+  const std::size_t numberOfSlices = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(numberOfLeaves))));
+  const std::size_t itemsPerSlice  = numberOfSlices * m_NodeCapacity;
+  for (std::size_t start = 0; start < n; start += itemsPerSlice)
+  {
+    const std::size_t end = std::min(n, start + itemsPerSlice);
+    std::sort(m_Items.begin() + start, m_Items.begin() + end, [&](std::size_t a, std::size_t b) { return centerY(a) < centerY(b); });
+  }
+
+  m_ItemEnvelopes.resize(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    m_ItemEnvelopes[i] = envelopes[m_Items[i]];
+  }
+
+  // Leaves, then upper levels until a single root
+  std::vector<Node> level;
+  for (std::size_t start = 0; start < n; start += m_NodeCapacity)
+  {
+    Node node;
+    node.first    = start;
+    node.count    = std::min<std::size_t>(m_NodeCapacity, n - start);
+    node.envelope = m_ItemEnvelopes[start];
+    for (std::size_t i = start + 1; i < start + node.count; ++i)
+    {
+      Expand(node.envelope, m_ItemEnvelopes[i]);
+    }
+    level.push_back(node);
+  }
+  m_Levels.push_back(level);
+
+  while (m_Levels.back().size() > 1)
+  {
+    const std::vector<Node>& below = m_Levels.back();
+    std::vector<Node>        above;
+    for (std::size_t start = 0; start < below.size(); start += m_NodeCapacity)
+    {
+      Node node;
+      node.first    = start;
+      node.count    = std::min<std::size_t>(m_NodeCapacity, below.size() - start);
+      node.envelope = below[start].envelope;
+      for (std::size_t i = start + 1; i < start + node.count; ++i)
+      {
+        Expand(node.envelope, below[i].envelope);
+      }
+      above.push_back(node);
+    }
+    m_Levels.push_back(above);
+  }
+}
+
+void EnvelopeRTree::Query(const Envelope& box, std::vector<std::size_t>& result) const
+{
+  result.clear();
+  if (m_Levels.empty())
+  {
+    return;
+  }
+
+  // Depth first search, with (level, node) pairs
+  std::vector<std::pair<std::size_t, std::size_t>> stack;
+  stack.emplace_back(m_Levels.size() - 1, 0);
+  while (!stack.empty())
+  {
+    const std::size_t level = stack.back().first;
+    const Node&       node  = m_Levels[level][stack.back().second];
+    stack.pop_back();
+    if (!Intersects(node.envelope, box))
+    {
+      continue;
+    }
+    if (level == 0)
+    {
+      for (std::size_t i = node.first; i < node.first + node.count; ++i)
+      {
+        if (Intersects(m_ItemEnvelopes[i], box))
+        {
+          result.push_back(m_Items[i]);
+        }
+      }
+    }
+    else
+    {
+      for (std::size_t i = node.first; i < node.first + node.count; ++i)
+      {
+        stack.emplace_back(level - 1, i);
+      }
+    }
+  }
+  std::sort(result.begin(), result.end());
+}
+
+} // end namespace otb
@@ -33,11 +33,12 @@ int otbOGRDataToClassStatisticsFilter(int argc, char* argv[])
 
   if (argc < 3)
   {
-    std::cout << "Usage : " << argv[0] << " input_vector  output_stats" << std::endl;
+    std::cout << "Usage : " << argv[0] << " input_vector  output_stats  [use_spatial_index]" << std::endl;
   }
 
   std::string vectorPath(argv[1]);
   std::string outputPath(argv[2]);
+  bool        useSpatialIndex = argc < 4 || atoi(argv[3]) != 0;
 
   otb::ogr::DataSource::Pointer vectors = otb::ogr::DataSource::New(vectorPath);
 
@@ -84,6 +85,7 @@ int otbOGRDataToClassStatisticsFilter(int argc, char* argv[])
   filter->SetOGRData(vectors);
   filter->SetFieldName(fieldName);
   filter->SetLayerIndex(0);
+  filter->GetFilter()->SetUseSpatialIndex(useSpatialIndex);
 
   filter->Update();
 
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFlatForest_h
+#define otbFlatForest_h
+
+#include "OTBSupervisedExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace otb
+{
+
+/** \class FlatForest
+ * \brief Forest of binary decision trees stored in flat arrays, evaluated
+ * over blocks of samples.
+ *
+ * The trees of a trained forest are copied once in a structure of arrays:
+ * feature index, threshold and children of every node, each tree laid out
+ * breadth first so that the top levels, visited by every sample, share a
+ * few cache lines. A leaf is its own child, so every sample of a block
+ * goes down a tree in the same number of steps, given by the depth of
+ * the tree, with a loop free of branches that the compiler can vectorize.
+ *
+ * Thresholds are stored as float, rounded down: for float features, the
+ * test x <= threshold gives the same result as with the original
+ * threshold. A NaN feature goes to the right child.
+ *
+ * In classification, the value of a leaf is a class index in
+ * [0, numberOfClasses[ and the forest counts the votes of the trees. In
+ * regression (numberOfClasses = 0), it gives the mean of the leaf values.
+ *
+ * \sa RandomForestsMachineLearningModel
+ *
+ * \ingroup OTBSupervised
+ */
+class OTBSupervised_EXPORT FlatForest
+{
+public:
+  /** Node of a tree given to AddTree(). A leaf has a negative feature.
+   *  The left child is taken when the feature is lower than or equal to
+   *  the threshold. */
+  struct TreeNode
+  {
+    int    feature;
+    double threshold;
+    int    left;
+    int    right;
+    double value;
+  };
+
+  FlatForest();
+
+  /** Remove all the trees and set the number of classes, 0 for a
+   *  regression forest */
+  void Initialize(unsigned int numberOfClasses);
+
+  /** Append the tree starting at node root of nodes. Throws if the node
+   *  indices are out of range or if the nodes do not form a tree. */
+  void AddTree(const std::vector<TreeNode>& nodes, int root);
+
+  bool IsEmpty() const
+  {
+    return m_Roots.empty();
+  }
+
+  unsigned int GetNumberOfTrees() const
+  {
+    return static_cast<unsigned int>(m_Roots.size());
+  }
+
+  std::size_t GetNumberOfNodes() const
+  {
+    return m_Feature.size();
+  }
+
+  unsigned int GetNumberOfClasses() const
+  {
+    return m_NumberOfClasses;
+  }
+
+  /** Smallest number of features a sample must have */
+  unsigned int GetNumberOfFeatures() const
+  {
+    return m_NumberOfFeatures;
+  }
+
+  /** Count the votes of the trees for numberOfSamples samples stored one
+   *  per row in samples. votes receives numberOfClasses counts per sample. */
+  void PredictVotes(const float* samples, std::size_t numberOfSamples, unsigned int numberOfFeatures, unsigned int* votes) const;
+
+  /** Mean of the values of the trees for numberOfSamples samples stored
+   *  one per row in samples */
+  void PredictMean(const float* samples, std::size_t numberOfSamples, unsigned int numberOfFeatures, double* output) const;
+
+private:
+  /** Number of samples going down a tree together */
+  static const std::size_t BlockSize = 64;
+
+  /** Find the leaves of tree for the samples of a block */
+  void FindLeaves(unsigned int tree, const float* samples, std::size_t numberOfSamples, unsigned int numberOfFeatures, std::int32_t* leaves) const;
+
+  unsigned int m_NumberOfClasses;
+  unsigned int m_NumberOfFeatures;
+
+  /** Nodes, as a structure of arrays */
+  std::vector<std::int32_t> m_Feature;
+  std::vector<float>        m_Threshold;
+  std::vector<std::int32_t> m_Left;
+  std::vector<std::int32_t> m_Right;
+  std::vector<double>       m_Value;
+
+  /** Root and depth of each tree */
+  std::vector<std::int32_t> m_Roots;
+  std::vector<unsigned int> m_Depths;
+};
+
+} // end namespace otb
+
+#endif
@@ -275,6 +275,10 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  /** Predict a block of samples, reusing the same nodes for all of them */
+  void DoPredictBlock(const InputValueType* input, unsigned int numberOfSamples, unsigned int numberOfFeatures, TargetValueType* targets,
+                      ConfidenceValueType* quality, double* proba, unsigned int probaSize) const override;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -292,6 +296,10 @@ private:
 
   void OptimizeParameters(void);
 
+  /** Predict the sample held by the nodes x. estimates is resized to hold
+   *  the probabilities or decision values computed by libSVM. */
+  TargetValueType PredictNodes(const struct svm_node* x, ConfidenceValueType* quality, std::vector<double>& estimates) const;
+
   /** Container to hold the SVM model itself */
   struct svm_model* m_Model;
 
@@ -27,6 +27,8 @@
 #include "otbExhaustiveExponentialOptimizer.h"
 #include "otbMacro.h"
 #include "otbUtils.h"
+#include <algorithm>
+#include <vector>
 
 namespace otb
 {
@@ -105,12 +107,11 @@ LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSamp
   TargetSampleType target;
   target.Fill(0);
 
-  // Get type and number of classes
-  int svm_type = svm_get_svm_type(m_Model);
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
 
-  // Allocate nodes (/TODO if performances problems are related to too
-  // many allocations, a cache approach can be set)
-  struct svm_node* x = new struct svm_node[input.Size() + 1];
+  // Allocate nodes
+  std::vector<struct svm_node> x(input.Size() + 1);
 
   // Fill the node
   for (unsigned int i = 0; i < input.Size(); i++)
@@ -122,9 +123,57 @@ LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSamp
   // terminate node
   x[input.Size()].index = -1;
   x[input.Size()].value = 0;
+
+  std::vector<double> estimates;
+  target[0] = this->PredictNodes(x.data(), quality, estimates);
+
+  return target;
+}
+
+template <class TInputValue, class TOutputValue>
+void LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredictBlock(const InputValueType* input, unsigned int numberOfSamples,
+                                                                            unsigned int numberOfFeatures, TargetValueType* targets,
+                                                                            ConfidenceValueType* quality, double* proba, unsigned int) const
+{
   if (proba != nullptr && !this->m_ProbaIndex)
     itkExceptionMacro("Probability per class not available for this classifier !");
 
+  // The nodes and the estimates are allocated once for the whole block
+  std::vector<struct svm_node> x(numberOfFeatures + 1);
+  for (unsigned int j = 0; j < numberOfFeatures; ++j)
+  {
+    x[j].index = j + 1;
+  }
+  x[numberOfFeatures].index = -1;
+  x[numberOfFeatures].value = 0;
+
+  std::vector<double> estimates;
+  for (unsigned int i = 0; i < numberOfSamples; ++i)
+  {
+    const InputValueType* sample = input + static_cast<std::size_t>(i) * numberOfFeatures;
+    for (unsigned int j = 0; j < numberOfFeatures; ++j)
+    {
+      x[j].value = sample[j];
+    }
+    targets[i] = this->PredictNodes(x.data(), quality != nullptr ? quality + i : nullptr, estimates);
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+typename LibSVMMachineLearningModel<TInputValue, TOutputValue>::TargetValueType
+LibSVMMachineLearningModel<TInputValue, TOutputValue>::PredictNodes(const struct svm_node* x, ConfidenceValueType* quality,
+                                                                    std::vector<double>& estimates) const
+{
+  // Get type and number of classes
+  int          svm_type = svm_get_svm_type(m_Model);
+  unsigned int nr_class = svm_get_nr_class(m_Model);
+
+  // Room for the probability estimates or the decision values of all the
+  // pairs of classes
+  estimates.resize(std::max(1u, std::max(nr_class, nr_class * (nr_class - 1) / 2)));
+
+  TargetValueType target = 0;
+
   if (quality != nullptr)
   {
     if (!this->m_ConfidenceIndex)
@@ -135,32 +184,27 @@ LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSamp
     {
       if (svm_type == C_SVC || svm_type == NU_SVC)
       {
-        // Eventually allocate space for probabilities
-        unsigned int nr_class       = svm_get_nr_class(m_Model);
-        double*      prob_estimates = new double[nr_class];
         // predict
-        target[0]      = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, prob_estimates));
+        target         = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, estimates.data()));
         double maxProb = 0.0;
         double secProb = 0.0;
         for (unsigned int i = 0; i < nr_class; ++i)
         {
-          if (maxProb < prob_estimates[i])
+          if (maxProb < estimates[i])
           {
             secProb = maxProb;
-            maxProb = prob_estimates[i];
+            maxProb = estimates[i];
           }
-          else if (secProb < prob_estimates[i])
+          else if (secProb < estimates[i])
           {
-            secProb = prob_estimates[i];
+            secProb = estimates[i];
           }
         }
         (*quality) = static_cast<ConfidenceValueType>(maxProb - secProb);
-
-        delete[] prob_estimates;
       }
       else
       {
-        target[0] = static_cast<TargetValueType>(svm_predict(m_Model, x));
+        target = static_cast<TargetValueType>(svm_predict(m_Model, x));
         // Prob. model for test data: target value = predicted value + z
         // z: Laplace distribution e^(-|z|/sigma)/(2sigma)
         // sigma is output as confidence index
@@ -169,11 +213,13 @@ LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSamp
     }
     else if (this->m_ConfidenceMode == CM_PROBA)
     {
-      target[0] = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, quality));
+      target     = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, estimates.data()));
+      (*quality) = static_cast<ConfidenceValueType>(estimates[0]);
     }
     else if (this->m_ConfidenceMode == CM_HYPER)
     {
-      target[0] = static_cast<TargetValueType>(svm_predict_values(m_Model, x, quality));
+      target     = static_cast<TargetValueType>(svm_predict_values(m_Model, x, estimates.data()));
+      (*quality) = static_cast<ConfidenceValueType>(estimates[0]);
     }
   }
   else
@@ -182,20 +228,14 @@ LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSamp
     // which gives different results than svm_predict()
     if (svm_check_probability_model(m_Model))
     {
-      unsigned int nr_class       = svm_get_nr_class(m_Model);
-      double*      prob_estimates = new double[nr_class];
-      target[0]                   = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, prob_estimates));
-      delete[] prob_estimates;
+      target = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, estimates.data()));
     }
     else
     {
-      target[0] = static_cast<TargetValueType>(svm_predict(m_Model, x));
+      target = static_cast<TargetValueType>(svm_predict(m_Model, x));
     }
   }
 
-  // Free allocated memory
-  delete[] x;
-
   return target;
 }
 
@@ -179,6 +179,11 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  /** Train the network on the first chunk, then update its weights with
+   *  the next ones (with the BACKPROP train method, this is a stochastic
+   *  gradient descent over the chunks) */
+  void DoPartialFit() override;
+
   void LabelsToMat(const TargetListSampleType* listSample, cv::Mat& output);
 
   /** PrintSelf method */
@@ -189,7 +194,7 @@ private:
   void operator=(const Self&) = delete;
 
   void CreateNetwork();
-  void SetupNetworkAndTrain(cv::Mat& labels);
+  void SetupNetworkAndTrain(cv::Mat& labels, bool updateWeights = false);
   cv::Ptr<cv::ml::ANN_MLP> m_ANNModel;
   int                       m_TrainMethod;
   int                       m_ActivateFunction;
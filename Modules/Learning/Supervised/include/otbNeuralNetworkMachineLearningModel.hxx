@@ -46,6 +46,7 @@ NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::NeuralNetworkMachi
 {
   this->m_ConfidenceIndex       = true;
   this->m_IsRegressionSupported = true;
+  this->m_IsPartialFitSupported = true;
 }
 
 /** Sets the topology of the NN */
@@ -141,13 +142,21 @@ void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::CreateNetwork
 
 
 template <class TInputValue, class TOutputValue>
-void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::SetupNetworkAndTrain(cv::Mat& labels)
+void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::SetupNetworkAndTrain(cv::Mat& labels, bool updateWeights)
 {
   // convert listsample to opencv matrix
   cv::Mat samples;
   otb::ListSampleToMat<InputListSampleType>(this->GetInputListSample(), samples);
-  this->CreateNetwork();
+  // Creating the network resets its weights
+  if (!updateWeights)
+  {
+    this->CreateNetwork();
+  }
   int flags = (this->m_RegressionMode ? 0 : cv::ml::ANN_MLP::NO_OUTPUT_SCALE);
+  if (updateWeights)
+  {
+    flags |= cv::ml::ANN_MLP::UPDATE_WEIGHTS;
+  }
   m_ANNModel->setTrainMethod(m_TrainMethod);
   m_ANNModel->setBackpropMomentumScale(m_BackPropMomentScale);
   m_ANNModel->setBackpropWeightScale(m_BackPropDWScale);
@@ -179,6 +188,38 @@ void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::Train()
   this->SetupNetworkAndTrain(matOutputANN);
 }
 
+template <class TInputValue, class TOutputValue>
+void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::DoPartialFit()
+{
+  const bool firstChunk = this->m_NumberOfPartialFits == 0;
+  cv::Mat    matOutputANN;
+  if (this->m_RegressionMode)
+  {
+    otb::ListSampleToMat<TargetListSampleType>(this->GetTargetListSample(), matOutputANN);
+  }
+  else
+  {
+    // The classes, hence the output neurons, are the ones of the first chunk
+    if (firstChunk)
+    {
+      m_MapOfLabels.clear();
+    }
+    else
+    {
+      const TargetListSampleType* labels = this->GetTargetListSample();
+      for (typename TargetListSampleType::ConstIterator it = labels->Begin(); it != labels->End(); ++it)
+      {
+        if (m_MapOfLabels.count(it.GetMeasurementVector()[0]) == 0)
+        {
+          itkExceptionMacro(<< "Class " << it.GetMeasurementVector()[0] << " was not in the first chunk of samples.");
+        }
+      }
+    }
+    LabelsToMat(this->GetTargetListSample(), matOutputANN);
+  }
+  this->SetupNetworkAndTrain(matOutputANN, !firstChunk);
+}
+
 template <class TInputValue, class TOutputValue>
 typename NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::TargetSampleType
 NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSampleType& input, ConfidenceValueType* quality,
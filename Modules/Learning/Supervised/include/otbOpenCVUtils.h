@@ -78,6 +78,29 @@ void SampleToMat(const T& sample, cv::Mat& output)
 }
 
 
+/** Converts a block of samples stored contiguously, one sample per row, to
+ *  a cv::Mat with one sample per row. */
+template <class T>
+void BlockToMat(const T* block, unsigned int numberOfSamples, unsigned int numberOfFeatures, cv::Mat& output)
+{
+  output.create(numberOfSamples, numberOfFeatures, CV_32FC1);
+  for (unsigned int i = 0; i < numberOfSamples; ++i)
+  {
+    const T* sample = block + static_cast<std::size_t>(i) * numberOfFeatures;
+    float*   row    = output.ptr<float>(i);
+    for (unsigned int j = 0; j < numberOfFeatures; ++j)
+    {
+      row[j] = sample[j];
+    }
+  }
+}
+
+/** Same as above, for float samples the block is used without copy */
+inline void BlockToMat(const float* block, unsigned int numberOfSamples, unsigned int numberOfFeatures, cv::Mat& output)
+{
+  output = cv::Mat(numberOfSamples, numberOfFeatures, CV_32FC1, const_cast<float*>(block));
+}
+
 /** Converts a ListSample of VariableLengthVector to a CvMat. The user
  *  is responsible for freeing the output pointer with the
  *  cvReleaseMat function.  A null pointer is resturned in case the
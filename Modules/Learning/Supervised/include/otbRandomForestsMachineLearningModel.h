@@ -28,6 +28,7 @@
 #include "otbMachineLearningModel.h"
 #include "itkVariableSizeMatrix.h"
 #include "otbCvRTreesWrapper.h"
+#include "otbFlatForest.h"
 
 namespace otb
 {
@@ -123,6 +124,19 @@ public:
   itkGetMacro(ComputeMargin, bool);
   itkSetMacro(ComputeMargin, bool);
 
+  /** Predict with a flattened copy of the forest, built when the model is
+   * trained or loaded, instead of the OpenCV trees. It gives the same
+   * results, and is not used if the forest has categorical splits.
+   * Default is true. */
+  itkGetMacro(UseFlatForest, bool);
+  itkSetMacro(UseFlatForest, bool);
+
+  /** Tells whether the flattened copy of the forest is available */
+  bool HasFlatForest() const
+  {
+    return !m_FlatForest.IsEmpty();
+  }
+
   /** Returns a matrix containing variable importance */
   VariableImportanceMatrixType GetVariableImportance();
 
@@ -138,6 +152,10 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  /** Predict a block of samples with a single call to OpenCV */
+  void DoPredictBlock(const InputValueType* input, unsigned int numberOfSamples, unsigned int numberOfFeatures, TargetValueType* targets,
+                      ConfidenceValueType* quality, double* proba, unsigned int probaSize) const override;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -151,8 +169,19 @@ private:
   RandomForestsMachineLearningModel(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Build m_FlatForest from the OpenCV trees */
+  void FlattenForest();
+
+  /** Predict the rows of samples, a continuous CV_32FC1 matrix, with m_FlatForest */
+  void PredictFlat(const cv::Mat& samples, TargetValueType* targets, ConfidenceValueType* quality) const;
+
   cv::Ptr<CvRTreesWrapper> m_RFModel;
 
+  /** Flattened copy of m_RFModel, empty if it cannot be flattened */
+  FlatForest m_FlatForest;
+  /** Label of each class index of m_FlatForest */
+  std::vector<double> m_FlatClassLabels;
+
   /** The depth of the tree. A low value will likely underfit and conversely a
    * high value will likely overfit. The optimal value can be obtained using cross
    * validation or other suitable methods. */
@@ -216,6 +245,8 @@ private:
    * 2 most voted classes) instead of confidence (probability of the most
    * voted class) in prediction*/
   bool m_ComputeMargin;
+  /** Whether to predict with m_FlatForest */
+  bool m_UseFlatForest;
 };
 } // end namespace otb
 
@@ -25,6 +25,9 @@
 #include "itkMacro.h"
 #include "otbRandomForestsMachineLearningModel.h"
 #include "otbOpenCVUtils.h"
+#include "otbMacro.h"
+#include <algorithm>
+#include <vector>
 
 namespace otb
 {
@@ -43,7 +46,8 @@ RandomForestsMachineLearningModel<TInputValue, TOutputValue>::RandomForestsMachi
     m_MaxNumberOfTrees(100),
     m_ForestAccuracy(0.01),
     m_TerminationCriteria(CV_TERMCRIT_ITER | CV_TERMCRIT_EPS), // identic for v3 ?
-    m_ComputeMargin(false)
+    m_ComputeMargin(false),
+    m_UseFlatForest(true)
 {
   this->m_ConfidenceIndex       = true;
   this->m_ProbaIndex            = false;
@@ -105,6 +109,7 @@ void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::Train()
   m_RFModel->setActiveVarCount(m_MaxNumberOfVariables);
   m_RFModel->setTermCriteria(cv::TermCriteria(m_TerminationCriteria, m_MaxNumberOfTrees, m_ForestAccuracy));
   m_RFModel->train(cv::ml::TrainData::create(samples, cv::ml::ROW_SAMPLE, labels, cv::noArray(), cv::noArray(), cv::noArray(), var_type));
+  this->FlattenForest();
 }
 
 template <class TInputValue, class TOutputValue>
@@ -112,13 +117,21 @@ typename RandomForestsMachineLearningModel<TInputValue, TOutputValue>::TargetSam
 RandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSampleType& value, ConfidenceValueType* quality,
                                                                         ProbaSampleType* proba) const
 {
-  // std::cout << "Enter predict" << std::endl;
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+
   TargetSampleType target;
   // convert listsample to Mat
   cv::Mat sample;
 
   otb::SampleToMat<InputSampleType>(value, sample);
 
+  if (m_UseFlatForest && !m_FlatForest.IsEmpty())
+  {
+    this->PredictFlat(sample, &target[0], quality);
+    return target;
+  }
+
   double result = m_RFModel->predict(sample);
 
   target[0] = static_cast<TOutputValue>(result);
@@ -131,10 +144,44 @@ RandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const In
       (*quality) = m_RFModel->predict_confidence(sample);
   }
 
+  return target[0];
+}
+
+template <class TInputValue, class TOutputValue>
+void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredictBlock(const InputValueType* input, unsigned int numberOfSamples,
+                                                                                   unsigned int numberOfFeatures, TargetValueType* targets,
+                                                                                   ConfidenceValueType* quality, double* proba, unsigned int) const
+{
   if (proba != nullptr && !this->m_ProbaIndex)
     itkExceptionMacro("Probability per class not available for this classifier !");
 
-  return target[0];
+  cv::Mat samples;
+  otb::BlockToMat(input, numberOfSamples, numberOfFeatures, samples);
+
+  if (m_UseFlatForest && !m_FlatForest.IsEmpty())
+  {
+    this->PredictFlat(samples, targets, quality);
+    return;
+  }
+
+  cv::Mat results;
+  m_RFModel->predict(samples, results);
+
+  for (unsigned int i = 0; i < numberOfSamples; ++i)
+  {
+    targets[i] = static_cast<TargetValueType>(results.at<float>(i, 0));
+  }
+
+  if (quality != nullptr)
+  {
+    for (unsigned int i = 0; i < numberOfSamples; ++i)
+    {
+      if (m_ComputeMargin)
+        quality[i] = m_RFModel->predict_margin(samples.row(i));
+      else
+        quality[i] = m_RFModel->predict_confidence(samples.row(i));
+    }
+  }
 }
 
 template <class TInputValue, class TOutputValue>
@@ -152,6 +199,130 @@ void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::Load(const st
 {
   cv::FileStorage fs(filename, cv::FileStorage::READ);
   m_RFModel->read(name.empty() ? fs.getFirstTopLevelNode() : fs[name]);
+  this->FlattenForest();
+}
+
+template <class TInputValue, class TOutputValue>
+void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::FlattenForest()
+{
+  m_FlatForest.Initialize(0);
+  m_FlatClassLabels.clear();
+
+  // Categorical splits are not flattened. OTB trains with numerical
+  // features only, so they only come from models trained elsewhere.
+  if (!m_RFModel->isTrained() || !m_RFModel->getSubsets().empty())
+  {
+    return;
+  }
+
+  const std::vector<cv::ml::DTrees::Node>&  nodes      = m_RFModel->getNodes();
+  const std::vector<cv::ml::DTrees::Split>& splits     = m_RFModel->getSplits();
+  const bool                                classifier = m_RFModel->isClassifier();
+
+  std::vector<FlatForest::TreeNode> flatNodes(nodes.size());
+  for (std::size_t i = 0; i < nodes.size(); ++i)
+  {
+    const cv::ml::DTrees::Node& node     = nodes[i];
+    FlatForest::TreeNode&       flatNode = flatNodes[i];
+    if (node.split < 0)
+    {
+      flatNode.feature = -1;
+      if (classifier)
+      {
+        // A leaf holds its class index and the corresponding label
+        flatNode.value = node.classIdx;
+        if (node.classIdx >= static_cast<int>(m_FlatClassLabels.size()))
+        {
+          m_FlatClassLabels.resize(node.classIdx + 1);
+        }
+        m_FlatClassLabels[node.classIdx] = node.value;
+      }
+      else
+      {
+        flatNode.value = node.value;
+      }
+    }
+    else
+    {
+      // Same test as OpenCV: go left if the feature is lower than or
+      // equal to the threshold, the other way if the split is inversed
+      const cv::ml::DTrees::Split& split = splits[node.split];
+      flatNode.feature                   = split.varIdx;
+      flatNode.threshold                 = split.c;
+      flatNode.left                      = split.inversed ? node.right : node.left;
+      flatNode.right                     = split.inversed ? node.left : node.right;
+      flatNode.value                     = 0.;
+    }
+  }
+
+  if (classifier && m_FlatClassLabels.empty())
+  {
+    return;
+  }
+  m_FlatForest.Initialize(classifier ? static_cast<unsigned int>(m_FlatClassLabels.size()) : 0);
+  for (int root : m_RFModel->getRoots())
+  {
+    m_FlatForest.AddTree(flatNodes, root);
+  }
+  otbMsgDevMacro(<< "Flattened " << m_FlatForest.GetNumberOfTrees() << " trees, " << m_FlatForest.GetNumberOfNodes() << " nodes");
+}
+
+template <class TInputValue, class TOutputValue>
+void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::PredictFlat(const cv::Mat& samples, TargetValueType* targets,
+                                                                                ConfidenceValueType* quality) const
+{
+  const std::size_t numberOfSamples = samples.rows;
+  const float*      data            = samples.ptr<float>(0);
+
+  if (m_FlatForest.GetNumberOfClasses() == 0)
+  {
+    std::vector<double> values(numberOfSamples);
+    m_FlatForest.PredictMean(data, numberOfSamples, samples.cols, values.data());
+    for (std::size_t i = 0; i < numberOfSamples; ++i)
+    {
+      targets[i] = static_cast<TargetValueType>(static_cast<float>(values[i]));
+      if (quality != nullptr)
+      {
+        quality[i] = m_ComputeMargin ? m_RFModel->predict_margin(samples.row(i)) : m_RFModel->predict_confidence(samples.row(i));
+      }
+    }
+    return;
+  }
+
+  const unsigned int        numberOfClasses = m_FlatForest.GetNumberOfClasses();
+  const unsigned int        numberOfTrees   = m_FlatForest.GetNumberOfTrees();
+  std::vector<unsigned int> votes(numberOfSamples * numberOfClasses);
+  m_FlatForest.PredictVotes(data, numberOfSamples, samples.cols, votes.data());
+  for (std::size_t i = 0; i < numberOfSamples; ++i)
+  {
+    // The first class with the most votes wins, as in OpenCV
+    const unsigned int* sampleVotes = votes.data() + i * numberOfClasses;
+    unsigned int        best        = 0;
+    for (unsigned int c = 1; c < numberOfClasses; ++c)
+    {
+      if (sampleVotes[best] < sampleVotes[c])
+      {
+        best = c;
+      }
+    }
+    targets[i] = static_cast<TargetValueType>(static_cast<float>(m_FlatClassLabels[best]));
+
+    if (quality != nullptr)
+    {
+      unsigned int second = 0;
+      for (unsigned int c = 0; c < numberOfClasses; ++c)
+      {
+        if (c != best)
+        {
+          second = std::max(second, sampleVotes[c]);
+        }
+      }
+      if (m_ComputeMargin)
+        quality[i] = static_cast<float>(sampleVotes[best] - second) / numberOfTrees;
+      else
+        quality[i] = static_cast<float>(sampleVotes[best]) / numberOfTrees;
+    }
+  }
 }
 
 template <class TInputValue, class TOutputValue>
@@ -210,6 +381,8 @@ void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::PrintSelf(std
 {
   // Call superclass implementation
   Superclass::PrintSelf(os, indent);
+  os << indent << "UseFlatForest: " << m_UseFlatForest << std::endl;
+  os << indent << "Number of flattened nodes: " << m_FlatForest.GetNumberOfNodes() << std::endl;
 }
 
 } // end namespace otb
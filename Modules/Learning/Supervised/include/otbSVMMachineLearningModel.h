@@ -138,6 +138,10 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  /** Predict a block of samples with a single call to OpenCV */
+  void DoPredictBlock(const InputValueType* input, unsigned int numberOfSamples, unsigned int numberOfFeatures, TargetValueType* targets,
+                      ConfidenceValueType* quality, double* proba, unsigned int probaSize) const override;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
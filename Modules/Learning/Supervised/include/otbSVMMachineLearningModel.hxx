@@ -133,6 +133,36 @@ SVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSampleT
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+void SVMMachineLearningModel<TInputValue, TOutputValue>::DoPredictBlock(const InputValueType* input, unsigned int numberOfSamples,
+                                                                         unsigned int numberOfFeatures, TargetValueType* targets,
+                                                                         ConfidenceValueType* quality, double* proba, unsigned int) const
+{
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+
+  cv::Mat samples;
+  otb::BlockToMat(input, numberOfSamples, numberOfFeatures, samples);
+
+  cv::Mat results;
+  m_SVMModel->predict(samples, results);
+
+  for (unsigned int i = 0; i < numberOfSamples; ++i)
+  {
+    targets[i] = static_cast<TargetValueType>(results.at<float>(i, 0));
+  }
+
+  if (quality != nullptr)
+  {
+    cv::Mat rawResults;
+    m_SVMModel->predict(samples, rawResults, cv::ml::StatModel::RAW_OUTPUT);
+    for (unsigned int i = 0; i < numberOfSamples; ++i)
+    {
+      quality[i] = rawResults.at<float>(i, 0);
+    }
+  }
+}
+
 template <class TInputValue, class TOutputValue>
 void SVMMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& name)
 {
@@ -65,6 +65,10 @@
  *
  *  It is noteworthy that training step is parallel.
  *
+ *  The forest can also be trained by chunks with PartialFit(): each chunk
+ *  grows NumberOfTrees trees, which are added to the forest. Every chunk
+ *  must contain every class.
+ *
  *  For more information, see
  *  http://image.diku.dk/shark/doxygen_pages/html/classshark_1_1_r_f_trainer.html
  *
@@ -167,6 +171,12 @@ protected:
   void DoPredictBatch(const InputListSampleType*, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType*,
                       ConfidenceListSampleType* = nullptr, ProbaListSampleType* = nullptr) const override;
 
+  void DoPredictBlock(const InputValueType* input, unsigned int numberOfSamples, unsigned int numberOfFeatures, TargetValueType* targets,
+                      ConfidenceValueType* quality, double* proba, unsigned int probaSize) const override;
+
+  /** Grow trees on the chunk and add them to the forest */
+  void DoPartialFit() override;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -179,6 +189,9 @@ private:
   std::vector<unsigned int>         m_ClassDictionary;
   bool                              m_NormalizeClassLabels;
 
+  /** Number of outputs of the trees grown by PartialFit() */
+  unsigned int m_PartialFitNumberOfClasses;
+
   unsigned int m_NumberOfTrees;
   unsigned int m_MTry;
   unsigned int m_NodeSize;
@@ -50,8 +50,10 @@ SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::SharkRandomFo
   this->m_ProbaIndex                    = true;
   this->m_IsRegressionSupported         = false;
   this->m_IsDoPredictBatchMultiThreaded = true;
+  this->m_IsPartialFitSupported         = true;
   this->m_NormalizeClassLabels          = true;
   this->m_ComputeMargin                 = false;
+  this->m_PartialFitNumberOfClasses     = 0;
 }
 
 /** Train the machine learning model */
@@ -81,6 +83,74 @@ void SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::Train()
   m_RFTrainer.train(m_RFModel, TrainSamples);
 }
 
+template <class TInputValue, class TOutputValue>
+void SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPartialFit()
+{
+#ifdef _OPENMP
+  omp_set_num_threads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
+#endif
+
+  std::vector<shark::RealVector> features;
+  std::vector<unsigned int>      class_labels;
+
+  Shark::ListSampleToSharkVector(this->GetInputListSample(), features);
+  Shark::ListSampleToSharkVector(this->GetTargetListSample(), class_labels);
+
+  // The classes are the ones of the first chunk
+  const bool firstChunk = this->m_NumberOfPartialFits == 0;
+  if (m_NormalizeClassLabels)
+  {
+    if (firstChunk)
+    {
+      Shark::NormalizeLabelsAndGetDictionary(class_labels, m_ClassDictionary);
+    }
+    else
+    {
+      // The dictionary is sorted
+      for (auto& label : class_labels)
+      {
+        auto it = std::lower_bound(m_ClassDictionary.begin(), m_ClassDictionary.end(), label);
+        if (it == m_ClassDictionary.end() || *it != label)
+        {
+          itkExceptionMacro(<< "Class " << label << " was not in the first chunk of samples.");
+        }
+        label = static_cast<unsigned int>(it - m_ClassDictionary.begin());
+      }
+    }
+  }
+
+  // A tree has one output per label up to the largest label of its
+  // samples, the trees of all the chunks must have the same number
+  const unsigned int numberOfClasses = *std::max_element(class_labels.begin(), class_labels.end()) + 1;
+  if (firstChunk)
+  {
+    m_PartialFitNumberOfClasses = numberOfClasses;
+  }
+  else if (numberOfClasses != m_PartialFitNumberOfClasses)
+  {
+    itkExceptionMacro(<< "The chunk of samples does not have the classes of the first chunk, its trees cannot be added to the forest.");
+  }
+
+  shark::ClassificationDataset TrainSamples = shark::createLabeledDataFromRange(features, class_labels);
+
+  m_RFTrainer.setMTry(m_MTry);
+  m_RFTrainer.setNTrees(m_NumberOfTrees);
+  m_RFTrainer.setNodeSize(m_NodeSize);
+  if (firstChunk)
+  {
+    m_RFTrainer.train(m_RFModel, TrainSamples);
+  }
+  else
+  {
+    shark::RFClassifier<unsigned int> chunkModel;
+    m_RFTrainer.train(chunkModel, TrainSamples);
+    for (std::size_t i = 0; i < chunkModel.numberOfModels(); ++i)
+    {
+      m_RFModel.addModel(chunkModel.model(i), chunkModel.weight(i));
+    }
+  }
+}
+
 template <class TInputValue, class TOutputValue>
 typename SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::ConfidenceValueType
 SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::ComputeConfidence(shark::RealVector& probas, bool computeMargin) const
@@ -219,6 +289,64 @@ void SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredic
   }
 }
 
+template <class TInputValue, class TOutputValue>
+void SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredictBlock(const InputValueType* input, unsigned int numberOfSamples,
+                                                                                       unsigned int numberOfFeatures, TargetValueType* targets,
+                                                                                       ConfidenceValueType* quality, double* proba,
+                                                                                       unsigned int probaSize) const
+{
+  assert(input != nullptr);
+  assert(targets != nullptr);
+
+  std::vector<shark::RealVector> features(numberOfSamples, shark::RealVector(numberOfFeatures));
+  for (unsigned int i = 0; i < numberOfSamples; ++i)
+  {
+    std::copy(input + static_cast<std::size_t>(i) * numberOfFeatures, input + static_cast<std::size_t>(i + 1) * numberOfFeatures, features[i].begin());
+  }
+  shark::Data<shark::RealVector> inputSamples = shark::createDataFromRange(features);
+
+#ifdef _OPENMP
+  omp_set_num_threads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
+
+#endif
+  if (proba != nullptr || quality != nullptr)
+  {
+    shark::Data<shark::RealVector> probas = m_RFModel.decisionFunction()(inputSamples);
+    std::size_t                    id     = 0;
+    for (shark::RealVector&& p : probas.elements())
+    {
+      if (proba != nullptr)
+      {
+        double* prob = proba + id * probaSize;
+        for (unsigned int c = 0; c < probaSize; ++c)
+        {
+          prob[c] = c < p.size() ? p[c] * 1000 : 0.;
+        }
+      }
+      if (quality != nullptr)
+      {
+        quality[id] = static_cast<ConfidenceValueType>(ComputeConfidence(p, m_ComputeMargin));
+      }
+      ++id;
+    }
+  }
+
+  auto        prediction = m_RFModel(inputSamples);
+  std::size_t id         = 0;
+  for (const auto& p : prediction.elements())
+  {
+    if (m_NormalizeClassLabels)
+    {
+      targets[id] = m_ClassDictionary[static_cast<TOutputValue>(p)];
+    }
+    else
+    {
+      targets[id] = static_cast<TOutputValue>(p);
+    }
+    ++id;
+  }
+}
+
 template <class TInputValue, class TOutputValue>
 void SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& itkNotUsed(name))
 {
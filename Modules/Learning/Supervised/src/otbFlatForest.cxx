@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbFlatForest.h"
+#include "itkMacro.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace otb
+{
+
+namespace
+{
+/** Largest float lower than or equal to threshold: for a float x,
+ *  x <= threshold if and only if x <= RoundDown(threshold) */
+float RoundDown(double threshold)
+{
+  if (std::isnan(threshold) || threshold == std::numeric_limits<double>::infinity())
+  {
+    return static_cast<float>(threshold);
+  }
+  if (threshold >= std::numeric_limits<float>::max())
+  {
+    return std::numeric_limits<float>::max();
+  }
+  if (threshold < -std::numeric_limits<float>::max())
+  {
+    return -std::numeric_limits<float>::infinity();
+  }
+  float rounded = static_cast<float>(threshold);
+  if (rounded > threshold)
+  {
+    rounded = std::nextafter(rounded, -std::numeric_limits<float>::infinity());
+  }
+  return rounded;
+}
+}
+
+const std::size_t FlatForest::BlockSize;
+
+FlatForest::FlatForest() : m_NumberOfClasses(0), m_NumberOfFeatures(0)
+{
+}
+
+void FlatForest::Initialize(unsigned int numberOfClasses)
+{
+  m_NumberOfClasses  = numberOfClasses;
+  m_NumberOfFeatures = 0;
+  m_Feature.clear();
+  m_Threshold.clear();
+  m_Left.clear();
+  m_Right.clear();
+  m_Value.clear();
+  m_Roots.clear();
+  m_Depths.clear();
+}
+
+void FlatForest::AddTree(const std::vector<TreeNode>& nodes, int root)
+{
+  if (root < 0 || static_cast<std::size_t>(root) >= nodes.size())
+  {
+    itkGenericExceptionMacro(<< "Root " << root << " is outside the " << nodes.size() << " nodes");
+  }
+
+  // Breadth first order of the nodes, the two children of a node are
+  // next to each other
+  std::vector<int>          order(1, root);
+  std::vector<unsigned int> levels(1, 0);
+  std::vector<int>          position(nodes.size(), -1);
+  position[root]     = 0;
+  unsigned int depth = 0;
+  for (std::size_t i = 0; i < order.size(); ++i)
+  {
+    const TreeNode& node = nodes[order[i]];
+    if (node.feature < 0)
+    {
+      continue;
+    }
+    for (int child : {node.left, node.right})
+    {
+      if (child < 0 || static_cast<std::size_t>(child) >= nodes.size())
+      {
+        itkGenericExceptionMacro(<< "Child " << child << " of node " << order[i] << " is outside the " << nodes.size() << " nodes");
+      }
+      if (position[child] >= 0)
+      {
+        itkGenericExceptionMacro(<< "Node " << child << " is reached twice, the nodes do not form a tree");
+      }
+      position[child] = static_cast<int>(order.size());
+      order.push_back(child);
+      levels.push_back(levels[i] + 1);
+      depth = std::max(depth, levels[i] + 1);
+    }
+  }
+
+  const std::int32_t offset = static_cast<std::int32_t>(m_Feature.size());
+  for (std::size_t i = 0; i < order.size(); ++i)
+  {
+    const TreeNode&    node  = nodes[order[i]];
+    const std::int32_t index = offset + static_cast<std::int32_t>(i);
+    if (node.feature < 0)
+    {
+      if (m_NumberOfClasses > 0 && !(node.value >= 0 && node.value < m_NumberOfClasses && node.value == std::floor(node.value)))
+      {
+        itkGenericExceptionMacro(<< "Leaf " << order[i] << " has value " << node.value << ", which is not a class index in [0, " << m_NumberOfClasses
+                                 << "[");
+      }
+      // A leaf is its own child
+      m_Feature.push_back(0);
+      m_Threshold.push_back(0.f);
+      m_Left.push_back(index);
+      m_Right.push_back(index);
+      m_Value.push_back(node.value);
+    }
+    else
+    {
+      m_Feature.push_back(node.feature);
+      m_Threshold.push_back(RoundDown(node.threshold));
+      m_Left.push_back(offset + position[node.left]);
+      m_Right.push_back(offset + position[node.right]);
+      m_Value.push_back(0.);
+      m_NumberOfFeatures = std::max(m_NumberOfFeatures, static_cast<unsigned int>(node.feature) + 1);
+    }
+  }
+
+  m_Roots.push_back(offset);
+  m_Depths.push_back(depth);
+}
+
+void FlatForest::FindLeaves(unsigned int tree, const float* samples, std::size_t numberOfSamples, unsigned int numberOfFeatures,
+                            std::int32_t* leaves) const
+{
+  const std::int32_t* feature   = m_Feature.data();
+  const float*        threshold = m_Threshold.data();
+  const std::int32_t* left      = m_Left.data();
+  const std::int32_t* right     = m_Right.data();
+
+  std::fill(leaves, leaves + numberOfSamples, m_Roots[tree]);
+  for (unsigned int level = 0; level < m_Depths[tree]; ++level)
+  {
+    for (std::size_t k = 0; k < numberOfSamples; ++k)
+    {
+      const std::int32_t node = leaves[k];
+      leaves[k]               = samples[k * numberOfFeatures + feature[node]] <= threshold[node] ? left[node] : right[node];
+    }
+  }
+}
+
+void FlatForest::PredictVotes(const float* samples, std::size_t numberOfSamples, unsigned int numberOfFeatures, unsigned int* votes) const
+{
+  if (numberOfFeatures < m_NumberOfFeatures)
+  {
+    itkGenericExceptionMacro(<< "Samples have " << numberOfFeatures << " features, the forest needs " << m_NumberOfFeatures);
+  }
+  std::fill(votes, votes + numberOfSamples * m_NumberOfClasses, 0u);
+
+  std::int32_t leaves[BlockSize];
+  for (std::size_t start = 0; start < numberOfSamples; start += BlockSize)
+  {
+    const std::size_t count      = std::min(BlockSize, numberOfSamples - start);
+    const float*      block      = samples + start * numberOfFeatures;
+    unsigned int*     blockVotes = votes + start * m_NumberOfClasses;
+    for (unsigned int tree = 0; tree < m_Roots.size(); ++tree)
+    {
+      FindLeaves(tree, block, count, numberOfFeatures, leaves);
+      for (std::size_t k = 0; k < count; ++k)
+      {
+        ++blockVotes[k * m_NumberOfClasses + static_cast<unsigned int>(m_Value[leaves[k]])];
+      }
+    }
+  }
+}
+
+void FlatForest::PredictMean(const float* samples, std::size_t numberOfSamples, unsigned int numberOfFeatures, double* output) const
+{
+  if (numberOfFeatures < m_NumberOfFeatures)
+  {
+    itkGenericExceptionMacro(<< "Samples have " << numberOfFeatures << " features, the forest needs " << m_NumberOfFeatures);
+  }
+
+  std::int32_t leaves[BlockSize];
+  for (std::size_t start = 0; start < numberOfSamples; start += BlockSize)
+  {
+    const std::size_t count       = std::min(BlockSize, numberOfSamples - start);
+    const float*      block       = samples + start * numberOfFeatures;
+    double*           blockOutput = output + start;
+    std::fill(blockOutput, blockOutput + count, 0.);
+    for (unsigned int tree = 0; tree < m_Roots.size(); ++tree)
+    {
+      FindLeaves(tree, block, count, numberOfFeatures, leaves);
+      for (std::size_t k = 0; k < count; ++k)
+      {
+        blockOutput[k] += m_Value[leaves[k]];
+      }
+    }
+    if (!m_Roots.empty())
+    {
+      for (std::size_t k = 0; k < count; ++k)
+      {
+        blockOutput[k] /= m_Roots.size();
+      }
+    }
+  }
+}
+
+} // end namespace otb
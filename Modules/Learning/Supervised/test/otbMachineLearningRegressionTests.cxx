@@ -22,6 +22,9 @@
 #include "otbConfigure.h"
 
 #include "itkMersenneTwisterRandomVariateGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 #if defined(OTB_USE_OPENCV) || defined(OTB_USE_LIBSVM)
 const double otb_epsilon_01 = 0.1;
@@ -591,4 +594,66 @@ int otbRandomForestsRegressionTests(int itkNotUsed(argc), char* itkNotUsed(argv)
   }
   return status;
 }
+
+/** Compare the regression of the flattened forest with the one of the
+ *  OpenCV trees, on single samples and on a block */
+int otbRandomForestsRegressionFlatForest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::RandomForestsMachineLearningModel<InputValueRegressionType, TargetValueRegressionType> RFType;
+
+  BilinearFunctionSampleGenerator<PrecisionType> bfsg(2.0, -1.0, 1.0);
+  bfsg.GenerateSamples(-0.5, 0.5, 1500);
+
+  RFType::Pointer regression = RFType::New();
+  regression->SetRegressionMode(true);
+  regression->SetRegressionAccuracy(0.005);
+  regression->SetInputListSample(bfsg.m_isl);
+  regression->SetTargetListSample(bfsg.m_tsl);
+  regression->Train();
+  if (!regression->HasFlatForest())
+  {
+    std::cout << "Failed : the regression forest has not been flattened" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  bfsg.GenerateSamples(-0.5, 0.5, 1000);
+  const unsigned int                    nbSamples  = bfsg.m_isl->Size();
+  const unsigned int                    nbFeatures = bfsg.m_isl->GetMeasurementVectorSize();
+  std::vector<InputValueRegressionType> block(static_cast<std::size_t>(nbSamples) * nbFeatures);
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    const InputSampleRegressionType& sample = bfsg.m_isl->GetMeasurementVector(i);
+    std::copy(sample.GetDataPointer(), sample.GetDataPointer() + nbFeatures, block.begin() + static_cast<std::size_t>(i) * nbFeatures);
+  }
+
+  std::vector<TargetValueRegressionType> flatBlock(nbSamples), cvBlock(nbSamples), flatSingle(nbSamples), cvSingle(nbSamples);
+
+  regression->SetUseFlatForest(true);
+  regression->PredictBlock(block.data(), nbSamples, nbFeatures, flatBlock.data());
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    flatSingle[i] = regression->Predict(bfsg.m_isl->GetMeasurementVector(i))[0];
+  }
+
+  regression->SetUseFlatForest(false);
+  regression->PredictBlock(block.data(), nbSamples, nbFeatures, cvBlock.data());
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    cvSingle[i] = regression->Predict(bfsg.m_isl->GetMeasurementVector(i))[0];
+  }
+
+  // The leaf values are summed in the same order: only the rounding of the
+  // mean may differ
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    const double tolerance = 1e-5 * std::max(1., std::abs(static_cast<double>(cvSingle[i])));
+    if (std::abs(flatBlock[i] - cvBlock[i]) > tolerance || std::abs(flatSingle[i] - cvSingle[i]) > tolerance || std::abs(cvBlock[i] - cvSingle[i]) > tolerance)
+    {
+      std::cout << "Failed : sample " << i << " is predicted " << flatBlock[i] << " (block) and " << flatSingle[i] << " (single) by the flat forest, " << cvBlock[i]
+                << " (block) and " << cvSingle[i] << " (single) by the OpenCV trees" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
 #endif
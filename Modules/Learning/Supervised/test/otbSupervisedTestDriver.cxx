@@ -54,8 +54,10 @@ void RegisterTests()
   REGISTER_TEST(otbSVMMachineLearningModel);
   REGISTER_TEST(otbKNearestNeighborsMachineLearningModel);
   REGISTER_TEST(otbRandomForestsMachineLearningModel);
+  REGISTER_TEST(otbRandomForestsFlatForest);
   REGISTER_TEST(otbBoostMachineLearningModel);
   REGISTER_TEST(otbANNMachineLearningModel);
+  REGISTER_TEST(otbANNMachineLearningModelPartialFit);
   REGISTER_TEST(otbNormalBayesMachineLearningModel);
   REGISTER_TEST(otbDecisionTreeMachineLearningModel);
   // regression tests
@@ -65,10 +67,12 @@ void RegisterTests()
   REGISTER_TEST(otbDecisionTreeRegressionTests);
   REGISTER_TEST(otbKNearestNeighborsRegressionTests);
   REGISTER_TEST(otbRandomForestsRegressionTests);
+  REGISTER_TEST(otbRandomForestsRegressionFlatForest);
 #endif
 
 #ifdef OTB_USE_SHARK
   REGISTER_TEST(otbSharkRFMachineLearningModel);
+  REGISTER_TEST(otbSharkRFMachineLearningModelPartialFit);
   REGISTER_TEST(otbSharkRFMachineLearningModelCanRead);
   REGISTER_TEST(otbSharkImageClassificationFilter);
 #endif
@@ -23,6 +23,9 @@
 #include <string>
 #include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <map>
+#include <vector>
 
 #include "otbMacro.h"
 
@@ -108,9 +111,111 @@ int otbGenericMachineLearningModel(int argc, char* argv[])
   otbLogMacro(Debug, << "PredictBatch took " << elapsed << " ms");
   const float kappaLoad = GetConfusionMatrixResults(predictedLoad, labels);
 
+  // Same prediction from a contiguous block of samples
+  const unsigned int          nbFeatures = samples->GetMeasurementVectorSize();
+  std::vector<InputValueType> block;
+  block.reserve(samples->Size() * nbFeatures);
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+  {
+    const InputSampleType& sample = samples->GetMeasurementVector(i);
+    block.insert(block.end(), sample.GetDataPointer(), sample.GetDataPointer() + nbFeatures);
+  }
+  std::vector<TargetValueType> predictedBlock(samples->Size());
+  classifierLoad->PredictBlock(block.data(), samples->Size(), nbFeatures, predictedBlock.data());
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+  {
+    if (predictedBlock[i] != predictedLoad->GetMeasurementVector(i)[0])
+    {
+      std::cout << "PredictBlock and PredictBatch differ for sample " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   return (std::abs(kappaLoad - kappa) < 0.00000001 ? EXIT_SUCCESS : EXIT_FAILURE);
 }
 
+template <class TModel>
+int otbGenericMachineLearningModelPartialFit(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::cout << "Wrong number of arguments " << std::endl;
+    std::cout << "Usage : sample file, output file, maximum kappa loss against a full training " << std::endl;
+    return EXIT_FAILURE;
+  }
+  const float maximumKappaLoss = static_cast<float>(atof(argv[3]));
+  InputListSampleType::Pointer  samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels  = TargetListSampleType::New();
+  if (!otb::ReadDataFile(argv[1], samples, labels))
+  {
+    std::cout << "Failed to read samples file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Deal the samples of each class to the chunks in turn, so that every
+  // chunk has every class
+  const unsigned int                         nbChunks = 4;
+  std::vector<InputListSampleType::Pointer>  chunkSamples(nbChunks);
+  std::vector<TargetListSampleType::Pointer> chunkLabels(nbChunks);
+  for (unsigned int c = 0; c < nbChunks; ++c)
+  {
+    chunkSamples[c] = InputListSampleType::New();
+    chunkSamples[c]->SetMeasurementVectorSize(samples->GetMeasurementVectorSize());
+    chunkLabels[c] = TargetListSampleType::New();
+  }
+  std::map<TargetValueType, unsigned int> dealt;
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+  {
+    const unsigned int c = dealt[labels->GetMeasurementVector(i)[0]]++ % nbChunks;
+    chunkSamples[c]->PushBack(samples->GetMeasurementVector(i));
+    chunkLabels[c]->PushBack(labels->GetMeasurementVector(i));
+  }
+
+  typename TModel::Pointer classifier = TModel::New();
+  SetupModel<TModel>(classifier);
+  if (!classifier->HasPartialFit())
+  {
+    std::cout << "The model cannot be trained by chunks" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (unsigned int c = 0; c < nbChunks; ++c)
+  {
+    classifier->SetInputListSample(chunkSamples[c]);
+    classifier->SetTargetListSample(chunkLabels[c]);
+    classifier->PartialFit();
+  }
+  if (classifier->GetNumberOfPartialFits() != nbChunks)
+  {
+    std::cout << "The model was updated with " << classifier->GetNumberOfPartialFits() << " chunks instead of " << nbChunks << std::endl;
+    return EXIT_FAILURE;
+  }
+  classifier->Save(argv[2]);
+  TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, NULL);
+  const float                   kappa     = GetConfusionMatrixResults(predicted, labels);
+
+  typename TModel::Pointer classifierLoad = TModel::New();
+  classifierLoad->Load(argv[2]);
+  TargetListSampleType::Pointer predictedLoad = classifierLoad->PredictBatch(samples, NULL);
+  const float                   kappaLoad     = GetConfusionMatrixResults(predictedLoad, labels);
+  if (std::abs(kappaLoad - kappa) >= 0.00000001)
+  {
+    std::cout << "Kappa of the loaded model " << kappaLoad << " differs from " << kappa << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The chunks should give nearly the accuracy of a training on all samples
+  typename TModel::Pointer classifierFull = TModel::New();
+  SetupModel<TModel>(classifierFull);
+  classifierFull->SetInputListSample(samples);
+  classifierFull->SetTargetListSample(labels);
+  classifierFull->Train();
+  TargetListSampleType::Pointer predictedFull = classifierFull->PredictBatch(samples, NULL);
+  const float                   kappaFull     = GetConfusionMatrixResults(predictedFull, labels);
+  std::cout << "Kappa by chunks " << kappa << ", on all samples " << kappaFull << std::endl;
+
+  return (kappa > kappaFull - maximumKappaLoss ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
 // -------------------------- LibSVM -------------------------------------------
 #ifdef OTB_USE_LIBSVM
 #include "otbLibSVMMachineLearningModel.h"
@@ -227,6 +332,68 @@ void SetupModel(RandomForestType* model)
   model->SetPriors(priors);
 }
 
+int otbRandomForestsFlatForest(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::cout << "Wrong number of arguments " << std::endl;
+    std::cout << "Usage : sample file" << std::endl;
+    return EXIT_FAILURE;
+  }
+  InputListSampleType::Pointer  samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels  = TargetListSampleType::New();
+  if (!otb::ReadDataFile(argv[1], samples, labels))
+  {
+    std::cout << "Failed to read samples file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  RandomForestType::Pointer classifier = RandomForestType::New();
+  classifier->SetInputListSample(samples);
+  classifier->SetTargetListSample(labels);
+  SetupModel<RandomForestType>(classifier);
+  classifier->SetMaxDepth(10);
+  classifier->Train();
+
+  // Repeat the samples to get a block large enough to time
+  const unsigned int          nbFeatures = samples->GetMeasurementVectorSize();
+  const unsigned int          nbSamples  = 100000;
+  std::vector<InputValueType> block(static_cast<std::size_t>(nbSamples) * nbFeatures);
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    const InputSampleType& sample = samples->GetMeasurementVector(i % samples->Size());
+    std::copy(sample.GetDataPointer(), sample.GetDataPointer() + nbFeatures, block.begin() + static_cast<std::size_t>(i) * nbFeatures);
+  }
+
+  using TimeT               = std::chrono::milliseconds;
+  using ConfidenceValueType = MachineLearningModelType::ConfidenceValueType;
+  std::vector<TargetValueType>     flatLabels(nbSamples), cvLabels(nbSamples);
+  std::vector<ConfidenceValueType> flatConfidences(nbSamples), cvConfidences(nbSamples);
+
+  classifier->SetUseFlatForest(true);
+  auto start = std::chrono::system_clock::now();
+  classifier->PredictBlock(block.data(), nbSamples, nbFeatures, flatLabels.data(), flatConfidences.data());
+  auto flatElapsed = std::chrono::duration_cast<TimeT>(std::chrono::system_clock::now() - start).count();
+
+  classifier->SetUseFlatForest(false);
+  start = std::chrono::system_clock::now();
+  classifier->PredictBlock(block.data(), nbSamples, nbFeatures, cvLabels.data(), cvConfidences.data());
+  auto cvElapsed = std::chrono::duration_cast<TimeT>(std::chrono::system_clock::now() - start).count();
+
+  otbLogMacro(Info, << "Flat forest: " << flatElapsed << " ms, OpenCV trees: " << cvElapsed << " ms for " << nbSamples << " samples");
+
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    if (flatLabels[i] != cvLabels[i] || flatConfidences[i] != cvConfidences[i])
+    {
+      std::cout << "Sample " << i << ": flat forest gives " << flatLabels[i] << " (" << flatConfidences[i] << "), OpenCV trees give " << cvLabels[i] << " ("
+                << cvConfidences[i] << ")" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
 using BoostType = otb::BoostMachineLearningModel<InputValueType, TargetValueType>;
 int otbBoostMachineLearningModel(int argc, char* argv[])
 {
@@ -254,6 +421,11 @@ int otbANNMachineLearningModel(int argc, char* argv[])
   return otbGenericMachineLearningModel<ANNType>(argc, argv);
 }
 
+int otbANNMachineLearningModelPartialFit(int argc, char* argv[])
+{
+  return otbGenericMachineLearningModelPartialFit<ANNType>(argc, argv);
+}
+
 template <>
 void SetupModel(ANNType* model)
 {
@@ -288,6 +460,11 @@ int otbSharkRFMachineLearningModel(int argc, char* argv[])
   return otbGenericMachineLearningModel<SharkRandomForestType>(argc, argv);
 }
 
+int otbSharkRFMachineLearningModelPartialFit(int argc, char* argv[])
+{
+  return otbGenericMachineLearningModelPartialFit<SharkRandomForestType>(argc, argv);
+}
+
 template <>
 void SetupModel(SharkRandomForestType* model)
 {
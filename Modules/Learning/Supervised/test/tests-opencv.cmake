@@ -24,6 +24,13 @@ otb_add_test(NAME leTvANNMachineLearningModel COMMAND otbSupervisedTestDriver
   ${TEMP}/ann_model.txt
   )
 
+otb_add_test(NAME leTvANNMachineLearningModelPartialFit COMMAND otbSupervisedTestDriver
+  otbANNMachineLearningModelPartialFit
+  ${INPUTDATA}/letter_light.scale
+  ${TEMP}/ann_model_partialfit.txt
+  0.1
+  )
+
 # ------------------ Regression tests --------------------
 otb_add_test(NAME leTvANNMachineLearningModelReg COMMAND otbSupervisedTestDriver
   otbNeuralNetworkRegressionTests
@@ -44,6 +51,10 @@ otb_add_test(NAME leTvKNearestNeighborsMachineLearningModelReg COMMAND otbSuperv
 otb_add_test(NAME leTvRandomForestsMachineLearningModelReg COMMAND otbSupervisedTestDriver
   otbRandomForestsRegressionTests
   )
+
+otb_add_test(NAME leTvRandomForestsRegressionFlatForest COMMAND otbSupervisedTestDriver
+  otbRandomForestsRegressionFlatForest
+  )
 # --------------------------------------------------------------
 
 otb_add_test(NAME leTvSVMMachineLearningRegressionModel COMMAND otbSupervisedTestDriver
@@ -70,6 +81,11 @@ otb_add_test(NAME leTvRandomForestsMachineLearningModel COMMAND otbSupervisedTes
   ${TEMP}/rf_model.txt
   )
 
+otb_add_test(NAME leTvRandomForestsFlatForest COMMAND otbSupervisedTestDriver
+  otbRandomForestsFlatForest
+  ${INPUTDATA}/letter_light.scale
+  )
+
 otb_add_test(NAME leTvKNearestNeighborsMachineLearningModel COMMAND otbSupervisedTestDriver
   otbKNearestNeighborsMachineLearningModel
   ${INPUTDATA}/letter_light.scale
@@ -24,6 +24,13 @@ otb_add_test(NAME leTvSharkRFMachineLearningModel COMMAND otbSupervisedTestDrive
   ${TEMP}/shark_rf_model.txt
   )
 
+otb_add_test(NAME leTvSharkRFMachineLearningModelPartialFit COMMAND otbSupervisedTestDriver
+  otbSharkRFMachineLearningModelPartialFit
+  ${INPUTDATA}/letter_light.scale
+  ${TEMP}/shark_rf_model_partialfit.txt
+  0.1
+  )
+
 otb_add_test(NAME leTvSharkRFMachineLearningModelCanRead COMMAND otbSupervisedTestDriver
   otbSharkRFMachineLearningModelCanRead
   ${INPUTDATA}/Classification/otbSharkImageClassificationFilter_RFmodel.txt
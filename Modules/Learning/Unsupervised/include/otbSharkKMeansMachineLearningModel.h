@@ -156,6 +156,15 @@ protected:
   virtual void DoPredictBatch(const InputListSampleType*, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType*,
                               ConfidenceListSampleType* = nullptr, ProbaListSampleType* = nullptr) const override;
 
+  virtual void DoPredictBlock(const InputValueType* input, unsigned int numberOfSamples, unsigned int numberOfFeatures, TargetValueType* targets,
+                              ConfidenceValueType* quality, double* proba, unsigned int probaSize) const override;
+
+  /** Mini-batch k-means (Sculley, 2010): the first chunk is clustered as
+   *  in Train(), then each sample of the next chunks moves its nearest
+   *  centroid towards it, by the inverse of the number of samples already
+   *  assigned to this centroid */
+  virtual void DoPartialFit() override;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -171,6 +180,9 @@ private:
   /** Centroids results form kMeans */
   shark::Centroids m_Centroids;
 
+  /** Number of samples assigned to each centroid by PartialFit() */
+  std::vector<std::size_t> m_ClusterSizes;
+
   /** shark Model could be SoftClusteringModel or HardClusteringModel */
   std::shared_ptr<ClusteringModelType> m_ClusteringModel;
 };
@@ -20,7 +20,9 @@
 #ifndef otbSharkKMeansMachineLearningModel_hxx
 #define otbSharkKMeansMachineLearningModel_hxx
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
 #include <utility>
 
 #include "itkMacro.h"
@@ -57,8 +59,9 @@ template <class TInputValue, class TOutputValue>
 SharkKMeansMachineLearningModel<TInputValue, TOutputValue>::SharkKMeansMachineLearningModel() : m_K(2), m_MaximumNumberOfIterations(10)
 {
   // Default set HardClusteringModel
-  this->m_ConfidenceIndex = true;
-  m_ClusteringModel       = std::make_shared<ClusteringModelType>(&m_Centroids);
+  this->m_ConfidenceIndex       = true;
+  this->m_IsPartialFitSupported = true;
+  m_ClusteringModel             = std::make_shared<ClusteringModelType>(&m_Centroids);
 }
 
 
@@ -81,6 +84,64 @@ void SharkKMeansMachineLearningModel<TInputValue, TOutputValue>::Train()
   m_ClusteringModel = std::make_shared<ClusteringModelType>(&m_Centroids);
 }
 
+template <class TInputValue, class TOutputValue>
+void SharkKMeansMachineLearningModel<TInputValue, TOutputValue>::DoPartialFit()
+{
+  std::vector<shark::RealVector> vector_data;
+  otb::Shark::ListSampleToSharkVector(this->GetInputListSample(), vector_data);
+
+  const bool firstChunk = this->m_NumberOfPartialFits == 0;
+  if (firstChunk)
+  {
+    shark::Data<shark::RealVector> data = shark::createDataFromRange(vector_data);
+    shark::kMeans(data, m_K, m_Centroids, m_MaximumNumberOfIterations);
+    m_ClusterSizes.assign(m_Centroids.numberOfClusters(), 0);
+  }
+
+  std::vector<shark::RealVector> centroids;
+  for (const auto& centroid : m_Centroids.centroids().elements())
+  {
+    centroids.push_back(shark::RealVector(centroid));
+  }
+
+  for (const auto& sample : vector_data)
+  {
+    std::size_t nearest      = 0;
+    double      nearestDist2 = std::numeric_limits<double>::max();
+    for (std::size_t c = 0; c < centroids.size(); ++c)
+    {
+      double dist2 = 0.;
+      for (std::size_t d = 0; d < sample.size(); ++d)
+      {
+        const double diff = sample(d) - centroids[c](d);
+        dist2 += diff * diff;
+      }
+      if (dist2 < nearestDist2)
+      {
+        nearest      = c;
+        nearestDist2 = dist2;
+      }
+    }
+
+    // The first chunk only sets the sizes of the clusters found by kMeans
+    ++m_ClusterSizes[nearest];
+    if (!firstChunk)
+    {
+      const double rate = 1. / m_ClusterSizes[nearest];
+      for (std::size_t d = 0; d < sample.size(); ++d)
+      {
+        centroids[nearest](d) += rate * (sample(d) - centroids[nearest](d));
+      }
+    }
+  }
+
+  if (!firstChunk)
+  {
+    m_Centroids.setCentroids(shark::createDataFromRange(centroids));
+  }
+  m_ClusteringModel = std::make_shared<ClusteringModelType>(&m_Centroids);
+}
+
 template <class TInputValue, class TOutputValue>
 typename SharkKMeansMachineLearningModel<TInputValue, TOutputValue>::TargetSampleType
 SharkKMeansMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSampleType& value, ConfidenceValueType* quality, ProbaSampleType* proba) const
@@ -88,7 +149,7 @@ SharkKMeansMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const Inpu
   shark::RealVector data(value.Size());
   for (size_t i = 0; i < value.Size(); i++)
   {
-    data.push_back(value[i]);
+    data[i] = value[i];
   }
 
   // Change quality measurement only if SoftClustering or other clustering method is used.
@@ -172,6 +233,53 @@ void SharkKMeansMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(
 }
 
 
+template <class TInputValue, class TOutputValue>
+void SharkKMeansMachineLearningModel<TInputValue, TOutputValue>::DoPredictBlock(const InputValueType* input, unsigned int numberOfSamples,
+                                                                                unsigned int numberOfFeatures, TargetValueType* targets,
+                                                                                ConfidenceValueType* quality, double* proba,
+                                                                                unsigned int itkNotUsed(probaSize)) const
+{
+  assert(input != nullptr);
+  assert(targets != nullptr);
+
+  std::vector<shark::RealVector> features(numberOfSamples, shark::RealVector(numberOfFeatures));
+  for (unsigned int i = 0; i < numberOfSamples; ++i)
+  {
+    std::copy(input + static_cast<std::size_t>(i) * numberOfFeatures, input + static_cast<std::size_t>(i + 1) * numberOfFeatures, features[i].begin());
+  }
+  shark::Data<shark::RealVector> inputSamples = shark::createDataFromRange(features);
+
+  shark::Data<ClusteringOutputType> clusters;
+  try
+  {
+    clusters = (*m_ClusteringModel)(inputSamples);
+  }
+  catch (...)
+  {
+    itkExceptionMacro(
+        "Failed to run clustering classification. "
+        "The number of features of input samples and the model could differ.");
+  }
+
+  std::size_t id = 0;
+  for (const auto& p : clusters.elements())
+  {
+    targets[id] = static_cast<TOutputValue>(p);
+    ++id;
+  }
+
+  // Change quality measurement only if SoftClustering or other clustering method is used.
+  if (quality != nullptr)
+  {
+    std::fill(quality, quality + numberOfSamples, static_cast<ConfidenceValueType>(1.));
+  }
+  if (proba != nullptr && !this->m_ProbaIndex)
+  {
+    itkExceptionMacro("Probability per class not available for this classifier !");
+  }
+}
+
+
 template <class TInputValue, class TOutputValue>
 void SharkKMeansMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& itkNotUsed(name))
 {
@@ -42,7 +42,10 @@ typedef MachineLearningModelRegressionType::TargetListSampleType TargetListSampl
 #ifdef OTB_USE_SHARK
 #include "otbSharkKMeansMachineLearningModel.h"
 #include "otb_boost_string_header.h"
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <vector>
 
 bool SharkReadDataFile(const std::string& infname, InputListSampleType* samples, TargetListSampleType* labels)
 {
@@ -110,6 +113,42 @@ bool SharkReadDataFile(const std::string& infname, InputListSampleType* samples,
 }
 
 
+/** Sum of the squared distances of the samples to the mean of their cluster */
+double ComputeInertia(const InputListSampleType* samples, const TargetListSampleType* clusters, unsigned int k)
+{
+  const unsigned int               nbFeatures = samples->GetMeasurementVectorSize();
+  std::vector<std::vector<double>> means(k, std::vector<double>(nbFeatures, 0.));
+  std::vector<unsigned int>        sizes(k, 0);
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+  {
+    const unsigned int c = static_cast<unsigned int>(clusters->GetMeasurementVector(i)[0]);
+    ++sizes[c];
+    for (unsigned int d = 0; d < nbFeatures; ++d)
+    {
+      means[c][d] += samples->GetMeasurementVector(i)[d];
+    }
+  }
+  for (unsigned int c = 0; c < k; ++c)
+  {
+    for (unsigned int d = 0; d < nbFeatures && sizes[c] > 0; ++d)
+    {
+      means[c][d] /= sizes[c];
+    }
+  }
+  double inertia = 0.;
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+  {
+    const unsigned int c = static_cast<unsigned int>(clusters->GetMeasurementVector(i)[0]);
+    for (unsigned int d = 0; d < nbFeatures; ++d)
+    {
+      const double diff = samples->GetMeasurementVector(i)[d] - means[c][d];
+      inertia += diff * diff;
+    }
+  }
+  return inertia;
+}
+
+
 int otbSharkKMeansMachineLearningModelTrain(int argc, char* argv[])
 {
   if (argc != 3)
@@ -143,6 +182,74 @@ int otbSharkKMeansMachineLearningModelTrain(int argc, char* argv[])
   return EXIT_SUCCESS;
 }
 
+int otbSharkKMeansMachineLearningModelPartialFit(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::cout << "Wrong number of arguments " << std::endl;
+    std::cout << "Usage : sample file, output file, maximum relative inertia increase against a full training " << std::endl;
+    return EXIT_FAILURE;
+  }
+  const double maximumInertiaIncrease = atof(argv[3]);
+
+  typedef otb::SharkKMeansMachineLearningModel<InputValueType, TargetValueType> KMeansType;
+  InputListSampleType::Pointer  samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels  = TargetListSampleType::New();
+
+  if (!SharkReadDataFile(argv[1], samples, labels))
+  {
+    std::cout << "Failed to read samples file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  KMeansType::Pointer classifier = KMeansType::New();
+  classifier->SetRegressionMode(false);
+  classifier->SetK(3);
+  classifier->SetMaximumNumberOfIterations(10);
+
+  // Train on 4 chunks of consecutive samples
+  const unsigned int nbChunks  = 4;
+  const unsigned int chunkSize = (samples->Size() + nbChunks - 1) / nbChunks;
+  for (unsigned int c = 0; c < nbChunks; ++c)
+  {
+    InputListSampleType::Pointer  chunkSamples = InputListSampleType::New();
+    TargetListSampleType::Pointer chunkLabels  = TargetListSampleType::New();
+    chunkSamples->SetMeasurementVectorSize(samples->GetMeasurementVectorSize());
+    for (unsigned int i = c * chunkSize; i < std::min<unsigned int>((c + 1) * chunkSize, samples->Size()); ++i)
+    {
+      chunkSamples->PushBack(samples->GetMeasurementVector(i));
+      chunkLabels->PushBack(labels->GetMeasurementVector(i));
+    }
+    classifier->SetInputListSample(chunkSamples);
+    classifier->SetTargetListSample(chunkLabels);
+    std::cout << "PartialFit " << c << "\n";
+    classifier->PartialFit();
+  }
+  if (classifier->GetNumberOfPartialFits() != nbChunks)
+  {
+    std::cout << "The model was updated with " << classifier->GetNumberOfPartialFits() << " chunks instead of " << nbChunks << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Save\n";
+  classifier->Save(argv[2]);
+
+  // The clusters should be nearly as compact as the ones of a training on
+  // all samples
+  KMeansType::Pointer classifierFull = KMeansType::New();
+  classifierFull->SetRegressionMode(false);
+  classifierFull->SetK(3);
+  classifierFull->SetMaximumNumberOfIterations(10);
+  classifierFull->SetInputListSample(samples);
+  classifierFull->SetTargetListSample(labels);
+  classifierFull->Train();
+
+  const double inertia     = ComputeInertia(samples, classifier->PredictBatch(samples), 3);
+  const double inertiaFull = ComputeInertia(samples, classifierFull->PredictBatch(samples), 3);
+  std::cout << "Inertia by chunks " << inertia << ", on all samples " << inertiaFull << std::endl;
+
+  return (inertia <= inertiaFull * (1. + maximumInertiaIncrease) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
 
 int otbSharkKMeansMachineLearningModelPredict(int argc, char* argv[])
 {
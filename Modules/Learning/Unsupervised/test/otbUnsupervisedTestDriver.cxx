@@ -28,6 +28,7 @@ void RegisterTests()
 #ifdef OTB_USE_SHARK
   REGISTER_TEST(otbSharkKMeansMachineLearningModelCanRead);
   REGISTER_TEST(otbSharkKMeansMachineLearningModelTrain);
+  REGISTER_TEST(otbSharkKMeansMachineLearningModelPartialFit);
   REGISTER_TEST(otbSharkKMeansMachineLearningModelPredict);
   REGISTER_TEST(otbSharkUnsupervisedImageClassificationFilter);
 #endif
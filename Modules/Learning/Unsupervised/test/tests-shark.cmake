@@ -26,6 +26,13 @@ otb_add_test(NAME leTvSharkKMeansMachineLearningModel COMMAND otbUnsupervisedTes
   ${TEMP}/shark_km_model.txt
   )
 
+otb_add_test(NAME leTvSharkKMeansMachineLearningModelPartialFit COMMAND otbUnsupervisedTestDriver
+  otbSharkKMeansMachineLearningModelPartialFit
+  ${INPUTDATA}/letter.scale
+  ${TEMP}/shark_km_model_partialfit.txt
+  0.1
+  )
+
 otb_add_test(NAME otbSharkKMeansMachineLearningModelPredict COMMAND otbUnsupervisedTestDriver
   otbSharkKMeansMachineLearningModelPredict
   ${INPUTDATA}/letter.scale